@@ -62,7 +62,7 @@ static int runQtApplication(int argc, char* argv[], qtwebapp::LoggerWithFile *lo
     std::vector<int> vsig(catchSignals, catchSignals + sizeof(catchSignals) / sizeof(int));
     catchUnixSignals(vsig);
 
-    MainParser parser;
+    MainParser parser(true);
     parser.parse(a);
 
 #if QT_VERSION >= 0x050400
@@ -55,7 +55,8 @@ DaemonSink::DaemonSink(DeviceSourceAPI *deviceAPI) :
         m_nbBlocksFEC(0),
         m_txDelay(35),
         m_dataAddress("127.0.0.1"),
-        m_dataPort(9090)
+        m_dataPort(9090),
+        m_useGSO(false)
 {
     setObjectName(m_channelId);
 
@@ -188,6 +189,7 @@ void DaemonSink::feed(const SampleVector::const_iterator& begin, const SampleVec
                 m_dataBlock->m_txControlBlock.m_txDelay = m_txDelay;
                 m_dataBlock->m_txControlBlock.m_dataAddress = m_dataAddress;
                 m_dataBlock->m_txControlBlock.m_dataPort = m_dataPort;
+                m_dataBlock->m_txControlBlock.m_useGSO = m_useGSO;
 
                 emit dataBlockAvailable(m_dataBlock);
                 m_dataBlock = new SDRDaemonDataBlock(); // create a new one immediately
@@ -317,6 +319,7 @@ void DaemonSink::applySettings(const DaemonSinkSettings& settings, bool force)
             << " m_txDelay: " << settings.m_txDelay
             << " m_dataAddress: " << settings.m_dataAddress
             << " m_dataPort: " << settings.m_dataPort
+            << " m_useGSO: " << settings.m_useGSO
             << " force: " << force;
 
     if ((m_settings.m_nbFECBlocks != settings.m_nbFECBlocks) || force) {
@@ -336,6 +339,10 @@ void DaemonSink::applySettings(const DaemonSinkSettings& settings, bool force)
         m_dataPort = settings.m_dataPort;
     }
 
+    if ((m_settings.m_useGSO != settings.m_useGSO) || force) {
+        m_useGSO = settings.m_useGSO;
+    }
+
     m_settings = settings;
 }
 
@@ -394,6 +401,10 @@ int DaemonSink::webapiSettingsPutPatch(
         }
     }
 
+    if (channelSettingsKeys.contains("useGSO")) {
+        settings.m_useGSO = response.getDaemonSinkSettings()->getUseGso() != 0;
+    }
+
     if (channelSettingsKeys.contains("rgbColor")) {
         settings.m_rgbColor = response.getDaemonSinkSettings()->getRgbColor();
     }
@@ -421,6 +432,7 @@ void DaemonSink::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& re
 {
     response.getDaemonSinkSettings()->setNbFecBlocks(settings.m_nbFECBlocks);
     response.getDaemonSinkSettings()->setTxDelay(settings.m_txDelay);
+    response.getDaemonSinkSettings()->setUseGso(settings.m_useGSO ? 1 : 0);
 
     if (response.getDaemonSinkSettings()->getDataAddress()) {
         *response.getDaemonSinkSettings()->getDataAddress() = settings.m_dataAddress;
@@ -148,6 +148,7 @@ private:
     int m_txDelay;
     QString m_dataAddress;
     uint16_t m_dataPort;
+    bool m_useGSO;
 
     void applySettings(const DaemonSinkSettings& settings, bool force = false);
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const DaemonSinkSettings& settings);
@@ -35,6 +35,7 @@ void DaemonSinkSettings::resetToDefaults()
 {
     m_nbFECBlocks = 0;
     m_txDelay = 35;
+    m_useGSO = false;
     m_dataAddress = "127.0.0.1";
     m_dataPort = 9090;
     m_rgbColor = QColor(140, 4, 4).rgb();
@@ -50,6 +51,7 @@ QByteArray DaemonSinkSettings::serialize() const
     s.writeU32(4, m_dataPort);
     s.writeU32(5, m_rgbColor);
     s.writeString(6, m_title);
+    s.writeBool(7, m_useGSO);
 
     return s.final();
 }
@@ -89,6 +91,7 @@ bool DaemonSinkSettings::deserialize(const QByteArray& data)
 
         d.readU32(5, &m_rgbColor, QColor(0, 255, 255).rgb());
         d.readString(6, &m_title, "Daemon sink");
+        d.readBool(7, &m_useGSO, false);
 
         return true;
     }
@@ -31,6 +31,7 @@ struct DaemonSinkSettings
 {
     uint16_t m_nbFECBlocks;
     uint32_t m_txDelay;
+    bool     m_useGSO; //!< UDP segmentation offload (Linux)
     QString  m_dataAddress;
     uint16_t m_dataPort;
     quint32 m_rgbColor;
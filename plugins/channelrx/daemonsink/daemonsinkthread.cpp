@@ -23,9 +23,11 @@
 #include <QUdpSocket>
 
 #include "channel/sdrdaemondatablock.h"
+#include "util/udpbatchsender.h"
 #include "daemonsinkthread.h"
 
 #include "cm256.h"
+#include "util/threadroles.h"
 
 MESSAGE_CLASS_DEFINITION(DaemonSinkThread::MsgStartStop, Message)
 
@@ -33,7 +35,8 @@ DaemonSinkThread::DaemonSinkThread(QObject* parent) :
     QThread(parent),
     m_running(false),
     m_address(QHostAddress::LocalHost),
-    m_socket(0)
+    m_socket(0),
+    m_batchSender(0)
 {
 
     m_cm256p = m_cm256.isInitialized() ? &m_cm256 : 0;
@@ -56,6 +59,7 @@ void DaemonSinkThread::startWork()
     qDebug("DaemonSinkThread::startWork");
 	m_startWaitMutex.lock();
 	m_socket = new QUdpSocket(this);
+	m_batchSender = new UDPBatchSender(m_socket);
 	start();
 	while(!m_running)
 		m_startWaiter.wait(&m_startWaitMutex, 100);
@@ -65,6 +69,8 @@ void DaemonSinkThread::startWork()
 void DaemonSinkThread::stopWork()
 {
 	qDebug("DaemonSinkThread::stopWork");
+    delete m_batchSender;
+    m_batchSender = 0;
     delete m_socket;
     m_socket = 0;
 	m_running = false;
@@ -73,6 +79,8 @@ void DaemonSinkThread::stopWork()
 
 void DaemonSinkThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleNetwork);
+
     qDebug("DaemonSinkThread::run: begin");
 	m_running = true;
 	m_startWaiter.wakeAll();
@@ -103,19 +111,12 @@ void DaemonSinkThread::handleDataBlock(SDRDaemonDataBlock& dataBlock)
     int txDelay = dataBlock.m_txControlBlock.m_txDelay;
     m_address.setAddress(dataBlock.m_txControlBlock.m_dataAddress);
     uint16_t dataPort = dataBlock.m_txControlBlock.m_dataPort;
+    bool useGSO = dataBlock.m_txControlBlock.m_useGSO;
     SDRDaemonSuperBlock *txBlockx = dataBlock.m_superBlocks;
 
     if ((nbBlocksFEC == 0) || !m_cm256p) // Do not FEC encode
     {
-        if (m_socket)
-        {
-            for (int i = 0; i < SDRDaemonNbOrginalBlocks; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) SDRDaemonUdpSize, m_address, dataPort);
-                usleep(txDelay);
-            }
-        }
+        sendBlocks(txBlockx, SDRDaemonNbOrginalBlocks, dataPort, txDelay, useGSO);
     }
     else
     {
@@ -152,20 +153,36 @@ void DaemonSinkThread::handleDataBlock(SDRDaemonDataBlock& dataBlock)
         }
 
         // Transmit all blocks
-        if (m_socket)
-        {
-            for (int i = 0; i < cm256Params.OriginalCount + cm256Params.RecoveryCount; i++)
-            {
-                // send block via UDP
-                m_socket->writeDatagram((const char*)&txBlockx[i], (qint64 ) SDRDaemonUdpSize, m_address, dataPort);
-                usleep(txDelay);
-            }
-        }
+        sendBlocks(txBlockx, cm256Params.OriginalCount + cm256Params.RecoveryCount, dataPort, txDelay, useGSO);
     }
 
     dataBlock.m_txControlBlock.m_processed = true;
 }
 
+void DaemonSinkThread::sendBlocks(SDRDaemonSuperBlock *blocks, int nbBlocks, uint16_t dataPort, int txDelay, bool useGSO)
+{
+    if (!m_batchSender) {
+        return;
+    }
+
+    m_batchSender->setDestination(m_address, dataPort);
+    m_batchSender->setUseGSO(useGSO);
+
+    // the whole frame goes in one batch unless transmission is paced in which case
+    // the delay is applied per group of blocks instead of after each block
+    int batchSize = txDelay > 0 ? m_pacedBatchSize : nbBlocks;
+
+    for (int i = 0; i < nbBlocks; i += batchSize)
+    {
+        int nbBatch = std::min(batchSize, nbBlocks - i);
+        m_batchSender->send((const char*) &blocks[i], SDRDaemonUdpSize, nbBatch);
+
+        if (txDelay > 0) {
+            usleep(txDelay * nbBatch);
+        }
+    }
+}
+
 void DaemonSinkThread::handleInputMessages()
 {
     Message* message;
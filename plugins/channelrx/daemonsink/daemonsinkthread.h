@@ -31,8 +31,10 @@
 #include "util/messagequeue.h"
 
 class SDRDaemonDataBlock;
+struct SDRDaemonSuperBlock;
 class CM256;
 class QUdpSocket;
+class UDPBatchSender;
 
 class DaemonSinkThread : public QThread {
     Q_OBJECT
@@ -75,6 +77,9 @@ private:
 
     QHostAddress m_address;
     QUdpSocket *m_socket;
+    UDPBatchSender *m_batchSender;
+
+    static const int m_pacedBatchSize = 8; //!< blocks sent at once between delays when transmission is paced
 
     MessageQueue m_inputMessageQueue;
 
@@ -83,6 +88,7 @@ private:
 
     void run();
     void handleDataBlock(SDRDaemonDataBlock& dataBlock);
+    void sendBlocks(SDRDaemonSuperBlock *blocks, int nbBlocks, uint16_t dataPort, int txDelay, bool useGSO);
 
 private slots:
     void handleInputMessages();
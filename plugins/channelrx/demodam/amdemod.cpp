@@ -100,38 +100,27 @@ AMDemod::~AMDemod()
 
 void AMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst __attribute__((unused)))
 {
-	Complex ci;
-
 	if (!m_running) {
         return;
     }
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	unsigned int nbSamples = end - begin;
 
-		if (m_interpolatorDistance < 1.0f) // interpolate
-		{
-            processOneSample(ci);
+	if (m_mixBuffer.size() < nbSamples) {
+	    m_mixBuffer.resize(nbSamples);
+	}
 
-		    while (m_interpolator.interpolate(&m_interpolatorDistanceRemain, c, &ci))
-            {
-                processOneSample(ci);
-            }
+	if (nbSamples > 0) {
+	    m_nco.mixBlock(&(*begin), m_mixBuffer.data(), nbSamples);
+	}
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
-		}
-		else // decimate
-		{
-	        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-	        {
-	            processOneSample(ci);
-	            m_interpolatorDistanceRemain += m_interpolatorDistance;
-	        }
-		}
+	// decimates or interpolates depending on the audio rate
+	int nbOutput = m_resampler.resample(m_mixBuffer.data(), nbSamples, m_resampleBuffer);
+
+	for (int i = 0; i < nbOutput; i++) {
+	    processOneSample(m_resampleBuffer[i]);
 	}
 
 	if (m_audioBufferFill > 0)
@@ -367,9 +356,7 @@ void AMDemod::applyAudioSampleRate(int sampleRate)
 
     m_settingsMutex.lock();
 
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
+    m_resampler.create(16, m_inputSampleRate, sampleRate, m_settings.m_rfBandwidth / 2.2f);
     m_bandpass.create(301, sampleRate, 300.0, m_settings.m_rfBandwidth / 2.0f);
     m_audioFifo.setSize(sampleRate);
     m_squelchDelayLine.resize(sampleRate/5);
@@ -404,9 +391,7 @@ void AMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset
     if ((m_inputSampleRate != inputSampleRate) || force)
     {
         m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, inputSampleRate, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2f);
         m_settingsMutex.unlock();
     }
 
@@ -432,9 +417,7 @@ void AMDemod::applySettings(const AMDemodSettings& settings, bool force)
         (m_settings.m_bandpassEnable != settings.m_bandpassEnable) || force)
     {
         m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, m_inputSampleRate, m_audioSampleRate, settings.m_rfBandwidth / 2.2f);
         m_bandpass.create(301, m_audioSampleRate, 300.0, settings.m_rfBandwidth / 2.0f);
         DSBFilter->create_dsb_filter((2.0f * settings.m_rfBandwidth) / (float) m_audioSampleRate);
         m_settingsMutex.unlock();
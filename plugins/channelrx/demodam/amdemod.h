@@ -23,7 +23,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelsinkapi.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "util/movingaverage.h"
 #include "dsp/agc.h"
 #include "dsp/bandpass.h"
@@ -173,9 +173,9 @@ private:
     bool m_running;
 
 	NCO m_nco;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
-	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_mixBuffer; //!< block shifted to baseband
+	PolyphaseResampler m_resampler;
+	std::vector<Complex> m_resampleBuffer; //!< block at audio sample rate
 
 	Real m_squelchLevel;
 	uint32_t m_squelchCount;
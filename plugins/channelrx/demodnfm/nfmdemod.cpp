@@ -26,6 +26,7 @@
 #include "SWGNFMDemodReport.h"
 
 #include "dsp/downchannelizer.h"
+#include "dsp/pfbchannelizer.h"
 #include "util/stepfunctions.h"
 #include "util/db.h"
 #include "audio/audiooutput.h"
@@ -50,6 +51,9 @@ const int NFMDemod::m_udpBlockSize = 512;
 NFMDemod::NFMDemod(DeviceSourceAPI *devieAPI) :
         ChannelSinkAPI(m_channelIdURI),
         m_deviceAPI(devieAPI),
+        m_pfbChannelizer(0),
+        m_pfbChannels(0),
+        m_pfbChannel(-1),
         m_inputSampleRate(48000),
         m_inputFrequencyOffset(0),
         m_running(false),
@@ -100,7 +104,7 @@ NFMDemod::~NFMDemod()
 {
 	DSPEngine::instance()->getAudioDeviceManager()->removeAudioSink(&m_audioFifo);
 	m_deviceAPI->removeChannelAPI(this);
-    m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+    detachChannelizer();
     delete m_threadedChannelizer;
     delete m_channelizer;
 }
@@ -139,180 +143,183 @@ Real angleDist(Real a, Real b)
 
 void NFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst __attribute__((unused)))
 {
-	Complex ci;
-
 	if (!m_running) {
 	    return;
 	}
 
 	m_settingsMutex.lock();
 
-	for (SampleVector::const_iterator it = begin; it != end; ++it)
-	{
-		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+	unsigned int nbSamples = end - begin;
 
-        if (m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
-        {
+	if (m_mixBuffer.size() < nbSamples) {
+	    m_mixBuffer.resize(nbSamples);
+	}
 
-            qint16 sample;
+	if (nbSamples > 0) {
+	    m_nco.mixBlock(&(*begin), m_mixBuffer.data(), nbSamples); // shift the whole block to baseband at once
+	}
 
-            double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
-            Real deviation;
+	int nbOutput = m_resampler.resample(m_mixBuffer.data(), nbSamples, m_resampleBuffer);
 
-            Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
+	for (std::vector<Complex>::const_iterator it = m_resampleBuffer.begin(); it != m_resampleBuffer.begin() + nbOutput; ++it)
+	{
+        const Complex& ci = *it;
 
-            Real magsq = magsqRaw / (SDR_RX_SCALED*SDR_RX_SCALED);
-            m_movingAverage(magsq);
-            m_magsqSum += magsq;
+        qint16 sample;
 
-            if (magsq > m_magsqPeak)
-            {
-                m_magsqPeak = magsq;
-            }
+        double magsqRaw; // = ci.real()*ci.real() + c.imag()*c.imag();
+        Real deviation;
 
-            m_magsqCount++;
-            m_sampleCount++;
+        Real demod = m_phaseDiscri.phaseDiscriminatorDelta(ci, magsqRaw, deviation);
 
-            // AF processing
+        Real magsq = magsqRaw / (SDR_RX_SCALED*SDR_RX_SCALED);
+        m_movingAverage(magsq);
+        m_magsqSum += magsq;
 
-            if (m_settings.m_deltaSquelch)
+        if (magsq > m_magsqPeak)
+        {
+            m_magsqPeak = magsq;
+        }
+
+        m_magsqCount++;
+        m_sampleCount++;
+
+        // AF processing
+
+        if (m_settings.m_deltaSquelch)
+        {
+            if (m_afSquelch.analyze(demod * m_discriCompensation))
             {
-                if (m_afSquelch.analyze(demod * m_discriCompensation))
-                {
-                    m_afSquelchOpen = m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
+                m_afSquelchOpen = m_afSquelch.evaluate(); // ? m_squelchGate + m_squelchDecay : 0;
 
-                    if (!m_afSquelchOpen) {
-                        m_squelchDelayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
-                    }
+                if (!m_afSquelchOpen) {
+                    m_squelchDelayLine.zeroBack(m_audioSampleRate/10); // zero out evaluation period
                 }
+            }
 
-                if (m_afSquelchOpen)
-                {
-                    m_squelchDelayLine.write(demod * m_discriCompensation);
+            if (m_afSquelchOpen)
+            {
+                m_squelchDelayLine.write(demod * m_discriCompensation);
 
-                    if (m_squelchCount < 2*m_squelchGate) {
-                        m_squelchCount++;
-                    }
+                if (m_squelchCount < 2*m_squelchGate) {
+                    m_squelchCount++;
                 }
-                else
-                {
-                    m_squelchDelayLine.write(0);
+            }
+            else
+            {
+                m_squelchDelayLine.write(0);
 
-                    if (m_squelchCount > 0) {
-                        m_squelchCount--;
-                    }
+                if (m_squelchCount > 0) {
+                    m_squelchCount--;
                 }
             }
-            else
+        }
+        else
+        {
+            if ((Real) m_movingAverage < m_squelchLevel)
             {
-                if ((Real) m_movingAverage < m_squelchLevel)
-                {
-                    m_squelchDelayLine.write(0);
+                m_squelchDelayLine.write(0);
 
-                    if (m_squelchCount > 0) {
-                        m_squelchCount--;
-                    }
+                if (m_squelchCount > 0) {
+                    m_squelchCount--;
                 }
-                else
-                {
-                    m_squelchDelayLine.write(demod * m_discriCompensation);
+            }
+            else
+            {
+                m_squelchDelayLine.write(demod * m_discriCompensation);
 
-                    if (m_squelchCount < 2*m_squelchGate) {
-                        m_squelchCount++;
-                    }
+                if (m_squelchCount < 2*m_squelchGate) {
+                    m_squelchCount++;
                 }
             }
+        }
 
-            m_squelchOpen = (m_squelchCount > m_squelchGate);
+        m_squelchOpen = (m_squelchCount > m_squelchGate);
 
-            if (m_settings.m_audioMute)
-            {
-                sample = 0;
-            }
-            else
+        if (m_settings.m_audioMute)
+        {
+            sample = 0;
+        }
+        else
+        {
+            if (m_squelchOpen)
             {
-                if (m_squelchOpen)
+                if (m_settings.m_ctcssOn)
                 {
-                    if (m_settings.m_ctcssOn)
-                    {
-                        Real ctcss_sample = m_lowpass.filter(demod * m_discriCompensation);
+                    Real ctcss_sample = m_lowpass.filter(demod * m_discriCompensation);
 
-                        if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                    if ((m_sampleCount & 7) == 7) // decimate 48k -> 6k
+                    {
+                        if (m_ctcssDetector.analyze(&ctcss_sample))
                         {
-                            if (m_ctcssDetector.analyze(&ctcss_sample))
-                            {
-                                int maxToneIndex;
+                            int maxToneIndex;
 
-                                if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                            if (m_ctcssDetector.getDetectedTone(maxToneIndex))
+                            {
+                                if (maxToneIndex+1 != m_ctcssIndex)
                                 {
-                                    if (maxToneIndex+1 != m_ctcssIndex)
-                                    {
-                                        if (getMessageQueueToGUI()) {
-                                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
-                                            getMessageQueueToGUI()->push(msg);
-                                        }
-                                        m_ctcssIndex = maxToneIndex+1;
+                                    if (getMessageQueueToGUI()) {
+                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(m_ctcssDetector.getToneSet()[maxToneIndex]);
+                                        getMessageQueueToGUI()->push(msg);
                                     }
+                                    m_ctcssIndex = maxToneIndex+1;
                                 }
-                                else
+                            }
+                            else
+                            {
+                                if (m_ctcssIndex != 0)
                                 {
-                                    if (m_ctcssIndex != 0)
-                                    {
-                                        if (getMessageQueueToGUI()) {
-                                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                                            getMessageQueueToGUI()->push(msg);
-                                        }
-                                        m_ctcssIndex = 0;
+                                    if (getMessageQueueToGUI()) {
+                                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                                        getMessageQueueToGUI()->push(msg);
                                     }
+                                    m_ctcssIndex = 0;
                                 }
                             }
                         }
                     }
+                }
 
-                    if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
-                    {
-                        sample = 0;
-                    }
-                    else
-                    {
-                        sample = m_bandpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume;
-                    }
+                if (m_settings.m_ctcssOn && m_ctcssIndexSelected && (m_ctcssIndexSelected != m_ctcssIndex))
+                {
+                    sample = 0;
                 }
                 else
                 {
-                    if (m_ctcssIndex != 0)
-                    {
-                        if (getMessageQueueToGUI()) {
-                            MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
-                            getMessageQueueToGUI()->push(msg);
-                        }
-
-                        m_ctcssIndex = 0;
+                    sample = m_bandpass.filter(m_squelchDelayLine.readBack(m_squelchGate)) * m_settings.m_volume;
+                }
+            }
+            else
+            {
+                if (m_ctcssIndex != 0)
+                {
+                    if (getMessageQueueToGUI()) {
+                        MsgReportCTCSSFreq *msg = MsgReportCTCSSFreq::create(0);
+                        getMessageQueueToGUI()->push(msg);
                     }
 
-                    sample = 0;
+                    m_ctcssIndex = 0;
                 }
-            }
 
+                sample = 0;
+            }
+        }
 
-            m_audioBuffer[m_audioBufferFill].l = sample;
-            m_audioBuffer[m_audioBufferFill].r = sample;
-            ++m_audioBufferFill;
 
-            if (m_audioBufferFill >= m_audioBuffer.size())
-            {
-                uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+        m_audioBuffer[m_audioBufferFill].l = sample;
+        m_audioBuffer[m_audioBufferFill].r = sample;
+        ++m_audioBufferFill;
 
-                if (res != m_audioBufferFill)
-                {
-                    qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-                }
+        if (m_audioBufferFill >= m_audioBuffer.size())
+        {
+            uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-                m_audioBufferFill = 0;
+            if (res != m_audioBufferFill)
+            {
+                qDebug("NFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
             }
 
-            m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_audioBufferFill = 0;
         }
 	}
 
@@ -366,9 +373,17 @@ bool NFMDemod::handleMessage(const Message& cmd)
                  << " sampleRate: " << cfg.getSampleRate()
                  << " centerFrequency: " << cfg.getCenterFrequency();
 
+        int centerFrequency = cfg.getCenterFrequency();
+
+        if (m_pfbChannelizer) // the channelizer input is the filter bank channel nearest to the channel
+        {
+            applyPFBChannel(centerFrequency);
+            centerFrequency -= m_pfbChannelizer->getChannelFrequencyOffset(m_pfbChannel);
+        }
+
         m_channelizer->configure(m_channelizer->getInputMessageQueue(),
             cfg.getSampleRate(),
-            cfg.getCenterFrequency());
+            centerFrequency);
 
         return true;
     }
@@ -404,6 +419,13 @@ bool NFMDemod::handleMessage(const Message& cmd)
     }
 	else if (DSPSignalNotification::match(cmd))
 	{
+	    if (m_pfbChannelizer) // filter bank channels move with the device sample rate
+	    {
+	        MsgConfigureChannelizer* channelConfigMsg = MsgConfigureChannelizer::create(
+	                m_audioSampleRate, m_settings.m_inputFrequencyOffset);
+	        m_inputMessageQueue.push(channelConfigMsg);
+	    }
+
 	    return true;
 	}
 	else
@@ -422,9 +444,7 @@ void NFMDemod::applyAudioSampleRate(int sampleRate)
 
     m_settingsMutex.lock();
 
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
+    m_resampler.create(16, m_inputSampleRate, sampleRate, m_settings.m_rfBandwidth / 2.2f);
     m_lowpass.create(301, sampleRate, 250.0);
     m_bandpass.create(301, sampleRate, 300.0, m_settings.m_afBandwidth);
     m_squelchGate = (sampleRate / 100) * m_settings.m_squelchGate; // gate is given in 10s of ms at 48000 Hz audio sample rate
@@ -450,6 +470,75 @@ void NFMDemod::applyAudioSampleRate(int sampleRate)
     m_audioSampleRate = sampleRate;
 }
 
+void NFMDemod::applyPFBChannels(int pfbChannels, int inputFrequencyOffset)
+{
+    qDebug("NFMDemod::applyPFBChannels: %d", pfbChannels);
+    detachChannelizer();
+
+    if (pfbChannels > 0)
+    {
+        m_pfbChannelizer = m_deviceAPI->enablePFBChannelizer(pfbChannels, true);
+
+        if (!m_pfbChannelizer) {
+            qWarning("NFMDemod::applyPFBChannels: filter bank not available: channelize the whole baseband");
+        }
+    }
+
+    if (m_pfbChannelizer) {
+        applyPFBChannel(inputFrequencyOffset);
+    } else {
+        m_deviceAPI->addThreadedSink(m_threadedChannelizer);
+    }
+
+    m_pfbChannels = pfbChannels;
+
+    MsgConfigureChannelizer* channelConfigMsg = MsgConfigureChannelizer::create(
+            m_audioSampleRate, inputFrequencyOffset);
+    m_inputMessageQueue.push(channelConfigMsg);
+}
+
+void NFMDemod::applyPFBChannel(int inputFrequencyOffset)
+{
+    int channel = m_pfbChannelizer->getChannelIndex(inputFrequencyOffset);
+
+    if (channel < 0) { // sample rate not known yet or offset out of the baseband
+        channel = m_pfbChannelizer->getNbChannels() / 2;
+    }
+
+    if (channel != m_pfbChannel)
+    {
+        qDebug("NFMDemod::applyPFBChannel: channel %d -> %d", m_pfbChannel, channel);
+
+        if (m_pfbChannel >= 0) {
+            m_pfbChannelizer->removeThreadedSubscriber(m_threadedChannelizer);
+        }
+
+        m_pfbChannelizer->addThreadedSubscriber(channel, m_threadedChannelizer);
+        m_pfbChannel = channel;
+    }
+}
+
+void NFMDemod::detachChannelizer()
+{
+    if (m_pfbChannelizer)
+    {
+        if (m_pfbChannel >= 0) {
+            m_pfbChannelizer->removeThreadedSubscriber(m_threadedChannelizer);
+        }
+
+        if (m_pfbChannelizer->getNbSubscribers() == 0) { // last user of the filter bank
+            m_deviceAPI->disablePFBChannelizer();
+        }
+
+        m_pfbChannelizer = 0;
+        m_pfbChannel = -1;
+    }
+    else
+    {
+        m_deviceAPI->removeThreadedSink(m_threadedChannelizer);
+    }
+}
+
 void NFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force)
 {
     qDebug() << "NFMDemod::applyChannelSettings:"
@@ -465,9 +554,7 @@ void NFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
     if ((inputSampleRate != m_inputSampleRate) || force)
     {
         m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_rfBandwidth / 2.2f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, inputSampleRate, m_audioSampleRate, m_settings.m_rfBandwidth / 2.2f);
         m_settingsMutex.unlock();
     }
 
@@ -490,14 +577,13 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
             << " m_ctcssOn: " << settings.m_ctcssOn
             << " m_audioMute: " << settings.m_audioMute
             << " m_audioDeviceName: " << settings.m_audioDeviceName
+            << " m_pfbChannels: " << settings.m_pfbChannels
             << " force: " << force;
 
     if ((settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, settings.m_rfBandwidth / 2.2);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, m_inputSampleRate, m_audioSampleRate, settings.m_rfBandwidth / 2.2);
         m_settingsMutex.unlock();
     }
 
@@ -555,6 +641,10 @@ void NFMDemod::applySettings(const NFMDemodSettings& settings, bool force)
         }
     }
 
+    if (settings.m_pfbChannels != m_pfbChannels) { // not forced: the channelizer is not there yet in the constructor
+        applyPFBChannels(settings.m_pfbChannels, settings.m_inputFrequencyOffset);
+    }
+
     m_settings = settings;
 }
 
@@ -646,6 +736,9 @@ int NFMDemod::webapiSettingsPutPatch(
     if (channelSettingsKeys.contains("audioDeviceName")) {
         settings.m_audioDeviceName = *response.getNfmDemodSettings()->getAudioDeviceName();
     }
+    if (channelSettingsKeys.contains("pfbChannels")) {
+        settings.m_pfbChannels = response.getNfmDemodSettings()->getPfbChannels();
+    }
 
     if (frequencyOffsetChanged)
     {
@@ -692,6 +785,7 @@ void NFMDemod::webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& resp
     response.getNfmDemodSettings()->setSquelch(settings.m_squelch);
     response.getNfmDemodSettings()->setSquelchGate(settings.m_squelchGate);
     response.getNfmDemodSettings()->setVolume(settings.m_volume);
+    response.getNfmDemodSettings()->setPfbChannels(settings.m_pfbChannels);
 
     if (response.getNfmDemodSettings()->getTitle()) {
         *response.getNfmDemodSettings()->getTitle() = settings.m_title;
@@ -25,7 +25,7 @@
 #include "channel/channelsinkapi.h"
 #include "dsp/phasediscri.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/lowpass.h"
 #include "dsp/bandpass.h"
 #include "dsp/afsquelch.h"
@@ -41,6 +41,7 @@
 class DeviceSourceAPI;
 class ThreadedBasebandSampleSink;
 class DownChannelizer;
+class PFBChannelizer;
 
 class NFMDemod : public BasebandSampleSink, public ChannelSinkAPI {
 public:
@@ -192,6 +193,9 @@ private:
     DeviceSourceAPI* m_deviceAPI;
     ThreadedBasebandSampleSink* m_threadedChannelizer;
     DownChannelizer* m_channelizer;
+    PFBChannelizer* m_pfbChannelizer; //!< device filter bank feeding the channelizer. Null when fed by the device engine
+    int m_pfbChannels;                //!< applied number of filter bank channels
+    int m_pfbChannel;                 //!< filter bank channel subscribed to or -1
 
     int m_inputSampleRate;
     int m_inputFrequencyOffset;
@@ -201,9 +205,9 @@ private:
 	bool m_running;
 
 	NCO m_nco;
-	Interpolator m_interpolator;
-	Real m_interpolatorDistance;
-	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_mixBuffer; //!< block shifted to baseband
+	PolyphaseResampler m_resampler;
+	std::vector<Complex> m_resampleBuffer; //!< block at audio sample rate
 	Lowpass<Real> m_lowpass;
 	Bandpass<Real> m_bandpass;
 	CTCSSDetector m_ctcssDetector;
@@ -241,6 +245,9 @@ private:
     void applyChannelSettings(int inputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const NFMDemodSettings& settings, bool force = false);
     void applyAudioSampleRate(int sampleRate);
+    void applyPFBChannels(int pfbChannels, int inputFrequencyOffset);
+    void applyPFBChannel(int inputFrequencyOffset);
+    void detachChannelizer();
     void webapiFormatChannelSettings(SWGSDRangel::SWGChannelSettings& response, const NFMDemodSettings& settings);
     void webapiFormatChannelReport(SWGSDRangel::SWGChannelReport& response);
 };
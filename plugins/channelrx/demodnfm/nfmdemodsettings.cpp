@@ -52,6 +52,7 @@ void NFMDemodSettings::resetToDefaults()
     m_rgbColor = QColor(255, 0, 0).rgb();
     m_title = "NFM Demodulator";
     m_audioDeviceName = AudioDeviceManager::m_defaultDeviceName;
+    m_pfbChannels = 0;
 }
 
 QByteArray NFMDemodSettings::serialize() const
@@ -75,6 +76,7 @@ QByteArray NFMDemodSettings::serialize() const
 
     s.writeString(14, m_title);
     s.writeString(15, m_audioDeviceName);
+    s.writeS32(16, m_pfbChannels);
 
     return s.final();
 }
@@ -119,6 +121,7 @@ bool NFMDemodSettings::deserialize(const QByteArray& data)
         d.readBool(12, &m_deltaSquelch, false);
         d.readString(14, &m_title, "NFM Demodulator");
         d.readString(15, &m_audioDeviceName, AudioDeviceManager::m_defaultDeviceName);
+        d.readS32(16, &m_pfbChannels, 0);
 
         return true;
     }
@@ -41,6 +41,7 @@ struct NFMDemodSettings
     quint32 m_rgbColor;
     QString m_title;
     QString m_audioDeviceName;
+    int  m_pfbChannels; //!< 0: channelize the whole baseband else take the channel from a device filter bank of this many channels
 
     Serializable *m_channelMarker;
 
@@ -146,7 +146,6 @@ void SSBDemod::configure(MessageQueue* messageQueue,
 
 void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
 {
-	Complex ci;
 	fftfilt::cmplx *sideband;
 	int n_out;
 
@@ -155,113 +154,116 @@ void SSBDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
 	int decim = 1<<(m_spanLog2 - 1);
 	unsigned char decim_mask = decim - 1; // counter LSB bit mask for decimation by 2^(m_scaleLog2 - 1)
 
-	for(SampleVector::const_iterator it = begin; it < end; ++it)
+	unsigned int nbSamples = end - begin;
+
+	if (m_mixBuffer.size() < nbSamples) {
+	    m_mixBuffer.resize(nbSamples);
+	}
+
+	std::vector<Complex>::iterator mixIt = m_mixBuffer.begin();
+
+	for(SampleVector::const_iterator it = begin; it < end; ++it, ++mixIt)
 	{
 		Complex c(it->real(), it->imag());
-		c *= m_nco.nextIQ();
+		*mixIt = c * m_nco.nextIQ();
+	}
+
+	int nbOutput = m_resampler.resample(m_mixBuffer.data(), nbSamples, m_resampleBuffer);
+
+	if (m_dsb)
+	{
+		n_out = DSBFilter->runDSB(m_resampleBuffer.data(), nbOutput, m_sidebandBuffer);
+	}
+	else
+	{
+		n_out = SSBFilter->runSSB(m_resampleBuffer.data(), nbOutput, m_sidebandBuffer, m_usb);
+	}
+
+	sideband = m_sidebandBuffer.data();
 
-		if(m_interpolator.decimate(&m_interpolatorDistanceRemain, c, &ci))
+	for (int i = 0; i < n_out; i++)
+	{
+		// Downsample by 2^(m_scaleLog2 - 1) for SSB band spectrum display
+		// smart decimation with bit gain using float arithmetic (23 bits significand)
+
+		m_sum += sideband[i];
+
+		if (!(m_undersampleCount++ & decim_mask))
 		{
-			if (m_dsb)
-			{
-				n_out = DSBFilter->runDSB(ci, &sideband);
+			Real avgr = m_sum.real() / decim;
+			Real avgi = m_sum.imag() / decim;
+			m_magsq = (avgr * avgr + avgi * avgi) / (SDR_RX_SCALED*SDR_RX_SCALED);
+
+            m_magsqSum += m_magsq;
+
+            if (m_magsq > m_magsqPeak)
+            {
+                m_magsqPeak = m_magsq;
+            }
+
+            m_magsqCount++;
+
+			if (!m_dsb & !m_usb)
+			{ // invert spectrum for LSB
+				m_sampleBuffer.push_back(Sample(avgi, avgr));
 			}
 			else
 			{
-				n_out = SSBFilter->runSSB(ci, &sideband, m_usb);
+				m_sampleBuffer.push_back(Sample(avgr, avgi));
 			}
 
-			m_interpolatorDistanceRemain += m_interpolatorDistance;
+            m_sum.real(0.0);
+            m_sum.imag(0.0);
 		}
-		else
+
+        float agcVal = m_agcActive ? m_agc.feedAndGetValue(sideband[i]) : 10.0; // 10.0 for 3276.8, 1.0 for 327.68
+        fftfilt::cmplx& delayedSample = m_squelchDelayLine.readBack(m_agc.getStepDownDelay());
+        m_audioActive = delayedSample.real() != 0.0;
+        m_squelchDelayLine.write(sideband[i]*agcVal);
+
+		if (m_audioMute)
 		{
-			n_out = 0;
+			m_audioBuffer[m_audioBufferFill].r = 0;
+			m_audioBuffer[m_audioBufferFill].l = 0;
 		}
-
-		for (int i = 0; i < n_out; i++)
+		else
 		{
-			// Downsample by 2^(m_scaleLog2 - 1) for SSB band spectrum display
-			// smart decimation with bit gain using float arithmetic (23 bits significand)
+		    fftfilt::cmplx z = delayedSample * m_agc.getStepValue();
 
-			m_sum += sideband[i];
-
-			if (!(m_undersampleCount++ & decim_mask))
+			if (m_audioBinaual)
 			{
-				Real avgr = m_sum.real() / decim;
-				Real avgi = m_sum.imag() / decim;
-				m_magsq = (avgr * avgr + avgi * avgi) / (SDR_RX_SCALED*SDR_RX_SCALED);
-
-                m_magsqSum += m_magsq;
-
-                if (m_magsq > m_magsqPeak)
-                {
-                    m_magsqPeak = m_magsq;
-                }
-
-                m_magsqCount++;
-
-				if (!m_dsb & !m_usb)
-				{ // invert spectrum for LSB
-					m_sampleBuffer.push_back(Sample(avgi, avgr));
+				if (m_audioFlipChannels)
+				{
+					m_audioBuffer[m_audioBufferFill].r = (qint16)(z.imag() * m_volume);
+					m_audioBuffer[m_audioBufferFill].l = (qint16)(z.real() * m_volume);
 				}
 				else
 				{
-					m_sampleBuffer.push_back(Sample(avgr, avgi));
+					m_audioBuffer[m_audioBufferFill].r = (qint16)(z.real() * m_volume);
+					m_audioBuffer[m_audioBufferFill].l = (qint16)(z.imag() * m_volume);
 				}
-
-                m_sum.real(0.0);
-                m_sum.imag(0.0);
-			}
-
-            float agcVal = m_agcActive ? m_agc.feedAndGetValue(sideband[i]) : 10.0; // 10.0 for 3276.8, 1.0 for 327.68
-            fftfilt::cmplx& delayedSample = m_squelchDelayLine.readBack(m_agc.getStepDownDelay());
-            m_audioActive = delayedSample.real() != 0.0;
-            m_squelchDelayLine.write(sideband[i]*agcVal);
-
-			if (m_audioMute)
-			{
-				m_audioBuffer[m_audioBufferFill].r = 0;
-				m_audioBuffer[m_audioBufferFill].l = 0;
 			}
 			else
 			{
-			    fftfilt::cmplx z = delayedSample * m_agc.getStepValue();
-
-				if (m_audioBinaual)
-				{
-					if (m_audioFlipChannels)
-					{
-						m_audioBuffer[m_audioBufferFill].r = (qint16)(z.imag() * m_volume);
-						m_audioBuffer[m_audioBufferFill].l = (qint16)(z.real() * m_volume);
-					}
-					else
-					{
-						m_audioBuffer[m_audioBufferFill].r = (qint16)(z.real() * m_volume);
-						m_audioBuffer[m_audioBufferFill].l = (qint16)(z.imag() * m_volume);
-					}
-				}
-				else
-				{
-					Real demod = (z.real() + z.imag()) * 0.7;
-					qint16 sample = (qint16)(demod * m_volume);
-					m_audioBuffer[m_audioBufferFill].l = sample;
-					m_audioBuffer[m_audioBufferFill].r = sample;
-				}
+				Real demod = (z.real() + z.imag()) * 0.7;
+				qint16 sample = (qint16)(demod * m_volume);
+				m_audioBuffer[m_audioBufferFill].l = sample;
+				m_audioBuffer[m_audioBufferFill].r = sample;
 			}
+		}
 
-			++m_audioBufferFill;
-
-			if (m_audioBufferFill >= m_audioBuffer.size())
-			{
-				uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+		++m_audioBufferFill;
 
-				if (res != m_audioBufferFill)
-				{
-				    qDebug("SSBDemod::feed: %u/%u samples written", res, m_audioBufferFill);
-				}
+		if (m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-				m_audioBufferFill = 0;
+			if (res != m_audioBufferFill)
+			{
+			    qDebug("SSBDemod::feed: %u/%u samples written", res, m_audioBufferFill);
 			}
+
+			m_audioBufferFill = 0;
 		}
 	}
 
@@ -378,9 +380,7 @@ void SSBDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
     if ((m_inputSampleRate != inputSampleRate) || force)
     {
         m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_Bandwidth * 1.5f, 2.0f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, inputSampleRate, m_audioSampleRate, m_Bandwidth * 1.5f, 2.0f);
         m_settingsMutex.unlock();
     }
 
@@ -398,9 +398,7 @@ void SSBDemod::applyAudioSampleRate(int sampleRate)
 
     m_settingsMutex.lock();
 
-    m_interpolator.create(16, m_inputSampleRate, m_Bandwidth * 1.5f, 2.0f);
-    m_interpolatorDistanceRemain = 0;
-    m_interpolatorDistance = (Real) m_inputSampleRate / (Real) sampleRate;
+    m_resampler.create(16, m_inputSampleRate, sampleRate, m_Bandwidth * 1.5f, 2.0f);
 
     SSBFilter->create_filter(m_LowCutoff / (float) sampleRate, m_Bandwidth / (float) sampleRate);
     DSBFilter->create_dsb_filter((2.0f * m_Bandwidth) / (float) sampleRate);
@@ -480,9 +478,7 @@ void SSBDemod::applySettings(const SSBDemodSettings& settings, bool force)
         m_LowCutoff = lowCutoff;
 
         m_settingsMutex.lock();
-        m_interpolator.create(16, m_inputSampleRate, m_Bandwidth * 1.5f, 2.0f);
-        m_interpolatorDistanceRemain = 0;
-        m_interpolatorDistance = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, m_inputSampleRate, m_audioSampleRate, m_Bandwidth * 1.5f, 2.0f);
         SSBFilter->create_filter(m_LowCutoff / (float) m_audioSampleRate, m_Bandwidth / (float) m_audioSampleRate);
         DSBFilter->create_dsb_filter((2.0f * m_Bandwidth) / (float) m_audioSampleRate);
         m_settingsMutex.unlock();
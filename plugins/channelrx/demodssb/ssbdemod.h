@@ -24,7 +24,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelsinkapi.h"
 #include "dsp/ncof.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/fftfilt.h"
 #include "dsp/agc.h"
 #include "audio/audiofifo.h"
@@ -296,9 +296,10 @@ private:
     bool m_audioActive;         //!< True if an audio signal is produced (no AGC or AGC and above threshold)
 
 	NCOF m_nco;
-    Interpolator m_interpolator;
-    Real m_interpolatorDistance;
-    Real m_interpolatorDistanceRemain;
+    std::vector<Complex> m_mixBuffer; //!< block shifted to baseband
+    PolyphaseResampler m_resampler;
+    std::vector<Complex> m_resampleBuffer; //!< block at audio sample rate
+    std::vector<fftfilt::cmplx> m_sidebandBuffer; //!< filtered block
 	fftfilt* SSBFilter;
 	fftfilt* DSBFilter;
 
@@ -89,7 +89,6 @@ WFMDemod::~WFMDemod()
 
 void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool firstOfBurst __attribute__((unused)))
 {
-	Complex ci;
 	fftfilt::cmplx *rf;
 	int rf_out;
 	Real demod;
@@ -139,33 +138,35 @@ void WFMDemod::feed(const SampleVector::const_iterator& begin, const SampleVecto
                 demod = 0;
             }
 
-            Complex e(demod, 0);
-
-			if (m_interpolator.decimate(&m_interpolatorDistanceRemain, e, &ci))
-			{
-				qint16 sample = (qint16)(ci.real() * 3276.8f * m_settings.m_volume);
-				m_sampleBuffer.push_back(Sample(sample, sample));
-				m_audioBuffer[m_audioBufferFill].l = sample;
-				m_audioBuffer[m_audioBufferFill].r = sample;
+            m_demodBuffer.push_back(Complex(demod, 0));
+		}
+	}
 
-				++m_audioBufferFill;
+	int nbOutput = m_resampler.resample(m_demodBuffer.data(), m_demodBuffer.size(), m_resampleBuffer);
 
-				if(m_audioBufferFill >= m_audioBuffer.size())
-				{
-					uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
+	for (int j = 0; j < nbOutput; j++)
+	{
+		qint16 sample = (qint16)(m_resampleBuffer[j].real() * 3276.8f * m_settings.m_volume);
+		m_sampleBuffer.push_back(Sample(sample, sample));
+		m_audioBuffer[m_audioBufferFill].l = sample;
+		m_audioBuffer[m_audioBufferFill].r = sample;
 
-					if (res != m_audioBufferFill) {
-						qDebug("WFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
-					}
+		++m_audioBufferFill;
 
-					m_audioBufferFill = 0;
-				}
+		if(m_audioBufferFill >= m_audioBuffer.size())
+		{
+			uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
 
-				m_interpolatorDistanceRemain += m_interpolatorDistance;
+			if (res != m_audioBufferFill) {
+				qDebug("WFMDemod::feed: %u/%u audio samples written", res, m_audioBufferFill);
 			}
+
+			m_audioBufferFill = 0;
 		}
 	}
 
+	m_demodBuffer.clear();
+
 	if (m_audioBufferFill > 0)
 	{
 		uint res = m_audioFifo.write((const quint8*)&m_audioBuffer[0], m_audioBufferFill);
@@ -265,9 +266,7 @@ void WFMDemod::applyAudioSampleRate(int sampleRate)
 
     m_settingsMutex.lock();
 
-    m_interpolator.create(16, m_inputSampleRate, m_settings.m_afBandwidth);
-    m_interpolatorDistanceRemain = (Real) m_inputSampleRate / sampleRate;
-    m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) sampleRate;
+    m_resampler.create(16, m_inputSampleRate, sampleRate, m_settings.m_afBandwidth);
 
     m_settingsMutex.unlock();
 
@@ -288,11 +287,9 @@ void WFMDemod::applyChannelSettings(int inputSampleRate, int inputFrequencyOffse
 
     if ((inputSampleRate != m_inputSampleRate) || force)
     {
-        qDebug() << "WFMDemod::applyChannelSettings: m_interpolator.create";
+        qDebug() << "WFMDemod::applyChannelSettings: m_resampler.create";
         m_settingsMutex.lock();
-        m_interpolator.create(16, inputSampleRate, m_settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) inputSampleRate / (Real) m_audioSampleRate;
-        m_interpolatorDistance =  (Real) inputSampleRate / (Real) m_audioSampleRate;
+        m_resampler.create(16, inputSampleRate, m_audioSampleRate, m_settings.m_afBandwidth);
         m_settingsMutex.unlock();
         qDebug() << "WFMDemod::applySettings: m_rfFilter->create_filter";
         Real lowCut = -(m_settings.m_rfBandwidth / 2.0) / inputSampleRate;
@@ -322,10 +319,8 @@ void WFMDemod::applySettings(const WFMDemodSettings& settings, bool force)
        (settings.m_rfBandwidth != m_settings.m_rfBandwidth) || force)
     {
         m_settingsMutex.lock();
-        qDebug() << "WFMDemod::applySettings: m_interpolator.create";
-        m_interpolator.create(16, m_inputSampleRate, settings.m_afBandwidth);
-        m_interpolatorDistanceRemain = (Real) m_inputSampleRate / (Real) m_audioSampleRate;
-        m_interpolatorDistance =  (Real) m_inputSampleRate / (Real) m_audioSampleRate;
+        qDebug() << "WFMDemod::applySettings: m_resampler.create";
+        m_resampler.create(16, m_inputSampleRate, m_audioSampleRate, settings.m_afBandwidth);
         qDebug() << "WFMDemod::applySettings: m_rfFilter->create_filter";
         Real lowCut = -(settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
         Real hiCut  = (settings.m_rfBandwidth / 2.0) / m_inputSampleRate;
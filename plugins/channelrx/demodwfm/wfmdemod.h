@@ -24,7 +24,7 @@
 #include "dsp/basebandsamplesink.h"
 #include "channel/channelsinkapi.h"
 #include "dsp/nco.h"
-#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
 #include "dsp/lowpass.h"
 #include "util/movingaverage.h"
 #include "dsp/fftfilt.h"
@@ -177,9 +177,9 @@ private:
     quint32 m_audioSampleRate;
 
 	NCO m_nco;
-	Interpolator m_interpolator; //!< Interpolator between sample rate sent from DSP engine and requested RF bandwidth (rational)
-	Real m_interpolatorDistance;
-	Real m_interpolatorDistanceRemain;
+	std::vector<Complex> m_demodBuffer;    //!< demodulated block at channel sample rate
+	PolyphaseResampler m_resampler;        //!< Resampler from channel sample rate to audio sample rate (rational)
+	std::vector<Complex> m_resampleBuffer; //!< block at audio sample rate
 	fftfilt* m_rfFilter;
 
 	Real m_squelchLevel;
@@ -74,6 +74,13 @@ void DaemonSource::pull(Sample& sample)
     m_dataReadQueue.readSample(sample, true); // true is scale for Tx
 }
 
+void DaemonSource::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        m_dataReadQueue.readSample(*begin, true); // true is scale for Tx
+    }
+}
+
 void DaemonSource::pullAudio(int nbSamples __attribute__((unused)))
 {
 }
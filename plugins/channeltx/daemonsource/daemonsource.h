@@ -182,6 +182,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int count);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -23,6 +23,7 @@
 #include "channel/sdrdaemondatablock.h"
 
 #include "daemonsourcethread.h"
+#include "util/threadroles.h"
 
 MESSAGE_CLASS_DEFINITION(DaemonSourceThread::MsgStartStop, Message)
 MESSAGE_CLASS_DEFINITION(DaemonSourceThread::MsgDataBind, Message)
@@ -77,6 +78,8 @@ void DaemonSourceThread::stopWork()
 
 void DaemonSourceThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleNetwork);
+
     qDebug("DaemonSourceThread::run: begin");
     m_running = true;
     m_startWaiter.wakeAll();
@@ -22,6 +22,7 @@
 
 #include <stdio.h>
 #include <complex.h>
+#include <algorithm>
 
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
@@ -104,9 +105,31 @@ void AMMod::pull(Sample& sample)
 		return;
 	}
 
-	Complex ci;
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void AMMod::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + count, Sample());
+        return;
+    }
+
+    m_settingsMutex.lock(); // settings are frozen for the whole block
 
-	m_settingsMutex.lock();
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void AMMod::pullOne(Sample& sample)
+{
+	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -129,8 +152,6 @@ void AMMod::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -16,6 +16,7 @@
 
 #include <QDebug>
 #include <time.h>
+#include <algorithm>
 
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
@@ -129,9 +130,31 @@ void ATVMod::pull(Sample& sample)
 		return;
 	}
 
-    Complex ci;
-
     m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void ATVMod::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + count, Sample());
+        return;
+    }
+
+    m_settingsMutex.lock(); // settings are frozen for the whole block
+
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void ATVMod::pullOne(Sample& sample)
+{
+    Complex ci;
 
     if ((m_tvSampleRate == m_outputSampleRate) && (!m_settings.m_forceDecimator)) // no interpolation nor decimation
     {
@@ -166,8 +189,6 @@ void ATVMod::pullFinalize(Complex& ci, Sample& sample)
 {
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
     m_movingAverage(magsq);
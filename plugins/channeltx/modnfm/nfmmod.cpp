@@ -110,9 +110,31 @@ void NFMMod::pull(Sample& sample)
 		return;
 	}
 
-	Complex ci;
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void NFMMod::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + count, Sample());
+        return;
+    }
+
+    m_settingsMutex.lock(); // settings are frozen for the whole block
 
-	m_settingsMutex.lock();
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void NFMMod::pullOne(Sample& sample)
+{
+	Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -135,8 +157,6 @@ void NFMMod::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -204,6 +204,7 @@ public:
     void setSpectrumSampleSink(BasebandSampleSink* sampleSink) { m_sampleSink = sampleSink; }
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int count);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -314,6 +315,7 @@ private:
     void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const SSBModSettings& settings, bool force = false);
+    void pullOne(Sample& sample);
     void pullAF(Complex& sample);
     void calculateLevel(Complex& sample);
     void modulateSample();
@@ -117,12 +117,34 @@ void WFMMod::pull(Sample& sample)
 		return;
 	}
 
+    m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void WFMMod::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + count, Sample());
+        return;
+    }
+
+    m_settingsMutex.lock(); // settings are frozen for the whole block
+
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void WFMMod::pullOne(Sample& sample)
+{
 	Complex ci, ri;
     fftfilt::cmplx *rf;
     int rf_out;
 
-	m_settingsMutex.lock();
-
 	if ((m_settings.m_modAFInput == WFMModSettings::WFMModInputFile)
 	   || (m_settings.m_modAFInput == WFMModSettings::WFMModInputAudio))
 	{
@@ -157,8 +179,6 @@ void WFMMod::pull(Sample& sample)
     ci = m_rfFilterBuffer[m_rfFilterBufferIndex] * m_carrierNco.nextIQ(); // shift to carrier frequency
     m_rfFilterBufferIndex++;
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
 	magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
 	m_movingAverage(magsq);
@@ -202,6 +202,7 @@ public:
     virtual void destroy() { delete this; }
 
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int count);
     virtual void pullAudio(int nbSamples);
     virtual void start();
     virtual void stop();
@@ -300,6 +301,7 @@ private:
     void applyAudioSampleRate(int sampleRate);
     void applyChannelSettings(int basebandSampleRate, int outputSampleRate, int inputFrequencyOffset, bool force = false);
     void applySettings(const WFMModSettings& settings, bool force = false);
+    void pullOne(Sample& sample);
     void pullAF(Complex& sample);
     void calculateLevel(const Real& sample);
     void openFileStream();
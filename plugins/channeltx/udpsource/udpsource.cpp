@@ -16,6 +16,8 @@
 
 #include <QDebug>
 
+#include <algorithm>
+
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
 #include "SWGUDPSourceReport.h"
@@ -111,9 +113,32 @@ void UDPSource::pull(Sample& sample)
         return;
     }
 
-    Complex ci;
-
     m_settingsMutex.lock();
+    pullOne(sample);
+    m_settingsMutex.unlock();
+}
+
+void UDPSource::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if (m_settings.m_channelMute)
+    {
+        std::fill(begin, begin + count, Sample());
+        initSquelch(false);
+        return;
+    }
+
+    m_settingsMutex.lock(); // settings are frozen for the whole block
+
+    for (unsigned int i = 0; i < count; i++, ++begin) {
+        pullOne(*begin);
+    }
+
+    m_settingsMutex.unlock();
+}
+
+void UDPSource::pullOne(Sample& sample)
+{
+    Complex ci;
 
     if (m_interpolatorDistance > 1.0f) // decimate
     {
@@ -136,8 +161,6 @@ void UDPSource::pull(Sample& sample)
 
     ci *= m_carrierNco.nextIQ(); // shift to carrier frequency
 
-    m_settingsMutex.unlock();
-
     double magsq = ci.real() * ci.real() + ci.imag() * ci.imag();
     magsq /= (SDR_TX_SCALED*SDR_TX_SCALED);
     m_movingAverage.feed(magsq);
@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "bladerf1outputthread.h"
+#include "util/threadroles.h"
 
 #include <stdio.h>
 #include <errno.h>
@@ -59,6 +60,8 @@ void Bladerf1OutputThread::setLog2Interpolation(unsigned int log2_interp)
 
 void Bladerf1OutputThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	int res;
 
 	m_running = true;
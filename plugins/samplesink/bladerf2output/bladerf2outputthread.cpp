@@ -19,6 +19,7 @@
 #include "dsp/samplesourcefifo.h"
 
 #include "bladerf2outputthread.h"
+#include "util/threadroles.h"
 
 BladeRF2OutputThread::BladeRF2OutputThread(struct bladerf* dev, unsigned int nbTxChannels, QObject* parent) :
     QThread(parent),
@@ -63,6 +64,8 @@ void BladeRF2OutputThread::stopWork()
 
 void BladeRF2OutputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     m_running = true;
@@ -22,6 +22,7 @@
 
 #include "dsp/samplesourcefifo.h"
 #include "filesinkthread.h"
+#include "util/threadroles.h"
 
 FileSinkThread::FileSinkThread(std::ofstream *samplesStream, SampleSourceFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -147,6 +148,8 @@ void FileSinkThread::setLog2Interpolation(int log2Interpolation)
 
 void FileSinkThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	m_running = true;
 	m_startWaiter.wakeAll();
 
@@ -21,6 +21,7 @@
 #include <unistd.h>
 
 #include "dsp/samplesourcefifo.h"
+#include "util/threadroles.h"
 
 HackRFOutputThread::HackRFOutputThread(hackrf_device* dev, SampleSourceFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -61,6 +62,8 @@ void HackRFOutputThread::setLog2Interpolation(unsigned int log2Interp)
 
 void HackRFOutputThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	hackrf_error rc;
 
     m_running = true;
@@ -150,6 +153,7 @@ void HackRFOutputThread::callback(qint8* buf, qint32 len)
 
 int HackRFOutputThread::tx_callback(hackrf_transfer* transfer)
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceIO); // transfers run in a thread of the library
     HackRFOutputThread *thread = (HackRFOutputThread *) transfer->tx_ctx;
     qint32 bytes_to_write = transfer->valid_length;
 	thread->callback((qint8 *) transfer->buffer, bytes_to_write);
@@ -19,6 +19,7 @@
 
 #include "limesdroutputthread.h"
 #include "limesdroutputsettings.h"
+#include "util/threadroles.h"
 
 LimeSDROutputThread::LimeSDROutputThread(lms_stream_t* stream, SampleSourceFifo* sampleFifo, QObject* parent) :
     QThread(parent),
@@ -75,6 +76,8 @@ void LimeSDROutputThread::setLog2Interpolation(unsigned int log2_interp)
 
 void LimeSDROutputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     lms_stream_meta_t metadata;          //Use metadata for additional control over sample receive function behaviour
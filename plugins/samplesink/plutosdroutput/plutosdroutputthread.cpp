@@ -20,6 +20,7 @@
 #include "plutosdroutputsettings.h"
 #include "iio.h"
 #include "plutosdroutputthread.h"
+#include "util/threadroles.h"
 
 PlutoSDROutputThread::PlutoSDROutputThread(uint32_t blocksizeSamples, DevicePlutoSDRBox* plutoBox, SampleSourceFifo* sampleFifo, QObject* parent) :
     QThread(parent),
@@ -65,6 +66,8 @@ void PlutoSDROutputThread::setLog2Interpolation(unsigned int log2_interp)
 
 void PlutoSDROutputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     std::ptrdiff_t p_inc = m_plutoBox->txBufferStep();
 
     qDebug("PlutoSDROutputThread::run: txBufferStep: %ld bytes", p_inc);
@@ -23,6 +23,7 @@
 
 #include "dsp/samplesourcefifo.h"
 #include "sdrdaemonsinkthread.h"
+#include "util/threadroles.h"
 
 SDRdaemonSinkThread::SDRdaemonSinkThread(SampleSourceFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -99,6 +100,8 @@ void SDRdaemonSinkThread::setSamplerate(int samplerate)
 
 void SDRdaemonSinkThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleNetwork);
+
 	m_running = true;
 	m_startWaiter.wakeAll();
 
@@ -17,6 +17,7 @@
 #include <QUdpSocket>
 
 #include "udpsinkfecworker.h"
+#include "util/threadroles.h"
 
 MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgUDPFECEncodeAndSend, Message)
 MESSAGE_CLASS_DEFINITION(UDPSinkFECWorker::MsgConfigureRemoteAddress, Message)
@@ -63,6 +64,8 @@ void UDPSinkFECWorker::stopWork()
 
 void UDPSinkFECWorker::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleNetwork);
+
     m_running  = true;
     m_startWaiter.wakeAll();
 
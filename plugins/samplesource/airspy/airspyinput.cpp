@@ -83,7 +83,7 @@ bool AirspyInput::openDevice()
         qCritical("AirspyInput::start: failed to initiate Airspy library %s", airspy_error_name(rc));
     }
 
-    if (!m_sampleFifo.setSize(1<<19))
+    if (!m_sampleFifoSPSC.setSize(1<<19))
     {
         qCritical("AirspyInput::start: could not allocate SampleFifo");
         return false;
@@ -162,7 +162,7 @@ bool AirspyInput::start()
 
     if (m_running) { stop(); }
 
-	m_airspyThread = new AirspyThread(m_dev, &m_sampleFifo);
+	m_airspyThread = new AirspyThread(m_dev, &m_sampleFifoSPSC);
 	m_airspyThread->setSamplerate(m_sampleRates[m_settings.m_devSampleRateIndex]);
 	m_airspyThread->setLog2Decimation(m_settings.m_log2Decim);
 	m_airspyThread->setFcPos((int) m_settings.m_fcPos);
@@ -744,4 +744,6 @@ void AirspyInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respons
         response.getAirspyReport()->getSampleRates()->append(new SWGSDRangel::SWGSampleRate);
         response.getAirspyReport()->getSampleRates()->back()->setRate(*it);
     }
+
+    m_fileSink->webapiFormatReport(response.getAirspyReport()->getFileRecord());
 }
@@ -22,6 +22,7 @@
 
 #include <libairspy/airspy.h>
 #include <dsp/devicesamplesource.h>
+#include <dsp/samplesinkfifospsc.h>
 #include "airspysettings.h"
 
 class DeviceSourceAPI;
@@ -103,6 +104,7 @@ public:
     virtual bool deserialize(const QByteArray& data);
 
 	virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
+	virtual SampleSinkFifo* getSampleFifo() { return &m_sampleFifoSPSC; }
 	virtual const QString& getDeviceDescription() const;
 	virtual int getSampleRate() const;
 	virtual quint64 getCenterFrequency() const;
@@ -155,6 +157,7 @@ private:
 	std::vector<uint32_t> m_sampleRates;
 	bool m_running;
     FileRecord *m_fileSink; //!< File sink to record device I/Q output
+    SampleSinkFifoSPSC m_sampleFifoSPSC; //!< written by the libairspy callback only, read by the DSP engine only
 };
 
 #endif // INCLUDE_AIRSPYINPUT_H
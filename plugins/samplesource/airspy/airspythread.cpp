@@ -21,6 +21,7 @@
 #include "airspythread.h"
 
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 AirspyThread *AirspyThread::m_this = 0;
 
@@ -77,6 +78,8 @@ void AirspyThread::setFcPos(int fcPos)
 
 void AirspyThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	airspy_error rc;
 
 	m_running = true;
@@ -207,6 +210,7 @@ void AirspyThread::callback(const qint16* buf, qint32 len)
 
 int AirspyThread::rx_callback(airspy_transfer_t* transfer)
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceIO); // transfers run in a thread of the library
 	qint32 bytes_to_write = transfer->sample_count * sizeof(qint16);
 	m_this->callback((qint16 *) transfer->samples, bytes_to_write);
 	return 0;
@@ -566,6 +566,8 @@ void AirspyHFInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respo
         response.getAirspyHfReport()->getSampleRates()->append(new SWGSDRangel::SWGSampleRate);
         response.getAirspyHfReport()->getSampleRates()->back()->setRate(*it);
     }
+
+    m_fileSink->webapiFormatReport(response.getAirspyHfReport()->getFileRecord());
 }
 
 int AirspyHFInput::webapiReportGet(
@@ -20,6 +20,7 @@
 
 #include "dsp/samplesinkfifo.h"
 #include "airspyhfthread.h"
+#include "util/threadroles.h"
 
 AirspyHFThread *AirspyHFThread::m_this = 0;
 
@@ -70,6 +71,8 @@ void AirspyHFThread::setLog2Decimation(unsigned int log2_decim)
 
 void AirspyHFThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     airspyhf_error rc;
 
 	m_running = true;
@@ -138,6 +141,7 @@ void AirspyHFThread::callback(const float* buf, qint32 len)
 
 int AirspyHFThread::rx_callback(airspyhf_transfer_t* transfer)
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceIO); // transfers run in a thread of the library
 	qint32 nbIAndQ = transfer->sample_count * 2;
 	m_this->callback((float *) transfer->samples, nbIAndQ);
 	return 0;
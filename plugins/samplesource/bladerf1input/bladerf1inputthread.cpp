@@ -20,6 +20,7 @@
 #include <errno.h>
 #include <algorithm>
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 
 
@@ -67,6 +68,8 @@ void Bladerf1InputThread::setFcPos(int fcPos)
 
 void Bladerf1InputThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	int res;
 
 	m_running = true;
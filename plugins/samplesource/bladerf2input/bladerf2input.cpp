@@ -1119,6 +1119,8 @@ void BladeRF2Input::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respo
             response.getBladeRf2InputReport()->getGainModes()->back()->setValue(it->m_value);
         }
     }
+
+    m_fileSink->webapiFormatReport(response.getBladeRf2InputReport()->getFileRecord());
 }
 
 int BladeRF2Input::webapiRunGet(
@@ -17,6 +17,7 @@
 #include "dsp/samplesinkfifo.h"
 
 #include "bladerf2inputthread.h"
+#include "util/threadroles.h"
 
 BladeRF2InputThread::BladeRF2InputThread(struct bladerf* dev, unsigned int nbRxChannels, QObject* parent) :
     QThread(parent),
@@ -66,6 +67,8 @@ void BladeRF2InputThread::stopWork()
 
 void BladeRF2InputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     m_running = true;
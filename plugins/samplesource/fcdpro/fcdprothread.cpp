@@ -22,6 +22,7 @@
 
 #include "dsp/samplesinkfifo.h"
 #include "fcdtraits.h"
+#include "util/threadroles.h"
 
 FCDProThread::FCDProThread(SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -59,6 +60,8 @@ void FCDProThread::stopWork()
 
 void FCDProThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	if ( !OpenSource(fcd_traits<Pro>::alsaDeviceName) )
 	{
 		qCritical() << "FCDThread::run: cannot open FCD sound card";
@@ -22,6 +22,7 @@
 
 #include "dsp/samplesinkfifo.h"
 #include "fcdtraits.h"
+#include "util/threadroles.h"
 
 FCDProPlusThread::FCDProPlusThread(SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -59,6 +60,8 @@ void FCDProPlusThread::stopWork()
 
 void FCDProPlusThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	if ( !OpenSource(fcd_traits<ProPlus>::alsaDeviceName) )
 	{
 		qCritical() << "FCDThread::run: cannot open FCD sound card";
@@ -236,7 +236,13 @@ void FileSourceGui::displaySettings()
 {
     blockApplySettings(true);
     ui->playLoop->setChecked(m_settings.m_loop);
-    ui->acceleration->setCurrentIndex(FileSourceSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+
+    if (m_settings.m_asFastAsPossible) {
+        ui->acceleration->setCurrentIndex(ui->acceleration->count() - 1);
+    } else {
+        ui->acceleration->setCurrentIndex(FileSourceSettings::getAccelerationIndex(m_settings.m_accelerationFactor));
+    }
+
     blockApplySettings(false);
 }
 
@@ -313,7 +319,7 @@ void FileSourceGui::on_navTimeSlider_valueChanged(int value)
 void FileSourceGui::on_showFileDialog_clicked(bool checked __attribute__((unused)))
 {
 	QString fileName = QFileDialog::getOpenFileName(this,
-	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq)"), 0, QFileDialog::DontUseNativeDialog);
+	    tr("Open I/Q record file"), ".", tr("SDR I/Q Files (*.sdriq *.sdriqc)"), 0, QFileDialog::DontUseNativeDialog);
 
 	if (fileName != "")
 	{
@@ -328,7 +334,16 @@ void FileSourceGui::on_acceleration_currentIndexChanged(int index)
 {
     if (m_doApplySettings)
     {
-        m_settings.m_accelerationFactor = FileSourceSettings::getAccelerationValue(index);
+        if (index == ui->acceleration->count() - 1) // last item is "max"
+        {
+            m_settings.m_asFastAsPossible = true;
+        }
+        else
+        {
+            m_settings.m_asFastAsPossible = false;
+            m_settings.m_accelerationFactor = FileSourceSettings::getAccelerationValue(index);
+        }
+
         FileSourceInput::MsgConfigureFileSource *message = FileSourceInput::MsgConfigureFileSource::create(m_settings, false);
         m_sampleSource->getInputMessageQueue()->push(message);
     }
@@ -420,6 +435,7 @@ void FileSourceGui::setAccelerationCombo()
         ui->acceleration->addItem(s);
     }
 
+    ui->acceleration->addItem(QString("max"));
     ui->acceleration->blockSignals(false);
 }
 
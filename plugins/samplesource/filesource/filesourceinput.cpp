@@ -49,6 +49,9 @@ MESSAGE_CLASS_DEFINITION(FileSourceInput::MsgReportHeaderCRC, Message)
 FileSourceInput::FileSourceInput(DeviceSourceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
 	m_settings(),
+	m_mappedData(0),
+	m_mappedSamples(0),
+	m_compact(false),
 	m_fileSourceThread(NULL),
 	m_deviceDescription(),
 	m_fileName("..."),
@@ -67,6 +70,7 @@ FileSourceInput::FileSourceInput(DeviceSourceAPI *deviceAPI) :
 FileSourceInput::~FileSourceInput()
 {
 	stop();
+	unmapFile();
 }
 
 void FileSourceInput::destroy()
@@ -74,20 +78,42 @@ void FileSourceInput::destroy()
     delete this;
 }
 
-void FileSourceInput::openFileStream()
+bool FileSourceInput::openFileStream()
 {
-	//stopInput();
+	if (m_fileSourceThread) // the reading thread uses the stream and the mapped file
+	{
+		qWarning("FileSourceInput::openFileStream: cannot open %s while acquisition is on", qPrintable(m_fileName));
+		return false;
+	}
 
 	if (m_ifstream.is_open()) {
 		m_ifstream.close();
 	}
 
+	unmapFile();
+	m_compactReader.close();
 	m_ifstream.open(m_fileName.toStdString().c_str(), std::ios::binary | std::ios::ate);
 	quint64 fileSize = m_ifstream.tellg();
+	m_compact = m_compactReader.open(&m_ifstream);
 
-	if (fileSize > sizeof(FileRecord::Header))
+	if (m_compact)
+	{
+	    const CompactRecord::Header& header = m_compactReader.getHeader();
+		m_sampleRate = header.sampleRate;
+		m_centerFrequency = header.centerFrequency;
+		m_startingTimeStamp = header.startTimeStamp;
+		m_sampleSize = header.sampleSize;
+		m_recordLength = m_sampleRate == 0 ? 0 : m_compactReader.getNbSamples() / m_sampleRate;
+
+		if (getMessageQueueToGUI()) {
+			MsgReportHeaderCRC *report = MsgReportHeaderCRC::create(true); // the reader only accepts a valid header
+			getMessageQueueToGUI()->push(report);
+		}
+	}
+	else if (fileSize > sizeof(FileRecord::Header))
 	{
 	    FileRecord::Header header;
+	    m_ifstream.clear();
 	    m_ifstream.seekg(0,std::ios_base::beg);
 		bool crcOK = FileRecord::readHeader(m_ifstream, header);
 		m_sampleRate = header.sampleRate;
@@ -135,20 +161,76 @@ void FileSourceInput::openFileStream()
 
 	if (m_recordLength == 0) {
 	    m_ifstream.close();
+	} else if (!m_compact) {
+	    mapFile(fileSize);
 	}
+
+	return true;
+}
+
+void FileSourceInput::mapFile(quint64 fileSize)
+{
+    m_mappedFile.setFileName(m_fileName);
+
+    if (!m_mappedFile.open(QIODevice::ReadOnly))
+    {
+        qWarning("FileSourceInput::mapFile: cannot open %s: reading from stream", qPrintable(m_fileName));
+        return;
+    }
+
+    quint64 dataSize = fileSize - sizeof(FileRecord::Header);
+    m_mappedData = m_mappedFile.map(sizeof(FileRecord::Header), dataSize);
+
+    if (m_mappedData)
+    {
+        m_mappedSamples = dataSize / (m_sampleSize == 24 ? 8 : 4);
+        qDebug("FileSourceInput::mapFile: %llu samples mapped", m_mappedSamples);
+    }
+    else // typically a large file on a 32 bit system
+    {
+        qWarning("FileSourceInput::mapFile: cannot map %s: reading from stream", qPrintable(m_fileName));
+        m_mappedFile.close();
+    }
+}
+
+// Only when there is no reading thread: after stop() or from openFileStream()
+void FileSourceInput::unmapFile()
+{
+    if (m_mappedData)
+    {
+        m_mappedFile.unmap(m_mappedData);
+        m_mappedData = 0;
+        m_mappedSamples = 0;
+    }
+
+    if (m_mappedFile.isOpen()) {
+        m_mappedFile.close();
+    }
 }
 
 void FileSourceInput::seekFileStream(int seekMillis)
+{
+    seekFileStreamSample(((m_recordLength * seekMillis) / 1000) * m_sampleRate);
+}
+
+void FileSourceInput::seekFileStreamSample(quint64 sampleIndex)
 {
 	QMutexLocker mutexLocker(&m_mutex);
 
 	if ((m_ifstream.is_open()) && m_fileSourceThread && !m_fileSourceThread->isRunning())
 	{
-        quint64 seekPoint = ((m_recordLength * seekMillis) / 1000) * m_sampleRate;
-		m_fileSourceThread->setSamplesCount(seekPoint);
-        seekPoint *= (m_sampleSize == 24 ? 8 : 4); // + sizeof(FileSink::Header)
-		m_ifstream.clear();
-		m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		m_fileSourceThread->setSamplesCount(sampleIndex); // this is the read position of the memory mapped file
+
+		if (m_compact)
+		{
+			m_compactReader.seek(sampleIndex);
+		}
+		else if (!m_mappedData)
+		{
+			quint64 seekPoint = sampleIndex * (m_sampleSize == 24 ? 8 : 4);
+			m_ifstream.clear();
+			m_ifstream.seekg(seekPoint + sizeof(FileRecord::Header), std::ios::beg);
+		}
 	}
 }
 
@@ -180,7 +262,10 @@ bool FileSourceInput::start()
 	}
 
 	m_fileSourceThread = new FileSourceThread(&m_ifstream, &m_sampleFifo, m_masterTimer, &m_inputMessageQueue);
-	m_fileSourceThread->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+	m_fileSourceThread->setSampleRateAndSize(m_settings.m_accelerationFactor * m_sampleRate, m_compact ? SDR_RX_SAMP_SZ : m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+	m_fileSourceThread->setMappedData(m_mappedData, m_mappedSamples);
+	m_fileSourceThread->setCompactReader(m_compact ? &m_compactReader : 0);
+	m_fileSourceThread->setAsFastAsPossible(m_settings.m_asFastAsPossible);
 	m_fileSourceThread->startWork();
 	m_deviceDescription = "FileSource";
 
@@ -289,8 +374,13 @@ bool FileSourceInput::handleMessage(const Message& message)
     else if (MsgConfigureFileSourceName::match(message))
 	{
 		MsgConfigureFileSourceName& conf = (MsgConfigureFileSourceName&) message;
+		QString fileName = m_fileName;
 		m_fileName = conf.getFileName();
-		openFileStream();
+
+		if (!openFileStream()) { // keep on with the current file
+			m_fileName = fileName;
+		}
+
 		return true;
 	}
 	else if (MsgConfigureFileSourceWork::match(message))
@@ -399,7 +489,26 @@ bool FileSourceInput::applySettings(const FileSourceSettings& settings, bool for
                 qCritical("FileSourceInput::applySettings: could not reallocate sample FIFO size to %lu",
                         m_settings.m_accelerationFactor * m_sampleRate * sizeof(Sample));
             }
-            m_fileSourceThread->setSampleRateAndSize(settings.m_accelerationFactor * m_sampleRate, m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+            m_fileSourceThread->setSampleRateAndSize(settings.m_accelerationFactor * m_sampleRate, m_compact ? SDR_RX_SAMP_SZ : m_sampleSize); // Fast Forward: 1 corresponds to live. 1/2 is half speed, 2 is double speed
+        }
+    }
+
+    if ((m_settings.m_asFastAsPossible != settings.m_asFastAsPossible) || force)
+    {
+        if (m_fileSourceThread)
+        {
+            // the worker loop and the master timer tick must not read at the same time: switch with the thread stopped
+            bool wasRunning = m_fileSourceThread->isRunning();
+
+            if (wasRunning) {
+                m_fileSourceThread->stopWork();
+            }
+
+            m_fileSourceThread->setAsFastAsPossible(settings.m_asFastAsPossible);
+
+            if (wasRunning) {
+                m_fileSourceThread->startWork();
+            }
         }
     }
 
@@ -434,6 +543,9 @@ int FileSourceInput::webapiSettingsPutPatch(
     if (deviceSettingsKeys.contains("loop")) {
         settings.m_loop = response.getFileSourceSettings()->getLoop() != 0;
     }
+    if (deviceSettingsKeys.contains("asFastAsPossible")) {
+        settings.m_asFastAsPossible = response.getFileSourceSettings()->getAsFastAsPossible() != 0;
+    }
 
     MsgConfigureFileSource *msg = MsgConfigureFileSource::create(settings, force);
     m_inputMessageQueue.push(msg);
@@ -489,6 +601,7 @@ void FileSourceInput::webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings&
     response.getFileSourceSettings()->setFileName(new QString(settings.m_fileName));
     response.getFileSourceSettings()->setAccelerationFactor(settings.m_accelerationFactor);
     response.getFileSourceSettings()->setLoop(settings.m_loop ? 1 : 0);
+    response.getFileSourceSettings()->setAsFastAsPossible(settings.m_asFastAsPossible ? 1 : 0);
 
 }
 
@@ -20,11 +20,13 @@
 #include <QString>
 #include <QByteArray>
 #include <QTimer>
+#include <QFile>
 #include <ctime>
 #include <iostream>
 #include <fstream>
 
 #include <dsp/devicesamplesource.h>
+#include "dsp/compactrecordreader.h"
 #include "filesourcesettings.h"
 
 class FileSourceThread;
@@ -317,6 +319,11 @@ public:
 	QMutex m_mutex;
 	FileSourceSettings m_settings;
 	std::ifstream m_ifstream;
+	QFile m_mappedFile;     //!< same file memory mapped for the samples when possible
+	uchar *m_mappedData;    //!< start of the samples in the mapped file. Null if not mapped.
+	quint64 m_mappedSamples;
+	CompactRecordReader m_compactReader;
+	bool m_compact;         //!< file is in the compact format (.sdriqc)
 	FileSourceThread* m_fileSourceThread;
 	QString m_deviceDescription;
 	QString m_fileName;
@@ -327,8 +334,11 @@ public:
     quint64 m_startingTimeStamp;
 	const QTimer& m_masterTimer;
 
-	void openFileStream();
+	bool openFileStream(); //!< Refused while acquisition is on
+	void mapFile(quint64 fileSize);
+	void unmapFile();
 	void seekFileStream(int seekMillis);
+	void seekFileStreamSample(quint64 sampleIndex);
 	bool applySettings(const FileSourceSettings& settings, bool force = false);
     void webapiFormatDeviceSettings(SWGSDRangel::SWGDeviceSettings& response, const FileSourceSettings& settings);
     void webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& response);
@@ -32,6 +32,7 @@ void FileSourceSettings::resetToDefaults()
     m_fileName = "./test.sdriq";
     m_accelerationFactor = 1;
     m_loop = true;
+    m_asFastAsPossible = false;
 }
 
 QByteArray FileSourceSettings::serialize() const
@@ -40,6 +41,7 @@ QByteArray FileSourceSettings::serialize() const
     s.writeString(1, m_fileName);
     s.writeU32(2, m_accelerationFactor);
     s.writeBool(3, m_loop);
+    s.writeBool(4, m_asFastAsPossible);
     return s.final();
 }
 
@@ -56,6 +58,7 @@ bool FileSourceSettings::deserialize(const QByteArray& data)
         d.readString(1, &m_fileName, "./test.sdriq");
         d.readU32(2, &m_accelerationFactor, 1);
         d.readBool(3, &m_loop, true);
+        d.readBool(4, &m_asFastAsPossible, false);
         return true;
     } else {
         resetToDefaults();
@@ -17,12 +17,15 @@
 #include <stdio.h>
 #include <errno.h>
 #include <assert.h>
+#include <algorithm>
 #include <QDebug>
 
 #include "dsp/filerecord.h"
+#include "dsp/compactrecordreader.h"
 #include "filesourcethread.h"
 #include "dsp/samplesinkfifo.h"
 #include "util/messagequeue.h"
+#include "util/threadroles.h"
 
 MESSAGE_CLASS_DEFINITION(FileSourceThread::MsgReportEOF, Message)
 
@@ -34,6 +37,11 @@ FileSourceThread::FileSourceThread(std::ifstream *samplesStream,
 	QThread(parent),
 	m_running(false),
 	m_ifstream(samplesStream),
+	m_mappedData(0),
+	m_mappedSamples(0),
+	m_compactReader(0),
+	m_asFastAsPossible(false),
+	m_eof(false),
 	m_fileBuf(0),
 	m_convertBuf(0),
 	m_bufsize(0),
@@ -74,6 +82,7 @@ void FileSourceThread::startWork()
     {
         qDebug() << "FileSourceThread::startWork: file stream open, starting...";
         m_startWaitMutex.lock();
+        m_eof = false;
         m_elapsedTimer.start();
         start();
         while(!m_running)
@@ -158,22 +167,60 @@ void FileSourceThread::setBuffers(std::size_t chunksize)
     }
 }
 
+void FileSourceThread::setMappedData(const uchar *data, quint64 nbSamples)
+{
+    qDebug("FileSourceThread::setMappedData: %s %llu samples", data ? "memory mapped" : "stream", nbSamples);
+    m_mappedData = data;
+    m_mappedSamples = data ? nbSamples : 0;
+}
+
 void FileSourceThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	m_running = true;
 	m_startWaiter.wakeAll();
 
-	while(m_running) // actual work is in the tick() function
+	while(m_running) // actual work is in the tick() function unless going as fast as possible
 	{
-		sleep(1);
+		if (m_asFastAsPossible && !m_eof) {
+			runAsFastAsPossible();
+		} else {
+			msleep(FILESOURCE_THROTTLE_MS);
+		}
 	}
 
 	m_running = false;
 }
 
+// Feed the FIFO by slices of 1/8th of its size each time there is room for it. The pace is
+// set by the device engine consuming the FIFO and not by the wall clock.
+void FileSourceThread::runAsFastAsPossible()
+{
+    quint64 slice = m_sampleFifo->size() / 8;
+    setBuffers(slice * 2 * m_samplebytes);
+    qDebug("FileSourceThread::runAsFastAsPossible: slices of %llu samples", slice);
+
+    while (m_running && m_asFastAsPossible)
+    {
+        if (m_sampleFifo->size() - m_sampleFifo->fill() < slice)
+        {
+            usleep(500);
+            continue;
+        }
+
+        if (!readSamples(slice))
+        {
+            m_eof = true;
+            m_fileInputMessageQueue->push(MsgReportEOF::create());
+            break;
+        }
+    }
+}
+
 void FileSourceThread::tick()
 {
-	if (m_running)
+	if (m_running && !m_asFastAsPossible && !m_eof)
 	{
         qint64 throttlems = m_elapsedTimer.restart();
 
@@ -185,21 +232,52 @@ void FileSourceThread::tick()
             setBuffers(m_chunksize);
         }
 
-		// read samples directly feeding the SampleFifo (no callback)
-		m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), m_chunksize);
+        // read samples directly feeding the SampleFifo (no callback)
+        if (!readSamples(m_chunksize / (2 * m_samplebytes)))
+        {
+            m_eof = true;
+            MsgReportEOF *message = MsgReportEOF::create();
+            m_fileInputMessageQueue->push(message);
+        }
+	}
+}
+
+bool FileSourceThread::readSamples(quint64 nbSamples)
+{
+    quint64 sampleBytes = 2 * m_samplebytes;
+
+    if (m_compactReader) // decoded to the native sample format
+    {
+        quint64 n = m_compactReader->read((Sample *) m_fileBuf, nbSamples);
+        writeToSampleFifo(m_fileBuf, (qint32) (n * sampleBytes));
+        m_samplesCount += n;
+        return n == nbSamples;
+    }
+    else if (m_mappedData) // straight from the page cache to the FIFO
+    {
+        quint64 remaining = m_samplesCount < m_mappedSamples ? m_mappedSamples - m_samplesCount : 0;
+        quint64 n = std::min(nbSamples, remaining);
+        writeToSampleFifo(m_mappedData + m_samplesCount * sampleBytes, (qint32) (n * sampleBytes));
+        m_samplesCount += n;
+        return m_samplesCount < m_mappedSamples;
+    }
+    else
+    {
+        m_ifstream->read(reinterpret_cast<char*>(m_fileBuf), nbSamples * sampleBytes);
 
         if (m_ifstream->eof())
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
-        	MsgReportEOF *message = MsgReportEOF::create();
-        	m_fileInputMessageQueue->push(message);
+            writeToSampleFifo(m_fileBuf, (qint32) m_ifstream->gcount());
+            m_samplesCount += m_ifstream->gcount() / sampleBytes;
+            return false;
         }
         else
         {
-        	writeToSampleFifo(m_fileBuf, (qint32) m_chunksize);
-    		m_samplesCount += m_chunksize / (2 * m_samplebytes);
+            writeToSampleFifo(m_fileBuf, (qint32) (nbSamples * sampleBytes));
+            m_samplesCount += nbSamples;
+            return true;
         }
-	}
+    }
 }
 
 void FileSourceThread::writeToSampleFifo(const quint8* buf, qint32 nbBytes)
@@ -32,6 +32,7 @@
 #define FILESOURCE_THROTTLE_MS 50
 
 class SampleSinkFifo;
+class CompactRecordReader;
 class MessageQueue;
 
 class FileSourceThread : public QThread {
@@ -66,9 +67,12 @@ public:
 	void stopWork();
 	void setSampleRateAndSize(int samplerate, quint32 samplesize);
     void setBuffers(std::size_t chunksize);
+    void setMappedData(const uchar *data, quint64 nbSamples); //!< Read the samples from the memory mapped file instead of the stream. Null to go back to the stream.
+    void setCompactReader(CompactRecordReader *compactReader) { m_compactReader = compactReader; } //!< Decode the stream with this reader. Sample size must be SDR_RX_SAMP_SZ
+    void setAsFastAsPossible(bool asFastAsPossible) { m_asFastAsPossible = asFastAsPossible; } //!< Pace on the sample FIFO free space instead of the timer. Only while stopped
 	bool isRunning() const { return m_running; }
     quint64 getSamplesCount() const { return m_samplesCount; }
-    void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; }
+    void setSamplesCount(quint64 samplesCount) { m_samplesCount = samplesCount; } //!< This is also the read position when the file is memory mapped
 
 private:
 	QMutex m_startWaitMutex;
@@ -76,6 +80,11 @@ private:
 	volatile bool m_running;
 
 	std::ifstream* m_ifstream;
+	const uchar *m_mappedData; //!< start of the samples in the memory mapped file
+	quint64 m_mappedSamples;   //!< number of I/Q samples in the memory mapped file
+	CompactRecordReader *m_compactReader; //!< non null for a compact recording
+	volatile bool m_asFastAsPossible;
+	bool m_eof;
 	quint8  *m_fileBuf;
 	quint8  *m_convertBuf;
 	std::size_t m_bufsize;
@@ -93,6 +102,8 @@ private:
     bool m_throttleToggle;
 
 	void run();
+	void runAsFastAsPossible();
+	bool readSamples(quint64 nbSamples); //!< Read samples to the FIFO. Returns false at end of file
 	//void decimate1(SampleVector::iterator* it, const qint16* buf, qint32 len);
 	void writeToSampleFifo(const quint8* buf, qint32 nbBytes);
 private slots:
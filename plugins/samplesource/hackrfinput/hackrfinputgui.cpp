@@ -310,7 +310,7 @@ void HackRFInputGui::on_sampleRate_changed(quint64 value)
 
 void HackRFInputGui::on_decim_currentIndexChanged(int index)
 {
-	if ((index <0) || (index > 6))
+	if ((index <0) || (index > 8))
 		return;
 	m_settings.m_log2Decim = index;
 	sendSettings();
@@ -22,6 +22,7 @@
 #include <algorithm>
 
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 HackRFInputThread::HackRFInputThread(hackrf_device* dev, SampleSinkFifo* sampleFifo, QObject* parent) :
 	QThread(parent),
@@ -74,6 +75,8 @@ void HackRFInputThread::setFcPos(int fcPos)
 
 void HackRFInputThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	hackrf_error rc;
 
     m_running = true;
@@ -154,6 +157,12 @@ void HackRFInputThread::callback(const qint8* buf, qint32 len)
 			case 6:
 				m_decimators.decimate64_inf(&it, buf, len);
 				break;
+			case 7:
+				m_decimators.decimate128_inf(&it, buf, len);
+				break;
+			case 8:
+				m_decimators.decimate256_inf(&it, buf, len);
+				break;
 			default:
 				break;
 			}
@@ -180,6 +189,12 @@ void HackRFInputThread::callback(const qint8* buf, qint32 len)
 			case 6:
 				m_decimators.decimate64_sup(&it, buf, len);
 				break;
+			case 7:
+				m_decimators.decimate128_sup(&it, buf, len);
+				break;
+			case 8:
+				m_decimators.decimate256_sup(&it, buf, len);
+				break;
 			default:
 				break;
 			}
@@ -206,6 +221,12 @@ void HackRFInputThread::callback(const qint8* buf, qint32 len)
 			case 6:
 				m_decimators.decimate64_cen(&it, buf, len);
 				break;
+			case 7:
+				m_decimators.decimate128_cen(&it, buf, len);
+				break;
+			case 8:
+				m_decimators.decimate256_cen(&it, buf, len);
+				break;
 			default:
 				break;
 			}
@@ -218,6 +239,7 @@ void HackRFInputThread::callback(const qint8* buf, qint32 len)
 
 int HackRFInputThread::rx_callback(hackrf_transfer* transfer)
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceIO); // transfers run in a thread of the library
     HackRFInputThread *thread = (HackRFInputThread *) transfer->rx_ctx;
 	qint32 bytes_to_write = transfer->valid_length;
 	thread->callback((qint8 *) transfer->buffer, bytes_to_write);
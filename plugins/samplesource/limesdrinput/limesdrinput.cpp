@@ -1474,4 +1474,5 @@ void LimeSDRInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respon
     }
 
     response.getLimeSdrInputReport()->setTemperature(temp);
+    m_fileSink->webapiFormatReport(response.getLimeSdrInputReport()->getFileRecord());
 }
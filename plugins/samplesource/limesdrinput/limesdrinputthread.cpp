@@ -19,6 +19,7 @@
 
 #include "limesdrinputsettings.h"
 #include "limesdrinputthread.h"
+#include "util/threadroles.h"
 
 LimeSDRInputThread::LimeSDRInputThread(lms_stream_t* stream, SampleSinkFifo* sampleFifo, QObject* parent) :
     QThread(parent),
@@ -76,6 +77,8 @@ void LimeSDRInputThread::setLog2Decimation(unsigned int log2_decim)
 
 void LimeSDRInputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     lms_stream_meta_t metadata;          //Use metadata for additional control over sample receive function behaviour
@@ -127,6 +130,12 @@ void LimeSDRInputThread::callback(const qint16* buf, qint32 len)
     case 6:
         m_decimators.decimate64_cen(&it, buf, len);
         break;
+    case 7:
+        m_decimators.decimate128_cen(&it, buf, len);
+        break;
+    case 8:
+        m_decimators.decimate256_cen(&it, buf, len);
+        break;
     default:
         break;
     }
@@ -532,5 +532,7 @@ void PerseusInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respon
         response.getPerseusReport()->getSampleRates()->append(new SWGSDRangel::SWGSampleRate);
         response.getPerseusReport()->getSampleRates()->back()->setRate(*it);
     }
+
+    m_fileSink->webapiFormatReport(response.getPerseusReport()->getFileRecord());
 }
 
@@ -17,6 +17,7 @@
 #include <QtGlobal>
 #include <algorithm>
 #include "perseusthread.h"
+#include "util/threadroles.h"
 
 PerseusThread *PerseusThread::m_this = 0;
 
@@ -62,6 +63,8 @@ void PerseusThread::setLog2Decimation(unsigned int log2_decim)
 
 void PerseusThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	m_running = true;
 	m_startWaiter.wakeAll();
 
@@ -113,6 +116,7 @@ void PerseusThread::callback(const uint8_t* buf, qint32 len)
 
 int PerseusThread::rx_callback(void *buf, int buf_size, void *extra __attribute__((unused)))
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceIO); // transfers run in a thread of the library
 	qint32 nbIAndQ = buf_size / 3; // 3 bytes per I or Q
 	m_this->callback((uint8_t*) buf, nbIAndQ);
 	return 0;
@@ -783,4 +783,5 @@ void PlutoSDRInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respo
     response.getPlutoSdrInputReport()->setGainDb(gainDB);
     fetchTemperature();
     response.getPlutoSdrInputReport()->setTemperature(getTemperature());
+    m_fileSink->webapiFormatReport(response.getPlutoSdrInputReport()->getFileRecord());
 }
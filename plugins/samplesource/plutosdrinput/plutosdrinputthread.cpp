@@ -21,6 +21,7 @@
 #include "plutosdrinputthread.h"
 
 #include "iio.h"
+#include "util/threadroles.h"
 
 PlutoSDRInputThread::PlutoSDRInputThread(uint32_t blocksizeSamples, DevicePlutoSDRBox* plutoBox, SampleSinkFifo* sampleFifo, QObject* parent) :
     QThread(parent),
@@ -75,6 +76,8 @@ void PlutoSDRInputThread::setFcPos(int fcPos)
 
 void PlutoSDRInputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     std::ptrdiff_t p_inc = m_plutoBox->rxBufferStep();
 
     qDebug("PlutoSDRInputThread::run: rxBufferStep: %ld bytes", p_inc);
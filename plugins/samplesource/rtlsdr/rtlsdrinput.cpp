@@ -681,6 +681,8 @@ void RTLSDRInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respons
         response.getRtlSdrReport()->getGains()->append(new SWGSDRangel::SWGGain);
         response.getRtlSdrReport()->getGains()->back()->setGainCb(*it);
     }
+
+    m_fileSink->webapiFormatReport(response.getRtlSdrReport()->getFileRecord());
 }
 
 
@@ -20,6 +20,7 @@
 #include "rtlsdrthread.h"
 
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 #define FCD_BLOCKSIZE 16384
 
@@ -72,6 +73,8 @@ void RTLSDRThread::setFcPos(int fcPos)
 
 void RTLSDRThread::run()
 {
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
 	int res;
 
 	m_running = true;
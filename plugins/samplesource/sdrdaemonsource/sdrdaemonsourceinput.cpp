@@ -356,4 +356,7 @@ void SDRdaemonSourceInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport
 
     response.getSdrDaemonSourceReport()->setMinNbBlocks(m_SDRdaemonUDPHandler->getMinNbBlocks());
     response.getSdrDaemonSourceReport()->setMaxNbRecovery(m_SDRdaemonUDPHandler->getMaxNbRecovery());
+    response.getSdrDaemonSourceReport()->setJitterUs(m_SDRdaemonUDPHandler->getJitterUs());
+    response.getSdrDaemonSourceReport()->setMaxGapUs(m_SDRdaemonUDPHandler->getMaxGapUs());
+    response.getSdrDaemonSourceReport()->setNbKernelDrops(m_SDRdaemonUDPHandler->getNbKernelDrops());
 }
@@ -14,10 +14,10 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
-#include <QUdpSocket>
 #include <QDebug>
 #include <QTimer>
 #include <unistd.h>
+#include <algorithm>
 
 #include "dsp/dspcommands.h"
 #include "dsp/dspengine.h"
@@ -25,6 +25,7 @@
 
 #include "sdrdaemonsourceinput.h"
 #include "sdrdaemonsourceudphandler.h"
+#include "sdrdaemonsourceudpthread.h"
 
 SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo, DeviceSourceAPI *deviceAPI) :
     m_deviceAPI(deviceAPI),
@@ -32,13 +33,10 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_masterTimerConnected(false),
     m_running(false),
     m_rateDivider(1000/SDRDAEMONSOURCE_THROTTLE_MS),
-	m_dataSocket(0),
+	m_udpThread(0),
 	m_dataAddress(QHostAddress::LocalHost),
-	m_remoteAddress(QHostAddress::LocalHost),
 	m_dataPort(9090),
 	m_dataConnected(false),
-	m_udpBuf(0),
-	m_udpReadBytes(0),
 	m_sampleFifo(sampleFifo),
 	m_samplerate(0),
 	m_centerFrequency(0),
@@ -56,8 +54,6 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
     m_throttleToggle(false),
 	m_autoCorrBuffer(true)
 {
-    m_udpBuf = new char[SDRDaemonUdpSize];
-
 #ifdef USE_INTERNAL_TIMER
 #warning "Uses internal timer"
     m_timer = new QTimer();
@@ -72,7 +68,6 @@ SDRdaemonSourceUDPHandler::SDRdaemonSourceUDPHandler(SampleSinkFifo *sampleFifo,
 SDRdaemonSourceUDPHandler::~SDRdaemonSourceUDPHandler()
 {
 	stop();
-	delete[] m_udpBuf;
 	if (m_converterBuffer) { delete[] m_converterBuffer; }
 #ifdef USE_INTERNAL_TIMER
     if (m_timer) {
@@ -89,16 +84,15 @@ void SDRdaemonSourceUDPHandler::start()
 	    return;
 	}
 
-	if (!m_dataSocket)
+	if (!m_udpThread)
 	{
-		m_dataSocket = new QUdpSocket(this);
+		m_udpThread = new SDRdaemonSourceUDPThread(&m_sdrDaemonBuffer, &m_bufferMutex);
+		connect(m_udpThread, SIGNAL(streamChanged()), this, SLOT(handleStreamChange()), Qt::QueuedConnection);
 	}
 
     if (!m_dataConnected)
 	{
-        connect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead())); //, Qt::QueuedConnection);
-
-        if (m_dataSocket->bind(m_dataAddress, m_dataPort))
+        if (m_udpThread->startWork(m_dataAddress, m_dataPort))
 		{
 			qDebug("SDRdaemonSourceUDPHandler::start: bind data socket to %s:%d", m_dataAddress.toString().toStdString().c_str(),  m_dataPort);
 			m_dataConnected = true;
@@ -106,7 +100,6 @@ void SDRdaemonSourceUDPHandler::start()
 		else
 		{
 			qWarning("SDRdaemonSourceUDPHandler::start: cannot bind data port %d", m_dataPort);
-	        disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
 			m_dataConnected = false;
 		}
 	}
@@ -128,13 +121,13 @@ void SDRdaemonSourceUDPHandler::stop()
     if (m_dataConnected)
     {
 		m_dataConnected = false;
-	    disconnect(m_dataSocket, SIGNAL(readyRead()), this, SLOT(dataReadyRead()));
+		m_udpThread->stopWork();
 	}
 
-	if (m_dataSocket)
+	if (m_udpThread)
 	{
-		delete m_dataSocket;
-		m_dataSocket = 0;
+		delete m_udpThread;
+		m_udpThread = 0;
 	}
 
 	m_centerFrequency = 0;
@@ -158,30 +151,53 @@ void SDRdaemonSourceUDPHandler::configureUDPLink(const QString& address, quint16
 	start();
 }
 
-void SDRdaemonSourceUDPHandler::dataReadyRead()
+void SDRdaemonSourceUDPHandler::getRemoteAddress(QString& s)
 {
-    m_udpReadBytes = 0;
+    QHostAddress remoteAddress(QHostAddress::LocalHost);
 
-	while (m_dataSocket->hasPendingDatagrams() && m_dataConnected)
-	{
-		qint64 pendingDataSize = m_dataSocket->pendingDatagramSize();
-		m_udpReadBytes += m_dataSocket->readDatagram(&m_udpBuf[m_udpReadBytes], pendingDataSize, &m_remoteAddress, 0);
+    if (m_udpThread) {
+        m_udpThread->getRemoteAddress(remoteAddress);
+    }
 
-		if (m_udpReadBytes == SDRDaemonUdpSize) {
-		    processData();
-		    m_udpReadBytes = 0;
-		}
-	}
+    s = remoteAddress.toString();
 }
 
-void SDRdaemonSourceUDPHandler::processData()
+int SDRdaemonSourceUDPHandler::getMinNbBlocks()
 {
-    m_sdrDaemonBuffer.writeData(m_udpBuf);
-    const SDRDaemonMetaDataFEC& metaData =  m_sdrDaemonBuffer.getCurrentMeta();
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    return m_sdrDaemonBuffer.getMinNbBlocks();
+}
+
+int SDRdaemonSourceUDPHandler::getMaxNbRecovery()
+{
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    return m_sdrDaemonBuffer.getMaxNbRecovery();
+}
+
+float SDRdaemonSourceUDPHandler::getJitterUs()
+{
+    return m_udpThread ? m_udpThread->getJitterUs() : 0.0f;
+}
+
+int SDRdaemonSourceUDPHandler::getMaxGapUs()
+{
+    return m_udpThread ? m_udpThread->getMaxGapUs() : 0;
+}
+
+quint64 SDRdaemonSourceUDPHandler::getNbKernelDrops()
+{
+    return m_udpThread ? m_udpThread->getNbKernelDrops() : 0;
+}
+
+void SDRdaemonSourceUDPHandler::handleStreamChange()
+{
+    QMutexLocker mutexLocker(&m_bufferMutex);
+    SDRDaemonMetaDataFEC metaData =  m_sdrDaemonBuffer.getCurrentMeta();
     bool change = false;
 
     m_tv_sec = m_sdrDaemonBuffer.getTVOutSec();
     m_tv_usec = m_sdrDaemonBuffer.getTVOutUsec();
+    mutexLocker.unlock();
 
     if (m_centerFrequency != metaData.m_centerFrequency)
     {
@@ -197,7 +213,7 @@ void SDRdaemonSourceUDPHandler::processData()
 
     if (change && (m_samplerate != 0))
     {
-        qDebug("SDRdaemonSourceUDPHandler::processData: m_samplerate: %u m_centerFrequency: %u kHz", m_samplerate, m_centerFrequency);
+        qDebug("SDRdaemonSourceUDPHandler::handleStreamChange: m_samplerate: %u m_centerFrequency: %u kHz", m_samplerate, m_centerFrequency);
 
         DSPSignalNotification *notif = new DSPSignalNotification(m_samplerate, m_centerFrequency * 1000); // Frequency in Hz for the DSP engine
         m_deviceAPI->getDeviceEngineInputMessageQueue()->push(notif);
@@ -249,6 +265,16 @@ void SDRdaemonSourceUDPHandler::disconnectTimer()
 
 void SDRdaemonSourceUDPHandler::tick()
 {
+    // samples are copied out of the UDP buffer with the lock held and written to the FIFO
+    // once it is released so that the UDP thread does not wait for the FIFO
+    quint8 *fifoData = 0;
+    uint32_t fifoLength = 0;
+    SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming *report = 0;
+
+    m_bufferMutex.lock();
+    m_tv_sec = m_sdrDaemonBuffer.getTVOutSec();
+    m_tv_usec = m_sdrDaemonBuffer.getTVOutUsec();
+
     // auto throttling
     int throttlems = m_elapsedTimer.restart();
 
@@ -268,8 +294,14 @@ void SDRdaemonSourceUDPHandler::tick()
 
     if (SDR_RX_SAMP_SZ == metaData.m_sampleBits) // same sample size
     {
-        // read samples directly feeding the SampleFifo (no callback)
-        m_sampleFifo->write(reinterpret_cast<quint8*>(m_sdrDaemonBuffer.readData(m_readLength)), m_readLength);
+        if (m_readCopy.size() < m_readLength) {
+            m_readCopy.resize(m_readLength);
+        }
+
+        uint8_t *buf = m_sdrDaemonBuffer.readData(m_readLength);
+        std::copy(buf, buf + m_readLength, m_readCopy.begin());
+        fifoData = m_readCopy.data();
+        fifoLength = m_readLength;
         m_samplesCount += m_readLengthSamples;
     }
     else if (metaData.m_sampleBits == 16) // 16 -> 24 bits
@@ -278,6 +310,7 @@ void SDRdaemonSourceUDPHandler::tick()
         {
             if (m_converterBuffer) { delete[] m_converterBuffer; }
             m_converterBuffer = new int32_t[m_readLengthSamples*2];
+            m_converterBufferNbSamples = m_readLengthSamples;
         }
 
         uint8_t *buf = m_sdrDaemonBuffer.readData(m_readLength);
@@ -290,7 +323,8 @@ void SDRdaemonSourceUDPHandler::tick()
             m_converterBuffer[2*is+1]<<=8;
         }
 
-        m_sampleFifo->write(reinterpret_cast<quint8*>(m_converterBuffer), m_readLengthSamples*sizeof(Sample));
+        fifoData = reinterpret_cast<quint8*>(m_converterBuffer);
+        fifoLength = m_readLengthSamples*sizeof(Sample);
     }
     else if (metaData.m_sampleBits == 24) // 24 -> 16 bits
     {
@@ -298,6 +332,7 @@ void SDRdaemonSourceUDPHandler::tick()
         {
             if (m_converterBuffer) { delete[] m_converterBuffer; }
             m_converterBuffer = new int32_t[m_readLengthSamples];
+            m_converterBufferNbSamples = m_readLengthSamples;
         }
 
         uint8_t *buf = m_sdrDaemonBuffer.readData(m_readLength);
@@ -309,7 +344,8 @@ void SDRdaemonSourceUDPHandler::tick()
             m_converterBuffer[is] += ((int32_t *)buf)[2*is]>>8; // I -> LSB
         }
 
-        m_sampleFifo->write(reinterpret_cast<quint8*>(m_converterBuffer), m_readLengthSamples*sizeof(Sample));
+        fifoData = reinterpret_cast<quint8*>(m_converterBuffer);
+        fifoLength = m_readLengthSamples*sizeof(Sample);
     }
     else
     {
@@ -343,7 +379,7 @@ void SDRdaemonSourceUDPHandler::tick()
 	            framesDecodingStatus = 2;
 	        }
 
-	        SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming *report = SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming::create(
+	        report = SDRdaemonSourceInput::MsgReportSDRdaemonSourceStreamTiming::create(
 	            m_tv_sec,
 	            m_tv_usec,
 	            m_sdrDaemonBuffer.getBufferLengthInSecs(),
@@ -360,8 +396,16 @@ void SDRdaemonSourceUDPHandler::tick()
 	            nbFECblocks,
 	            sampleBits,
 	            sampleBytes);
-
-	            m_outputMessageQueueToGUI->push(report);
 		}
 	}
+
+    m_bufferMutex.unlock();
+
+    if (fifoData) {
+        m_sampleFifo->write(fifoData, fifoLength);
+    }
+
+    if (report) {
+        m_outputMessageQueueToGUI->push(report);
+    }
 }
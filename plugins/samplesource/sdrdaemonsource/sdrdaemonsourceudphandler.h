@@ -18,10 +18,10 @@
 #define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPHANDLER_H_
 
 #include <QObject>
-#include <QUdpSocket>
 #include <QHostAddress>
 #include <QMutex>
 #include <QElapsedTimer>
+#include <vector>
 
 #include "sdrdaemonsourcebuffer.h"
 
@@ -31,6 +31,7 @@ class SampleSinkFifo;
 class MessageQueue;
 class QTimer;
 class DeviceSourceAPI;
+class SDRdaemonSourceUDPThread;
 
 class SDRdaemonSourceUDPHandler : public QObject
 {
@@ -42,7 +43,7 @@ public:
 	void start();
 	void stop();
 	void configureUDPLink(const QString& address, quint16 port);
-	void getRemoteAddress(QString& s) const { s = m_remoteAddress.toString(); }
+	void getRemoteAddress(QString& s);
     int getNbOriginalBlocks() const { return SDRDaemonNbOrginalBlocks; }
     bool isStreaming() const { return m_masterTimerConnected; }
     int getSampleRate() const { return m_samplerate; }
@@ -50,10 +51,11 @@ public:
     int getBufferGauge() const { return m_sdrDaemonBuffer.getBufferGauge(); }
     uint32_t getTVSec() const { return m_tv_sec; }
     uint32_t getTVuSec() const { return m_tv_usec; }
-    int getMinNbBlocks() { return m_sdrDaemonBuffer.getMinNbBlocks(); }
-    int getMaxNbRecovery() { return m_sdrDaemonBuffer.getMaxNbRecovery(); }
-public slots:
-	void dataReadyRead();
+    int getMinNbBlocks();
+    int getMaxNbRecovery();
+    float getJitterUs();
+    int getMaxGapUs();
+    quint64 getNbKernelDrops();
 
 private:
 	DeviceSourceAPI *m_deviceAPI;
@@ -62,13 +64,11 @@ private:
 	bool m_running;
     uint32_t m_rateDivider;
 	SDRdaemonSourceBuffer m_sdrDaemonBuffer;
-	QUdpSocket *m_dataSocket;
+	QMutex m_bufferMutex; //!< buffer is written by the UDP thread
+	SDRdaemonSourceUDPThread *m_udpThread;
 	QHostAddress m_dataAddress;
-	QHostAddress m_remoteAddress;
 	quint16 m_dataPort;
 	bool m_dataConnected;
-	char *m_udpBuf;
-	qint64 m_udpReadBytes;
 	SampleSinkFifo *m_sampleFifo;
 	uint32_t m_samplerate;
 	uint32_t m_centerFrequency;
@@ -85,15 +85,16 @@ private:
     uint32_t m_readLength;
     int32_t *m_converterBuffer;
     uint32_t m_converterBufferNbSamples;
+    std::vector<quint8> m_readCopy; //!< samples read from the UDP buffer under lock then written to the FIFO
     bool m_throttleToggle;
     bool m_autoCorrBuffer;
 
 	void connectTimer();
     void disconnectTimer();
-	void processData();
 
 private slots:
 	void tick();
+	void handleStreamChange();
 };
 
 
@@ -0,0 +1,373 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QUdpSocket>
+#include <QDebug>
+#include <sys/time.h>
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+#endif
+
+#include "sdrdaemonsourcebuffer.h"
+#include "sdrdaemonsourceudpthread.h"
+#include "util/threadroles.h"
+
+SDRdaemonSourceUDPThread::SDRdaemonSourceUDPThread(SDRdaemonSourceBuffer *buffer, QMutex *bufferMutex, QObject* parent) :
+    QThread(parent),
+    m_running(false),
+    m_buffer(buffer),
+    m_bufferMutex(bufferMutex),
+    m_port(0),
+    m_fd(-1),
+    m_bound(false),
+    m_pool(m_poolSize),
+    m_rxSizes(m_poolSize),
+    m_rxTimestamps(m_poolSize),
+    m_remoteAddress(QHostAddress::LocalHost),
+    m_centerFrequency(0),
+    m_sampleRate(0),
+    m_lastRxTimestamp(0),
+    m_lastTransit(0),
+    m_hasTransit(false),
+    m_jitter(0.0),
+    m_maxGap(0),
+    m_nbDatagrams(0),
+    m_nbKernelDrops(0)
+{
+}
+
+SDRdaemonSourceUDPThread::~SDRdaemonSourceUDPThread()
+{
+    if (m_running) {
+        stopWork();
+    }
+}
+
+bool SDRdaemonSourceUDPThread::startWork(const QHostAddress& address, quint16 port)
+{
+    qDebug("SDRdaemonSourceUDPThread::startWork: %s:%d", qPrintable(address.toString()), port);
+    m_address = address;
+    m_port = port;
+    m_centerFrequency = 0;
+    m_sampleRate = 0;
+    m_lastRxTimestamp = 0;
+    m_hasTransit = false;
+    m_jitter = 0.0;
+    m_maxGap = 0;
+    m_nbDatagrams = 0;
+    m_nbKernelDrops = 0;
+    m_bound = false;
+
+#if defined(__linux__)
+    if (address.protocol() == QAbstractSocket::IPv4Protocol)
+    {
+        m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+
+        if (m_fd >= 0)
+        {
+            int one = 1;
+            int rcvBuf = 1<<22; // capped by net.core.rmem_max
+            struct timeval tv = {0, 100000}; // so that the thread checks for stop regularly
+            setsockopt(m_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+            setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &one, sizeof(one));
+            setsockopt(m_fd, SOL_SOCKET, SO_RXQ_OVFL, &one, sizeof(one));
+            setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(address.toIPv4Address());
+            addr.sin_port = htons(port);
+
+            if (bind(m_fd, (struct sockaddr *) &addr, sizeof(addr)) < 0)
+            {
+                qWarning("SDRdaemonSourceUDPThread::startWork: cannot bind data port %d: %s", port, strerror(errno));
+                close(m_fd);
+                m_fd = -1;
+                return false;
+            }
+        }
+    }
+#endif
+
+	m_startWaitMutex.lock();
+	start();
+	while(!m_running && isRunning())
+		m_startWaiter.wait(&m_startWaitMutex, 100);
+	m_startWaitMutex.unlock();
+
+    return (m_fd >= 0) || m_bound;
+}
+
+void SDRdaemonSourceUDPThread::stopWork()
+{
+    qDebug("SDRdaemonSourceUDPThread::stopWork");
+    m_running = false;
+    wait();
+
+#if defined(__linux__)
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+        m_fd = -1;
+    }
+#endif
+}
+
+void SDRdaemonSourceUDPThread::getRemoteAddress(QHostAddress& address)
+{
+    QMutexLocker mutexLocker(m_bufferMutex);
+    address = m_remoteAddress;
+}
+
+float SDRdaemonSourceUDPThread::getJitterUs()
+{
+    QMutexLocker mutexLocker(m_bufferMutex);
+    return m_jitter;
+}
+
+int SDRdaemonSourceUDPThread::getMaxGapUs()
+{
+    QMutexLocker mutexLocker(m_bufferMutex);
+    int maxGap = m_maxGap;
+    m_maxGap = 0;
+    return maxGap;
+}
+
+quint64 SDRdaemonSourceUDPThread::getNbDatagrams()
+{
+    QMutexLocker mutexLocker(m_bufferMutex);
+    return m_nbDatagrams;
+}
+
+quint64 SDRdaemonSourceUDPThread::getNbKernelDrops()
+{
+    QMutexLocker mutexLocker(m_bufferMutex);
+    return m_nbKernelDrops;
+}
+
+void SDRdaemonSourceUDPThread::run()
+{
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleNetwork);
+
+    qDebug("SDRdaemonSourceUDPThread::run: begin");
+    QUdpSocket *socket = 0;
+
+    if (m_fd < 0) // portable path. The socket must live in this thread
+    {
+        socket = new QUdpSocket();
+        m_bound = socket->bind(m_address, m_port);
+
+        if (!m_bound) {
+            qWarning("SDRdaemonSourceUDPThread::run: cannot bind data port %d", m_port);
+        }
+    }
+
+    if ((m_fd >= 0) || m_bound)
+    {
+        m_running = true;
+        m_startWaiter.wakeAll();
+
+        if (socket) {
+            runQt(socket);
+        } else {
+            runNative();
+        }
+    }
+
+    delete socket;
+    m_running = false;
+    qDebug("SDRdaemonSourceUDPThread::run: end");
+}
+
+void SDRdaemonSourceUDPThread::runNative()
+{
+#if defined(__linux__)
+    static const int controlSize = CMSG_SPACE(sizeof(struct timespec)) + CMSG_SPACE(sizeof(uint32_t));
+    std::vector<struct mmsghdr> msgs(m_poolSize);
+    std::vector<struct iovec> iovecs(m_poolSize);
+    std::vector<struct sockaddr_in> addrs(m_poolSize);
+    std::vector<char> control(m_poolSize * controlSize);
+
+    for (int i = 0; i < m_poolSize; i++)
+    {
+        iovecs[i].iov_base = (void *) &m_pool[i];
+        iovecs[i].iov_len = sizeof(SDRDaemonSuperBlock);
+    }
+
+    while (m_running)
+    {
+        for (int i = 0; i < m_poolSize; i++)
+        {
+            memset(&msgs[i].msg_hdr, 0, sizeof(struct msghdr));
+            msgs[i].msg_hdr.msg_name = (void *) &addrs[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            msgs[i].msg_hdr.msg_control = (void *) &control[i * controlSize];
+            msgs[i].msg_hdr.msg_controllen = controlSize;
+            msgs[i].msg_len = 0;
+        }
+
+        // blocks until at least one datagram is there (or timeout) then takes whatever else is queued
+        int nbDatagrams = recvmmsg(m_fd, msgs.data(), m_poolSize, MSG_WAITFORONE, 0);
+
+        if (nbDatagrams <= 0)
+        {
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
+                qWarning("SDRdaemonSourceUDPThread::runNative: recvmmsg: %s", strerror(errno));
+            }
+
+            continue;
+        }
+
+        qint64 now = 0;
+
+        for (int i = 0; i < nbDatagrams; i++)
+        {
+            struct msghdr *hdr = &msgs[i].msg_hdr;
+            m_rxSizes[i] = (hdr->msg_flags & MSG_TRUNC) ? -1 : (int) msgs[i].msg_len;
+            m_rxTimestamps[i] = 0;
+
+            for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(hdr); cmsg != 0; cmsg = CMSG_NXTHDR(hdr, cmsg))
+            {
+                if (cmsg->cmsg_level != SOL_SOCKET) {
+                    continue;
+                }
+
+                if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                {
+                    struct timespec ts;
+                    memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                    m_rxTimestamps[i] = ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+                }
+                else if (cmsg->cmsg_type == SO_RXQ_OVFL)
+                {
+                    uint32_t drops;
+                    memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+                    m_nbKernelDrops = drops; // cumulative count for the socket. Benign race with the getter
+                }
+            }
+
+            if (m_rxTimestamps[i] == 0) // no kernel timestamp
+            {
+                now = now == 0 ? nowUs() : now;
+                m_rxTimestamps[i] = now;
+            }
+        }
+
+        struct sockaddr_in& remote = addrs[nbDatagrams - 1];
+        processDatagrams(nbDatagrams, QHostAddress(ntohl(remote.sin_addr.s_addr)));
+    }
+#endif
+}
+
+void SDRdaemonSourceUDPThread::runQt(QUdpSocket *socket)
+{
+    QHostAddress remoteAddress;
+
+    while (m_running)
+    {
+        if (!socket->waitForReadyRead(100)) {
+            continue;
+        }
+
+        int nbDatagrams = 0;
+
+        while ((nbDatagrams < m_poolSize) && socket->hasPendingDatagrams())
+        {
+            m_rxSizes[nbDatagrams] = socket->readDatagram((char *) &m_pool[nbDatagrams], sizeof(SDRDaemonSuperBlock), &remoteAddress, 0);
+            m_rxTimestamps[nbDatagrams] = nowUs();
+            nbDatagrams++;
+        }
+
+        processDatagrams(nbDatagrams, remoteAddress);
+    }
+}
+
+void SDRdaemonSourceUDPThread::processDatagrams(int nbDatagrams, const QHostAddress& remoteAddress)
+{
+    bool change = false;
+
+    {
+        QMutexLocker mutexLocker(m_bufferMutex);
+        m_remoteAddress = remoteAddress;
+
+        for (int i = 0; i < nbDatagrams; i++)
+        {
+            if (m_rxSizes[i] != SDRDaemonUdpSize) {
+                continue;
+            }
+
+            qint64 rxTimestamp = m_rxTimestamps[i];
+
+            if ((m_lastRxTimestamp != 0) && (rxTimestamp - m_lastRxTimestamp > m_maxGap)) {
+                m_maxGap = rxTimestamp - m_lastRxTimestamp;
+            }
+
+            m_lastRxTimestamp = rxTimestamp;
+            m_nbDatagrams++;
+            SDRDaemonSuperBlock& superBlock = m_pool[i];
+
+            if (superBlock.m_header.m_blockIndex == 0) // meta data block carries the frame timestamp at the sender
+            {
+                SDRDaemonMetaDataFEC *metaData = (SDRDaemonMetaDataFEC *) &superBlock.m_protectedBlock;
+                qint64 transit = rxTimestamp - (metaData->m_tv_sec * 1000000LL + metaData->m_tv_usec);
+
+                if (m_hasTransit)
+                {
+                    qint64 d = transit - m_lastTransit;
+                    m_jitter += ((d < 0 ? -d : d) - m_jitter) / 16.0;
+                }
+
+                m_lastTransit = transit;
+                m_hasTransit = true;
+            }
+
+            m_buffer->writeData((char *) &superBlock);
+        }
+
+        const SDRDaemonMetaDataFEC& currentMeta = m_buffer->getCurrentMeta();
+
+        if ((currentMeta.m_centerFrequency != m_centerFrequency) || (currentMeta.m_sampleRate != m_sampleRate))
+        {
+            m_centerFrequency = currentMeta.m_centerFrequency;
+            m_sampleRate = currentMeta.m_sampleRate;
+            change = true;
+        }
+    }
+
+    if (change) {
+        emit streamChanged();
+    }
+}
+
+qint64 SDRdaemonSourceUDPThread::nowUs()
+{
+    struct timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec * 1000000LL + tv.tv_usec;
+}
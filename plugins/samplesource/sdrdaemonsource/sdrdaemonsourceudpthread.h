@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+#define PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHostAddress>
+#include <vector>
+
+#include "channel/sdrdaemondatablock.h"
+
+class SDRdaemonSourceBuffer;
+class QUdpSocket;
+
+/**
+ * Receives the SDRdaemon UDP stream in its own thread so that it does not depend on the
+ * responsiveness of the event loop of the main thread.
+ *
+ * Datagrams are received straight into a preallocated pool of super blocks then written into
+ * the decoding buffer under the buffer mutex. On Linux the socket is drained with recvmmsg
+ * (up to one pool of datagrams per call) with kernel receive timestamps and the count of
+ * datagrams dropped by the kernel. Elsewhere it uses a QUdpSocket owned by the thread.
+ *
+ * Receive timestamps give the interarrival jitter of the frames (RFC 3550 estimator applied
+ * to the meta data block timestamps) and the largest gap between two datagrams.
+ */
+class SDRdaemonSourceUDPThread : public QThread {
+    Q_OBJECT
+
+public:
+    SDRdaemonSourceUDPThread(SDRdaemonSourceBuffer *buffer, QMutex *bufferMutex, QObject* parent = 0);
+    ~SDRdaemonSourceUDPThread();
+
+    bool startWork(const QHostAddress& address, quint16 port);
+    void stopWork();
+
+    void getRemoteAddress(QHostAddress& address);
+    float getJitterUs();         //!< frames interarrival jitter in microseconds
+    int getMaxGapUs();           //!< largest gap between two datagrams since last call in microseconds
+    quint64 getNbDatagrams();    //!< datagrams received since start
+    quint64 getNbKernelDrops();  //!< datagrams dropped by the kernel since start (socket buffer full). Linux only
+
+signals:
+    void streamChanged(); //!< center frequency or sample rate changed
+
+private:
+	QMutex m_startWaitMutex;
+	QWaitCondition m_startWaiter;
+	volatile bool m_running;
+
+    SDRdaemonSourceBuffer *m_buffer;
+    QMutex *m_bufferMutex;
+    QHostAddress m_address;
+    quint16 m_port;
+    int m_fd;     //!< native socket. -1 if not used
+    bool m_bound; //!< QUdpSocket bound successfully (non native case)
+
+    std::vector<SDRDaemonSuperBlock> m_pool; //!< received datagrams land here
+    std::vector<int> m_rxSizes;              //!< size of the datagram in each pool slot
+    std::vector<qint64> m_rxTimestamps;      //!< receive time of each pool slot (us since epoch)
+
+    QHostAddress m_remoteAddress;
+    uint32_t m_centerFrequency;
+    uint32_t m_sampleRate;
+    qint64 m_lastRxTimestamp;
+    qint64 m_lastTransit;
+    bool m_hasTransit;
+    double m_jitter;
+    int m_maxGap;
+    quint64 m_nbDatagrams;
+    quint64 m_nbKernelDrops;
+
+    static const int m_poolSize = 64; //!< datagrams per receive call at most
+
+    void run();
+    void runNative();
+    void runQt(QUdpSocket *socket);
+    void processDatagrams(int nbDatagrams, const QHostAddress& remoteAddress);
+
+    static qint64 nowUs();
+};
+
+#endif /* PLUGINS_SAMPLESOURCE_SDRDAEMONSOURCE_SDRDAEMONSOURCEUDPTHREAD_H_ */
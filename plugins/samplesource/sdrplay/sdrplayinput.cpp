@@ -802,6 +802,8 @@ void SDRPlayInput::webapiFormatDeviceReport(SWGSDRangel::SWGDeviceReport& respon
         response.getSdrPlayReport()->getFrequencyBands()->back()->setLowerBound(SDRPlayBands::getBandLow(i));
         response.getSdrPlayReport()->getFrequencyBands()->back()->setHigherBound(SDRPlayBands::getBandHigh(i));
     }
+
+    m_fileSink->webapiFormatReport(response.getSdrPlayReport()->getFileRecord());
 }
 
 // ====================================================================
@@ -18,6 +18,7 @@
 #include <errno.h>
 #include "sdrplaythread.h"
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 SDRPlayThread::SDRPlayThread(mirisdr_dev_t* dev, SampleSinkFifo* sampleFifo, QObject* parent) :
     QThread(parent),
@@ -68,6 +69,8 @@ void SDRPlayThread::setFcPos(int fcPos)
 
 void SDRPlayThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     m_running = true;
@@ -19,6 +19,7 @@
 #include "testsourcethread.h"
 
 #include "dsp/samplesinkfifo.h"
+#include "util/threadroles.h"
 
 #define TESTSOURCE_BLOCKSIZE 16384
 
@@ -191,6 +192,8 @@ void TestSourceThread::startStop(bool start)
 
 void TestSourceThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     m_running = true;
     m_startWaiter.wakeAll();
 
@@ -19,6 +19,7 @@
 
 #include "xtrxinputsettings.h"
 #include "xtrxinputthread.h"
+#include "util/threadroles.h"
 
 XTRXInputThread::XTRXInputThread(DeviceXTRXShared* shared,
                                  SampleSinkFifo* sampleFifo,
@@ -103,6 +104,8 @@ void XTRXInputThread::setFcPos(int fcPos)
 
 void XTRXInputThread::run()
 {
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceIO);
+
     int res;
 
     m_running = true;
@@ -92,6 +92,9 @@ public:
 
     void addAudioSink(AudioFifo* audioFifo, MessageQueue *sampleSinkMessageQueue, int outputDeviceIndex = -1); //!< Add the audio sink
     void removeAudioSink(AudioFifo* audioFifo); //!< Remove the audio sink
+    QList<AudioFifo*> getAudioSinkFifos() const { return m_audioSinkFifos.keys(); } //!< FIFOs of all audio sinks
+    MessageQueue *getAudioSinkMessageQueue(AudioFifo* audioFifo) const { return m_audioFifoToSinkMessageQueues.value(audioFifo, 0); }
+    int getAudioSinkOutputDeviceIndex(AudioFifo* audioFifo) const { return m_audioSinkFifos.value(audioFifo, -1); }
 
     void addAudioSource(AudioFifo* audioFifo, MessageQueue *sampleSourceMessageQueue, int inputDeviceIndex = -1);    //!< Add an audio source
     void removeAudioSource(AudioFifo* audioFifo); //!< Remove an audio source
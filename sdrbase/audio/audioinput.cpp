@@ -15,11 +15,13 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
+#include <QCoreApplication>
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
 #include <QAudioInput>
 #include "audio/audioinput.h"
 #include "audio/audiofifo.h"
+#include "util/threadroles.h"
 
 AudioInput::AudioInput() :
 	m_mutex(QMutex::Recursive),
@@ -160,6 +162,10 @@ qint64 AudioInput::readData(char* data, qint64 maxLen)
 
 qint64 AudioInput::writeData(const char *data, qint64 len)
 {
+    if (QThread::currentThread() != QCoreApplication::instance()->thread()) { // never change the scheduling of the main thread
+        ThreadRoles::applyOnce(ThreadRoles::RoleAudio);
+    }
+
     // Study this mutex on OSX, for now deadlocks possible
     // Removed as it may indeed cause lockups and is in fact useless.
 //#ifndef __APPLE__
@@ -16,12 +16,14 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <string.h>
+#include <QCoreApplication>
 #include <QAudioFormat>
 #include <QAudioDeviceInfo>
 #include <QAudioOutput>
 #include "audiooutput.h"
 #include "audiofifo.h"
 #include "audionetsink.h"
+#include "util/threadroles.h"
 
 AudioOutput::AudioOutput() :
 	m_mutex(QMutex::Recursive),
@@ -209,6 +211,10 @@ void AudioOutput::setUdpChannelFormat(bool stereo, int sampleRate)
 
 qint64 AudioOutput::readData(char* data, qint64 maxLen)
 {
+    if (QThread::currentThread() != QCoreApplication::instance()->thread()) { // never change the scheduling of the main thread
+        ThreadRoles::applyOnce(ThreadRoles::RoleAudio);
+    }
+
     //qDebug("AudioOutput::readData: %lld", maxLen);
 
     // Study this mutex on OSX, for now deadlocks possible
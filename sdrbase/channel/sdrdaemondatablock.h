@@ -120,6 +120,7 @@ struct SDRDaemonTxControlBlock
     int m_txDelay;
     QString m_dataAddress;
     uint16_t m_dataPort;
+    bool m_useGSO; //!< send with UDP segmentation offload if available
 
     SDRDaemonTxControlBlock() {
         m_complete = false;
@@ -129,6 +130,7 @@ struct SDRDaemonTxControlBlock
         m_txDelay = 100;
         m_dataAddress = "127.0.0.1";
         m_dataPort = 9090;
+        m_useGSO = false;
     }
 };
 
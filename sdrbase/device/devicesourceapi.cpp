@@ -21,6 +21,7 @@
 #include "plugin/plugininterface.h"
 #include "settings/preset.h"
 #include "dsp/dspengine.h"
+#include "dsp/pfbchannelizer.h"
 #include "channel/channelsinkapi.h"
 
 DeviceSourceAPI::DeviceSourceAPI(int deviceTabIndex,
@@ -34,12 +35,14 @@ DeviceSourceAPI::DeviceSourceAPI(int deviceTabIndex,
     m_sampleSourcePluginInstanceUI(0),
     m_buddySharedPtr(0),
     m_isBuddyLeader(false),
-    m_masterTimer(DSPEngine::instance()->getMasterTimer())
+    m_masterTimer(DSPEngine::instance()->getMasterTimer()),
+    m_pfbChannelizer(0)
 {
 }
 
 DeviceSourceAPI::~DeviceSourceAPI()
 {
+    delete m_pfbChannelizer; // device engine is gone at this point
 }
 
 void DeviceSourceAPI::addSink(BasebandSampleSink *sink)
@@ -62,6 +65,38 @@ void DeviceSourceAPI::removeThreadedSink(ThreadedBasebandSampleSink* sink)
     m_deviceSourceEngine->removeThreadedSink(sink);
 }
 
+PFBChannelizer *DeviceSourceAPI::enablePFBChannelizer(int nbChannels, bool oversampled)
+{
+    if (m_pfbChannelizer)
+    {
+        if ((m_pfbChannelizer->getNbChannels() == nbChannels) && (m_pfbChannelizer->getOversampled() == oversampled)) {
+            return m_pfbChannelizer;
+        }
+
+        if (m_pfbChannelizer->getNbSubscribers() > 0)
+        {
+            qWarning("DeviceSourceAPI::enablePFBChannelizer: cannot change the filter bank while it has subscribers");
+            return 0;
+        }
+
+        disablePFBChannelizer();
+    }
+
+    m_pfbChannelizer = new PFBChannelizer(nbChannels, oversampled);
+    m_deviceSourceEngine->addSink(m_pfbChannelizer);
+    return m_pfbChannelizer;
+}
+
+void DeviceSourceAPI::disablePFBChannelizer()
+{
+    if (m_pfbChannelizer)
+    {
+        m_deviceSourceEngine->removeSink(m_pfbChannelizer);
+        delete m_pfbChannelizer;
+        m_pfbChannelizer = 0;
+    }
+}
+
 void DeviceSourceAPI::addChannelAPI(ChannelSinkAPI* channelAPI)
 {
     m_channelAPIs.append(channelAPI);
@@ -34,6 +34,7 @@ class PluginInterface;
 class Preset;
 class DeviceSinkAPI;
 class ChannelSinkAPI;
+class PFBChannelizer;
 
 class SDRBASE_API DeviceSourceAPI : public QObject {
     Q_OBJECT
@@ -50,6 +51,9 @@ public:
     void removeThreadedSink(ThreadedBasebandSampleSink* sink);  //!< Remove a sample sink that runs on its own thread from device engine
     void addChannelAPI(ChannelSinkAPI* channelAPI);
     void removeChannelAPI(ChannelSinkAPI* channelAPI);
+    PFBChannelizer *enablePFBChannelizer(int nbChannels, bool oversampled); //!< Add a filter bank channelizer to device engine or return the existing one if it matches
+    void disablePFBChannelizer();         //!< Remove the filter bank channelizer from device engine. It must have no more subscribers.
+    PFBChannelizer *getPFBChannelizer() { return m_pfbChannelizer; } //!< Channels can subscribe to its outputs instead of running their own channelizer. Null if not enabled.
     void setSampleSource(DeviceSampleSource* source); //!< Set device sample source
     DeviceSampleSource *getSampleSource();      //!< Return pointer to the device sample source
     bool initAcquisition();               //!< Initialize device engine acquisition sequence
@@ -127,6 +131,7 @@ protected:
     const QTimer& m_masterTimer; //!< This is the DSPEngine master timer
 
     QList<ChannelSinkAPI*> m_channelAPIs;
+    PFBChannelizer *m_pfbChannelizer;
 
     friend class DeviceSinkAPI;
 
@@ -21,7 +21,8 @@
 BasebandSampleSource::BasebandSampleSource() :
     m_guiMessageQueue(0),
 	m_sampleFifo(48000), // arbitrary, will be adjusted to match device sink FIFO size
-	m_deviceSampleFifo(0)
+	m_deviceSampleFifo(0),
+	m_mixerGain(1.0f)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()));
 	connect(&m_sampleFifo, SIGNAL(dataWrite(int)), this, SLOT(handleWriteToFifo(int)));
@@ -56,15 +57,17 @@ void BasebandSampleSource::handleWriteToDeviceFifo(int nbSamples)
 
 void BasebandSampleSource::handleWriteToFifo(SampleSourceFifo *sampleFifo, int nbSamples)
 {
-    SampleVector::iterator writeAt;
-    sampleFifo->getWriteIterator(writeAt);
+    SampleVector::iterator part1Begin, part1End, part2Begin, part2End;
+    sampleFifo->getWriteIterators(nbSamples, part1Begin, part1End, part2Begin, part2End);
     pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
 
-    for (int i = 0; i < nbSamples; i++)
-    {
-        pull((*writeAt));
-        sampleFifo->bumpIndex(writeAt);
+    pullBlock(part1Begin, part1End - part1Begin);
+
+    if (part2Begin != part2End) { // block wraps around
+        pullBlock(part2Begin, part2End - part2Begin);
     }
+
+    sampleFifo->writeAdvance(nbSamples);
 }
 
 
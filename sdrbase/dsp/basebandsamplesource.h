@@ -37,18 +37,19 @@ public:
 	virtual void pull(Sample& sample) = 0;
 	virtual void pullAudio(int nbSamples __attribute__((unused))) {}
 
+	/** Pull a block of samples. Sources should override it to process the block in one go.
+	 *  Default is the compatibility fallback to the per sample pull() */
+	virtual void pullBlock(SampleVector::iterator begin, unsigned int count)
+	{
+	    for (unsigned int i = 0; i < count; i++, ++begin) {
+	        pull(*begin);
+	    }
+	}
+
     /** direct feeding of sample source FIFO */
 	void feed(SampleSourceFifo* sampleFifo, int nbSamples)
 	{
-	    SampleVector::iterator writeAt;
-	    sampleFifo->getWriteIterator(writeAt);
-	    pullAudio(nbSamples); // Pre-fetch input audio samples this is mandatory to keep things running smoothly
-
-	    for (int i = 0; i < nbSamples; i++)
-	    {
-	        pull((*writeAt));
-	        sampleFifo->bumpIndex(writeAt);
-	    }
+	    handleWriteToFifo(sampleFifo, nbSamples);
 	}
 
 	SampleSourceFifo& getSampleSourceFifo() { return m_sampleFifo; }
@@ -59,12 +60,16 @@ public:
     virtual void setMessageQueueToGUI(MessageQueue *queue) { m_guiMessageQueue = queue; }
     MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
     void setDeviceSampleSourceFifo(SampleSourceFifo *deviceSampleFifo);
+    /** Gain applied to the source when it is mixed with other sources of the device (not used with a single source). Set from the WebAPI channel settings mixerGain field */
+    void setMixerGain(float gain) { m_mixerGain = gain; }
+    float getMixerGain() const { return m_mixerGain; }
 
 protected:
 	MessageQueue m_inputMessageQueue;     //!< Queue for asynchronous inbound communication
     MessageQueue *m_guiMessageQueue;      //!< Input message queue to the GUI
 	SampleSourceFifo m_sampleFifo;        //!< Internal FIFO for multi-channel processing
 	SampleSourceFifo *m_deviceSampleFifo; //!< Reference to the device FIFO for single channel processing
+	float m_mixerGain;                    //!< Gain in the multiple channels mix
 
 	void handleWriteToFifo(SampleSourceFifo *sampleFifo, int nbSamples);
 
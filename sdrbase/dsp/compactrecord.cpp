@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <algorithm>
+#include <boost/crc.hpp>
+
+#include "compactrecord.h"
+
+namespace {
+
+/** LSB first bit stream writer to a buffer of fixed size */
+class BitWriter
+{
+public:
+    BitWriter(quint8 *data, std::size_t size) : m_begin(data), m_p(data), m_end(data + size), m_acc(0), m_nbits(0), m_overflow(false) {}
+
+    inline void put(quint32 value, int nbits) //!< nbits <= 32
+    {
+        m_acc |= ((quint64) value) << m_nbits;
+        m_nbits += nbits;
+
+        if (m_nbits >= 32)
+        {
+            if (m_p + 4 <= m_end)
+            {
+                m_p[0] = m_acc;
+                m_p[1] = m_acc >> 8;
+                m_p[2] = m_acc >> 16;
+                m_p[3] = m_acc >> 24;
+                m_p += 4;
+            }
+            else
+            {
+                m_overflow = true;
+            }
+
+            m_acc >>= 32;
+            m_nbits -= 32;
+        }
+    }
+
+    void flush()
+    {
+        for (; m_nbits > 0; m_nbits -= 8, m_acc >>= 8)
+        {
+            if (m_p < m_end) {
+                *m_p++ = m_acc;
+            } else {
+                m_overflow = true;
+            }
+        }
+
+        m_nbits = 0;
+    }
+
+    bool overflow() const { return m_overflow; }
+    std::size_t size() const { return m_p - m_begin; }
+
+private:
+    quint8 *m_begin;
+    quint8 *m_p;
+    quint8 *m_end;
+    quint64 m_acc;
+    int m_nbits;
+    bool m_overflow;
+};
+
+/** LSB first bit stream reader. Reads zeros past the end and keeps track of the bits consumed */
+class BitReader
+{
+public:
+    BitReader(const quint8 *data, quint32 size) : m_p(data), m_end(data + size), m_acc(0), m_nbits(0), m_consumed(0) {}
+
+    inline void refill() //!< at least 32 bits available after this
+    {
+        if (m_nbits < 32)
+        {
+            quint32 word = 0;
+
+            if (m_p + 4 <= m_end)
+            {
+                word = m_p[0] | (m_p[1] << 8) | (m_p[2] << 16) | (((quint32) m_p[3]) << 24);
+                m_p += 4;
+            }
+            else
+            {
+                for (int i = 0; m_p < m_end; i += 8) {
+                    word |= ((quint32) *m_p++) << i;
+                }
+            }
+
+            m_acc |= ((quint64) word) << m_nbits;
+            m_nbits += 32;
+        }
+    }
+
+    inline quint32 get(int nbits) //!< nbits <= 32
+    {
+        refill();
+        quint32 value = m_acc & ((1ULL << nbits) - 1);
+        m_acc >>= nbits;
+        m_nbits -= nbits;
+        m_consumed += nbits;
+        return value;
+    }
+
+    inline int countOnes(int limit) //!< number of consecutive 1 bits up to limit (<= 32), not consumed
+    {
+        refill();
+        quint64 inverted = ~m_acc;
+        int ones = inverted ? __builtin_ctzll(inverted) : 64;
+        return std::min(ones, limit);
+    }
+
+    inline void skip(int nbits)
+    {
+        m_acc >>= nbits;
+        m_nbits -= nbits;
+        m_consumed += nbits;
+    }
+
+    quint64 consumed() const { return m_consumed; }
+
+private:
+    const quint8 *m_p;
+    const quint8 *m_end;
+    quint64 m_acc;
+    int m_nbits;
+    quint64 m_consumed;
+};
+
+inline quint32 zigzag(qint32 v) {
+    return (((quint32) v) << 1) ^ (quint32) (v >> 31);
+}
+
+inline qint32 unzigzag(quint32 u) {
+    return (qint32) (u >> 1) ^ -((qint32) (u & 1));
+}
+
+inline qint32 signExtend(quint32 v, int nbits) {
+    return ((qint32) (v << (32 - nbits))) >> (32 - nbits);
+}
+
+/** Rice parameter minimizing the code length for the mean of the values */
+int riceParameter(quint64 sum, quint32 count, int maxK)
+{
+    int k = 0;
+
+    while ((k < maxK) && ((((quint64) count) << (k + 1)) <= sum)) {
+        k++;
+    }
+
+    return k;
+}
+
+} // namespace
+
+void CompactRecord::setHeaderCRC(Header& header)
+{
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, sizeof(Header) - sizeof(quint32));
+    header.crc32 = crc32.checksum();
+}
+
+bool CompactRecord::checkHeaderCRC(const Header& header)
+{
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, sizeof(Header) - sizeof(quint32));
+    return header.crc32 == crc32.checksum();
+}
+
+bool CompactRecord::readHeader(std::istream& stream, Header& header)
+{
+    stream.read((char *) &header, sizeof(Header));
+
+    if (stream.gcount() != sizeof(Header)) {
+        return false;
+    }
+
+    return (header.magic == m_headerMagic) && (header.version == m_version) && checkHeaderCRC(header);
+}
+
+void CompactRecord::encodeBlock(const Sample *samples, quint32 nbSamples, int sampleBits, bool compress, std::vector<quint8>& out)
+{
+    std::size_t headerPos = out.size();
+    BlockHeader blockHeader;
+    memset(&blockHeader, 0, sizeof(BlockHeader));
+    blockHeader.magic = m_blockMagic;
+    blockHeader.nbSamples = nbSamples;
+    blockHeader.codec = CodecPacked;
+
+    quint32 nbValues = 2 * nbSamples;
+    std::vector<qint32> values(nbValues);
+    int shift, bits;
+
+    if ((sampleBits > 0) && (sampleBits < SDR_RX_SAMP_SZ)) // rounded to the requested width
+    {
+        shift = SDR_RX_SAMP_SZ - sampleBits;
+        bits = sampleBits;
+        qint32 round = 1 << (shift - 1);
+        qint32 maxValue = (1 << (bits - 1)) - 1;
+        qint32 minValue = -(1 << (bits - 1));
+
+        for (quint32 i = 0; i < nbSamples; i++)
+        {
+            values[2*i]     = std::max(minValue, std::min(maxValue, (samples[i].m_real + round) >> shift));
+            values[2*i + 1] = std::max(minValue, std::min(maxValue, (samples[i].m_imag + round) >> shift));
+        }
+    }
+    else // effective width: drop the low bits that are zero in all samples and the unused high bits
+    {
+        quint32 orBits = 0;
+
+        for (quint32 i = 0; i < nbSamples; i++) {
+            orBits |= (quint32) samples[i].m_real | (quint32) samples[i].m_imag;
+        }
+
+        shift = orBits == 0 ? 0 : __builtin_ctz(orBits);
+        qint32 minValue = 0, maxValue = 0;
+
+        for (quint32 i = 0; i < nbSamples; i++)
+        {
+            values[2*i]     = samples[i].m_real >> shift;
+            values[2*i + 1] = samples[i].m_imag >> shift;
+            minValue = std::min(minValue, std::min(values[2*i], values[2*i + 1]));
+            maxValue = std::max(maxValue, std::max(values[2*i], values[2*i + 1]));
+        }
+
+        bits = 1;
+
+        while ((maxValue > (1 << (bits - 1)) - 1) || (minValue < -(1 << (bits - 1)))) {
+            bits++;
+        }
+    }
+
+    blockHeader.sampleBits = bits;
+    blockHeader.shift = shift;
+
+    std::size_t payloadPos = headerPos + sizeof(BlockHeader);
+    std::size_t packedSize = (((quint64) nbValues) * bits + 7) / 8;
+    out.resize(payloadPos + packedSize);
+    std::size_t payloadSize = 0;
+
+    if (compress && (nbSamples > 0))
+    {
+        // first order prediction on each channel and zigzag mapping of the residuals
+        std::vector<quint32> residuals(nbValues);
+        qint32 previous[2] = {0, 0};
+        quint64 sums[2] = {0, 0};
+
+        for (quint32 i = 0; i < nbValues; i++)
+        {
+            int c = i & 1;
+            residuals[i] = zigzag(values[i] - previous[c]);
+            previous[c] = values[i];
+            sums[c] += residuals[i];
+        }
+
+        int k[2];
+        k[0] = riceParameter(sums[0], nbSamples, bits);
+        k[1] = riceParameter(sums[1], nbSamples, bits);
+        BitWriter writer(&out[payloadPos], packedSize);
+
+        for (quint32 i = 0; (i < nbValues) && !writer.overflow(); i++)
+        {
+            int c = i & 1;
+            quint32 q = residuals[i] >> k[c];
+
+            if (q < (quint32) m_riceEscape)
+            {
+                writer.put((1U << q) - 1, q + 1); // unary quotient terminated by a 0
+                writer.put(residuals[i] & ((1U << k[c]) - 1), k[c]);
+            }
+            else
+            {
+                writer.put((1U << m_riceEscape) - 1, m_riceEscape);
+                writer.put(residuals[i], bits + 1);
+            }
+        }
+
+        writer.flush();
+
+        if (!writer.overflow() && (writer.size() < packedSize)) // else not worth it
+        {
+            blockHeader.codec = CodecDeltaRice;
+            blockHeader.riceI = k[0];
+            blockHeader.riceQ = k[1];
+            payloadSize = writer.size();
+        }
+    }
+
+    if (blockHeader.codec == CodecPacked)
+    {
+        quint32 mask = bits == 32 ? 0xFFFFFFFF : (1U << bits) - 1;
+        BitWriter writer(&out[payloadPos], packedSize);
+
+        for (quint32 i = 0; i < nbValues; i++) {
+            writer.put(((quint32) values[i]) & mask, bits);
+        }
+
+        writer.flush();
+        payloadSize = writer.size();
+    }
+
+    out.resize(payloadPos + payloadSize);
+    blockHeader.payloadSize = payloadSize;
+    memcpy(&out[headerPos], &blockHeader, sizeof(BlockHeader));
+}
+
+bool CompactRecord::decodeBlock(const BlockHeader& blockHeader, const quint8 *payload, Sample *samples, int scaleShift)
+{
+    int bits = blockHeader.sampleBits;
+
+    if ((blockHeader.magic != m_blockMagic) || (bits < 1) || (bits > 31)
+        || (blockHeader.riceI > bits) || (blockHeader.riceQ > bits)) {
+        return false;
+    }
+
+    int shift = blockHeader.shift + scaleShift;
+    quint32 nbValues = 2 * blockHeader.nbSamples;
+    FixReal *out = &samples[0].m_real;
+    BitReader reader(payload, blockHeader.payloadSize);
+
+    if (blockHeader.codec == CodecPacked)
+    {
+        for (quint32 i = 0; i < nbValues; i++)
+        {
+            qint32 v = signExtend(reader.get(bits), bits);
+            out[i] = shift >= 0 ? v << shift : v >> -shift;
+        }
+    }
+    else if (blockHeader.codec == CodecDeltaRice)
+    {
+        int k[2] = {blockHeader.riceI, blockHeader.riceQ};
+        qint32 previous[2] = {0, 0};
+
+        for (quint32 i = 0; i < nbValues; i++)
+        {
+            int c = i & 1;
+            int q = reader.countOnes(m_riceEscape);
+            quint32 u;
+
+            if (q < m_riceEscape)
+            {
+                reader.skip(q + 1);
+                u = (((quint32) q) << k[c]) | reader.get(k[c]);
+            }
+            else
+            {
+                reader.skip(m_riceEscape);
+                u = reader.get(bits + 1);
+            }
+
+            previous[c] += unzigzag(u);
+            out[i] = shift >= 0 ? previous[c] << shift : previous[c] >> -shift;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    return reader.consumed() <= 8ULL * blockHeader.payloadSize;
+}
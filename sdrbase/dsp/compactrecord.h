@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_COMPACTRECORD_H_
+#define SDRBASE_DSP_COMPACTRECORD_H_
+
+#include <vector>
+#include <iostream>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Compact I/Q recording format (.sdriqc). Samples are cut in blocks of a fixed number of
+ * samples (except the last one) and each block is stored with the smallest bit width that
+ * holds its values. Optionally the block is compressed losslessly with a first order
+ * prediction (delta) followed by Rice coding of the residuals. The codec is decided block
+ * by block and falls back to plain bit packing when compression does not pay off.
+ *
+ * File layout (little endian):
+ *   Header
+ *   Block 0: BlockHeader + payload
+ *   ...
+ *   Block N-1
+ *   Index: N x quint64 offsets of the blocks from the start of the file
+ *   Trailer
+ *
+ * The index and trailer are written when the recording is stopped. If they are missing
+ * (interrupted recording) the reader rebuilds the index by walking the block headers.
+ */
+class SDRBASE_API CompactRecord
+{
+public:
+    enum Codec
+    {
+        CodecPacked,   //!< bit packed two's complement
+        CodecDeltaRice //!< delta + Rice coded zigzag residuals
+    };
+
+#pragma pack(push, 1)
+    struct Header
+    {
+        quint32 magic;           //!< m_headerMagic
+        quint32 version;
+        quint32 sampleRate;
+        quint64 centerFrequency;
+        quint64 startTimeStamp;
+        quint32 sampleSize;      //!< 16 or 24: scale of the recorded samples
+        quint32 blockSamples;    //!< number of samples in all blocks but the last
+        quint32 crc32;           //!< CRC32 of the previous 36 bytes
+    };
+
+    struct BlockHeader
+    {
+        quint32 magic;           //!< m_blockMagic
+        quint32 nbSamples;
+        quint32 payloadSize;     //!< bytes following the block header
+        quint8 codec;
+        quint8 sampleBits;       //!< width of the stored values
+        quint8 shift;            //!< stored values are shifted right by this number of bits
+        quint8 riceI;            //!< Rice parameter of the I channel
+        quint8 riceQ;            //!< Rice parameter of the Q channel
+        quint8 filler[3];
+    };
+
+    struct Trailer
+    {
+        quint32 magic;           //!< m_trailerMagic
+        quint32 nbBlocks;
+        quint64 nbSamples;
+        quint64 indexOffset;
+    };
+#pragma pack(pop)
+
+    static const quint32 m_headerMagic = 0x43524453;  //!< "SDRC"
+    static const quint32 m_blockMagic = 0x42524453;   //!< "SDRB"
+    static const quint32 m_trailerMagic = 0x58524453; //!< "SDRX"
+    static const quint32 m_version = 1;
+    static const quint32 m_defaultBlockSamples = 32768;
+
+    static void setHeaderCRC(Header& header);
+    static bool checkHeaderCRC(const Header& header);
+    static bool readHeader(std::istream& stream, Header& header); //!< returns false if this is not a valid compact header
+
+    /**
+     * Encode a block. The block header followed by the payload is appended to out.
+     * sampleBits 0 stores the samples losslessly with their effective width. A non zero value
+     * rounds the samples to this number of bits (lossy if the samples have more resolution).
+     */
+    static void encodeBlock(const Sample *samples, quint32 nbSamples, int sampleBits, bool compress, std::vector<quint8>& out);
+    /**
+     * Decode the payload of a block. scaleShift is the left shift from the recorded sample
+     * size to the sample size of the reader (negative to shift right).
+     */
+    static bool decodeBlock(const BlockHeader& blockHeader, const quint8 *payload, Sample *samples, int scaleShift);
+
+private:
+    static const int m_riceEscape = 24; //!< quotient from which the value is stored verbatim
+};
+
+#endif /* SDRBASE_DSP_COMPACTRECORD_H_ */
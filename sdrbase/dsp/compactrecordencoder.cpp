@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <QThread>
+#include <QDebug>
+
+#include "dsp/filerecordwriter.h"
+#include "compactrecordencoder.h"
+
+void CompactRecordEncoder::EncodeTask::run()
+{
+    CompactRecord::encodeBlock(m_samples.data(), m_nbSamples, m_encoder->m_sampleBits, m_encoder->m_compress, m_data);
+    std::vector<Sample>().swap(m_samples);
+    m_encoder->blockEncoded(this);
+}
+
+CompactRecordEncoder::CompactRecordEncoder(FileRecordWriter& writer) :
+    m_writer(writer),
+    m_nextSequence(0),
+    m_writeSequence(0),
+    m_inFlight(0),
+    m_sampleBits(0),
+    m_compress(true),
+    m_offset(0),
+    m_nbSamples(0),
+    m_droppedBlocks(0),
+    m_inputBytes(0),
+    m_outputBytes(0)
+{
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1)); // leave one core to the DSP
+    m_maxInFlight = 2 * m_pool.maxThreadCount() + 2;
+}
+
+CompactRecordEncoder::~CompactRecordEncoder()
+{
+    m_pool.waitForDone();
+}
+
+void CompactRecordEncoder::setOptions(int sampleBits, bool compress)
+{
+    m_sampleBits = sampleBits;
+    m_compress = compress;
+}
+
+void CompactRecordEncoder::begin(quint32 sampleRate, quint64 centerFrequency, quint64 startTimeStamp)
+{
+    CompactRecord::Header header;
+    header.magic = CompactRecord::m_headerMagic;
+    header.version = CompactRecord::m_version;
+    header.sampleRate = sampleRate;
+    header.centerFrequency = centerFrequency;
+    header.startTimeStamp = startTimeStamp;
+    header.sampleSize = SDR_RX_SAMP_SZ;
+    header.blockSamples = CompactRecord::m_defaultBlockSamples;
+    CompactRecord::setHeaderCRC(header);
+
+    m_block.clear();
+    m_block.reserve(CompactRecord::m_defaultBlockSamples);
+    m_nextSequence = 0;
+    m_writeSequence = 0;
+    m_index.clear();
+    m_nbSamples = 0;
+    m_droppedBlocks = 0;
+    m_inputBytes = 0;
+    m_outputBytes = sizeof(CompactRecord::Header);
+    m_offset = sizeof(CompactRecord::Header);
+
+    m_writer.write((const char *) &header, sizeof(CompactRecord::Header));
+}
+
+void CompactRecordEncoder::feed(const Sample *samples, quint32 nbSamples)
+{
+    m_inputBytes += nbSamples * sizeof(Sample);
+
+    while (nbSamples > 0)
+    {
+        quint32 len = std::min(nbSamples, (quint32) (CompactRecord::m_defaultBlockSamples - m_block.size()));
+        m_block.insert(m_block.end(), samples, samples + len);
+        samples += len;
+        nbSamples -= len;
+
+        if (m_block.size() == CompactRecord::m_defaultBlockSamples) {
+            submitBlock();
+        }
+    }
+}
+
+void CompactRecordEncoder::end()
+{
+    if (m_block.size() > 0) {
+        submitBlock();
+    }
+
+    m_pool.waitForDone();
+
+    CompactRecord::Trailer trailer;
+    trailer.magic = CompactRecord::m_trailerMagic;
+    trailer.nbBlocks = m_index.size();
+    trailer.nbSamples = m_nbSamples;
+    trailer.indexOffset = m_offset;
+    m_writer.write((const char *) m_index.data(), m_index.size() * sizeof(quint64));
+    m_writer.write((const char *) &trailer, sizeof(CompactRecord::Trailer));
+    m_outputBytes += m_index.size() * sizeof(quint64) + sizeof(CompactRecord::Trailer);
+
+    qDebug("CompactRecordEncoder::end: %llu samples in %u blocks (%llu dropped) ratio: %.2f",
+        m_nbSamples, (unsigned int) m_index.size(), m_droppedBlocks,
+        m_outputBytes == 0 ? 0.0 : (double) m_inputBytes / m_outputBytes);
+}
+
+void CompactRecordEncoder::submitBlock()
+{
+    if (m_inFlight.fetchAndAddOrdered(1) >= m_maxInFlight) // encoders are late: drop rather than wait
+    {
+        m_inFlight.fetchAndAddOrdered(-1);
+        m_droppedBlocks++;
+        m_block.clear();
+        return;
+    }
+
+    EncodeTask *task = new EncodeTask(this, m_nextSequence++);
+    task->m_nbSamples = m_block.size();
+    task->m_samples.swap(m_block);
+    m_block.reserve(CompactRecord::m_defaultBlockSamples);
+    m_pool.start(task);
+}
+
+// Called from the pool threads. Blocks are written in sequence order by whichever thread
+// completes the next expected block.
+void CompactRecordEncoder::blockEncoded(EncodeTask *task)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_encoded[task->m_sequence] = task;
+    std::map<quint64, EncodeTask*>::iterator it;
+
+    while ((it = m_encoded.find(m_writeSequence)) != m_encoded.end())
+    {
+        EncodeTask *next = it->second;
+        m_writer.write((const char *) next->m_data.data(), next->m_data.size());
+        m_index.push_back(m_offset);
+        m_offset += next->m_data.size();
+        m_outputBytes += next->m_data.size();
+        m_nbSamples += next->m_nbSamples;
+        m_encoded.erase(it);
+        delete next;
+        m_writeSequence++;
+        m_inFlight.fetchAndAddOrdered(-1);
+    }
+}
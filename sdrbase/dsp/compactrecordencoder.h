@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_COMPACTRECORDENCODER_H_
+#define SDRBASE_DSP_COMPACTRECORDENCODER_H_
+
+#include <QMutex>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QThreadPool>
+#include <vector>
+#include <map>
+
+#include "dsp/compactrecord.h"
+#include "export.h"
+
+class FileRecordWriter;
+
+/**
+ * Produces a compact recording (see CompactRecord) from the sample stream. Blocks are
+ * encoded in parallel by a private thread pool and passed in order to the FileRecordWriter.
+ * feed() never blocks: if the encoders cannot keep up the block is dropped and counted.
+ */
+class SDRBASE_API CompactRecordEncoder
+{
+public:
+    CompactRecordEncoder(FileRecordWriter& writer);
+    ~CompactRecordEncoder();
+
+    void setOptions(int sampleBits, bool compress); //!< see CompactRecord::encodeBlock. Applies to the next recording
+    void begin(quint32 sampleRate, quint64 centerFrequency, quint64 startTimeStamp); //!< writes the header
+    void feed(const Sample *samples, quint32 nbSamples);
+    void end(); //!< encodes the last partial block and writes the index and the trailer
+
+    quint64 getDroppedBlocks() const { return m_droppedBlocks; }
+    quint64 getInputBytes() const { return m_inputBytes; }
+    quint64 getOutputBytes() const { return m_outputBytes; }
+
+private:
+    class EncodeTask : public QRunnable
+    {
+    public:
+        EncodeTask(CompactRecordEncoder *encoder, quint64 sequence) :
+            m_encoder(encoder),
+            m_sequence(sequence),
+            m_nbSamples(0)
+        {
+            setAutoDelete(false);
+        }
+
+        virtual void run();
+
+        CompactRecordEncoder *m_encoder;
+        quint64 m_sequence;
+        quint32 m_nbSamples;
+        std::vector<Sample> m_samples;
+        std::vector<quint8> m_data;
+    };
+
+    FileRecordWriter& m_writer;
+    QThreadPool m_pool;
+    QMutex m_mutex;
+    std::map<quint64, EncodeTask*> m_encoded; //!< encoded blocks waiting for their turn to be written
+    std::vector<Sample> m_block;              //!< block being filled
+    quint64 m_nextSequence;                   //!< sequence number of the next block submitted
+    quint64 m_writeSequence;                  //!< sequence number of the next block to write
+    QAtomicInt m_inFlight;
+    int m_maxInFlight;
+    int m_sampleBits;
+    bool m_compress;
+    std::vector<quint64> m_index;
+    quint64 m_offset;
+    quint64 m_nbSamples;
+    quint64 m_droppedBlocks;
+    quint64 m_inputBytes;
+    quint64 m_outputBytes;
+
+    void submitBlock();
+    void blockEncoded(EncodeTask *task);
+};
+
+#endif /* SDRBASE_DSP_COMPACTRECORDENCODER_H_ */
@@ -0,0 +1,216 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <QDebug>
+
+#include "compactrecordreader.h"
+
+CompactRecordReader::CompactRecordReader() :
+    m_stream(0),
+    m_nbSamples(0),
+    m_scaleShift(0),
+    m_blockIndex(0),
+    m_blockPos(0)
+{
+}
+
+bool CompactRecordReader::open(std::istream *stream)
+{
+    close();
+
+    stream->clear();
+    stream->seekg(0, std::ios::end);
+    quint64 fileSize = stream->tellg();
+    stream->seekg(0, std::ios::beg);
+
+    if (!CompactRecord::readHeader(*stream, m_header)) {
+        return false;
+    }
+
+    m_stream = stream;
+    m_scaleShift = SDR_RX_SAMP_SZ - (int) m_header.sampleSize;
+
+    if (!readIndex(fileSize))
+    {
+        qWarning("CompactRecordReader::open: no index (interrupted recording?): scanning blocks");
+        scanBlocks(fileSize);
+    }
+
+    qDebug("CompactRecordReader::open: %u blocks %llu samples", (unsigned int) m_index.size(), m_nbSamples);
+    seek(0);
+    return true;
+}
+
+void CompactRecordReader::close()
+{
+    m_stream = 0;
+    m_index.clear();
+    m_blockStart.clear();
+    m_block.clear();
+    m_nbSamples = 0;
+    m_blockIndex = 0;
+    m_blockPos = 0;
+}
+
+bool CompactRecordReader::readIndex(quint64 fileSize)
+{
+    CompactRecord::Trailer trailer;
+
+    if (fileSize < sizeof(CompactRecord::Header) + sizeof(CompactRecord::Trailer)) {
+        return false;
+    }
+
+    m_stream->clear();
+    m_stream->seekg(fileSize - sizeof(CompactRecord::Trailer), std::ios::beg);
+    m_stream->read((char *) &trailer, sizeof(CompactRecord::Trailer));
+
+    if ((m_stream->gcount() != sizeof(CompactRecord::Trailer))
+     || (trailer.magic != CompactRecord::m_trailerMagic)
+     || (trailer.indexOffset + trailer.nbBlocks * sizeof(quint64) + sizeof(CompactRecord::Trailer) != fileSize)) {
+        return false;
+    }
+
+    m_index.resize(trailer.nbBlocks);
+    m_blockStart.resize(trailer.nbBlocks);
+    m_stream->seekg(trailer.indexOffset, std::ios::beg);
+    m_stream->read((char *) m_index.data(), trailer.nbBlocks * sizeof(quint64));
+
+    if (m_stream->gcount() != (std::streamsize) (trailer.nbBlocks * sizeof(quint64)))
+    {
+        m_index.clear();
+        m_blockStart.clear();
+        return false;
+    }
+
+    for (quint32 i = 0; i < trailer.nbBlocks; i++) { // only the last block may be shorter
+        m_blockStart[i] = ((quint64) i) * m_header.blockSamples;
+    }
+
+    m_nbSamples = trailer.nbSamples;
+    return true;
+}
+
+void CompactRecordReader::scanBlocks(quint64 fileSize)
+{
+    CompactRecord::BlockHeader blockHeader;
+    quint64 offset = sizeof(CompactRecord::Header);
+    m_index.clear();
+    m_blockStart.clear();
+    m_nbSamples = 0;
+
+    while (offset + sizeof(CompactRecord::BlockHeader) <= fileSize)
+    {
+        m_stream->clear();
+        m_stream->seekg(offset, std::ios::beg);
+        m_stream->read((char *) &blockHeader, sizeof(CompactRecord::BlockHeader));
+
+        if ((m_stream->gcount() != sizeof(CompactRecord::BlockHeader))
+         || (blockHeader.magic != CompactRecord::m_blockMagic)
+         || (offset + sizeof(CompactRecord::BlockHeader) + blockHeader.payloadSize > fileSize)) {
+            break; // end of the valid data
+        }
+
+        m_index.push_back(offset);
+        m_blockStart.push_back(m_nbSamples);
+        m_nbSamples += blockHeader.nbSamples;
+        offset += sizeof(CompactRecord::BlockHeader) + blockHeader.payloadSize;
+    }
+}
+
+bool CompactRecordReader::seek(quint64 sampleIndex)
+{
+    if (!m_stream) {
+        return false;
+    }
+
+    m_block.clear();
+    m_blockPos = 0;
+
+    if (sampleIndex >= m_nbSamples)
+    {
+        m_blockIndex = m_index.size();
+        return sampleIndex == m_nbSamples;
+    }
+
+    m_blockIndex = (std::upper_bound(m_blockStart.begin(), m_blockStart.end(), sampleIndex) - m_blockStart.begin()) - 1;
+    quint64 blockStart = m_blockStart[m_blockIndex];
+
+    if (!decodeNextBlock()) {
+        return false;
+    }
+
+    m_blockPos = sampleIndex - blockStart;
+    return true;
+}
+
+quint64 CompactRecordReader::read(Sample *samples, quint64 nbSamples)
+{
+    quint64 done = 0;
+
+    while (done < nbSamples)
+    {
+        if ((m_blockPos >= m_block.size()) && !decodeNextBlock()) {
+            break;
+        }
+
+        quint64 len = std::min(nbSamples - done, (quint64) (m_block.size() - m_blockPos));
+        std::copy(m_block.begin() + m_blockPos, m_block.begin() + m_blockPos + len, samples + done);
+        m_blockPos += len;
+        done += len;
+    }
+
+    return done;
+}
+
+bool CompactRecordReader::decodeNextBlock()
+{
+    CompactRecord::BlockHeader blockHeader;
+    m_block.clear();
+    m_blockPos = 0;
+
+    if (!m_stream || (m_blockIndex >= m_index.size())) {
+        return false;
+    }
+
+    m_stream->clear();
+    m_stream->seekg(m_index[m_blockIndex], std::ios::beg);
+    m_stream->read((char *) &blockHeader, sizeof(CompactRecord::BlockHeader));
+
+    if ((blockHeader.magic != CompactRecord::m_blockMagic) || (blockHeader.nbSamples > m_header.blockSamples)
+     || (blockHeader.payloadSize > 8 * blockHeader.nbSamples + 8))
+    {
+        qWarning("CompactRecordReader::decodeNextBlock: bad block header %u", m_blockIndex);
+        m_blockIndex = m_index.size();
+        return false;
+    }
+
+    m_payload.resize(blockHeader.payloadSize);
+    m_stream->read((char *) m_payload.data(), blockHeader.payloadSize);
+    m_block.resize(blockHeader.nbSamples);
+
+    if (!m_stream->good() || !CompactRecord::decodeBlock(blockHeader, m_payload.data(), m_block.data(), m_scaleShift))
+    {
+        qWarning("CompactRecordReader::decodeNextBlock: corrupted block %u", m_blockIndex);
+        m_blockIndex = m_index.size();
+        m_block.clear();
+        return false;
+    }
+
+    m_blockIndex++;
+    return true;
+}
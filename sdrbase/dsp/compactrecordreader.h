@@ -0,0 +1,63 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_COMPACTRECORDREADER_H_
+#define SDRBASE_DSP_COMPACTRECORDREADER_H_
+
+#include <vector>
+#include <iostream>
+
+#include "dsp/compactrecord.h"
+#include "export.h"
+
+/**
+ * Sequential and random access reading of a compact recording (see CompactRecord) from a
+ * stream opened by the caller. Samples are returned at the sample size of this build.
+ */
+class SDRBASE_API CompactRecordReader
+{
+public:
+    CompactRecordReader();
+
+    /** Read the header and the block index. Returns false if the stream is not a valid compact recording */
+    bool open(std::istream *stream);
+    void close();
+    bool isOpen() const { return m_stream != 0; }
+    const CompactRecord::Header& getHeader() const { return m_header; }
+    quint64 getNbSamples() const { return m_nbSamples; }
+
+    bool seek(quint64 sampleIndex);                 //!< random access through the block index
+    quint64 read(Sample *samples, quint64 nbSamples); //!< returns the number of samples read. Less than requested at the end
+
+private:
+    std::istream *m_stream;
+    CompactRecord::Header m_header;
+    std::vector<quint64> m_index;      //!< offset of each block
+    std::vector<quint64> m_blockStart; //!< first sample of each block
+    quint64 m_nbSamples;
+    int m_scaleShift;
+    std::vector<quint8> m_payload;
+    std::vector<Sample> m_block;       //!< current decoded block
+    quint32 m_blockIndex;              //!< index of the next block to decode
+    quint32 m_blockPos;                //!< read position in m_block
+
+    bool readIndex(quint64 fileSize);
+    void scanBlocks(quint64 fileSize);
+    bool decodeNextBlock();
+};
+
+#endif /* SDRBASE_DSP_COMPACTRECORDREADER_H_ */
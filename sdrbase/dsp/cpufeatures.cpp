@@ -0,0 +1,105 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#include <QDebug>
+
+#include "cpufeatures.h"
+
+QAtomicInt CPUFeatures::m_maxLevel(CPUFeatures::SIMDAVX2);
+
+CPUFeatures::SIMDLevel CPUFeatures::detect()
+{
+    SIMDLevel level = SIMDNone;
+
+#if defined(NO_DSP_SIMD)
+    // SIMD explicitly disabled at build time
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse4.1")) {
+        level = SIMDSSE41;
+    }
+    if (__builtin_cpu_supports("avx2")) { // also checks that the OS saves the YMM registers
+        level = SIMDAVX2;
+    }
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int regs[4];
+    __cpuid(regs, 0);
+    int nbIds = regs[0];
+
+    if (nbIds >= 1)
+    {
+        __cpuid(regs, 1);
+        bool sse41 = (regs[2] & (1<<19)) != 0;
+        bool osxsave = (regs[2] & (1<<27)) != 0;
+        bool avx = (regs[2] & (1<<28)) != 0;
+
+        if (sse41) {
+            level = SIMDSSE41;
+        }
+
+        if (sse41 && osxsave && avx && (nbIds >= 7) && ((_xgetbv(0) & 6) == 6))
+        {
+            __cpuidex(regs, 7, 0);
+
+            if (regs[1] & (1<<5)) {
+                level = SIMDAVX2;
+            }
+        }
+    }
+#endif
+
+    qDebug("CPUFeatures::detect: %s", getSIMDLevelName(level));
+    return level;
+}
+
+CPUFeatures::SIMDLevel CPUFeatures::getDetectedSIMDLevel()
+{
+    static const SIMDLevel detected = detect(); // thread safe one time initialization
+    return detected;
+}
+
+CPUFeatures::SIMDLevel CPUFeatures::getSIMDLevel()
+{
+    SIMDLevel detected = getDetectedSIMDLevel();
+    SIMDLevel max = (SIMDLevel) m_maxLevel.load();
+    return detected < max ? detected : max;
+}
+
+void CPUFeatures::setMaxSIMDLevel(SIMDLevel level)
+{
+    m_maxLevel.store((int) level);
+}
+
+const char *CPUFeatures::getSIMDLevelName(SIMDLevel level)
+{
+    switch (level)
+    {
+    case SIMDSSE41:
+        return "SSE4.1";
+    case SIMDAVX2:
+        return "AVX2";
+    case SIMDNone:
+    default:
+        return "none";
+    }
+}
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_CPUFEATURES_H_
+#define SDRBASE_DSP_CPUFEATURES_H_
+
+#include <QAtomicInt>
+
+#include "export.h"
+
+/**
+ * SIMD instruction sets of the processor the program runs on. DSP code built for a baseline
+ * target uses this to pick its SSE4.1 or AVX2 kernels at run time. Detection is done once.
+ * The level used can be capped to compare the SIMD kernels with the plain code (sdrbench).
+ * With NO_DSP_SIMD defined nothing is detected.
+ */
+class SDRBASE_API CPUFeatures
+{
+public:
+    enum SIMDLevel
+    {
+        SIMDNone,  //!< plain C++ code
+        SIMDSSE41, //!< SSE up to 4.1
+        SIMDAVX2   //!< AVX2 (implies SSE4.1)
+    };
+
+    static bool hasSSE41() { return getDetectedSIMDLevel() >= SIMDSSE41; }
+    static bool hasAVX2() { return getDetectedSIMDLevel() >= SIMDAVX2; }
+    static SIMDLevel getDetectedSIMDLevel();
+    /** Level to be used by the DSP kernels: the detected level capped by the maximum level set */
+    static SIMDLevel getSIMDLevel();
+    static void setMaxSIMDLevel(SIMDLevel level);
+    static SIMDLevel getMaxSIMDLevel() { return (SIMDLevel) m_maxLevel.load(); }
+    static const char *getSIMDLevelName(SIMDLevel level);
+
+private:
+    static SIMDLevel detect();
+    static QAtomicInt m_maxLevel;
+};
+
+#endif /* SDRBASE_DSP_CPUFEATURES_H_ */
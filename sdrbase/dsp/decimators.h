@@ -17,8 +17,11 @@
 #ifndef INCLUDE_GPL_DSP_DECIMATORS_H_
 #define INCLUDE_GPL_DSP_DECIMATORS_H_
 
+#include <algorithm>
+
 #include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfiltereo.h"
+#include "dsp/decimatorsblock.h"
 
 #define DECIMATORS_HB_FILTER_ORDER 64
 
@@ -38,6 +41,10 @@ struct decimation_shifts
     static const uint post32 = 0;
     static const uint pre64  = 0;
     static const uint post64 = 0;
+    static const uint pre128  = 0;
+    static const uint post128 = 0;
+    static const uint pre256  = 0;
+    static const uint post256 = 0;
 };
 
 template<>
@@ -56,6 +63,10 @@ struct decimation_shifts<16, 24>
     static const uint post32 = 13;
     static const uint pre64  = 0;
     static const uint post64 = 14;
+    static const uint pre128  = 0;
+    static const uint post128 = 15;
+    static const uint pre256  = 0;
+    static const uint post256 = 16;
 };
 
 template<>
@@ -74,6 +85,10 @@ struct decimation_shifts<24, 24>
     static const uint post32 = 5;
     static const uint pre64  = 0;
     static const uint post64 = 6;
+    static const uint pre128  = 0;
+    static const uint post128 = 7;
+    static const uint pre256  = 0;
+    static const uint post256 = 8;
 };
 
 template<>
@@ -92,6 +107,10 @@ struct decimation_shifts<16, 16>
     static const uint post32 = 5;
     static const uint pre64  = 0;
     static const uint post64 = 6;
+    static const uint pre128  = 0;
+    static const uint post128 = 7;
+    static const uint pre256  = 0;
+    static const uint post256 = 8;
 };
 
 template<>
@@ -110,6 +129,10 @@ struct decimation_shifts<24, 16>
     static const uint post32 = 0;
     static const uint pre64  = 2;
     static const uint post64 = 0;
+    static const uint pre128  = 1;
+    static const uint post128 = 0;
+    static const uint pre256  = 0;
+    static const uint post256 = 0;
 };
 
 template<>
@@ -128,6 +151,10 @@ struct decimation_shifts<16, 12>
     static const uint post32 = 1;
     static const uint pre64  = 0;
     static const uint post64 = 2;
+    static const uint pre128  = 0;
+    static const uint post128 = 3;
+    static const uint pre256  = 0;
+    static const uint post256 = 4;
 };
 
 template<>
@@ -146,6 +173,10 @@ struct decimation_shifts<24, 12>
     static const uint post32 = 0;
     static const uint pre64  = 6;
     static const uint post64 = 0;
+    static const uint pre128  = 5;
+    static const uint post128 = 0;
+    static const uint pre256  = 4;
+    static const uint post256 = 0;
 };
 
 template<>
@@ -164,6 +195,10 @@ struct decimation_shifts<16, 8>
     static const uint post32 = 0;
     static const uint pre64  = 2;
     static const uint post64 = 0;
+    static const uint pre128  = 1;
+    static const uint post128 = 0;
+    static const uint pre256  = 0;
+    static const uint post256 = 0;
 };
 
 template<>
@@ -182,6 +217,10 @@ struct decimation_shifts<24, 8>
     static const uint post32 = 0;
     static const uint pre64  = 10;
     static const uint post64 = 0;
+    static const uint pre128  = 9;
+    static const uint post128 = 0;
+    static const uint pre256  = 8;
+    static const uint post256 = 0;
 };
 
 template<typename T>
@@ -300,6 +339,12 @@ public:
 	void decimate64_inf(SampleVector::iterator* it, const T* buf, qint32 len);
 	void decimate64_sup(SampleVector::iterator* it, const T* buf, qint32 len);
 	void decimate64_cen(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate128_inf(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate128_sup(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate128_cen(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate256_inf(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate256_sup(SampleVector::iterator* it, const T* buf, qint32 len);
+    void decimate256_cen(SampleVector::iterator* it, const T* buf, qint32 len);
 	// separate I and Q input buffers
     void decimate1(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
     void decimate2_u(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
@@ -321,6 +366,8 @@ public:
     void decimate64_inf(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
     void decimate64_sup(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
     void decimate64_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
+    void decimate128_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
+    void decimate256_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len);
 
 private:
 #ifdef SDR_RX_SAMPLE_24BIT
@@ -330,6 +377,8 @@ private:
     IntHalfbandFilterEO<qint64, qint64, DECIMATORS_HB_FILTER_ORDER> m_decimator16; // 4th stages
     IntHalfbandFilterEO<qint64, qint64, DECIMATORS_HB_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEO<qint64, qint64, DECIMATORS_HB_FILTER_ORDER> m_decimator64; // 6th stages
+    IntHalfbandFilterEO<qint64, qint64, DECIMATORS_HB_FILTER_ORDER> m_decimator128; // 7th stages
+    IntHalfbandFilterEO<qint64, qint64, DECIMATORS_HB_FILTER_ORDER> m_decimator256; // 8th stages
 #else
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator2;  // 1st stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator4;  // 2nd stages
@@ -337,7 +386,37 @@ private:
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator16; // 4th stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator64; // 6th stages
+    IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator128; // 7th stages
+    IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator256; // 8th stages
 #endif
+    DecimatorsBlock m_block; // SIMD block cascades
+
+    /**
+     * Run the cascade with the block code if enabled (16 bit builds only as 24 bit builds use
+     * 64 bit accumulators). The whole frames of frameSize I/Q values are processed like the
+     * sample by sample loop does. Returns false if the caller has to use the sample by sample code.
+     */
+    bool decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 frameSize, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post);
+    bool decimateBlock(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len, qint32 frameSize, unsigned int log2, uint pre, uint post);
+    /** Sample by sample cascades looping over the stages for decimation by 128 and 256 */
+    void decimateDeep(SampleVector::iterator* it, const T* buf, qint32 len, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post);
+    void decimateDeep(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len, unsigned int log2, uint pre, uint post);
+    StorageType *decimateDeepStages(StorageType *buf, StorageType *work, int nbValues, unsigned int log2, DecimatorsBlock::Mode mode);
+
+    template<typename HBFilter>
+    static void decimateStage(HBFilter& filter, DecimatorsBlock::Mode mode, StorageType *in, StorageType *out, int nbValues)
+    {
+        for (int i = 0; i < nbValues; i += 8)
+        {
+            if (mode == DecimatorsBlock::ModeInf) {
+                filter.myDecimateInf(&in[i], &out[i/2]);
+            } else if (mode == DecimatorsBlock::ModeSup) {
+                filter.myDecimateSup(&in[i], &out[i/2]);
+            } else {
+                filter.myDecimateCen(&in[i], &out[i/2]);
+            }
+        }
+    }
 };
 
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
@@ -462,6 +541,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_u(SampleVector::i
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -490,6 +573,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_inf(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -540,6 +627,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -590,6 +681,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_inf(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -682,6 +777,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 3, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
     StorageType buf2[16], buf4[8], buf8[4];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -755,6 +854,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_inf(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 3, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
     StorageType buf2[16], buf4[8], buf8[4];
 
     for (int pos = 0; pos < len - 31; pos += 32)
@@ -828,6 +931,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_sup(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 4, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -961,6 +1068,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 4, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -1094,6 +1205,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_sup(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 5, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1347,6 +1462,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 5, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1600,6 +1719,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_sup(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 256, 6, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -2093,6 +2216,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_inf(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 256, 6, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -2609,6 +2736,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_sup(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -2637,6 +2768,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 2, 1, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType intbuf[2];
 
     for (int pos = 0; pos < len - 1; pos += 2)
@@ -2659,6 +2794,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate2_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
 	StorageType buf2[8], buf4[4];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -2702,6 +2841,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 4, 2, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType intbuf[4];
 
     for (int pos = 0; pos < len - 3; pos += 4)
@@ -2737,6 +2880,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate4_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 3, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
 	StorageType intbuf[8];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -2797,6 +2944,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 8, 3, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
     StorageType intbuf[8];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -2857,6 +3008,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate8_cen(SampleVector:
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 4, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
 	StorageType intbuf[16];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -2966,6 +3121,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 16, 4, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
     StorageType intbuf[16];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -3075,6 +3234,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate16_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 5, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
 	StorageType intbuf[32];
 
 	for (int pos = 0; pos < len - 63; pos += 64)
@@ -3281,6 +3444,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 32, 5, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
     StorageType intbuf[32];
 
     for (int pos = 0; pos < len - 31; pos += 32)
@@ -3487,6 +3654,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate32_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 6, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
 	StorageType intbuf[64];
 
 	for (int pos = 0; pos < len - 127; pos += 128)
@@ -3887,6 +4058,10 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_cen(SampleVector
 template<typename StorageType, typename T, uint SdrBits, uint InputBits>
 void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
 {
+    if (decimateBlock(it, bufI, bufQ, len, 64, 6, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
     StorageType intbuf[64];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -4284,4 +4459,216 @@ void Decimators<StorageType, T, SdrBits, InputBits>::decimate64_cen(SampleVector
     }
 }
 
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate128_inf(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 512, 7, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128)) {
+        decimateDeep(it, buf, len, 7, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate128_sup(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 512, 7, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128)) {
+        decimateDeep(it, buf, len, 7, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate128_cen(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 512, 7, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128)) {
+        decimateDeep(it, buf, len, 7, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate128_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
+{
+    if (!decimateBlock(it, bufI, bufQ, len, 256, 7, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128)) {
+        decimateDeep(it, bufI, bufQ, len, 7, decimation_shifts<SdrBits, InputBits>::pre128, decimation_shifts<SdrBits, InputBits>::post128);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate256_inf(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 1024, 8, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256)) {
+        decimateDeep(it, buf, len, 8, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate256_sup(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 1024, 8, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256)) {
+        decimateDeep(it, buf, len, 8, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate256_cen(SampleVector::iterator* it, const T* buf, qint32 len)
+{
+    if (!decimateBlock(it, buf, len, 1024, 8, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256)) {
+        decimateDeep(it, buf, len, 8, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimate256_cen(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len)
+{
+    if (!decimateBlock(it, bufI, bufQ, len, 512, 8, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256)) {
+        decimateDeep(it, bufI, bufQ, len, 8, decimation_shifts<SdrBits, InputBits>::pre256, decimation_shifts<SdrBits, InputBits>::post256);
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+bool Decimators<StorageType, T, SdrBits, InputBits>::decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 frameSize, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    (void) it; (void) buf; (void) len; (void) frameSize; (void) log2; (void) mode; (void) pre; (void) post;
+    return false;
+#else
+    if (!DecimatorsBlock::isEnabled()) {
+        return false;
+    }
+
+    int nbValues = (len / frameSize) * frameSize;
+    int32_t *work = m_block.getBuffer(nbValues / 2);
+    DecimatorsBlock::convert(buf, work, nbValues, pre);
+    const int32_t *out = m_block.decimate(nbValues / 2, log2, mode);
+
+    for (int pos = 0; pos < (nbValues >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos] >> post);
+        (**it).setImag(out[pos+1] >> post);
+        ++(*it);
+    }
+
+    return true;
+#endif
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+bool Decimators<StorageType, T, SdrBits, InputBits>::decimateBlock(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len, qint32 frameSize, unsigned int log2, uint pre, uint post)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    (void) it; (void) bufI; (void) bufQ; (void) len; (void) frameSize; (void) log2; (void) pre; (void) post;
+    return false;
+#else
+    if (!DecimatorsBlock::isEnabled()) {
+        return false;
+    }
+
+    int nbSamples = (len / frameSize) * frameSize;
+    int32_t *work = m_block.getBuffer(nbSamples);
+    DecimatorsBlock::convert(bufI, bufQ, work, nbSamples, pre);
+    const int32_t *out = m_block.decimate(nbSamples, log2, DecimatorsBlock::ModeCen);
+
+    for (int pos = 0; pos < 2*(nbSamples >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos] >> post);
+        (**it).setImag(out[pos+1] >> post);
+        ++(*it);
+    }
+
+    return true;
+#endif
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimateDeep(SampleVector::iterator* it, const T* buf, qint32 len, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post)
+{
+    StorageType intbuf[1024], work[512];
+    int frameSize = 4<<log2; // one rotation period at the last stage
+
+    for (int pos = 0; pos < len - frameSize + 1; pos += frameSize)
+    {
+        for (int i = 0; i < frameSize; i++) {
+            intbuf[i] = buf[pos+i] << pre;
+        }
+
+        StorageType *out = decimateDeepStages(intbuf, work, frameSize, log2, mode);
+
+        for (int i = 0; i < 4; i += 2)
+        {
+            (**it).setReal(out[i] >> post);
+            (**it).setImag(out[i+1] >> post);
+            ++(*it);
+        }
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+void Decimators<StorageType, T, SdrBits, InputBits>::decimateDeep(SampleVector::iterator* it, const T* bufI, const T* bufQ, qint32 len, unsigned int log2, uint pre, uint post)
+{
+    StorageType intbuf[1024], work[512];
+    int frameSize = 2<<log2;
+
+    for (int pos = 0; pos < len - frameSize + 1; pos += frameSize)
+    {
+        for (int i = 0; i < frameSize; i++)
+        {
+            intbuf[2*i]   = bufI[pos+i] << pre;
+            intbuf[2*i+1] = bufQ[pos+i] << pre;
+        }
+
+        StorageType *out = decimateDeepStages(intbuf, work, 2*frameSize, log2, DecimatorsBlock::ModeCen);
+
+        for (int i = 0; i < 4; i += 2)
+        {
+            (**it).setReal(out[i] >> post);
+            (**it).setImag(out[i+1] >> post);
+            ++(*it);
+        }
+    }
+}
+
+template<typename StorageType, typename T, uint SdrBits, uint InputBits>
+StorageType *Decimators<StorageType, T, SdrBits, InputBits>::decimateDeepStages(StorageType *buf, StorageType *work, int nbValues, unsigned int log2, DecimatorsBlock::Mode mode)
+{
+    StorageType *in = buf;
+    StorageType *out = work;
+
+    for (unsigned int stage = 0; stage < log2; stage++)
+    {
+        DecimatorsBlock::Mode stageMode = DecimatorsBlock::getStageMode(mode, log2, stage);
+
+        switch (stage)
+        {
+        case 0:
+            decimateStage(m_decimator2, stageMode, in, out, nbValues);
+            break;
+        case 1:
+            decimateStage(m_decimator4, stageMode, in, out, nbValues);
+            break;
+        case 2:
+            decimateStage(m_decimator8, stageMode, in, out, nbValues);
+            break;
+        case 3:
+            decimateStage(m_decimator16, stageMode, in, out, nbValues);
+            break;
+        case 4:
+            decimateStage(m_decimator32, stageMode, in, out, nbValues);
+            break;
+        case 5:
+            decimateStage(m_decimator64, stageMode, in, out, nbValues);
+            break;
+        case 6:
+            decimateStage(m_decimator128, stageMode, in, out, nbValues);
+            break;
+        default:
+            decimateStage(m_decimator256, stageMode, in, out, nbValues);
+            break;
+        }
+
+        std::swap(in, out);
+        nbValues /= 2;
+    }
+
+    return in;
+}
+
 #endif /* INCLUDE_GPL_DSP_DECIMATORS_H_ */
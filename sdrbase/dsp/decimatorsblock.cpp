@@ -0,0 +1,704 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "dsp/hbfiltertraits.h"
+#include "decimatorsblock.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define DECIMATORSBLOCK_X86
+#include <immintrin.h>
+#endif
+
+// The kernels are compiled for their instruction set whatever the target of the build
+#if defined(DECIMATORSBLOCK_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DECIMATORSBLOCK_SSE41 __attribute__((target("sse4.1")))
+#define DECIMATORSBLOCK_AVX2 __attribute__((target("avx2")))
+#else
+#define DECIMATORSBLOCK_SSE41
+#define DECIMATORSBLOCK_AVX2
+#endif
+
+namespace {
+
+typedef HBFIRFilterTraits<DECIMATORSBLOCK_HB_FILTER_ORDER> HBTraits;
+
+const int hbTaps = HBTraits::hbOrder / 4;  // symmetric pairs of taps
+const int oddHistory = 2*hbTaps - 1;       // odd samples in the taps span but the newest
+const int evenHistory = hbTaps - 1;        // even samples before the center tap
+const int hbShift = HBTraits::hbShift - 1; // one bit is gained per stage
+
+// Same constants for the integer stages of any filter order
+template<uint32_t HBFilterOrder>
+struct StageTraits
+{
+    static const int hbTaps = HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4;
+    static const int oddHistory = 2*hbTaps - 1;
+    static const int evenHistory = hbTaps - 1;
+    static const int hbShift = HBFIRFilterTraits<HBFilterOrder>::hbShift - 1;
+};
+
+// Split the stage input into its even and odd samples applying the rotation of the mode as
+// IntHalfbandFilterEO::myDecimateInf and myDecimateSup do for each group of 4 samples:
+//   inf: j, -1, -j, 1
+//   sup: -j, -1, j, 1
+// phase is the position of the first pair in the rotation period (0 or 1)
+void splitScalar(const int32_t *in, int nbIn, int32_t *even, int32_t *odd, DecimatorsBlock::Mode mode, int phase = 0)
+{
+    for (int k = 0; k < nbIn/2; k++)
+    {
+        int32_t ei = in[4*k], eq = in[4*k+1], oi = in[4*k+2], oq = in[4*k+3];
+
+        if (mode == DecimatorsBlock::ModeCen)
+        {
+            even[2*k] = ei;
+            even[2*k+1] = eq;
+            odd[2*k] = oi;
+            odd[2*k+1] = oq;
+        }
+        else
+        {
+            bool first = ((k + phase) % 2) == 0;
+            bool neg = first == (mode == DecimatorsBlock::ModeInf);
+            even[2*k]   = neg ? -eq : eq;
+            even[2*k+1] = neg ? ei : -ei;
+            odd[2*k]    = first ? -oi : oi;
+            odd[2*k+1]  = first ? -oq : oq;
+        }
+    }
+}
+
+// Half-band FIR over the split samples. Output j (I or Q) uses the odd samples j + 2*i and
+// j + 2*(oddHistory - i) for tap i and the even sample j for the center tap.
+template<uint32_t HBFilterOrder>
+void firScalar(const int32_t *even, const int32_t *odd, int32_t *out, int from, int to)
+{
+    typedef StageTraits<HBFilterOrder> T;
+
+    for (int j = from; j < to; j++)
+    {
+        int32_t acc = 0;
+
+        for (int i = 0; i < T::hbTaps; i++) {
+            acc += (odd[j + 2*(T::oddHistory - i)] + odd[j + 2*i]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+        }
+
+        acc += even[j] << T::hbShift;
+        out[j] = acc >> T::hbShift;
+    }
+}
+
+#if defined(DECIMATORSBLOCK_X86)
+
+DECIMATORSBLOCK_SSE41
+void splitSSE41(const int32_t *in, int nbIn, int32_t *even, int32_t *odd, DecimatorsBlock::Mode mode)
+{
+    // rotated even samples are (Q, I) with signs, odd samples (I, Q) with signs
+    const __m128i evenSign = mode == DecimatorsBlock::ModeInf ?
+        _mm_setr_epi32(-1, 1, 1, -1) : _mm_setr_epi32(1, -1, -1, 1);
+    const __m128i oddSign = _mm_setr_epi32(-1, -1, 1, 1);
+    int k = 0;
+
+    for (; k + 4 <= nbIn; k += 4) // one rotation period
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*) &in[2*k]);
+        __m128i b = _mm_loadu_si128((const __m128i*) &in[2*k+4]);
+        __m128i e = _mm_unpacklo_epi64(a, b);
+        __m128i o = _mm_unpackhi_epi64(a, b);
+
+        if (mode != DecimatorsBlock::ModeCen)
+        {
+            e = _mm_sign_epi32(_mm_shuffle_epi32(e, _MM_SHUFFLE(2,3,0,1)), evenSign);
+            o = _mm_sign_epi32(o, oddSign);
+        }
+
+        _mm_storeu_si128((__m128i*) &even[k], e);
+        _mm_storeu_si128((__m128i*) &odd[k], o);
+    }
+
+    if (k < nbIn) { // last pair of the center mode
+        splitScalar(&in[2*k], nbIn - k, &even[k], &odd[k], mode);
+    }
+}
+
+template<uint32_t HBFilterOrder>
+DECIMATORSBLOCK_SSE41
+void firSSE41(const int32_t *even, const int32_t *odd, int32_t *out, int n)
+{
+    typedef StageTraits<HBFilterOrder> T;
+    int j = 0;
+
+    for (; j + 4 <= n; j += 4) // two I/Q outputs
+    {
+        __m128i acc = _mm_slli_epi32(_mm_loadu_si128((const __m128i*) &even[j]), T::hbShift);
+
+        for (int i = 0; i < T::hbTaps; i++)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*) &odd[j + 2*(T::oddHistory - i)]);
+            __m128i b = _mm_loadu_si128((const __m128i*) &odd[j + 2*i]);
+            acc = _mm_add_epi32(acc, _mm_mullo_epi32(_mm_add_epi32(a, b), _mm_set1_epi32(HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i])));
+        }
+
+        _mm_storeu_si128((__m128i*) &out[j], _mm_srai_epi32(acc, T::hbShift));
+    }
+
+    firScalar<HBFilterOrder>(even, odd, out, j, n);
+}
+
+template<uint32_t HBFilterOrder>
+DECIMATORSBLOCK_AVX2
+void firAVX2(const int32_t *even, const int32_t *odd, int32_t *out, int n)
+{
+    typedef StageTraits<HBFilterOrder> T;
+    int j = 0;
+
+    for (; j + 8 <= n; j += 8) // four I/Q outputs
+    {
+        __m256i acc = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*) &even[j]), T::hbShift);
+
+        for (int i = 0; i < T::hbTaps; i++)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*) &odd[j + 2*(T::oddHistory - i)]);
+            __m256i b = _mm256_loadu_si256((const __m256i*) &odd[j + 2*i]);
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(_mm256_add_epi32(a, b), _mm256_set1_epi32(HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i])));
+        }
+
+        _mm256_storeu_si256((__m256i*) &out[j], _mm256_srai_epi32(acc, T::hbShift));
+    }
+
+    firScalar<HBFilterOrder>(even, odd, out, j, n);
+}
+
+DECIMATORSBLOCK_SSE41
+void convertS16SSE41(const qint16 *src, int32_t *dst, int n, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*) &src[i]));
+        _mm_storeu_si128((__m128i*) &dst[i], _mm_sll_epi32(v, count));
+    }
+
+    DecimatorsBlock::convert<qint16>(&src[i], &dst[i], n - i, shift);
+}
+
+DECIMATORSBLOCK_AVX2
+void convertS16AVX2(const qint16 *src, int32_t *dst, int n, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i v = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) &src[i]));
+        _mm256_storeu_si256((__m256i*) &dst[i], _mm256_sll_epi32(v, count));
+    }
+
+    DecimatorsBlock::convert<qint16>(&src[i], &dst[i], n - i, shift);
+}
+
+DECIMATORSBLOCK_SSE41
+void convertS8SSE41(const qint8 *src, int32_t *dst, int n, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[i]);
+        _mm_storeu_si128((__m128i*) &dst[i],    _mm_sll_epi32(_mm_cvtepi8_epi32(v), count));
+        _mm_storeu_si128((__m128i*) &dst[i+4],  _mm_sll_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(v, 4)), count));
+        _mm_storeu_si128((__m128i*) &dst[i+8],  _mm_sll_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(v, 8)), count));
+        _mm_storeu_si128((__m128i*) &dst[i+12], _mm_sll_epi32(_mm_cvtepi8_epi32(_mm_srli_si128(v, 12)), count));
+    }
+
+    DecimatorsBlock::convert<qint8>(&src[i], &dst[i], n - i, shift);
+}
+
+DECIMATORSBLOCK_AVX2
+void convertS8AVX2(const qint8 *src, int32_t *dst, int n, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[i]);
+        _mm256_storeu_si256((__m256i*) &dst[i],   _mm256_sll_epi32(_mm256_cvtepi8_epi32(v), count));
+        _mm256_storeu_si256((__m256i*) &dst[i+8], _mm256_sll_epi32(_mm256_cvtepi8_epi32(_mm_srli_si128(v, 8)), count));
+    }
+
+    DecimatorsBlock::convert<qint8>(&src[i], &dst[i], n - i, shift);
+}
+
+DECIMATORSBLOCK_SSE41
+void convertU8SSE41(const quint8 *src, int32_t *dst, int n, int offset, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    const __m128i off = _mm_set1_epi32(offset);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[i]);
+
+        for (int k = 0; k < 4; k++)
+        {
+            __m128i x = _mm_sub_epi32(_mm_cvtepu8_epi32(v), off);
+            _mm_storeu_si128((__m128i*) &dst[i+4*k], _mm_sll_epi32(x, count));
+            v = _mm_srli_si128(v, 4);
+        }
+    }
+
+    for (; i < n; i++) {
+        dst[i] = (src[i] - offset) << shift;
+    }
+}
+
+DECIMATORSBLOCK_AVX2
+void convertU8AVX2(const quint8 *src, int32_t *dst, int n, int offset, unsigned int shift)
+{
+    const __m128i count = _mm_cvtsi32_si128(shift);
+    const __m256i off = _mm256_set1_epi32(offset);
+    int i = 0;
+
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &src[i]);
+        __m256i x0 = _mm256_sub_epi32(_mm256_cvtepu8_epi32(v), off);
+        __m256i x1 = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(v, 8)), off);
+        _mm256_storeu_si256((__m256i*) &dst[i],   _mm256_sll_epi32(x0, count));
+        _mm256_storeu_si256((__m256i*) &dst[i+8], _mm256_sll_epi32(x1, count));
+    }
+
+    for (; i < n; i++) {
+        dst[i] = (src[i] - offset) << shift;
+    }
+}
+
+#endif // DECIMATORSBLOCK_X86
+
+// Float stages (center only) as IntHalfbandFilterEOF: tip + tail order, accumulation from zero
+// and center tap added last so that each output lane sees the same operations.
+
+void splitScalarF(const float *in, int nbIn, float *even, float *odd)
+{
+    for (int k = 0; k < nbIn/2; k++)
+    {
+        even[2*k]   = in[4*k];
+        even[2*k+1] = in[4*k+1];
+        odd[2*k]    = in[4*k+2];
+        odd[2*k+1]  = in[4*k+3];
+    }
+}
+
+void firScalarF(const float *even, const float *odd, float *out, int from, int to)
+{
+    for (int j = from; j < to; j++)
+    {
+        float acc = 0.0f;
+
+        for (int i = 0; i < hbTaps; i++) {
+            acc += (odd[j + 2*(oddHistory - i)] + odd[j + 2*i]) * HBTraits::hbCoeffsF[i];
+        }
+
+        acc += even[j] * 0.5f;
+        out[j] = acc;
+    }
+}
+
+#if defined(DECIMATORSBLOCK_X86)
+
+DECIMATORSBLOCK_SSE41
+void splitSSE41F(const float *in, int nbIn, float *even, float *odd)
+{
+    int k = 0;
+
+    for (; k + 4 <= nbIn; k += 4)
+    {
+        __m128 a = _mm_loadu_ps(&in[2*k]);
+        __m128 b = _mm_loadu_ps(&in[2*k+4]);
+        _mm_storeu_ps(&even[k], _mm_movelh_ps(a, b));
+        _mm_storeu_ps(&odd[k], _mm_movehl_ps(b, a));
+    }
+
+    if (k < nbIn) {
+        splitScalarF(&in[2*k], nbIn - k, &even[k], &odd[k]);
+    }
+}
+
+DECIMATORSBLOCK_SSE41
+void firSSE41F(const float *even, const float *odd, float *out, int n)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    int j = 0;
+
+    for (; j + 4 <= n; j += 4)
+    {
+        __m128 acc = _mm_setzero_ps();
+
+        for (int i = 0; i < hbTaps; i++)
+        {
+            __m128 a = _mm_loadu_ps(&odd[j + 2*(oddHistory - i)]);
+            __m128 b = _mm_loadu_ps(&odd[j + 2*i]);
+            acc = _mm_add_ps(acc, _mm_mul_ps(_mm_add_ps(a, b), _mm_set1_ps(HBTraits::hbCoeffsF[i])));
+        }
+
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(&even[j]), half));
+        _mm_storeu_ps(&out[j], acc);
+    }
+
+    firScalarF(even, odd, out, j, n);
+}
+
+DECIMATORSBLOCK_AVX2
+void firAVX2F(const float *even, const float *odd, float *out, int n)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    int j = 0;
+
+    for (; j + 8 <= n; j += 8)
+    {
+        __m256 acc = _mm256_setzero_ps();
+
+        for (int i = 0; i < hbTaps; i++)
+        {
+            __m256 a = _mm256_loadu_ps(&odd[j + 2*(oddHistory - i)]);
+            __m256 b = _mm256_loadu_ps(&odd[j + 2*i]);
+            acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_add_ps(a, b), _mm256_set1_ps(HBTraits::hbCoeffsF[i])));
+        }
+
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(_mm256_loadu_ps(&even[j]), half));
+        _mm256_storeu_ps(&out[j], acc);
+    }
+
+    firScalarF(even, odd, out, j, n);
+}
+
+#endif // DECIMATORSBLOCK_X86
+
+template<typename T>
+T *stageBuffer(std::vector<T>& v, int history, int nbNew)
+{
+    std::size_t size = 2*(history + nbNew);
+
+    if (v.size() < size) {
+        v.resize(size); // new history is zero
+    }
+
+    return v.data();
+}
+
+template<typename T>
+void keepHistory(T *samples, int history, int nbNew)
+{
+    memmove(samples, &samples[2*nbNew], 2*history*sizeof(T));
+}
+
+} // namespace
+
+DecimatorsBlock::DecimatorsBlock()
+{}
+
+DecimatorsBlock::Mode DecimatorsBlock::getStageMode(Mode mode, unsigned int log2, unsigned int stage)
+{
+    if ((mode == ModeCen) || (stage == 0)) {
+        return mode;
+    } else if ((log2 > 2) && (stage == log2 - 1)) {
+        return ModeCen;
+    } else {
+        return mode == ModeInf ? ModeSup : ModeInf;
+    }
+}
+
+int32_t *DecimatorsBlock::getBuffer(int nbSamples)
+{
+    if (m_buffer.size() < 2U*nbSamples) {
+        m_buffer.resize(2*nbSamples);
+    }
+
+    return m_buffer.data();
+}
+
+const int32_t *DecimatorsBlock::decimate(int nbSamples, unsigned int log2, Mode mode)
+{
+    CPUFeatures::SIMDLevel level = CPUFeatures::getSIMDLevel();
+    int32_t *buf = m_buffer.data();
+    int nbIn = nbSamples;
+
+    for (unsigned int s = 0; (s < log2) && (s < m_maxLog2); s++)
+    {
+        int nbOut = nbIn / 2;
+        int32_t *even = stageBuffer(m_stages[s].m_even, evenHistory, nbOut);
+        int32_t *odd = stageBuffer(m_stages[s].m_odd, oddHistory, nbOut);
+        Mode stageMode = getStageMode(mode, log2, s);
+
+        // the input is fully split before the FIR so the output can overwrite it
+        switch (level)
+        {
+#if defined(DECIMATORSBLOCK_X86)
+        case CPUFeatures::SIMDAVX2:
+            splitSSE41(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory], stageMode);
+            firAVX2<DECIMATORSBLOCK_HB_FILTER_ORDER>(even, odd, buf, 2*nbOut);
+            break;
+        case CPUFeatures::SIMDSSE41:
+            splitSSE41(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory], stageMode);
+            firSSE41<DECIMATORSBLOCK_HB_FILTER_ORDER>(even, odd, buf, 2*nbOut);
+            break;
+#endif
+        default:
+            splitScalar(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory], stageMode);
+            firScalar<DECIMATORSBLOCK_HB_FILTER_ORDER>(even, odd, buf, 0, 2*nbOut);
+            break;
+        }
+
+        keepHistory(even, evenHistory, nbOut);
+        keepHistory(odd, oddHistory, nbOut);
+        nbIn = nbOut;
+    }
+
+    return buf;
+}
+
+void DecimatorsBlock::reset()
+{
+    for (unsigned int s = 0; s < m_maxLog2; s++)
+    {
+        m_stages[s].m_even.clear();
+        m_stages[s].m_odd.clear();
+    }
+}
+
+void DecimatorsBlock::convert(const qint8 *src, int32_t *dst, int nbValues, unsigned int shift)
+{
+    switch (CPUFeatures::getSIMDLevel())
+    {
+#if defined(DECIMATORSBLOCK_X86)
+    case CPUFeatures::SIMDAVX2:
+        convertS8AVX2(src, dst, nbValues, shift);
+        break;
+    case CPUFeatures::SIMDSSE41:
+        convertS8SSE41(src, dst, nbValues, shift);
+        break;
+#endif
+    default:
+        convert<qint8>(src, dst, nbValues, shift);
+        break;
+    }
+}
+
+void DecimatorsBlock::convert(const qint16 *src, int32_t *dst, int nbValues, unsigned int shift)
+{
+    switch (CPUFeatures::getSIMDLevel())
+    {
+#if defined(DECIMATORSBLOCK_X86)
+    case CPUFeatures::SIMDAVX2:
+        convertS16AVX2(src, dst, nbValues, shift);
+        break;
+    case CPUFeatures::SIMDSSE41:
+        convertS16SSE41(src, dst, nbValues, shift);
+        break;
+#endif
+    default:
+        convert<qint16>(src, dst, nbValues, shift);
+        break;
+    }
+}
+
+void DecimatorsBlock::convertUnsigned(const quint8 *src, int32_t *dst, int nbValues, int offset, unsigned int shift)
+{
+    switch (CPUFeatures::getSIMDLevel())
+    {
+#if defined(DECIMATORSBLOCK_X86)
+    case CPUFeatures::SIMDAVX2:
+        convertU8AVX2(src, dst, nbValues, offset, shift);
+        break;
+    case CPUFeatures::SIMDSSE41:
+        convertU8SSE41(src, dst, nbValues, offset, shift);
+        break;
+#endif
+    default:
+        for (int i = 0; i < nbValues; i++) {
+            dst[i] = (src[i] - offset) << shift;
+        }
+        break;
+    }
+}
+
+DecimatorsBlockStage::DecimatorsBlockStage(uint32_t hbOrder, DecimatorsBlock::Mode mode) :
+    m_hbOrder(hbOrder == 64 ? 64 : 48),
+    m_mode(mode),
+    m_pending(false),
+    m_pendingI(0),
+    m_pendingQ(0),
+    m_phase(0)
+{}
+
+int DecimatorsBlockStage::decimate(const Sample *in, Sample *out, int nbIn)
+{
+    if (m_hbOrder == 64) {
+        return decimateOrder<64>(in, out, nbIn);
+    } else {
+        return decimateOrder<48>(in, out, nbIn);
+    }
+}
+
+template<uint32_t HBFilterOrder>
+int DecimatorsBlockStage::decimateOrder(const Sample *in, Sample *out, int nbIn)
+{
+    typedef StageTraits<HBFilterOrder> T;
+    CPUFeatures::SIMDLevel level = CPUFeatures::getSIMDLevel();
+    int nbSamples = nbIn + (m_pending ? 1 : 0);
+    int nbOut = nbSamples / 2;
+
+    if (m_work.size() < 2U*nbSamples) {
+        m_work.resize(2*nbSamples);
+    }
+
+    int32_t *work = m_work.data();
+    int32_t *values = work;
+
+    if (m_pending)
+    {
+        values[0] = m_pendingI;
+        values[1] = m_pendingQ;
+        values += 2;
+    }
+
+    DecimatorsBlock::convert(reinterpret_cast<const FixReal*>(in), values, 2*nbIn, 0);
+    m_pending = (nbSamples % 2) == 1;
+
+    if (m_pending)
+    {
+        m_pendingI = work[2*nbSamples - 2];
+        m_pendingQ = work[2*nbSamples - 1];
+    }
+
+    int32_t *even = stageBuffer(m_even, T::evenHistory, nbOut);
+    int32_t *odd = stageBuffer(m_odd, T::oddHistory, nbOut);
+    int32_t *evenNew = &even[2*T::evenHistory];
+    int32_t *oddNew = &odd[2*T::oddHistory];
+    int k = 0;
+
+    // the SIMD split starts a rotation period
+    if ((m_phase == 1) && (nbOut > 0))
+    {
+        splitScalar(work, 2, evenNew, oddNew, m_mode, 1);
+        k = 1;
+    }
+
+    // the input is fully split before the FIR so the output can overwrite it
+    switch (level)
+    {
+#if defined(DECIMATORSBLOCK_X86)
+    case CPUFeatures::SIMDAVX2:
+        splitSSE41(&work[4*k], 2*(nbOut - k), &evenNew[2*k], &oddNew[2*k], m_mode);
+        firAVX2<HBFilterOrder>(even, odd, work, 2*nbOut);
+        break;
+    case CPUFeatures::SIMDSSE41:
+        splitSSE41(&work[4*k], 2*(nbOut - k), &evenNew[2*k], &oddNew[2*k], m_mode);
+        firSSE41<HBFilterOrder>(even, odd, work, 2*nbOut);
+        break;
+#endif
+    default:
+        splitScalar(&work[4*k], 2*(nbOut - k), &evenNew[2*k], &oddNew[2*k], m_mode);
+        firScalar<HBFilterOrder>(even, odd, work, 0, 2*nbOut);
+        break;
+    }
+
+    for (int j = 0; j < nbOut; j++)
+    {
+        out[j].setReal(work[2*j]);
+        out[j].setImag(work[2*j+1]);
+    }
+
+    keepHistory(even, T::evenHistory, nbOut);
+    keepHistory(odd, T::oddHistory, nbOut);
+    m_phase = (m_phase + nbOut) % 2;
+
+    return nbOut;
+}
+
+void DecimatorsBlockStage::reset()
+{
+    m_even.clear();
+    m_odd.clear();
+    m_pending = false;
+    m_phase = 0;
+}
+
+DecimatorsBlockF::DecimatorsBlockF()
+{}
+
+float *DecimatorsBlockF::getBuffer(int nbSamples)
+{
+    if (m_buffer.size() < 2U*nbSamples) {
+        m_buffer.resize(2*nbSamples);
+    }
+
+    return m_buffer.data();
+}
+
+const float *DecimatorsBlockF::decimate(int nbSamples, unsigned int log2)
+{
+    CPUFeatures::SIMDLevel level = CPUFeatures::getSIMDLevel();
+    float *buf = m_buffer.data();
+    int nbIn = nbSamples;
+
+    for (unsigned int s = 0; (s < log2) && (s < DecimatorsBlock::m_maxLog2); s++)
+    {
+        int nbOut = nbIn / 2;
+        float *even = stageBuffer(m_stages[s].m_even, evenHistory, nbOut);
+        float *odd = stageBuffer(m_stages[s].m_odd, oddHistory, nbOut);
+
+        switch (level)
+        {
+#if defined(DECIMATORSBLOCK_X86)
+        case CPUFeatures::SIMDAVX2:
+            splitSSE41F(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory]);
+            firAVX2F(even, odd, buf, 2*nbOut);
+            break;
+        case CPUFeatures::SIMDSSE41:
+            splitSSE41F(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory]);
+            firSSE41F(even, odd, buf, 2*nbOut);
+            break;
+#endif
+        default:
+            splitScalarF(buf, nbIn, &even[2*evenHistory], &odd[2*oddHistory]);
+            firScalarF(even, odd, buf, 0, 2*nbOut);
+            break;
+        }
+
+        keepHistory(even, evenHistory, nbOut);
+        keepHistory(odd, oddHistory, nbOut);
+        nbIn = nbOut;
+    }
+
+    return buf;
+}
+
+void DecimatorsBlockF::reset()
+{
+    for (unsigned int s = 0; s < DecimatorsBlock::m_maxLog2; s++)
+    {
+        m_stages[s].m_even.clear();
+        m_stages[s].m_odd.clear();
+    }
+}
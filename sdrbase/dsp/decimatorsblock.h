@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DECIMATORSBLOCK_H_
+#define SDRBASE_DSP_DECIMATORSBLOCK_H_
+
+#include <stdint.h>
+#include <vector>
+#include <QtGlobal>
+
+#include "dsp/cpufeatures.h"
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+#define DECIMATORSBLOCK_HB_FILTER_ORDER 64
+
+/**
+ * Block implementation of the half-band decimation cascades of the Decimators templates.
+ * The whole buffer goes through one stage after the other and each stage computes several
+ * outputs at once with the SSE4.1 or AVX2 kernels selected at run time (see CPUFeatures).
+ *
+ * The arithmetic is that of IntHalfbandFilterEO<qint32, qint32, 64> (32 bit accumulator,
+ * same rotations and shifts) so that the output is bit identical to the sample by sample
+ * cascades. Up to 8 stages (decimation by 256).
+ */
+class SDRBASE_API DecimatorsBlock
+{
+public:
+    enum Mode
+    {
+        ModeCen, //!< keep the center of the band
+        ModeInf, //!< keep the lower half of the band
+        ModeSup  //!< keep the upper half of the band
+    };
+
+    static const unsigned int m_maxLog2 = 8;
+
+    DecimatorsBlock();
+
+    /** True if the block code should replace the sample by sample code */
+    static bool isEnabled() { return CPUFeatures::getSIMDLevel() != CPUFeatures::SIMDNone; }
+    /** Rotation applied at the input of a stage. Same sequence as the sample by sample cascades */
+    static Mode getStageMode(Mode mode, unsigned int log2, unsigned int stage);
+
+    /** Work buffer of nbSamples I/Q pairs to be filled before calling decimate() */
+    int32_t *getBuffer(int nbSamples);
+    /**
+     * Decimate by 2^log2 the nbSamples I/Q pairs of the work buffer. Returns the work buffer
+     * that holds the nbSamples >> log2 output I/Q pairs. nbSamples must be a multiple of
+     * 2^log2 or of 2^(log2+1) when the mode is inf or sup.
+     */
+    const int32_t *decimate(int nbSamples, unsigned int log2, Mode mode);
+    /** Clear the stages history */
+    void reset();
+
+    // input conversions with left shift
+    static void convert(const qint8 *src, int32_t *dst, int nbValues, unsigned int shift);
+    static void convert(const qint16 *src, int32_t *dst, int nbValues, unsigned int shift);
+    static void convertUnsigned(const quint8 *src, int32_t *dst, int nbValues, int offset, unsigned int shift);
+
+    template<typename T>
+    static void convert(const T *src, int32_t *dst, int nbValues, unsigned int shift)
+    {
+        for (int i = 0; i < nbValues; i++) {
+            dst[i] = ((int32_t) src[i]) << shift;
+        }
+    }
+
+    template<typename T>
+    static void convertUnsigned(const T *src, int32_t *dst, int nbValues, int offset, unsigned int shift)
+    {
+        for (int i = 0; i < nbValues; i++) {
+            dst[i] = ((int32_t) src[i] - offset) << shift;
+        }
+    }
+
+    /** Separate I and Q buffers of nbSamples samples each */
+    template<typename T>
+    static void convert(const T *srcI, const T *srcQ, int32_t *dst, int nbSamples, unsigned int shift)
+    {
+        for (int i = 0; i < nbSamples; i++)
+        {
+            dst[2*i]   = ((int32_t) srcI[i]) << shift;
+            dst[2*i+1] = ((int32_t) srcQ[i]) << shift;
+        }
+    }
+
+private:
+    struct Stage
+    {
+        std::vector<int32_t> m_even; //!< history then new even samples
+        std::vector<int32_t> m_odd;  //!< history then new odd samples
+    };
+
+    Stage m_stages[m_maxLog2];
+    std::vector<int32_t> m_buffer;
+};
+
+/**
+ * One half-band decimation by 2 stage of a channelizer chain (DownChannelizer) using the
+ * kernels of DecimatorsBlock. Blocks may have any number of samples: an odd last sample and
+ * the rotation phase are carried over to the next block. The output is bit identical to
+ * IntHalfbandFilterEO<qint32, qint32, order> fed sample by sample. Supported filter orders
+ * are 48 and 64.
+ */
+class SDRBASE_API DecimatorsBlockStage
+{
+public:
+    DecimatorsBlockStage(uint32_t hbOrder, DecimatorsBlock::Mode mode);
+
+    /** Decimate nbIn samples. in and out may be the same buffer. Returns the number of output samples */
+    int decimate(const Sample *in, Sample *out, int nbIn);
+    void reset();
+    DecimatorsBlock::Mode getMode() const { return m_mode; }
+
+private:
+    uint32_t m_hbOrder;
+    DecimatorsBlock::Mode m_mode;
+    std::vector<int32_t> m_even; //!< history then new even samples
+    std::vector<int32_t> m_odd;  //!< history then new odd samples
+    std::vector<int32_t> m_work; //!< I/Q values of the pending sample and of the block then FIR output
+    bool m_pending;              //!< one input sample waits for its pair
+    int32_t m_pendingI;
+    int32_t m_pendingQ;
+    int m_phase;                 //!< position of the next pair in the rotation period
+
+    template<uint32_t HBFilterOrder>
+    int decimateOrder(const Sample *in, Sample *out, int nbIn);
+};
+
+/**
+ * Float version for the center cascades of DecimatorsFF, DecimatorsFI and DecimatorsIF
+ * (arithmetic of IntHalfbandFilterEOF<64>).
+ */
+class SDRBASE_API DecimatorsBlockF
+{
+public:
+    DecimatorsBlockF();
+
+    static bool isEnabled() { return DecimatorsBlock::isEnabled(); }
+
+    /** Work buffer of nbSamples I/Q pairs to be filled before calling decimate() */
+    float *getBuffer(int nbSamples);
+    /** Decimate by 2^log2 keeping the center of the band. nbSamples must be a multiple of 2^log2 */
+    const float *decimate(int nbSamples, unsigned int log2);
+    void reset();
+
+private:
+    struct Stage
+    {
+        std::vector<float> m_even;
+        std::vector<float> m_odd;
+    };
+
+    Stage m_stages[DecimatorsBlock::m_maxLog2];
+    std::vector<float> m_buffer;
+};
+
+#endif /* SDRBASE_DSP_DECIMATORSBLOCK_H_ */
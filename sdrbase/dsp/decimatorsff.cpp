@@ -14,6 +14,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "decimatorsff.h"
 
 void DecimatorsFF::decimate1(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
@@ -32,6 +34,10 @@ void DecimatorsFF::decimate1(FSampleVector::iterator* it, const float* buf, qint
 
 void DecimatorsFF::decimate2_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 1)) {
+        return;
+    }
+
     float intbuf[2];
 
     for (int pos = 0; pos < nbIAndQ - 3; pos += 4)
@@ -368,6 +374,10 @@ void DecimatorsFF::decimate64_sup(FSampleVector::iterator* it, const float* buf,
 
 void DecimatorsFF::decimate4_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 2)) {
+        return;
+    }
+
     float intbuf[4];
 
     for (int pos = 0; pos < nbIAndQ - 7; pos += 8)
@@ -402,6 +412,10 @@ void DecimatorsFF::decimate4_cen(FSampleVector::iterator* it, const float* buf,
 
 void DecimatorsFF::decimate8_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 3)) {
+        return;
+    }
+
     float intbuf[8];
 
     for (int pos = 0; pos < nbIAndQ - 15; pos += 16)
@@ -461,6 +475,10 @@ void DecimatorsFF::decimate8_cen(FSampleVector::iterator* it, const float* buf,
 
 void DecimatorsFF::decimate16_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 4)) {
+        return;
+    }
+
     float intbuf[16];
 
     for (int pos = 0; pos < nbIAndQ - 31; pos += 32)
@@ -569,6 +587,10 @@ void DecimatorsFF::decimate16_cen(FSampleVector::iterator* it, const float* buf,
 
 void DecimatorsFF::decimate32_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 5)) {
+        return;
+    }
+
     float intbuf[32];
 
     for (int pos = 0; pos < nbIAndQ - 63; pos += 64)
@@ -774,6 +796,10 @@ void DecimatorsFF::decimate32_cen(FSampleVector::iterator* it, const float* buf,
 
 void DecimatorsFF::decimate64_cen(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 6)) {
+        return;
+    }
+
     float intbuf[64];
 
     for (int pos = 0; pos < nbIAndQ - 127; pos += 128)
@@ -1171,3 +1197,24 @@ void DecimatorsFF::decimate64_cen(FSampleVector::iterator* it, const float* buf,
     }
 }
 
+bool DecimatorsFF::decimateBlock(FSampleVector::iterator* it, const float* buf, qint32 nbIAndQ, unsigned int log2)
+{
+    if (!DecimatorsBlockF::isEnabled()) {
+        return false;
+    }
+
+    int frameSize = 2 << log2;
+    int nbSamples = ((nbIAndQ / frameSize) * frameSize) / 2;
+    float *work = m_blockF.getBuffer(nbSamples);
+    std::copy(buf, buf + 2*nbSamples, work);
+    const float *out = m_blockF.decimate(nbSamples, log2);
+
+    for (int pos = 0; pos < 2*(nbSamples >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos]);
+        (**it).setImag(out[pos+1]);
+        ++(*it);
+    }
+
+    return true;
+}
@@ -14,6 +14,8 @@
 // along with this program. If not, see <http://www.gnu.org/licenses/>.          //
 ///////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "decimatorsfi.h"
 
 void DecimatorsFI::decimate1(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
@@ -32,6 +34,10 @@ void DecimatorsFI::decimate1(SampleVector::iterator* it, const float* buf, qint3
 
 void DecimatorsFI::decimate2_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 1)) {
+        return;
+    }
+
     float intbuf[2];
 
     for (int pos = 0; pos < nbIAndQ - 3; pos += 4)
@@ -368,6 +374,10 @@ void DecimatorsFI::decimate64_sup(SampleVector::iterator* it, const float* buf,
 
 void DecimatorsFI::decimate4_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 2)) {
+        return;
+    }
+
     float intbuf[4];
 
     for (int pos = 0; pos < nbIAndQ - 7; pos += 8)
@@ -402,6 +412,10 @@ void DecimatorsFI::decimate4_cen(SampleVector::iterator* it, const float* buf, q
 
 void DecimatorsFI::decimate8_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 3)) {
+        return;
+    }
+
     float intbuf[8];
 
     for (int pos = 0; pos < nbIAndQ - 15; pos += 16)
@@ -461,6 +475,10 @@ void DecimatorsFI::decimate8_cen(SampleVector::iterator* it, const float* buf, q
 
 void DecimatorsFI::decimate16_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 4)) {
+        return;
+    }
+
     float intbuf[16];
 
     for (int pos = 0; pos < nbIAndQ - 31; pos += 32)
@@ -569,6 +587,10 @@ void DecimatorsFI::decimate16_cen(SampleVector::iterator* it, const float* buf,
 
 void DecimatorsFI::decimate32_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 5)) {
+        return;
+    }
+
     float intbuf[32];
 
     for (int pos = 0; pos < nbIAndQ - 63; pos += 64)
@@ -774,6 +796,10 @@ void DecimatorsFI::decimate32_cen(SampleVector::iterator* it, const float* buf,
 
 void DecimatorsFI::decimate64_cen(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 6)) {
+        return;
+    }
+
     float intbuf[64];
 
     for (int pos = 0; pos < nbIAndQ - 127; pos += 128)
@@ -1171,3 +1197,24 @@ void DecimatorsFI::decimate64_cen(SampleVector::iterator* it, const float* buf,
     }
 }
 
+bool DecimatorsFI::decimateBlock(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ, unsigned int log2)
+{
+    if (!DecimatorsBlockF::isEnabled()) {
+        return false;
+    }
+
+    int frameSize = 2 << log2;
+    int nbSamples = ((nbIAndQ / frameSize) * frameSize) / 2;
+    float *work = m_blockF.getBuffer(nbSamples);
+    std::copy(buf, buf + 2*nbSamples, work);
+    const float *out = m_blockF.decimate(nbSamples, log2);
+
+    for (int pos = 0; pos < 2*(nbSamples >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos] * SDR_RX_SCALED);
+        (**it).setImag(out[pos+1] * SDR_RX_SCALED);
+        ++(*it);
+    }
+
+    return true;
+}
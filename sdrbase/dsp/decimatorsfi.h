@@ -18,6 +18,7 @@
 #define SDRBASE_DSP_DECIMATORSFI_H_
 
 #include "dsp/inthalfbandfiltereof.h"
+#include "dsp/decimatorsblock.h"
 #include "export.h"
 
 #define DECIMATORSFI_HB_FILTER_ORDER 64
@@ -52,6 +53,15 @@ public:
     IntHalfbandFilterEOF<DECIMATORSFI_HB_FILTER_ORDER> m_decimator16; // 4th stages
     IntHalfbandFilterEOF<DECIMATORSFI_HB_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEOF<DECIMATORSFI_HB_FILTER_ORDER> m_decimator64; // 6th stages
+
+private:
+    DecimatorsBlockF m_blockF; // SIMD block cascades
+
+    /**
+     * Run the whole frames of the buffer through the SIMD center block cascade when available.
+     * Returns false when the caller should fall back to the scalar per-frame code.
+     */
+    bool decimateBlock(SampleVector::iterator* it, const float* buf, qint32 nbIAndQ, unsigned int log2);
 };
 
 
@@ -19,6 +19,7 @@
 
 #include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfiltereof.h"
+#include "dsp/decimatorsblock.h"
 
 #define DECIMATORS_IF_FILTER_ORDER 64
 
@@ -80,6 +81,15 @@ public:
     IntHalfbandFilterEOF<DECIMATORS_IF_FILTER_ORDER> m_decimator16; // 4th stages
     IntHalfbandFilterEOF<DECIMATORS_IF_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEOF<DECIMATORS_IF_FILTER_ORDER> m_decimator64; // 6th stages
+
+private:
+    DecimatorsBlockF m_blockF; // SIMD block cascades
+
+    /**
+     * Run the whole frames of the buffer through the SIMD center block cascade when available.
+     * Returns false when the caller should fall back to the scalar per-frame code.
+     */
+    bool decimateBlock(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ, unsigned int log2);
 };
 
 template<typename T, uint InputBits>
@@ -142,6 +152,10 @@ void DecimatorsIF<T, InputBits>::decimate2_sup(FSampleVector::iterator* it, cons
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate2_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 1)) {
+        return;
+    }
+
     float intbuf[2];
 
     for (int pos = 0; pos < nbIAndQ - 3; pos += 4)
@@ -199,6 +213,10 @@ void DecimatorsIF<T, InputBits>::decimate4_sup(FSampleVector::iterator* it, cons
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate4_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 2)) {
+        return;
+    }
+
     float intbuf[4];
 
     for (int pos = 0; pos < nbIAndQ - 7; pos += 8)
@@ -280,6 +298,10 @@ void DecimatorsIF<T, InputBits>::decimate8_sup(FSampleVector::iterator* it, cons
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate8_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 3)) {
+        return;
+    }
+
     float intbuf[8];
 
     for (int pos = 0; pos < nbIAndQ - 15; pos += 16)
@@ -392,6 +414,10 @@ void DecimatorsIF<T, InputBits>::decimate16_sup(FSampleVector::iterator* it, con
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate16_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 4)) {
+        return;
+    }
+
     float intbuf[16];
 
     for (int pos = 0; pos < nbIAndQ - 31; pos += 32)
@@ -563,6 +589,10 @@ void DecimatorsIF<T, InputBits>::decimate32_sup(FSampleVector::iterator* it, con
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate32_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 5)) {
+        return;
+    }
+
     float intbuf[32];
 
     for (int pos = 0; pos < nbIAndQ - 63; pos += 64)
@@ -849,6 +879,10 @@ void DecimatorsIF<T, InputBits>::decimate64_sup(FSampleVector::iterator* it, con
 template<typename T, uint InputBits>
 void DecimatorsIF<T, InputBits>::decimate64_cen(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ)
 {
+    if (decimateBlock(it, buf, nbIAndQ, 6)) {
+        return;
+    }
+
     float intbuf[64];
 
     for (int pos = 0; pos < nbIAndQ - 127; pos += 128)
@@ -1246,4 +1280,31 @@ void DecimatorsIF<T, InputBits>::decimate64_cen(FSampleVector::iterator* it, con
     }
 }
 
+template<typename T, uint InputBits>
+bool DecimatorsIF<T, InputBits>::decimateBlock(FSampleVector::iterator* it, const T* buf, qint32 nbIAndQ, unsigned int log2)
+{
+    if (!DecimatorsBlockF::isEnabled()) {
+        return false;
+    }
+
+    int frameSize = 2 << log2;
+    int nbSamples = ((nbIAndQ / frameSize) * frameSize) / 2;
+    float *work = m_blockF.getBuffer(nbSamples);
+
+    for (int i = 0; i < 2*nbSamples; i++) {
+        work[i] = buf[i];
+    }
+
+    const float *out = m_blockF.decimate(nbSamples, log2);
+
+    for (int pos = 0; pos < 2*(nbSamples >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos] * decimation_scale<InputBits>::scaleIn);
+        (**it).setImag(out[pos+1] * decimation_scale<InputBits>::scaleIn);
+        ++(*it);
+    }
+
+    return true;
+}
+
 #endif /* SDRBASE_DSP_DECIMATORSIF_H_ */
@@ -25,6 +25,7 @@
 
 #include "dsp/dsptypes.h"
 #include "dsp/inthalfbandfiltereo.h"
+#include "dsp/decimatorsblock.h"
 
 #define DECIMATORS_HB_FILTER_ORDER 64
 
@@ -213,6 +214,13 @@ private:
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator32; // 5th stages
     IntHalfbandFilterEO<qint32, qint32, DECIMATORS_HB_FILTER_ORDER> m_decimator64; // 6th stages
 #endif
+    DecimatorsBlock m_block; // SIMD block cascades
+
+    /**
+     * Run the whole frames of the buffer through the SIMD block cascade when available.
+     * Returns false when the caller should fall back to the scalar per-frame code.
+     */
+    bool decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 frameSize, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post);
 };
 
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
@@ -233,6 +241,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate1(SampleVec
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -261,6 +273,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_inf(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -289,6 +305,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_sup(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -339,6 +359,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_inf(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -389,6 +413,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_sup(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_inf(SampleVector::iterator* it, const T* buf __attribute__((unused)), qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 3, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
     StorageType buf2[16], buf4[8], buf8[4];
 
     for (int pos = 0; pos < len - 31; pos += 32)
@@ -465,6 +493,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_inf(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_sup(SampleVector::iterator* it, const T* buf __attribute__((unused)), qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 3, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
     StorageType buf2[16], buf4[8], buf8[4];
 
     for (int pos = 0; pos < len - 31; pos += 32)
@@ -541,6 +573,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_sup(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 4, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -681,6 +717,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_inf(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 4, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
     StorageType buf2[32], buf4[16], buf8[8], buf16[4];
 
     for (int pos = 0; pos < len - 63; pos += 64)
@@ -821,6 +861,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_sup(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 5, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1089,6 +1133,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_inf(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 5, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
     StorageType buf2[64], buf4[32], buf8[16], buf16[8], buf32[4];
 
     for (int pos = 0; pos < len - 127; pos += 128)
@@ -1357,6 +1405,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_sup(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_inf(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 256, 6, DecimatorsBlock::ModeInf, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -1881,6 +1933,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_inf(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_sup(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 256, 6, DecimatorsBlock::ModeSup, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
     StorageType buf2[128], buf4[64], buf8[32], buf16[16], buf32[8], buf64[4];
 
     for (int pos = 0; pos < len - 255; pos += 256)
@@ -2405,6 +2461,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_sup(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 8, 1, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre2, decimation_shifts<SdrBits, InputBits>::post2)) {
+        return;
+    }
+
     StorageType buf2[4];
 
     for (int pos = 0; pos < len - 7; pos += 8)
@@ -2433,6 +2493,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate2_cen(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 2, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre4, decimation_shifts<SdrBits, InputBits>::post4)) {
+        return;
+    }
+
     StorageType buf2[8], buf4[4];
 
     for (int pos = 0; pos < len - 15; pos += 16)
@@ -2476,6 +2540,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate4_cen(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 16, 3, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre8, decimation_shifts<SdrBits, InputBits>::post8)) {
+        return;
+    }
+
 	StorageType intbuf[8];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -2536,6 +2604,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate8_cen(Sampl
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 32, 4, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre16, decimation_shifts<SdrBits, InputBits>::post16)) {
+        return;
+    }
+
 	StorageType intbuf[16];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -2645,6 +2717,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate16_cen(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 64, 5, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre32, decimation_shifts<SdrBits, InputBits>::post32)) {
+        return;
+    }
+
 	StorageType intbuf[32];
 
 	for (int pos = 0; pos < len - 63; pos += 64)
@@ -2851,6 +2927,10 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate32_cen(Samp
 template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
 void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_cen(SampleVector::iterator* it, const T* buf, qint32 len)
 {
+    if (decimateBlock(it, buf, len, 128, 6, DecimatorsBlock::ModeCen, decimation_shifts<SdrBits, InputBits>::pre64, decimation_shifts<SdrBits, InputBits>::post64)) {
+        return;
+    }
+
 	StorageType intbuf[64];
 
 	for (int pos = 0; pos < len - 127; pos += 128)
@@ -3248,4 +3328,31 @@ void DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimate64_cen(Samp
 	}
 }
 
+template<typename StorageType, typename T, uint SdrBits, uint InputBits, int Shift>
+bool DecimatorsU<StorageType, T, SdrBits, InputBits, Shift>::decimateBlock(SampleVector::iterator* it, const T* buf, qint32 len, qint32 frameSize, unsigned int log2, DecimatorsBlock::Mode mode, uint pre, uint post)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    (void) it; (void) buf; (void) len; (void) frameSize; (void) log2; (void) mode; (void) pre; (void) post;
+    return false;
+#else
+    if (!DecimatorsBlock::isEnabled()) {
+        return false;
+    }
+
+    int nbValues = (len / frameSize) * frameSize;
+    int32_t *work = m_block.getBuffer(nbValues / 2);
+    DecimatorsBlock::convertUnsigned(buf, work, nbValues, Shift, pre);
+    const int32_t *out = m_block.decimate(nbValues / 2, log2, mode);
+
+    for (int pos = 0; pos < (nbValues >> log2); pos += 2)
+    {
+        (**it).setReal(out[pos] >> post);
+        (**it).setImag(out[pos+1] >> post);
+        ++(*it);
+    }
+
+    return true;
+#endif
+}
+
 #endif /* INCLUDE_GPL_DSP_DECIMATORSU_H_ */
@@ -90,7 +90,7 @@ public:
 	MessageQueue *getInputMessageQueue() { return &m_inputMessageQueue; }
 	virtual void setMessageQueueToGUI(MessageQueue *queue) = 0; // pure virtual so that child classes must have to deal with this
 	MessageQueue *getMessageQueueToGUI() { return m_guiMessageQueue; }
-    SampleSinkFifo* getSampleFifo() { return &m_sampleFifo; }
+    virtual SampleSinkFifo* getSampleFifo() { return &m_sampleFifo; } //!< devices may supply their own implementation
 
     static qint64 calculateDeviceCenterFrequency(
             quint64 centerFrequency,
@@ -18,13 +18,16 @@
 #include <dsp/downchannelizer.h>
 #include "dsp/inthalfbandfilter.h"
 #include "dsp/dspcommands.h"
+#include "util/messagepool.h"
 
 #include <QString>
 #include <QDebug>
 
 MESSAGE_CLASS_DEFINITION(DownChannelizer::MsgChannelizerNotification, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(DownChannelizer::MsgChannelizerNotification)
 
 DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
+	m_filterChain(0),
 	m_sampleSink(sampleSink),
 	m_inputSampleRate(0),
 	m_requestedOutputSampleRate(0),
@@ -38,7 +41,7 @@ DownChannelizer::DownChannelizer(BasebandSampleSink* sampleSink) :
 
 DownChannelizer::~DownChannelizer()
 {
-	freeFilterChain();
+	delete m_filterChain.fetchAndStoreOrdered(0);
 }
 
 void DownChannelizer::configure(MessageQueue* messageQueue, int sampleRate, int centerFrequency)
@@ -54,39 +57,49 @@ void DownChannelizer::feed(const SampleVector::const_iterator& begin, const Samp
 		return;
 	}
 
-	if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+	if (begin == end) {
+	    return;
+	}
+
+	// take the filter chain for the duration of the block
+	FilterStages *filterStages = m_filterChain.fetchAndStoreAcquire(0);
+
+	if ((filterStages == 0) || (filterStages->size() == 0)) // optimization when no downsampling is done anyway
 	{
 		m_sampleSink->feed(begin, end, positiveOnly);
 	}
 	else
 	{
-		m_mutex.lock();
+		int nbSamples = end - begin;
+
+		if ((int) m_sampleBuffer.size() < nbSamples/2 + 1) {
+		    m_sampleBuffer.resize(nbSamples/2 + 1); // first stage output at most
+		}
 
-		for(SampleVector::const_iterator sample = begin; sample != end; ++sample)
+		// each stage processes the whole block before passing it to the next stage
+		const Sample *in = &(*begin);
+		Sample *out = &m_sampleBuffer[0];
+
+		for (FilterStages::iterator stage = filterStages->begin(); stage != filterStages->end(); ++stage)
 		{
-			Sample s(*sample);
-			FilterStages::iterator stage = m_filterStages.begin();
-
-			for (; stage != m_filterStages.end(); ++stage)
-			{
-				if(!(*stage)->work(&s))
-				{
-					break;
-				}
-			}
-
-			if(stage == m_filterStages.end())
-			{
-			    s.m_real /= (1<<(m_filterStages.size()));
-			    s.m_imag /= (1<<(m_filterStages.size()));
-				m_sampleBuffer.push_back(s);
-			}
+		    nbSamples = stage->work(in, out, nbSamples);
+		    in = out;
 		}
 
-		m_mutex.unlock();
+		int divisor = 1<<(filterStages->size());
 
-		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.end(), positiveOnly);
-		m_sampleBuffer.clear();
+		for (int i = 0; i < nbSamples; i++)
+		{
+		    out[i].m_real /= divisor;
+		    out[i].m_imag /= divisor;
+		}
+
+		m_sampleSink->feed(m_sampleBuffer.begin(), m_sampleBuffer.begin() + nbSamples, positiveOnly);
+	}
+
+	// give the chain back unless a new one has been configured meanwhile
+	if ((filterStages != 0) && !m_filterChain.testAndSetRelease(0, filterStages)) {
+	    delete filterStages;
 	}
 }
 
@@ -162,19 +175,18 @@ void DownChannelizer::applyConfiguration()
 		return;
 	}
 
-	m_mutex.lock();
+	FilterStages *filterStages = new FilterStages();
 
-	freeFilterChain();
-
-	m_currentCenterFrequency = createFilterChain(
+	m_currentCenterFrequency = createFilterChain(*filterStages,
 		m_inputSampleRate / -2, m_inputSampleRate / 2,
 		m_requestedCenterFrequency - m_requestedOutputSampleRate / 2, m_requestedCenterFrequency + m_requestedOutputSampleRate / 2);
 
-	m_mutex.unlock();
+	//debugFilterChain(*filterStages);
 
-	//debugFilterChain();
+	m_currentOutputSampleRate = m_inputSampleRate / (1 << filterStages->size());
 
-	m_currentOutputSampleRate = m_inputSampleRate / (1 << m_filterStages.size());
+	// publish the new chain. If feed() is using the previous one it gets null here and feed() will delete it
+	delete m_filterChain.fetchAndStoreOrdered(filterStages);
 
 	qDebug() << "DownChannelizer::applyConfiguration in=" << m_inputSampleRate
 			<< ", req=" << m_requestedOutputSampleRate
@@ -188,53 +200,18 @@ void DownChannelizer::applyConfiguration()
 	}
 }
 
-#ifdef SDR_RX_SAMPLE_24BIT
 DownChannelizer::FilterStage::FilterStage(Mode mode) :
-    m_filter(new IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0),
+#ifdef SDR_RX_SAMPLE_24BIT
+    m_filter(),
     m_mode(mode),
-    m_sse(true)
-{
-    switch(mode) {
-        case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-            break;
-
-        case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-            break;
-
-        case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-            break;
-    }
-}
+    m_sse(false)
 #else
-DownChannelizer::FilterStage::FilterStage(Mode mode) :
-    m_filter(new IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>),
-    m_workFunction(0),
+    m_filter(DOWNCHANNELIZER_HB_FILTER_ORDER,
+        mode == ModeLowerHalf ? DecimatorsBlock::ModeInf : mode == ModeUpperHalf ? DecimatorsBlock::ModeSup : DecimatorsBlock::ModeCen),
     m_mode(mode),
-    m_sse(true)
-{
-    switch(mode) {
-        case ModeCenter:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateCenter;
-            break;
-
-        case ModeLowerHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateLowerHalf;
-            break;
-
-        case ModeUpperHalf:
-            m_workFunction = &IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::workDecimateUpperHalf;
-            break;
-    }
-}
+    m_sse(DecimatorsBlock::isEnabled())
 #endif
-
-DownChannelizer::FilterStage::~FilterStage()
 {
-	delete m_filter;
 }
 
 bool DownChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const
@@ -247,7 +224,7 @@ bool DownChannelizer::signalContainsChannel(Real sigStart, Real sigEnd, Real cha
 	return (sigStart <= chanStart) && (sigEnd >= chanEnd);
 }
 
-Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
+Real DownChannelizer::createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd)
 {
 	Real sigBw = sigEnd - sigStart;
 	Real safetyMargin = sigBw / 20;
@@ -261,24 +238,24 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	// check if it fits into the left half
 	if(signalContainsChannel(sigStart + safetyMargin, sigStart + sigBw / 2.0 - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take left half (rotate by +1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeLowerHalf));
-		return createFilterChain(sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
+		filterStages.push_back(FilterStage(FilterStage::ModeLowerHalf));
+		return createFilterChain(filterStages, sigStart, sigStart + sigBw / 2.0, chanStart, chanEnd);
 	}
 
 	// check if it fits into the right half
 	if(signalContainsChannel(sigEnd - sigBw / 2.0f + safetyMargin, sigEnd - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take right half (rotate by -1/4 and decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeUpperHalf));
-		return createFilterChain(sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
+		filterStages.push_back(FilterStage(FilterStage::ModeUpperHalf));
+		return createFilterChain(filterStages, sigEnd - sigBw / 2.0f, sigEnd, chanStart, chanEnd);
 	}
 
 	// check if it fits into the center
 	// Was: if(signalContainsChannel(sigStart + rot + safetyMargin, sigStart + rot + sigBw / 2.0f - safetyMargin, chanStart, chanEnd)) {
 	if(signalContainsChannel(sigStart + rot + safetyMargin, sigEnd - rot - safetyMargin, chanStart, chanEnd)) {
 		//fprintf(stderr, "-> take center half (decimate by 2)\n");
-		m_filterStages.push_back(new FilterStage(FilterStage::ModeCenter));
+		filterStages.push_back(FilterStage(FilterStage::ModeCenter));
 		// Was: return createFilterChain(sigStart + rot, sigStart + sigBw / 2.0f + rot, chanStart, chanEnd);
-		return createFilterChain(sigStart + rot, sigEnd - rot, chanStart, chanEnd);
+		return createFilterChain(filterStages, sigStart + rot, sigEnd - rot, chanStart, chanEnd);
 	}
 #endif
 	Real ofs = ((chanEnd - chanStart) / 2.0 + chanStart) - ((sigEnd - sigStart) / 2.0 + sigStart);
@@ -286,32 +263,25 @@ Real DownChannelizer::createFilterChain(Real sigStart, Real sigEnd, Real chanSta
 	return ofs;
 }
 
-void DownChannelizer::freeFilterChain()
-{
-	for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
-		delete *it;
-	m_filterStages.clear();
-}
-
-void DownChannelizer::debugFilterChain()
+void DownChannelizer::debugFilterChain(const FilterStages& filterStages)
 {
-    qDebug("DownChannelizer::debugFilterChain: %lu stages", m_filterStages.size());
+    qDebug("DownChannelizer::debugFilterChain: %lu stages", filterStages.size());
 
-    for(FilterStages::iterator it = m_filterStages.begin(); it != m_filterStages.end(); ++it)
+    for(FilterStages::const_iterator it = filterStages.begin(); it != filterStages.end(); ++it)
     {
-        switch ((*it)->m_mode)
+        switch (it->m_mode)
         {
         case FilterStage::ModeCenter:
-            qDebug("DownChannelizer::debugFilterChain: center %s", (*it)->m_sse ? "sse" : "no_sse");
+            qDebug("DownChannelizer::debugFilterChain: center %s", it->m_sse ? "sse" : "no_sse");
             break;
         case FilterStage::ModeLowerHalf:
-            qDebug("DownChannelizer::debugFilterChain: lower %s", (*it)->m_sse ? "sse" : "no_sse");
+            qDebug("DownChannelizer::debugFilterChain: lower %s", it->m_sse ? "sse" : "no_sse");
             break;
         case FilterStage::ModeUpperHalf:
-            qDebug("DownChannelizer::debugFilterChain: upper %s", (*it)->m_sse ? "sse" : "no_sse");
+            qDebug("DownChannelizer::debugFilterChain: upper %s", it->m_sse ? "sse" : "no_sse");
             break;
         default:
-            qDebug("DownChannelizer::debugFilterChain: none %s", (*it)->m_sse ? "sse" : "no_sse");
+            qDebug("DownChannelizer::debugFilterChain: none %s", it->m_sse ? "sse" : "no_sse");
             break;
         }
     }
@@ -19,11 +19,12 @@
 #define SDRBASE_DSP_DOWNCHANNELIZER_H
 
 #include <dsp/basebandsamplesink.h>
-#include <list>
-#include <QMutex>
+#include <vector>
+#include <QAtomicPointer>
 #include "export.h"
 #include "util/message.h"
 #include "dsp/inthalfbandfiltereo.h"
+#include "dsp/decimatorsblock.h"
 
 #define DOWNCHANNELIZER_HB_FILTER_ORDER 48
 
@@ -34,6 +35,7 @@ class SDRBASE_API DownChannelizer : public BasebandSampleSink {
 public:
 	class MsgChannelizerNotification : public Message {
 		MESSAGE_CLASS_DECLARATION
+		MESSAGE_CLASS_POOLED
 
 	public:
 		MsgChannelizerNotification(int samplerate, qint64 frequencyOffset) :
@@ -61,6 +63,7 @@ public:
 	void configure(MessageQueue* messageQueue, int sampleRate, int centerFrequency);
 	int getInputSampleRate() const { return m_inputSampleRate; }
 	int getRequestedCenterFrequency() const { return m_requestedCenterFrequency; }
+	const BasebandSampleSink *getSampleSink() const { return m_sampleSink; }
 
 	virtual void start();
 	virtual void stop();
@@ -76,41 +79,49 @@ protected:
 		};
 
 #ifdef SDR_RX_SAMPLE_24BIT
-        typedef bool (IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-        IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+        IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER> m_filter; // needs a 64 bit accumulator
 #else
-        typedef bool (IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>::*WorkFunction)(Sample* s);
-        IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER>* m_filter;
+        DecimatorsBlockStage m_filter; // SSE4.1 or AVX2 kernels selected at run time
 #endif
 
-		WorkFunction m_workFunction;
 		Mode m_mode;
 		bool m_sse;
 
 		FilterStage(Mode mode);
-		~FilterStage();
 
-		bool work(Sample* sample)
+		/** decimate a block by 2. in and out may be the same buffer. Returns the number of output samples */
+		int work(const Sample* in, Sample* out, int nbIn)
 		{
-			return (m_filter->*m_workFunction)(sample);
+#ifdef SDR_RX_SAMPLE_24BIT
+		    switch (m_mode)
+		    {
+		    case ModeLowerHalf:
+		        return m_filter.workDecimateLowerHalfBlock(in, out, nbIn);
+		    case ModeUpperHalf:
+		        return m_filter.workDecimateUpperHalfBlock(in, out, nbIn);
+		    case ModeCenter:
+		    default:
+		        return m_filter.workDecimateCenterBlock(in, out, nbIn);
+		    }
+#else
+		    return m_filter.decimate(in, out, nbIn);
+#endif
 		}
 	};
-	typedef std::list<FilterStage*> FilterStages;
-	FilterStages m_filterStages;
+	typedef std::vector<FilterStage> FilterStages; //!< stages stored contiguously
+	QAtomicPointer<FilterStages> m_filterChain;    //!< configuration snapshot. Taken by feed() while it runs and swapped by applyConfiguration()
 	BasebandSampleSink* m_sampleSink; //!< Demodulator
 	int m_inputSampleRate;
 	int m_requestedOutputSampleRate;
 	int m_requestedCenterFrequency;
 	int m_currentOutputSampleRate;
 	int m_currentCenterFrequency;
-	SampleVector m_sampleBuffer;
-	QMutex m_mutex;
+	SampleVector m_sampleBuffer; //!< work buffer for the whole filter chain. Only grows.
 
 	void applyConfiguration();
 	bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
-	Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
-	void freeFilterChain();
-	void debugFilterChain();
+	Real createFilterChain(FilterStages& filterStages, Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
+	void debugFilterChain(const FilterStages& filterStages);
 
 signals:
 	void inputSampleRateChanged();
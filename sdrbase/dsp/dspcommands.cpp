@@ -16,6 +16,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include "dsp/dspcommands.h"
+#include "util/messagepool.h"
 
 MESSAGE_CLASS_DEFINITION(DSPAcquisitionInit, Message)
 MESSAGE_CLASS_DEFINITION(DSPAcquisitionStart, Message)
@@ -43,7 +44,9 @@ MESSAGE_CLASS_DEFINITION(DSPRemoveAudioSink, Message)
 //MESSAGE_CLASS_DEFINITION(DSPConfigureSpectrumVis, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureCorrection, Message)
 MESSAGE_CLASS_DEFINITION(DSPEngineReport, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(DSPEngineReport)
 MESSAGE_CLASS_DEFINITION(DSPConfigureScopeVis, Message)
 MESSAGE_CLASS_DEFINITION(DSPSignalNotification, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(DSPSignalNotification)
 MESSAGE_CLASS_DEFINITION(DSPConfigureChannelizer, Message)
 MESSAGE_CLASS_DEFINITION(DSPConfigureAudio, Message)
@@ -298,6 +298,7 @@ private:
 
 class SDRBASE_API DSPEngineReport : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOLED
 
 public:
 	DSPEngineReport(int sampleRate, quint64 centerFrequency) :
@@ -337,6 +338,7 @@ private:
 
 class SDRBASE_API DSPSignalNotification : public Message {
 	MESSAGE_CLASS_DECLARATION
+	MESSAGE_CLASS_POOLED
 
 public:
 	DSPSignalNotification(int samplerate, qint64 centerFrequency) :
@@ -27,6 +27,7 @@
 #include "dsp/dspcommands.h"
 #include "samplesourcefifo.h"
 #include "threadedbasebandsamplesource.h"
+#include "util/threadroles.h"
 
 DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	QThread(parent),
@@ -38,7 +39,8 @@ DSPDeviceSinkEngine::DSPDeviceSinkEngine(uint32_t uid, QObject* parent) :
 	m_spectrumSink(0),
 	m_sampleRate(0),
 	m_centerFrequency(0),
-	m_multipleSourcesDivisionFactor(1)
+	m_multipleSourcesDivisionFactor(1),
+	m_multipleSourcesGain(1.0f)
 {
 	connect(&m_inputMessageQueue, SIGNAL(messageEnqueued()), this, SLOT(handleInputMessages()), Qt::QueuedConnection);
 	connect(&m_syncMessenger, SIGNAL(messageSent()), this, SLOT(handleSynchronousMessages()), Qt::QueuedConnection);
@@ -56,6 +58,7 @@ void DSPDeviceSinkEngine::run()
 {
 	qDebug() << "DSPDeviceSinkEngine::run";
 	m_state = StIdle;
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceDSP);
 	exec();
 }
 
@@ -177,44 +180,44 @@ void DSPDeviceSinkEngine::work(int nbWriteSamples)
 	{
 //	    qDebug("DSPDeviceSinkEngine::work: multiple channel sources handling: %u", m_multipleSourcesDivisionFactor);
 
-	    SampleVector::iterator writeBegin;
 	    SampleSourceFifo* sampleFifo = m_deviceSampleSink->getSampleFifo();
-	    sampleFifo->getWriteIterator(writeBegin);
-	    SampleVector::iterator writeAt = writeBegin;
-	    std::vector<SampleVector::iterator> sampleSourceIterators;
+	    SampleVector::iterator readUntil;
+	    unsigned int is = 0;
 
-	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it)
+	    // the blocks to be read are contiguous in the sources FIFOs (double buffers)
+	    for (ThreadedBasebandSampleSources::iterator it = m_threadedBasebandSampleSources.begin(); it != m_threadedBasebandSampleSources.end(); ++it, is++)
 	    {
-	        sampleSourceIterators.push_back(SampleVector::iterator());
-	        (*it)->getSampleSourceFifo().readAdvance(sampleSourceIterators.back(), nbWriteSamples);
-	        sampleSourceIterators.back() -= nbWriteSamples;
+	        (*it)->getSampleSourceFifo().readAdvance(readUntil, nbWriteSamples);
+	        m_mixerSources[is] = &(*(readUntil - nbWriteSamples));
+	        m_sampleMixer.setGain(is, (*it)->getMixerGain() * m_multipleSourcesGain);
 	    }
 
-	    for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it)
+	    for (BasebandSampleSources::iterator it = m_basebandSampleSources.begin(); it != m_basebandSampleSources.end(); ++it, is++)
 	    {
-            sampleSourceIterators.push_back(SampleVector::iterator());
-            (*it)->getSampleSourceFifo().readAdvance(sampleSourceIterators.back(), nbWriteSamples);
-            sampleSourceIterators.back() -= nbWriteSamples;
+	        (*it)->getSampleSourceFifo().readAdvance(readUntil, nbWriteSamples);
+	        m_mixerSources[is] = &(*(readUntil - nbWriteSamples));
+	        m_sampleMixer.setGain(is, (*it)->getMixerGain() * m_multipleSourcesGain);
 	    }
 
-	    for (int is = 0; is < nbWriteSamples; is++)
-		{
-			// pull data from sources FIFOs and merge them in the device sample FIFO
-	        for (std::vector<SampleVector::iterator>::iterator it = sampleSourceIterators.begin(); it != sampleSourceIterators.end(); ++it)
-	        {
-	            Sample s = (**it);
-	            s /= m_multipleSourcesDivisionFactor;
-	            ++(*it);
-
-	            if (it == sampleSourceIterators.begin()) {
-	                (*writeAt) = s;
-	            } else {
-	                (*writeAt) += s;
-	            }
+	    // mix straight into the device sample FIFO: up to the end of its buffer then wrapped around at start
+	    SampleVector::iterator part1Begin, part1End, part2Begin, part2End;
+	    sampleFifo->getWriteIterators(nbWriteSamples, part1Begin, part1End, part2Begin, part2End);
+	    unsigned int part1Length = part1End - part1Begin;
+
+	    if (part1Length > 0) {
+	        m_sampleMixer.mix(m_mixerSources.data(), &(*part1Begin), part1Length);
+	    }
+
+	    if (part2End != part2Begin)
+	    {
+	        for (unsigned int i = 0; i < is; i++) {
+	            m_mixerSources[i] += part1Length;
 	        }
 
-			sampleFifo->bumpIndex(writeAt);
-		}
+	        m_sampleMixer.mix(m_mixerSources.data(), &(*part2Begin), part2End - part2Begin);
+	    }
+
+	    sampleFifo->writeAdvance(nbWriteSamples);
 	}
 }
 
@@ -416,6 +419,8 @@ void DSPDeviceSinkEngine::handleSetSink(DeviceSampleSink* sink)
 
 void DSPDeviceSinkEngine::handleData(int nbSamples)
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceDSP); // role settings changed while running
+
 	if(m_state == StRunning)
 	{
 		work(nbSamples);
@@ -596,6 +601,7 @@ void DSPDeviceSinkEngine::checkNumberOfBasebandSources()
         }
 
         m_multipleSourcesDivisionFactor = 1; // for consistency but it is not used in this case
+        m_multipleSourcesGain = 1.0f;
     }
     // null or multiple channel sources handling
     else
@@ -622,6 +628,10 @@ void DSPDeviceSinkEngine::checkNumberOfBasebandSources()
             m_multipleSourcesDivisionFactor = 1<<nbSources;
         }
 
+        m_multipleSourcesGain = 1.0f / m_multipleSourcesDivisionFactor;
+        m_sampleMixer.setNbSources(nbSources);
+        m_mixerSources.resize(nbSources);
+
         if (nbSources > 1) {
             connect(sampleFifo, SIGNAL(dataWrite(int)), this, SLOT(handleData(int)), Qt::QueuedConnection);
         }
@@ -25,8 +25,10 @@
 #include <stdint.h>
 #include <list>
 #include <map>
+#include <vector>
 #include "dsp/dsptypes.h"
 #include "dsp/fftwindow.h"
+#include "dsp/samplemixer.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
@@ -115,6 +117,9 @@ private:
 	uint32_t m_sampleRate;
 	quint64 m_centerFrequency;
 	uint32_t m_multipleSourcesDivisionFactor;
+	float m_multipleSourcesGain;               //!< reciprocal of the division factor
+	SampleMixer m_sampleMixer;                 //!< sums the sources blocks when there are several sources
+	std::vector<const Sample*> m_mixerSources; //!< blocks of the sources to be mixed
 
 	void run();
 	void work(int nbWriteSamples); //!< transfer samples from beseband sources to sink if in running state
@@ -22,10 +22,17 @@
 #include <dsp/downchannelizer.h>
 #include <stdio.h>
 #include <QDebug>
+#include <QElapsedTimer>
 #include "dsp/dspcommands.h"
-#include "util/fixed.h"
 #include "samplesinkfifo.h"
 #include "threadedbasebandsamplesink.h"
+#include "util/threadroles.h"
+
+#include "SWGDeviceSet.h"
+#include "SWGDSPSinkStats.h"
+#include "SWGSampleFifoStats.h"
+
+#define DSPDEVICESOURCEENGINE_RING_SIZE (1<<19)
 
 DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	QThread(parent),
@@ -34,6 +41,7 @@ DSPDeviceSourceEngine::DSPDeviceSourceEngine(uint uid, QObject* parent) :
 	m_deviceSampleSource(0),
 	m_sampleSourceSequence(0),
 	m_basebandSampleSinks(),
+	m_sampleRing(DSPDEVICESOURCEENGINE_RING_SIZE),
 	m_sampleRate(0),
 	m_centerFrequency(0),
 	m_dcOffsetCorrection(false),
@@ -60,6 +68,7 @@ void DSPDeviceSourceEngine::run()
 {
 	qDebug() << "DSPDeviceSourceEngine::run";
 	m_state = StIdle;
+	ThreadRoles::applyToCurrentThread(ThreadRoles::RoleDeviceDSP);
     exec();
 }
 
@@ -174,91 +183,7 @@ QString DSPDeviceSourceEngine::sourceDeviceDescription()
 
 void DSPDeviceSourceEngine::iqCorrections(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
 {
-    for(SampleVector::iterator it = begin; it < end; it++)
-    {
-        m_iBeta(it->real());
-        m_qBeta(it->imag());
-
-        if (imbalanceCorrection)
-        {
-#if IMBALANCE_INT
-            // acquisition
-            int64_t xi = (it->m_real - (int32_t) m_iBeta) << 5;
-            int64_t xq = (it->m_imag - (int32_t) m_qBeta) << 5;
-
-            // phase imbalance
-            m_avgII((xi*xi)>>28); // <I", I">
-            m_avgIQ((xi*xq)>>28); // <I", Q">
-
-            if ((int64_t) m_avgII != 0)
-            {
-                int64_t phi = (((int64_t) m_avgIQ)<<28) / (int64_t) m_avgII;
-                m_avgPhi(phi);
-            }
-
-            int64_t corrPhi = (((int64_t) m_avgPhi) * xq) >> 28;  //(m_avgPhi.asDouble()/16777216.0) * ((double) xq);
-
-            int64_t yi = xi - corrPhi;
-            int64_t yq = xq;
-
-            // amplitude I/Q imbalance
-            m_avgII2((yi*yi)>>28); // <I, I>
-            m_avgQQ2((yq*yq)>>28); // <Q, Q>
-
-            if ((int64_t) m_avgQQ2 != 0)
-            {
-                int64_t a = (((int64_t) m_avgII2)<<28) / (int64_t) m_avgQQ2;
-                Fixed<int64_t, 28> fA(Fixed<int64_t, 28>::internal(), a);
-                Fixed<int64_t, 28> sqrtA = sqrt((Fixed<int64_t, 28>) fA);
-                m_avgAmp(sqrtA.as_internal());
-            }
-
-            int64_t zq = (((int64_t) m_avgAmp) * yq) >> 28;
-
-            it->m_real = yi >> 5;
-            it->m_imag = zq >> 5;
-
-#else
-            // DC correction and conversion
-            float xi = (it->m_real - (int32_t) m_iBeta) / SDR_RX_SCALEF;
-            float xq = (it->m_imag - (int32_t) m_qBeta) / SDR_RX_SCALEF;
-
-            // phase imbalance
-            m_avgII(xi*xi); // <I", I">
-            m_avgIQ(xi*xq); // <I", Q">
-
-
-            if (m_avgII.asDouble() != 0) {
-                m_avgPhi(m_avgIQ.asDouble()/m_avgII.asDouble());
-            }
-
-            float& yi = xi; // the in phase remains the reference
-            float yq = xq - m_avgPhi.asDouble()*xi;
-
-            // amplitude I/Q imbalance
-            m_avgII2(yi*yi); // <I, I>
-            m_avgQQ2(yq*yq); // <Q, Q>
-
-            if (m_avgQQ2.asDouble() != 0) {
-                m_avgAmp(sqrt(m_avgII2.asDouble() / m_avgQQ2.asDouble()));
-            }
-
-            // final correction
-            float& zi = yi; // the in phase remains the reference
-            float zq = m_avgAmp.asDouble() * yq;
-
-            // convert and store
-            it->m_real = zi * SDR_RX_SCALEF;
-            it->m_imag = zq * SDR_RX_SCALEF;
-#endif
-        }
-        else
-        {
-            // DC correction only
-            it->m_real -= (int32_t) m_iBeta;
-            it->m_imag -= (int32_t) m_qBeta;
-        }
-    }
+    m_iqCorrector.process(begin, end, imbalanceCorrection);
 }
 
 void DSPDeviceSourceEngine::dcOffset(SampleVector::iterator begin, SampleVector::iterator end)
@@ -326,7 +251,6 @@ void DSPDeviceSourceEngine::work()
 {
 	SampleSinkFifo* sampleFifo = m_deviceSampleSource->getSampleFifo();
 	std::size_t samplesDone = 0;
-	bool positiveOnly = false;
 
 	while ((sampleFifo->fill() > 0) && (m_inputMessageQueue.size() == 0) && (samplesDone < m_sampleRate))
 	{
@@ -340,65 +264,13 @@ void DSPDeviceSourceEngine::work()
 		// first part of FIFO data
 		if (part1begin != part1end)
 		{
-			// correct stuff
-            if (m_dcOffsetCorrection)
-            {
-                iqCorrections(part1begin, part1end, m_iqImbalanceCorrection);
-            }
-
-//			if (m_dcOffsetCorrection)
-//			{
-//				dcOffset(part1begin, part1end);
-//			}
-//
-//			if (m_iqImbalanceCorrection)
-//			{
-//				imbalance(part1begin, part1end);
-//			}
-
-			// feed data to direct sinks
-			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
-			{
-				(*it)->feed(part1begin, part1end, positiveOnly);
-			}
-
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
-			{
-				(*it)->feed(part1begin, part1end, positiveOnly);
-			}
+			processSamples(part1begin, part1end);
 		}
 
 		// second part of FIFO data (used when block wraps around)
 		if(part2begin != part2end)
 		{
-			// correct stuff
-            if (m_dcOffsetCorrection)
-            {
-                iqCorrections(part2begin, part2end, m_iqImbalanceCorrection);
-            }
-
-//            if (m_dcOffsetCorrection)
-//			{
-//				dcOffset(part2begin, part2end);
-//			}
-//
-//			if (m_iqImbalanceCorrection)
-//			{
-//				imbalance(part2begin, part2end);
-//			}
-
-			// feed data to direct sinks
-			for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); it++)
-			{
-				(*it)->feed(part2begin, part2end, positiveOnly);
-			}
-
-			// feed data to threaded sinks
-			for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
-			{
-				(*it)->feed(part2begin, part2end, positiveOnly);
-			}
+			processSamples(part2begin, part2end);
 		}
 
 		// adjust FIFO pointers
@@ -407,6 +279,209 @@ void DSPDeviceSourceEngine::work()
 	}
 }
 
+void DSPDeviceSourceEngine::processSamples(SampleVector::iterator begin, SampleVector::iterator end)
+{
+	bool positiveOnly = false;
+
+	// correct stuff
+	if (m_dcOffsetCorrection)
+	{
+		iqCorrections(begin, end, m_iqImbalanceCorrection);
+	}
+
+//	if (m_dcOffsetCorrection)
+//	{
+//		dcOffset(begin, end);
+//	}
+//
+//	if (m_iqImbalanceCorrection)
+//	{
+//		imbalance(begin, end);
+//	}
+
+	// feed data to direct sinks
+	QElapsedTimer timer;
+
+	for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
+	{
+		timer.start();
+		(*it)->feed(begin, end, positiveOnly);
+		qint64 elapsedNs = timer.nsecsElapsed();
+		QMutexLocker mutexLocker(&m_sinksStatsMutex);
+		m_basebandSampleSinksStats[*it].add(end - begin, elapsedNs);
+	}
+
+	// feed data to threaded sinks through the shared ring
+	if (m_threadedBasebandSampleSinks.size() > 0)
+	{
+		m_sampleRing.write(begin, end);
+	}
+}
+
+bool DSPDeviceSourceEngine::startOffline(uint sampleRate, quint64 centerFrequency)
+{
+	qDebug("DSPDeviceSourceEngine::startOffline: sampleRate: %u centerFrequency: %llu", sampleRate, centerFrequency);
+
+	if (m_state == StRunning)
+	{
+		qWarning("DSPDeviceSourceEngine::startOffline: acquisition is running");
+		return false;
+	}
+
+	m_sampleRate = sampleRate;
+	m_centerFrequency = centerFrequency;
+	DSPSignalNotification notif(m_sampleRate, m_centerFrequency);
+
+	for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
+	{
+		(*it)->handleMessage(notif);
+		(*it)->start();
+	}
+
+	for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+	{
+		(*it)->handleSinkMessage(notif);
+		(*it)->start();
+	}
+
+	return true;
+}
+
+void DSPDeviceSourceEngine::feedOffline(SampleVector::iterator begin, SampleVector::iterator end)
+{
+	uint chunkSize = m_sampleRing.size() / 2; // never let the ring skip a reader
+
+	while (begin < end)
+	{
+		SampleVector::iterator chunkEnd = (uint) (end - begin) > chunkSize ? begin + chunkSize : end;
+		processSamples(begin, chunkEnd);
+
+		while (!m_sampleRing.waitConsumed(10)) { // threaded sinks are still busy
+		}
+
+		begin = chunkEnd;
+	}
+}
+
+void DSPDeviceSourceEngine::stopOffline()
+{
+	qDebug("DSPDeviceSourceEngine::stopOffline");
+
+	for (BasebandSampleSinks::const_iterator it = m_basebandSampleSinks.begin(); it != m_basebandSampleSinks.end(); ++it)
+	{
+		(*it)->stop();
+	}
+
+	for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+	{
+		(*it)->stop();
+	}
+
+	m_sampleRate = 0;
+}
+
+void DSPDeviceSourceEngine::getSinksStats(std::vector<SinkStats>& stats)
+{
+	stats.clear();
+	// called from other threads (WebAPI): the sinks cannot be added or removed while the snapshot is taken
+	QMutexLocker mutexLocker(&m_sinksStatsMutex);
+
+	for (std::map<const BasebandSampleSink*, SampleSinkFeedStats>::const_iterator it = m_basebandSampleSinksStats.begin(); it != m_basebandSampleSinksStats.end(); ++it)
+	{
+		stats.push_back(SinkStats());
+		stats.back().m_name = it->first->objectName();
+		stats.back().m_sink = it->first;
+		stats.back().m_feedStats = it->second;
+	}
+
+	for (ThreadedBasebandSampleSinks::const_iterator it = m_threadedBasebandSampleSinks.begin(); it != m_threadedBasebandSampleSinks.end(); ++it)
+	{
+		stats.push_back(SinkStats());
+		SinkStats& sinkStats = stats.back();
+		sinkStats.m_name = (*it)->getSampleSinkObjectName();
+		sinkStats.m_sink = (*it)->getSink();
+		sinkStats.m_threaded = true;
+		(*it)->getFeedStats(sinkStats.m_feedStats);
+		(*it)->getFifoStats(sinkStats.m_fifoStats);
+		const DownChannelizer *channelizer = dynamic_cast<const DownChannelizer*>(sinkStats.m_sink);
+
+		if (channelizer) {
+			sinkStats.m_channel = channelizer->getSampleSink();
+		}
+	}
+}
+
+bool DSPDeviceSourceEngine::getSourceFifoStats(SampleFifoStats& stats)
+{
+	if (!m_deviceSampleSource) {
+		return false;
+	}
+
+	m_deviceSampleSource->getSampleFifo()->getStats(stats);
+	return true;
+}
+
+void DSPDeviceSourceEngine::webapiFormatStats(SWGSDRangel::SWGDeviceSet& response)
+{
+	SampleFifoStats fifoStats;
+
+	if (getSourceFifoStats(fifoStats)) {
+		webapiFormatFifoStats(*response.getSampleFifo(), fifoStats);
+	}
+
+	std::vector<SinkStats> sinksStats;
+	getSinksStats(sinksStats);
+	QList<SWGSDRangel::SWGDSPSinkStats*> *dspSinks = response.getDspSinks();
+
+	for (std::vector<SinkStats>::const_iterator it = sinksStats.begin(); it != sinksStats.end(); ++it)
+	{
+		dspSinks->append(new SWGSDRangel::SWGDSPSinkStats());
+		webapiFormatSinkStats(*dspSinks->back(), *it);
+	}
+}
+
+bool DSPDeviceSourceEngine::webapiFormatChannelStats(SWGSDRangel::SWGDSPSinkStats& response, const BasebandSampleSink *channel)
+{
+	std::vector<SinkStats> sinksStats;
+	getSinksStats(sinksStats);
+
+	for (std::vector<SinkStats>::const_iterator it = sinksStats.begin(); it != sinksStats.end(); ++it)
+	{
+		if ((it->m_channel == channel) || (it->m_sink == channel))
+		{
+			webapiFormatSinkStats(response, *it);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void DSPDeviceSourceEngine::webapiFormatFifoStats(SWGSDRangel::SWGSampleFifoStats& response, const SampleFifoStats& stats)
+{
+	response.setSize(stats.m_size);
+	response.setFill(stats.m_fill);
+	response.setHighWater(stats.m_highWater);
+	response.setOverflowCount(stats.m_overflowCount);
+	response.setDroppedSamples(stats.m_droppedSamples);
+	response.setUnderflowCount(stats.m_underflowCount);
+}
+
+void DSPDeviceSourceEngine::webapiFormatSinkStats(SWGSDRangel::SWGDSPSinkStats& response, const SinkStats& stats)
+{
+	response.init();
+	*response.getName() = stats.m_name;
+	response.setThreaded(stats.m_threaded ? 1 : 0);
+	response.setNbSamples(stats.m_feedStats.m_nbSamples);
+	response.setProcessingTimeNs(stats.m_feedStats.m_processingTimeNs);
+	response.setMaxLatencyNs(stats.m_feedStats.m_maxLatencyNs);
+	response.setThreadCpuTimeNs(stats.m_feedStats.m_threadCpuTimeNs);
+
+	if (stats.m_threaded) {
+		webapiFormatFifoStats(*response.getFifo(), stats.m_fifoStats);
+	}
+}
+
 // notStarted -> idle -> init -> running -+
 //                ^                       |
 //                +-----------------------+
@@ -598,6 +673,8 @@ void DSPDeviceSourceEngine::handleSetSource(DeviceSampleSource* source)
 
 void DSPDeviceSourceEngine::handleData()
 {
+	ThreadRoles::applyOnce(ThreadRoles::RoleDeviceDSP); // role settings changed while running
+
 	if(m_state == StRunning)
 	{
 		work();
@@ -642,6 +719,9 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 	{
 		BasebandSampleSink* sink = ((DSPAddBasebandSampleSink*) message)->getSampleSink();
 		m_basebandSampleSinks.push_back(sink);
+		m_sinksStatsMutex.lock();
+		m_basebandSampleSinksStats[sink] = SampleSinkFeedStats();
+		m_sinksStatsMutex.unlock();
         // initialize sample rate and center frequency in the sink:
         DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
         sink->handleMessage(msg);
@@ -659,11 +739,17 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 		}
 
 		m_basebandSampleSinks.remove(sink);
+		m_sinksStatsMutex.lock();
+		m_basebandSampleSinksStats.erase(sink);
+		m_sinksStatsMutex.unlock();
 	}
 	else if (DSPAddThreadedBasebandSampleSink::match(*message))
 	{
 		ThreadedBasebandSampleSink *threadedSink = ((DSPAddThreadedBasebandSampleSink*) message)->getThreadedSampleSink();
+		threadedSink->attachRing(&m_sampleRing);
+		m_sinksStatsMutex.lock();
 		m_threadedBasebandSampleSinks.push_back(threadedSink);
+		m_sinksStatsMutex.unlock();
 		// initialize sample rate and center frequency in the sink:
 		DSPSignalNotification msg(m_sampleRate, m_centerFrequency);
 		threadedSink->handleSinkMessage(msg);
@@ -676,7 +762,10 @@ void DSPDeviceSourceEngine::handleSynchronousMessages()
 	{
 		ThreadedBasebandSampleSink* threadedSink = ((DSPRemoveThreadedBasebandSampleSink*) message)->getThreadedSampleSink();
 		threadedSink->stop();
+		threadedSink->detachRing();
+		m_sinksStatsMutex.lock();
 		m_threadedBasebandSampleSinks.remove(threadedSink);
+		m_sinksStatsMutex.unlock();
 	}
 
 	m_syncMessenger.done(m_state);
@@ -712,12 +801,7 @@ void DSPDeviceSourceEngine::handleInputMessages()
 				m_imbalance = 65536;
 			}
 
-			m_avgAmp.reset();
-			m_avgII.reset();
-			m_avgII2.reset();
-			m_avgIQ.reset();
-			m_avgPhi.reset();
-			m_avgQQ2.reset();
+			m_iqCorrector.reset();
 			m_iBeta.reset();
 			m_qBeta.reset();
 
@@ -22,17 +22,29 @@
 #include <QTimer>
 #include <QMutex>
 #include <QWaitCondition>
+#include <vector>
+#include <map>
 #include "dsp/dsptypes.h"
+#include "dsp/dspstats.h"
 #include "dsp/fftwindow.h"
+#include "dsp/samplesinkring.h"
 #include "util/messagequeue.h"
 #include "util/syncmessenger.h"
 #include "export.h"
 #include "util/movingaverage.h"
+#include "dsp/iqcorrector.h"
 
 class DeviceSampleSource;
 class BasebandSampleSink;
 class ThreadedBasebandSampleSink;
 
+namespace SWGSDRangel
+{
+    class SWGDeviceSet;
+    class SWGDSPSinkStats;
+    class SWGSampleFifoStats;
+}
+
 class SDRBASE_API DSPDeviceSourceEngine : public QThread {
 	Q_OBJECT
 
@@ -73,6 +85,31 @@ public:
 
 	State state() const { return m_state; } //!< Return DSP engine current state
 
+	/**
+	 * Offline processing: the samples are pushed by the caller instead of being taken from the device FIFO.
+	 * The acquisition must not be running and sinks must not be added or removed meanwhile.
+	 */
+	bool startOffline(uint sampleRate, quint64 centerFrequency); //!< Notify and start all sinks
+	void feedOffline(SampleVector::iterator begin, SampleVector::iterator end); //!< Process samples. Returns when all threaded sinks have consumed them.
+	void stopOffline(); //!< Stop all sinks
+
+	struct SinkStats
+	{
+		QString m_name;
+		const BasebandSampleSink *m_sink;    //!< for a threaded sink the sink it runs in its thread
+		const BasebandSampleSink *m_channel; //!< for a threaded sink running a channelizer the channel it feeds else 0
+		bool m_threaded;
+		SampleSinkFeedStats m_feedStats;
+		SampleFifoStats m_fifoStats;         //!< threaded sinks only
+
+		SinkStats() : m_sink(0), m_channel(0), m_threaded(false) {}
+	};
+
+	void getSinksStats(std::vector<SinkStats>& stats); //!< Processing statistics of the direct sinks then of the threaded sinks (channels) in the order they were added
+	bool getSourceFifoStats(SampleFifoStats& stats);   //!< Health of the FIFO between the device and this engine. Returns false if there is no device.
+	void webapiFormatStats(SWGSDRangel::SWGDeviceSet& response); //!< Fill the source FIFO and DSP sinks statistics of a device set
+	bool webapiFormatChannelStats(SWGSDRangel::SWGDSPSinkStats& response, const BasebandSampleSink *channel); //!< Returns false if the channel is not fed by this engine
+
 	QString errorMessage(); //!< Return the current error message
 	QString sourceDeviceDescription(); //!< Return the source device description
 
@@ -92,9 +129,12 @@ private:
 
 	typedef std::list<BasebandSampleSink*> BasebandSampleSinks;
 	BasebandSampleSinks m_basebandSampleSinks; //!< sample sinks within main thread (usually spectrum, file output)
+	std::map<const BasebandSampleSink*, SampleSinkFeedStats> m_basebandSampleSinksStats; //!< feed statistics of the direct sinks
+	QMutex m_sinksStatsMutex; //!< protects the statistics and the lists of sinks read by the WebAPI thread
 
 	typedef std::list<ThreadedBasebandSampleSink*> ThreadedBasebandSampleSinks;
 	ThreadedBasebandSampleSinks m_threadedBasebandSampleSinks; //!< sample sinks on their own threads (usually channels)
+	SampleSinkRing m_sampleRing; //!< baseband ring shared by all threaded sinks: device samples are copied once whatever the number of channels
 
 	uint m_sampleRate;
 	quint64 m_centerFrequency;
@@ -106,24 +146,7 @@ private:
 	MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
     MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
 
-#if IMBALANCE_INT
-    // Fixed point DC + IQ corrections
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgIQ;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgPhi;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgII2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgQQ2;
-    MovingAverageUtil<int64_t, int64_t, 128> m_avgAmp;
-
-#else
-    // Floating point DC + IQ corrections
-    MovingAverageUtil<float, double, 128> m_avgII;
-    MovingAverageUtil<float, double, 128> m_avgIQ;
-    MovingAverageUtil<float, double, 128> m_avgII2;
-    MovingAverageUtil<float, double, 128> m_avgQQ2;
-    MovingAverageUtil<double, double, 128> m_avgPhi;
-    MovingAverageUtil<double, double, 128> m_avgAmp;
-#endif
+    IQCorrector m_iqCorrector; //!< block DC and IQ imbalance correction
 
     qint32 m_iRange;
 	qint32 m_qRange;
@@ -135,6 +158,7 @@ private:
 	void dcOffset(SampleVector::iterator begin, SampleVector::iterator end);
 	void imbalance(SampleVector::iterator begin, SampleVector::iterator end);
 	void work(); //!< transfer samples from source to sinks if in running state
+	void processSamples(SampleVector::iterator begin, SampleVector::iterator end); //!< corrections then feed all sinks
 
 	State gotoIdle();     //!< Go to the idle state
 	State gotoInit();     //!< Go to the acquisition init state from idle
@@ -147,6 +171,9 @@ private slots:
 	void handleData(); //!< Handle data when samples from source FIFO are ready to be processed
 	void handleInputMessages(); //!< Handle input message queue
 	void handleSynchronousMessages(); //!< Handle synchronous messages with the thread
+
+	static void webapiFormatFifoStats(SWGSDRangel::SWGSampleFifoStats& response, const SampleFifoStats& stats);
+	static void webapiFormatSinkStats(SWGSDRangel::SWGDSPSinkStats& response, const SinkStats& stats);
 };
 
 #endif // INCLUDE_DSPDEVICEENGINE_H
@@ -17,20 +17,37 @@
 
 #include <QGlobalStatic>
 #include <QThread>
+#include <QDir>
+#include <QStandardPaths>
 
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#ifdef USE_FFTW
+#include "dsp/fftwengine.h"
+#endif
 
 
 DSPEngine::DSPEngine() :
     m_deviceSourceEnginesUIDSequence(0),
     m_deviceSinkEnginesUIDSequence(0),
     m_audioInputDeviceIndex(-1),    // default device
-    m_audioOutputDeviceIndex(-1)    // default device
+    m_audioOutputDeviceIndex(-1),   // default device
+    m_recordDirectIO(false)
 {
 	m_dvSerialSupport = false;
     m_masterTimer.start(50);
+
+#ifdef USE_FFTW
+    // FFTW wisdom store saves the expensive patient planning across runs
+    QString wisdomDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+
+    if (!wisdomDir.isEmpty() && QDir().mkpath(wisdomDir))
+    {
+        FFTWEngine::setWisdomFileName(wisdomDir + "/fftw-wisdom");
+        FFTWEngine::importWisdom();
+    }
+#endif
 }
 
 DSPEngine::~DSPEngine()
@@ -42,6 +59,12 @@ DSPEngine::~DSPEngine()
         delete *it;
         ++it;
     }
+
+#ifdef USE_FFTW
+    FFTWEngine::stopPrePlanning();
+    FFTWEngine::exportWisdom();
+    FFTWEngine::logPlanStats();
+#endif
 }
 
 Q_GLOBAL_STATIC(DSPEngine, dspEngine)
@@ -86,6 +109,24 @@ void DSPEngine::removeLastDeviceSinkEngine()
     }
 }
 
+void DSPEngine::setFFTWPrePlanning(bool prePlanning)
+{
+#ifdef USE_FFTW
+    if (prePlanning) {
+        FFTWEngine::startPrePlanning();
+    } else {
+        FFTWEngine::stopPrePlanning();
+    }
+#else
+    (void) prePlanning;
+#endif
+}
+
+void DSPEngine::setDSPScheduler(int nbThreads, bool pinCores)
+{
+    m_scheduler.configure(nbThreads, pinCores);
+}
+
 DSPDeviceSourceEngine *DSPEngine::getDeviceSourceEngineByUID(uint uid)
 {
     std::vector<DSPDeviceSourceEngine*>::iterator it = m_deviceSourceEngines.begin();
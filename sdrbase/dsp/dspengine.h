@@ -25,6 +25,7 @@
 #include "audio/audiodevicemanager.h"
 #include "audio/audiooutput.h"
 #include "audio/audioinput.h"
+#include "dsp/dspscheduler.h"
 #include "export.h"
 #ifdef DSD_USE_SERIALDV
 #include "dsp/dvserialengine.h"
@@ -73,6 +74,14 @@ public:
 
     const QTimer& getMasterTimer() const { return m_masterTimer; }
 
+    void setFFTWPrePlanning(bool prePlanning); //!< Plan the common FFT sizes in the background so that the wisdom store is filled
+
+    DSPScheduler *getScheduler() { return &m_scheduler; }
+    void setDSPScheduler(int nbThreads, bool pinCores); //!< Run the channels in a pool of nbThreads threads (0: one thread per channel, negative: one per core)
+
+    void setRecordDirectIO(bool directIO) { m_recordDirectIO = directIO; } //!< File recordings bypass the page cache (Linux). Applies to the next recording
+    bool getRecordDirectIO() const { return m_recordDirectIO; }
+
 private:
 	std::vector<DSPDeviceSourceEngine*> m_deviceSourceEngines;
 	uint m_deviceSourceEnginesUIDSequence;
@@ -82,7 +91,9 @@ private:
     int m_audioInputDeviceIndex;
     int m_audioOutputDeviceIndex;
     QTimer m_masterTimer;
+    DSPScheduler m_scheduler;
 	bool m_dvSerialSupport;
+    bool m_recordDirectIO;
 #ifdef DSD_USE_SERIALDV
 	DVSerialEngine m_dvSerialEngine;
 #endif
@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QMutexLocker>
+#include <QMetaObject>
+#include <QDebug>
+
+#include "util/threadroles.h"
+#include "dspscheduler.h"
+
+DSPSchedulerThread::DSPSchedulerThread(int core, QObject *parent) :
+    QThread(parent),
+    m_core(core)
+{
+}
+
+void DSPSchedulerThread::run()
+{
+    ThreadRoles::applyToCurrentThread(ThreadRoles::RoleChannelDSP);
+
+    if ((m_core >= 0) && !ThreadRoles::setCurrentThreadAffinity(((quint64) 1) << m_core)) {
+        qWarning("DSPSchedulerThread::run: cannot pin thread to core %d", m_core);
+    }
+
+    exec();
+}
+
+DSPScheduler::DSPScheduler() :
+    m_nbThreads(0),
+    m_pinCores(false),
+    m_configChanged(false),
+    m_nbClients(0)
+{
+}
+
+DSPScheduler::~DSPScheduler()
+{
+    stopWorkers();
+}
+
+void DSPScheduler::configure(int nbThreads, bool pinCores)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (nbThreads < 0) {
+        nbThreads = QThread::idealThreadCount() > 0 ? QThread::idealThreadCount() : 1;
+    }
+
+    if ((nbThreads == m_nbThreads) && (pinCores == m_pinCores)) {
+        return;
+    }
+
+    qDebug("DSPScheduler::configure: %d threads%s", nbThreads, pinCores ? " pinned to cores" : "");
+    m_nbThreads = nbThreads;
+    m_pinCores = pinCores;
+
+    if (m_nbClients == 0) {
+        stopWorkers(); // threads are started on demand
+    } else {
+        m_configChanged = true; // wait until the channels using the pool are gone
+    }
+}
+
+int DSPScheduler::getNbThreads()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_workers.size();
+}
+
+QThread *DSPScheduler::acquireThread()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_configChanged && (m_nbClients == 0))
+    {
+        stopWorkers();
+        m_configChanged = false;
+    }
+
+    if (m_workers.size() == 0)
+    {
+        if (m_nbThreads <= 0) {
+            return 0;
+        }
+
+        startWorkers();
+    }
+
+    Worker *leastLoaded = &m_workers[0];
+
+    for (std::vector<Worker>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        if (it->m_nbClients < leastLoaded->m_nbClients) {
+            leastLoaded = &(*it);
+        }
+    }
+
+    leastLoaded->m_nbClients++;
+    m_nbClients++;
+    return leastLoaded->m_thread;
+}
+
+void DSPScheduler::releaseThread(QThread *thread)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    Worker *worker = findWorker(thread);
+
+    if (worker)
+    {
+        worker->m_nbClients--;
+        m_nbClients--;
+    }
+}
+
+void DSPScheduler::sync(QThread *thread)
+{
+    DSPSchedulerWorker *worker;
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        Worker *w = findWorker(thread);
+
+        if (!w || (QThread::currentThread() == thread)) {
+            return;
+        }
+
+        worker = w->m_worker;
+    }
+
+    QMetaObject::invokeMethod(worker, "sync", Qt::BlockingQueuedConnection);
+}
+
+void DSPScheduler::recall(QObject *object, QThread *thread, QThread *target)
+{
+    DSPSchedulerWorker *worker;
+
+    if (QThread::currentThread() == thread)
+    {
+        object->moveToThread(target);
+        return;
+    }
+
+    {
+        QMutexLocker mutexLocker(&m_mutex);
+        Worker *w = findWorker(thread);
+
+        if (!w) {
+            return;
+        }
+
+        worker = w->m_worker;
+    }
+
+    QMutexLocker mutexLocker(&m_recallMutex);
+    worker->m_recallObject = object;
+    worker->m_recallTarget = target;
+    QMetaObject::invokeMethod(worker, "recall", Qt::BlockingQueuedConnection);
+}
+
+void DSPScheduler::startWorkers()
+{
+    std::vector<int> cores; // cores of the channel DSP role or all cores
+    quint64 affinityMask = ThreadRoles::getRoleSettings(ThreadRoles::RoleChannelDSP).m_affinityMask;
+
+    for (int core = 0; core < 64; core++)
+    {
+        if (affinityMask ? (affinityMask & (((quint64) 1) << core)) != 0 : core < QThread::idealThreadCount()) {
+            cores.push_back(core);
+        }
+    }
+
+    for (int i = 0; i < m_nbThreads; i++)
+    {
+        Worker worker;
+        worker.m_thread = new DSPSchedulerThread(m_pinCores && (cores.size() > 0) ? cores[i % cores.size()] : -1);
+        worker.m_thread->setObjectName(QString("DSPScheduler%1").arg(i));
+        worker.m_worker = new DSPSchedulerWorker();
+        worker.m_worker->moveToThread(worker.m_thread);
+        worker.m_nbClients = 0;
+        worker.m_thread->start();
+        m_workers.push_back(worker);
+    }
+
+    qDebug("DSPScheduler::startWorkers: %d threads started", m_nbThreads);
+}
+
+void DSPScheduler::stopWorkers()
+{
+    for (std::vector<Worker>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        it->m_thread->exit();
+        it->m_thread->wait();
+        delete it->m_worker;
+        delete it->m_thread;
+    }
+
+    if (m_workers.size() > 0) {
+        qDebug("DSPScheduler::stopWorkers: %u threads stopped", (unsigned int) m_workers.size());
+    }
+
+    m_workers.clear();
+}
+
+DSPScheduler::Worker *DSPScheduler::findWorker(QThread *thread)
+{
+    for (std::vector<Worker>::iterator it = m_workers.begin(); it != m_workers.end(); ++it)
+    {
+        if (it->m_thread == thread) {
+            return &(*it);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DSPSCHEDULER_H_
+#define SDRBASE_DSP_DSPSCHEDULER_H_
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <vector>
+
+#include "export.h"
+
+/**
+ * Thread of the DSP scheduler pool. Runs with the channel DSP thread role settings and is
+ * optionally pinned to one of the cores of this role.
+ */
+class SDRBASE_API DSPSchedulerThread : public QThread {
+    Q_OBJECT
+
+public:
+    DSPSchedulerThread(int core, QObject *parent = 0);
+
+protected:
+    void run();
+
+private:
+    int m_core; //!< -1 for no pinning
+};
+
+/**
+ * Lives in a thread of the pool to run operations that must be done in that thread
+ */
+class SDRBASE_API DSPSchedulerWorker : public QObject {
+    Q_OBJECT
+
+public:
+    QObject *m_recallObject;
+    QThread *m_recallTarget;
+
+    DSPSchedulerWorker() : m_recallObject(0), m_recallTarget(0) {}
+
+public slots:
+    void sync() {}
+    void recall() { m_recallObject->moveToThread(m_recallTarget); }
+};
+
+/**
+ * Optional pool of threads shared by the threaded channel sinks and sources. When enabled a channel
+ * does not get a thread of its own but runs in the pool thread serving the fewest channels. A channel
+ * always stays in the same thread so its samples and messages are processed in order.
+ */
+class SDRBASE_API DSPScheduler {
+public:
+    DSPScheduler();
+    ~DSPScheduler();
+
+    void configure(int nbThreads, bool pinCores); //!< 0 disables the pool, negative for one thread per core. Applied when no channel uses the pool.
+    int getNbThreads(); //!< threads of the running pool
+
+    QThread *acquireThread();              //!< Thread serving the fewest channels. 0 if the pool is disabled.
+    void releaseThread(QThread *thread);   //!< A channel does not run in this thread any more
+    void sync(QThread *thread);            //!< Returns when the events posted so far to the objects living in this thread have been processed
+    void recall(QObject *object, QThread *thread, QThread *target); //!< Move an object of this pool thread to the target thread
+
+private:
+    struct Worker
+    {
+        DSPSchedulerThread *m_thread;
+        DSPSchedulerWorker *m_worker;
+        int m_nbClients;
+    };
+
+    std::vector<Worker> m_workers;
+    int m_nbThreads;
+    bool m_pinCores;
+    bool m_configChanged;
+    int m_nbClients;
+    QMutex m_mutex;
+    QMutex m_recallMutex;
+
+    void startWorkers();
+    void stopWorkers();
+    Worker *findWorker(QThread *thread);
+};
+
+#endif /* SDRBASE_DSP_DSPSCHEDULER_H_ */
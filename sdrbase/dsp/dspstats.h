@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_DSPSTATS_H_
+#define SDRBASE_DSP_DSPSTATS_H_
+
+#include <QtGlobal>
+
+#include "export.h"
+
+/**
+ * Health of a sample FIFO or of the view a reader has of a shared sample ring
+ */
+struct SDRBASE_API SampleFifoStats
+{
+    uint m_size;               //!< capacity in samples
+    uint m_fill;               //!< samples waiting to be read
+    uint m_highWater;          //!< highest fill seen
+    quint32 m_overflowCount;   //!< writes that could not be stored completely
+    quint64 m_droppedSamples;  //!< samples lost in overflows
+    quint32 m_underflowCount;  //!< reads of more samples than available
+
+    SampleFifoStats() :
+        m_size(0),
+        m_fill(0),
+        m_highWater(0),
+        m_overflowCount(0),
+        m_droppedSamples(0),
+        m_underflowCount(0)
+    {}
+};
+
+/**
+ * Time spent by a baseband sample sink in its feed method. The sink thread is the only writer.
+ */
+struct SDRBASE_API SampleSinkFeedStats
+{
+    quint64 m_nbCalls;
+    quint64 m_nbSamples;
+    qint64 m_processingTimeNs; //!< cumulative time in feed
+    qint64 m_maxLatencyNs;     //!< longest single feed call
+    qint64 m_threadCpuTimeNs;  //!< CPU time of the thread running the sink. -1 if not available (sink in the engine thread or unsupported platform)
+
+    SampleSinkFeedStats() :
+        m_nbCalls(0),
+        m_nbSamples(0),
+        m_processingTimeNs(0),
+        m_maxLatencyNs(0),
+        m_threadCpuTimeNs(-1)
+    {}
+
+    void add(quint64 nbSamples, qint64 elapsedNs)
+    {
+        m_nbCalls++;
+        m_nbSamples += nbSamples;
+        m_processingTimeNs += elapsedNs;
+
+        if (elapsedNs > m_maxLatencyNs) {
+            m_maxLatencyNs = elapsedNs;
+        }
+    }
+
+    static qint64 getThreadCpuTimeNs(); //!< CPU time consumed by the calling thread. -1 if not available.
+};
+
+#endif /* SDRBASE_DSP_DSPSTATS_H_ */
@@ -42,31 +42,43 @@
 
 #include <dsp/misc.h>
 #include <dsp/fftfilt.h>
+#include <dsp/fftengine.h>
 
 //------------------------------------------------------------------------------
 // initialize the filter
 // create forward and reverse FFTs
 //------------------------------------------------------------------------------
 
-// Only need a single instance of g_fft, used for both forward and reverse
+// FFTs are done with the FFT engine (FFTW when available) using separate plans
+// for forward and reverse. Input samples are collected directly in the input
+// buffer of the forward FFT whose second half stays zero.
 void fftfilt::init_filter()
 {
 	flen2	= flen >> 1;
-	fft	= new g_fft<float>(flen);
+	fwd = FFTEngine::create();
+	fwd->configure(flen, false);
+	inv = FFTEngine::create();
+	inv->configure(flen, true);
 
 	filter		= new cmplx[flen];
     filterOpp   = new cmplx[flen];
-	data		= new cmplx[flen];
 	output		= new cmplx[flen2];
 	ovlbuf		= new cmplx[flen2];
 
 	memset(filter, 0, flen * sizeof(cmplx));
     memset(filterOpp, 0, flen * sizeof(cmplx));
-	memset(data, 0, flen * sizeof(cmplx));
+	memset(fwd->in(), 0, flen * sizeof(cmplx));
 	memset(output, 0, flen2 * sizeof(cmplx));
 	memset(ovlbuf, 0, flen2 * sizeof(cmplx));
 
 	inptr = 0;
+	zeroPhase = false;
+	generation = 0;
+	olsLen = 0;
+	olsFwd = 0;
+	olsInv = 0;
+	olsKey = -1;
+	olsGeneration = 0;
 }
 
 //------------------------------------------------------------------------------
@@ -96,17 +108,40 @@ fftfilt::fftfilt(float f2, int len)
 
 fftfilt::~fftfilt()
 {
-	if (fft) delete fft;
+	if (fwd) delete fwd;
+	if (inv) delete inv;
+	if (olsFwd) delete olsFwd;
+	if (olsInv) delete olsInv;
 
 	if (filter) delete [] filter;
     if (filterOpp) delete [] filterOpp;
-	if (data) delete [] data;
 	if (output) delete [] output;
 	if (ovlbuf) delete [] ovlbuf;
 }
 
+// The forward FFT of a filter is obtained from the reverse one as conj(IFFT(conj(x)))
+// so that the samples pending in the forward FFT input are not disturbed
+void fftfilt::forwardFFT(cmplx *buf)
+{
+	cmplx *in = inv->in();
+
+	for (int i = 0; i < flen; i++) {
+		in[i] = std::conj(buf[i]);
+	}
+
+	inv->transform();
+	const cmplx *out = inv->out();
+
+	for (int i = 0; i < flen; i++) {
+		buf[i] = std::conj(out[i]);
+	}
+}
+
 void fftfilt::create_filter(float f1, float f2)
 {
+	zeroPhase = false;
+	generation++;
+
 	// initialize the filter to zero
 	memset(filter, 0, flen * sizeof(cmplx));
 
@@ -131,7 +166,7 @@ void fftfilt::create_filter(float f1, float f2)
 	for (int i = 0; i < flen2; i++)
 		filter[i] *= _blackman(i, flen2);
 
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+	forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -148,6 +183,9 @@ void fftfilt::create_filter(float f1, float f2)
 // Double the size of FFT used for equivalent SSB filter or assume FFT is half the size of the one used for SSB
 void fftfilt::create_dsb_filter(float f2)
 {
+	zeroPhase = false;
+	generation++;
+
 	// initialize the filter to zero
 	memset(filter, 0, flen * sizeof(cmplx));
 
@@ -156,7 +194,7 @@ void fftfilt::create_dsb_filter(float f2)
 		filter[i] *= _blackman(i, flen2);
 	}
 
-	fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+	forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
 	// normalize the output filter for unity gain
 	float scale = 0, mag;
@@ -174,6 +212,9 @@ void fftfilt::create_dsb_filter(float f2)
 // used with runAsym for in band / opposite band asymmetrical filtering. Can be used for vestigial sideband modulation.
 void fftfilt::create_asym_filter(float fopp, float fin)
 {
+	zeroPhase = false;
+	generation++;
+
     // in band
     // initialize the filter to zero
     memset(filter, 0, flen * sizeof(cmplx));
@@ -183,7 +224,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filter[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filter); // filter was expressed in the time domain (impulse response)
+    forwardFFT(filter); // filter was expressed in the time domain (impulse response)
 
     // normalize the output filter for unity gain
     float scale = 0, mag;
@@ -205,7 +246,7 @@ void fftfilt::create_asym_filter(float fopp, float fin)
         filterOpp[i] *= _blackman(i, flen2);
     }
 
-    fft->ComplexFFT(filterOpp); // filter was expressed in the time domain (impulse response)
+    forwardFFT(filterOpp); // filter was expressed in the time domain (impulse response)
 
     // normalize the output filter for unity gain
     scale = 0;
@@ -222,6 +263,9 @@ void fftfilt::create_asym_filter(float fopp, float fin)
 // This filter is constructed directly from frequency domain response. Run with runFilt.
 void fftfilt::create_rrc_filter(float fb, float a)
 {
+	zeroPhase = true;
+	generation++;
+
     std::fill(filter, filter+flen, 0);
 
     for (int i = 0; i < flen; i++) {
@@ -245,160 +289,279 @@ void fftfilt::create_rrc_filter(float fb, float a)
     }
 }
 
-// test bypass
-int fftfilt::noFilt(const cmplx & in, cmplx **out)
+void fftfilt::setOverlapSave(int fftLen)
 {
-	data[inptr++] = in;
-	if (inptr < flen2)
-		return 0;
-	inptr = 0;
+	if (fftLen <= 0)
+	{
+		olsLen = 0;
+	}
+	else
+	{
+		int len = 2 * flen;
+
+		while (len < fftLen) {
+			len <<= 1;
+		}
+
+		if (len != olsLen)
+		{
+			if (!olsFwd) olsFwd = FFTEngine::create();
+			if (!olsInv) olsInv = FFTEngine::create();
+			olsFwd->configure(len, false);
+			olsInv->configure(len, true);
+			olsFilter.resize(len);
+			olsLen = len;
+		}
 
-	*out = data;
-	return flen2;
+		memset(olsFwd->in(), 0, olsLen * sizeof(cmplx));
+		olsKey = -1;
+	}
+
+	if (output) delete [] output;
+	output = new cmplx[getStepSize()];
+	memset(ovlbuf, 0, flen2 * sizeof(cmplx));
+	memset(fwd->in(), 0, flen * sizeof(cmplx));
+	inptr = 0;
 }
 
-// Filter with fast convolution (overlap-add algorithm).
-int fftfilt::runFilt(const cmplx & in, cmplx **out)
+// Multiply the spectrum by the filter response of the run mode.
+// This is exactly what the sample by sample versions always did including
+// the Nyquist bin left untouched in single sideband modes.
+void fftfilt::applyMode(const cmplx *in, cmplx *out, RunMode mode, bool usb, bool getDC)
 {
-	data[inptr++] = in;
-	if (inptr < flen2)
-		return 0;
-	inptr = 0;
+	switch (mode)
+	{
+	case RUN_SSB:
+		// get or reject DC component
+		out[0] = getDC ? in[0]*filter[0] : 0;
+		out[flen2] = in[flen2];
+
+		// Discard frequencies for ssb
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++) {
+				out[i] = in[i] * filter[i];
+				out[flen2 + i] = 0;
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++) {
+				out[i] = 0;
+				out[flen2 + i] = in[flen2 + i] * filter[flen2 + i];
+			}
+		}
+		break;
+	case RUN_DSB:
+		for (int i = 0; i < flen; i++) {
+			out[i] = in[i] * filter[i];
+		}
 
-	fft->ComplexFFT(data);
-	for (int i = 0; i < flen; i++)
-		data[i] *= filter[i];
+		// get or reject DC component
+		out[0] = getDC ? out[0] : 0;
+		break;
+	case RUN_ASYM:
+		out[0] = in[0] * filter[0]; // always keep DC
+		out[flen2] = in[flen2];
+
+		if (usb)
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				out[i] = in[i] * filter[i]; // usb
+				out[flen2 + i] = in[flen2 + i] * filterOpp[flen2 + i]; // lsb is the opposite
+			}
+		}
+		else
+		{
+			for (int i = 1; i < flen2; i++)
+			{
+				out[i] = in[i] * filterOpp[i]; // usb is the opposite
+				out[flen2 + i] = in[flen2 + i] * filter[flen2 + i]; // lsb
+			}
+		}
+		break;
+	case RUN_FILT:
+	default:
+		for (int i = 0; i < flen; i++) {
+			out[i] = in[i] * filter[i];
+		}
+		break;
+	}
+}
 
-	fft->InverseComplexFFT(data);
+// Overlap-save needs the impulse response of the run mode. It is obtained from the
+// frequency response at flen and used as a flen taps filter. The RRC response is
+// centered on time zero so it is delayed by half the length to make it causal.
+void fftfilt::createOverlapSaveFilter(RunMode mode, bool usb, bool getDC)
+{
+	std::vector<cmplx> ones(flen, cmplx(1.0f, 0.0f));
+	applyMode(ones.data(), inv->in(), mode, usb, getDC);
+	inv->transform();
+	const cmplx *h = inv->out();
+	cmplx *taps = olsInv->in();
+	float scale = 1.0f / ((float) flen * (float) olsLen); // both inverse transforms are not normalized
+
+	for (int i = 0; i < flen; i++) {
+		taps[i] = std::conj(h[zeroPhase ? (i + flen2) % flen : i]) * scale;
+	}
 
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[flen2 + i];
+	std::fill(taps + flen, taps + olsLen, cmplx(0.0f, 0.0f));
+	olsInv->transform(); // forward FFT as conj(IFFT(conj(x)))
+	const cmplx *response = olsInv->out();
+
+	for (int i = 0; i < olsLen; i++) {
+		olsFilter[i] = std::conj(response[i]);
 	}
-	memset (data, 0, flen * sizeof(cmplx));
 
-	*out = output;
-	return flen2;
+	olsKey = mode*4 + (usb ? 2 : 0) + (getDC ? 1 : 0);
+	olsGeneration = generation;
 }
 
-// Second version for single sideband
-int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
+fftfilt::cmplx *fftfilt::inputBuffer()
+{
+	return olsLen ? olsFwd->in() + flen : fwd->in();
+}
+
+// Filter the frame of getStepSize() samples collected in the input buffer and place the
+// getStepSize() output samples in out
+void fftfilt::processFrame(cmplx *out, RunMode mode, bool usb, bool getDC)
 {
-	data[inptr++] = in;
-	if (inptr < flen2)
-		return 0;
 	inptr = 0;
 
-	fft->ComplexFFT(data);
+	if (olsLen == 0) // overlap-add
+	{
+		fwd->transform();
+		applyMode(fwd->out(), inv->in(), mode, usb, getDC);
+		inv->transform();
 
-	// get or reject DC component
-	data[0] = getDC ? data[0]*filter[0] : 0;
+		const cmplx *data = inv->out();
+		float scale = 1.0f / flen;
 
-	// Discard frequencies for ssb
-	if (usb)
-	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] *= filter[i];
-			data[flen2 + i] = 0;
+		// overlap and add
+		for (int i = 0; i < flen2; i++) {
+			out[i] = ovlbuf[i] + data[i] * scale;
+			ovlbuf[i] = data[flen2 + i] * scale;
 		}
 	}
-	else
+	else // overlap-save
 	{
-		for (int i = 1; i < flen2; i++) {
-			data[i] = 0;
-			data[flen2 + i] *= filter[flen2 + i];
+		if ((olsKey != mode*4 + (usb ? 2 : 0) + (getDC ? 1 : 0)) || (olsGeneration != generation)) {
+			createOverlapSaveFilter(mode, usb, getDC);
 		}
-	}
 
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
+		olsFwd->transform();
+		const cmplx *spectrum = olsFwd->out();
+		cmplx *product = olsInv->in();
 
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
-	memset (data, 0, flen * sizeof(cmplx));
+		for (int i = 0; i < olsLen; i++) {
+			product[i] = spectrum[i] * olsFilter[i];
+		}
 
-	*out = output;
-	return flen2;
+		olsInv->transform();
+
+		// the first flen samples are corrupted by the circular convolution
+		std::copy(olsInv->out() + flen, olsInv->out() + olsLen, out);
+
+		// the last flen input samples are the history of the next frame
+		cmplx *buffer = olsFwd->in();
+		std::copy(buffer + olsLen - flen, buffer + olsLen, buffer);
+	}
 }
 
-// Version for double sideband. You have to double the FFT size used for SSB.
-int fftfilt::runDSB(const cmplx & in, cmplx **out, bool getDC)
+int fftfilt::runSample(const cmplx& in, cmplx **out, RunMode mode, bool usb, bool getDC)
 {
-	data[inptr++] = in;
-	if (inptr < flen2)
+	inputBuffer()[inptr++] = in;
+
+	if (inptr < getStepSize())
 		return 0;
-	inptr = 0;
 
-	fft->ComplexFFT(data);
+	processFrame(output, mode, usb, getDC);
+	*out = output;
+	return getStepSize();
+}
 
-	for (int i = 0; i < flen2; i++) {
-		data[i] *= filter[i];
-		data[flen2 + i] *= filter[flen2 + i];
+int fftfilt::runBlock(const cmplx *in, int len, std::vector<cmplx>& out, RunMode mode, bool usb, bool getDC)
+{
+	int stepSize = getStepSize();
+	int maxOut = ((inptr + len) / stepSize) * stepSize;
+	int nbOut = 0;
+	cmplx *buffer = inputBuffer();
+
+	if ((int) out.size() < maxOut) {
+		out.resize(maxOut);
 	}
 
-    // get or reject DC component
-    data[0] = getDC ? data[0] : 0;
+	while (len > 0)
+	{
+		int n = std::min(len, stepSize - inptr);
+		std::copy(in, in + n, buffer + inptr);
+		in += n;
+		len -= n;
+		inptr += n;
+
+		if (inptr == stepSize)
+		{
+			processFrame(&out[nbOut], mode, usb, getDC);
+			nbOut += stepSize;
+		}
+	}
 
-	// in-place FFT: freqdata overwritten with filtered timedata
-	fft->InverseComplexFFT(data);
+	return nbOut;
+}
 
-	// overlap and add
-	for (int i = 0; i < flen2; i++) {
-		output[i] = ovlbuf[i] + data[i];
-		ovlbuf[i] = data[i+flen2];
-	}
+// test bypass
+int fftfilt::noFilt(const cmplx & in, cmplx **out)
+{
+	cmplx *buffer = inputBuffer();
+	buffer[inptr++] = in;
 
-	memset (data, 0, flen * sizeof(cmplx));
+	if (inptr < getStepSize())
+		return 0;
+	inptr = 0;
 
-	*out = output;
-	return flen2;
+	*out = buffer;
+	return getStepSize();
 }
 
-// Version for asymmetrical sidebands. You have to double the FFT size used for SSB.
-int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
+int fftfilt::runFilt(const cmplx & in, cmplx **out)
 {
-    data[inptr++] = in;
-    if (inptr < flen2)
-        return 0;
-    inptr = 0;
+	return runSample(in, out, RUN_FILT, false, true);
+}
 
-    fft->ComplexFFT(data);
+int fftfilt::runSSB(const cmplx & in, cmplx **out, bool usb, bool getDC)
+{
+	return runSample(in, out, RUN_SSB, usb, getDC);
+}
 
-    data[0] *= filter[0]; // always keep DC
+int fftfilt::runDSB(const cmplx & in, cmplx **out, bool getDC)
+{
+	return runSample(in, out, RUN_DSB, false, getDC);
+}
 
-    if (usb)
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filter[i]; // usb
-            data[flen2 + i] *= filterOpp[flen2 + i]; // lsb is the opposite
-        }
-    }
-    else
-    {
-        for (int i = 1; i < flen2; i++)
-        {
-            data[i] *= filterOpp[i]; // usb is the opposite
-            data[flen2 + i] *= filter[flen2 + i]; // lsb
-        }
-    }
+int fftfilt::runAsym(const cmplx & in, cmplx **out, bool usb)
+{
+	return runSample(in, out, RUN_ASYM, usb, true);
+}
 
-    // in-place FFT: freqdata overwritten with filtered timedata
-    fft->InverseComplexFFT(data);
+int fftfilt::runFilt(const cmplx *in, int len, std::vector<cmplx>& out)
+{
+	return runBlock(in, len, out, RUN_FILT, false, true);
+}
 
-    // overlap and add
-    for (int i = 0; i < flen2; i++) {
-        output[i] = ovlbuf[i] + data[i];
-        ovlbuf[i] = data[i+flen2];
-    }
+int fftfilt::runSSB(const cmplx *in, int len, std::vector<cmplx>& out, bool usb, bool getDC)
+{
+	return runBlock(in, len, out, RUN_SSB, usb, getDC);
+}
 
-    memset (data, 0, flen * sizeof(cmplx));
+int fftfilt::runDSB(const cmplx *in, int len, std::vector<cmplx>& out, bool getDC)
+{
+	return runBlock(in, len, out, RUN_DSB, false, getDC);
+}
 
-    *out = output;
-    return flen2;
+int fftfilt::runAsym(const cmplx *in, int len, std::vector<cmplx>& out, bool usb)
+{
+	return runBlock(in, len, out, RUN_ASYM, usb, true);
 }
 
 /* Sliding FFT from Fldigi */
@@ -6,9 +6,11 @@
 #define	_FFTFILT_H
 
 #include <complex>
-#include "gfft.h"
+#include <vector>
 #include "export.h"
 
+class FFTEngine;
+
 #undef M_PI
 #define M_PI 3.14159265358979323846
 
@@ -36,18 +38,45 @@ public:
 	int runDSB(const cmplx& in, cmplx **out, bool getDC = true);
 	int runAsym(const cmplx & in, cmplx **out, bool usb); //!< Asymmetrical fitering can be used for vestigial sideband
 
+	// block versions: process len input samples and place all the completed output samples in out
+	// (resized if too small). Return the number of output samples. Same results as the sample by sample versions.
+	int runFilt(const cmplx *in, int len, std::vector<cmplx>& out);
+	int runSSB(const cmplx *in, int len, std::vector<cmplx>& out, bool usb, bool getDC = true);
+	int runDSB(const cmplx *in, int len, std::vector<cmplx>& out, bool getDC = true);
+	int runAsym(const cmplx *in, int len, std::vector<cmplx>& out, bool usb);
+
+	/** Use overlap-save with a FFT of fftLen (power of two, at least twice the filter length) instead of
+	 * overlap-add with a FFT of the filter length. Larger FFTs process more samples per transform.
+	 * This is a true linear convolution with the flen taps impulse response. Filters designed in the frequency
+	 * domain (sideband masks, RRC) are aliased by overlap-add so the output is close but not identical.
+	 * RRC output is delayed by flen/2. 0 reverts to overlap-add. Pending input samples are dropped. */
+	void setOverlapSave(int fftLen);
+	int getOverlapSave() const { return olsLen; }
+	int getStepSize() const { return olsLen ? olsLen - flen : flen2; } //!< number of samples output at once
+
 protected:
+	enum RunMode {RUN_FILT, RUN_SSB, RUN_DSB, RUN_ASYM};
+
 	int flen;
 	int flen2;
-	g_fft<float> *fft;
+	FFTEngine *fwd;     //!< forward FFT of flen. Its input buffer collects the input samples in overlap-add
+	FFTEngine *inv;     //!< inverse FFT of flen
 	cmplx *filter;
     cmplx *filterOpp;
-	cmplx *data;
 	cmplx *ovlbuf;
 	cmplx *output;
 	int inptr;
 	int pass;
 	int window;
+	bool zeroPhase;     //!< filter defined in the frequency domain centered on time zero (RRC)
+	unsigned int generation; //!< incremented each time the filter changes
+
+	int olsLen;         //!< overlap-save FFT length. 0 for overlap-add
+	FFTEngine *olsFwd;  //!< forward FFT of olsLen. Input buffer is flen samples of history followed by the new samples
+	FFTEngine *olsInv;  //!< inverse FFT of olsLen
+	std::vector<cmplx> olsFilter; //!< frequency response for olsLen (scaled) of the run mode olsKey
+	int olsKey;
+	unsigned int olsGeneration;
 
 	inline float fsinc(float fc, int i, int len)
 	{
@@ -88,6 +117,13 @@ protected:
 
 	void init_filter();
 	void init_dsb_filter();
+	void forwardFFT(cmplx *buf); //!< in place forward FFT of flen
+	void applyMode(const cmplx *in, cmplx *out, RunMode mode, bool usb, bool getDC);
+	void createOverlapSaveFilter(RunMode mode, bool usb, bool getDC);
+	cmplx *inputBuffer();
+	int runSample(const cmplx& in, cmplx **out, RunMode mode, bool usb, bool getDC);
+	int runBlock(const cmplx *in, int len, std::vector<cmplx>& out, RunMode mode, bool usb, bool getDC);
+	void processFrame(cmplx *out, RunMode mode, bool usb, bool getDC);
 };
 
 
@@ -1,6 +1,34 @@
+#include <cstdlib>
 #include <QTime>
+#include <QFile>
+#include <QThread>
 #include "dsp/fftwengine.h"
 
+namespace {
+
+/** Plans the common sizes so that wisdom is available when channels need them */
+class FFTWPrePlanner : public QThread
+{
+protected:
+	virtual void run()
+	{
+		FFTWEngine engine;
+
+		for (int n = 64; (n <= 32768) && !isInterruptionRequested(); n *= 2)
+		{
+			engine.configure(n, false);
+
+			if (!isInterruptionRequested()) {
+				engine.configure(n, true);
+			}
+		}
+
+		FFTWEngine::logPlanStats();
+	}
+};
+
+} // namespace
+
 FFTWEngine::FFTWEngine() :
 	m_plans(),
 	m_currentPlan(NULL)
@@ -28,10 +56,36 @@ void FFTWEngine::configure(int n, bool inverse)
 	m_currentPlan->out = (fftwf_complex*)fftwf_malloc(sizeof(fftwf_complex) * n);
 	QTime t;
 	t.start();
+	QByteArray wisdom;
+	QString wisdomFileName;
 	m_globalPlanMutex.lock();
-	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+	// try wisdom first so that we know if a new plan has to be saved
+	m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT | FFTW_WISDOM_ONLY);
+	bool fromWisdom = m_currentPlan->plan != NULL;
+
+	if (!fromWisdom)
+	{
+		m_currentPlan->plan = fftwf_plan_dft_1d(n, m_currentPlan->in, m_currentPlan->out, inverse ? FFTW_BACKWARD : FFTW_FORWARD, FFTW_PATIENT);
+
+		if (!m_wisdomFileName.isEmpty())
+		{
+			wisdom = getWisdomLocked(); // the file is written once the planner is released
+			wisdomFileName = m_wisdomFileName;
+		}
+	}
+
+	int elapsed = t.elapsed();
+	m_planStats.m_nbPlans++;
+	m_planStats.m_nbWisdomPlans += fromWisdom ? 1 : 0;
+	m_planStats.m_totalTimeMs += elapsed;
+	m_planStats.m_maxTimeMs = elapsed > m_planStats.m_maxTimeMs ? elapsed : m_planStats.m_maxTimeMs;
 	m_globalPlanMutex.unlock();
-	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms", n, inverse ? "inverse" : "forward", t.elapsed());
+
+	if (!wisdom.isEmpty()) {
+		writeWisdom(wisdom, wisdomFileName);
+	}
+
+	qDebug("FFT: creating FFTW plan (n=%d,%s) took %dms%s", n, inverse ? "inverse" : "forward", elapsed, fromWisdom ? " (wisdom)" : "");
 	m_plans.push_back(m_currentPlan);
 }
 
@@ -56,6 +110,111 @@ Complex* FFTWEngine::out()
 }
 
 QMutex FFTWEngine::m_globalPlanMutex;
+QMutex FFTWEngine::m_wisdomFileMutex;
+QString FFTWEngine::m_wisdomFileName;
+FFTWEngine::PlanStats FFTWEngine::m_planStats;
+QThread *FFTWEngine::m_prePlanner = 0;
+
+void FFTWEngine::setWisdomFileName(const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+	m_wisdomFileName = fileName;
+}
+
+bool FFTWEngine::importWisdom()
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+
+	if (m_wisdomFileName.isEmpty() || !QFile::exists(m_wisdomFileName)) {
+		return false;
+	}
+
+	if (fftwf_import_wisdom_from_filename(QFile::encodeName(m_wisdomFileName).constData()) == 0)
+	{
+		qWarning("FFTWEngine::importWisdom: cannot import wisdom from %s", qPrintable(m_wisdomFileName));
+		return false;
+	}
+
+	qDebug("FFTWEngine::importWisdom: imported wisdom from %s", qPrintable(m_wisdomFileName));
+	return true;
+}
+
+bool FFTWEngine::exportWisdom()
+{
+	m_globalPlanMutex.lock();
+
+	if (m_wisdomFileName.isEmpty())
+	{
+		m_globalPlanMutex.unlock();
+		return false;
+	}
+
+	QByteArray wisdom = getWisdomLocked();
+	QString fileName = m_wisdomFileName;
+	m_globalPlanMutex.unlock();
+
+	return writeWisdom(wisdom, fileName);
+}
+
+QByteArray FFTWEngine::getWisdomLocked()
+{
+	char *wisdomString = fftwf_export_wisdom_to_string();
+
+	if (!wisdomString) {
+		return QByteArray();
+	}
+
+	QByteArray wisdom(wisdomString);
+	free(wisdomString); // allocated by FFTW with malloc
+	return wisdom;
+}
+
+bool FFTWEngine::writeWisdom(const QByteArray& wisdom, const QString& fileName)
+{
+	QMutexLocker mutexLocker(&m_wisdomFileMutex);
+	QFile file(fileName);
+
+	if (wisdom.isEmpty() || !file.open(QIODevice::WriteOnly | QIODevice::Truncate) || (file.write(wisdom) != wisdom.size()))
+	{
+		qWarning("FFTWEngine::exportWisdom: cannot export wisdom to %s", qPrintable(fileName));
+		return false;
+	}
+
+	return true;
+}
+
+void FFTWEngine::startPrePlanning()
+{
+	if (m_prePlanner) {
+		return;
+	}
+
+	qDebug("FFTWEngine::startPrePlanning");
+	m_prePlanner = new FFTWPrePlanner();
+	m_prePlanner->start(QThread::LowPriority);
+}
+
+void FFTWEngine::stopPrePlanning()
+{
+	if (!m_prePlanner) {
+		return;
+	}
+
+	m_prePlanner->requestInterruption();
+	m_prePlanner->wait(); // at most one plan in progress
+	delete m_prePlanner;
+	m_prePlanner = 0;
+}
+
+void FFTWEngine::logPlanStats()
+{
+	QMutexLocker mutexLocker(&m_globalPlanMutex);
+	qDebug("FFTWEngine::logPlanStats: %d plans (%d from wisdom) total %lldms max %dms",
+		m_planStats.m_nbPlans,
+		m_planStats.m_nbWisdomPlans,
+		m_planStats.m_totalTimeMs,
+		m_planStats.m_maxTimeMs);
+}
 
 void FFTWEngine::freeAll()
 {
@@ -2,11 +2,15 @@
 #define INCLUDE_FFTWENGINE_H
 
 #include <QMutex>
+#include <QString>
+#include <QByteArray>
 #include <fftw3.h>
 #include <list>
 #include "dsp/fftengine.h"
 #include "export.h"
 
+class QThread;
+
 class SDRBASE_API FFTWEngine : public FFTEngine {
 public:
 	FFTWEngine();
@@ -18,8 +22,34 @@ public:
 	Complex* in();
 	Complex* out();
 
+	// wisdom store shared by all instances
+	static void setWisdomFileName(const QString& fileName); //!< Wisdom is exported to this file after each new plan. Empty to disable.
+	static bool importWisdom(); //!< Import wisdom from the wisdom file
+	static bool exportWisdom(); //!< Export wisdom to the wisdom file
+	static void startPrePlanning(); //!< Plan power of two sizes from 64 to 32k in a background thread
+	static void stopPrePlanning();  //!< Interrupt background planning and wait for it
+	static void logPlanStats();
+
 protected:
+	struct PlanStats {
+		int m_nbPlans;        //!< plans made since start
+		int m_nbWisdomPlans;  //!< plans obtained straight from wisdom
+		qint64 m_totalTimeMs; //!< total time spent planning
+		int m_maxTimeMs;      //!< longest planning time
+
+		PlanStats() :
+			m_nbPlans(0),
+			m_nbWisdomPlans(0),
+			m_totalTimeMs(0),
+			m_maxTimeMs(0)
+		{}
+	};
+
 	static QMutex m_globalPlanMutex;
+	static QMutex m_wisdomFileMutex; //!< serializes the wisdom file writes done outside m_globalPlanMutex
+	static QString m_wisdomFileName;
+	static PlanStats m_planStats;
+	static QThread *m_prePlanner;
 
 	struct Plan {
 		int n;
@@ -33,6 +63,9 @@ protected:
 	Plan* m_currentPlan;
 
 	void freeAll();
+	static QByteArray getWisdomLocked(); //!< Wisdom as a string. Call with m_globalPlanMutex held
+	static bool writeWisdom(const QByteArray& wisdom, const QString& fileName); //!< Call without m_globalPlanMutex
+
 };
 
 #endif // INCLUDE_FFTWENGINE_H
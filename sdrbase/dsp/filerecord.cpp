@@ -19,11 +19,15 @@
 
 #include <QDebug>
 #include <QDateTime>
+#include <QMutexLocker>
 
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
 #include "util/simpleserializer.h"
 #include "util/message.h"
 
+#include "SWGFileRecordReport.h"
+
 #include "filerecord.h"
 
 FileRecord::FileRecord() :
@@ -33,6 +37,8 @@ FileRecord::FileRecord() :
     m_centerFrequency(0),
 	m_recordOn(false),
     m_recordStart(false),
+    m_compact(false),
+    m_compactEncoder(m_writer),
     m_byteCount(0)
 {
 	setObjectName("FileSink");
@@ -45,6 +51,8 @@ FileRecord::FileRecord(const QString& filename) :
     m_centerFrequency(0),
     m_recordOn(false),
     m_recordStart(false),
+    m_compact(false),
+    m_compactEncoder(m_writer),
     m_byteCount(0)
 {
     setObjectName("FileRecord");
@@ -70,6 +78,8 @@ void FileRecord::genUniqueFileName(uint deviceUID)
 
 void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
 {
+    QMutexLocker mutexLocker(&m_mutex);
+
     // if no recording is active, send the samples to /dev/null
     if(!m_recordOn)
         return;
@@ -78,11 +88,21 @@ void FileRecord::feed(const SampleVector::const_iterator& begin, const SampleVec
     {
         if (m_recordStart)
         {
-            writeHeader();
+            if (m_compact) {
+                m_compactEncoder.begin(m_sampleRate, m_centerFrequency, time(0));
+            } else {
+                writeHeader();
+            }
+
             m_recordStart = false;
         }
 
-        m_sampleFile.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+        if (m_compact) {
+            m_compactEncoder.feed(&*begin, end - begin);
+        } else {
+            m_writer.write(reinterpret_cast<const char*>(&*(begin)), (end - begin)*sizeof(Sample));
+        }
+
         m_byteCount += end - begin;
     }
 }
@@ -98,10 +118,17 @@ void FileRecord::stop()
 
 void FileRecord::startRecording()
 {
-    if (!m_sampleFile.is_open())
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!m_writer.isOpen())
     {
     	qDebug() << "FileRecord::startRecording";
-        m_sampleFile.open(m_fileName.toStdString().c_str(), std::ios::binary);
+
+        if (!m_writer.open(m_fileName, DSPEngine::instance()->getRecordDirectIO())) {
+            return;
+        }
+
+        m_compact = m_fileName.endsWith(".sdriqc");
         m_recordOn = true;
         m_recordStart = true;
         m_byteCount = 0;
@@ -110,11 +137,18 @@ void FileRecord::startRecording()
 
 void FileRecord::stopRecording()
 {
-    if (m_sampleFile.is_open())
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_writer.isOpen())
     {
     	qDebug() << "FileRecord::stopRecording";
-        m_sampleFile.close();
         m_recordOn = false;
+
+        if (m_compact && !m_recordStart) {
+            m_compactEncoder.end();
+        }
+
+        m_writer.close();
         m_recordStart = false;
     }
 }
@@ -156,7 +190,10 @@ void FileRecord::writeHeader()
     header.sampleSize = SDR_RX_SAMP_SZ;
     header.filler = 0;
 
-    writeHeader(m_sampleFile, header);
+    boost::crc_32_type crc32;
+    crc32.process_bytes(&header, 28);
+    header.crc32 = crc32.checksum();
+    m_writer.write((const char *) &header, sizeof(Header));
 }
 
 bool FileRecord::readHeader(std::ifstream& sampleFile, Header& header)
@@ -173,4 +210,17 @@ void FileRecord::writeHeader(std::ofstream& sampleFile, Header& header)
     crc32.process_bytes(&header, 28);
     header.crc32 = crc32.checksum();
     sampleFile.write((const char *) &header, sizeof(Header));
-}
\ No newline at end of file
+}
+
+void FileRecord::webapiFormatReport(SWGSDRangel::SWGFileRecordReport *report)
+{
+    FileRecordWriter::Stats stats = m_writer.getStats();
+    report->setRecording(m_recordOn ? 1 : 0);
+    report->setWrittenBytes(stats.m_writtenBytes);
+    report->setDroppedBlocks(stats.m_droppedBlocks + (m_compact ? m_compactEncoder.getDroppedBlocks() : 0));
+    report->setDroppedBytes(stats.m_droppedBytes);
+    report->setPendingBlocks(stats.m_pendingBlocks);
+    report->setLastWriteLatencyUs(stats.m_lastLatencyUs);
+    report->setMaxWriteLatencyUs(stats.m_maxLatencyUs);
+    report->setAvgWriteLatencyUs(stats.m_avgLatencyUs);
+}
@@ -17,16 +17,25 @@
 #ifndef INCLUDE_FILERECORD_H
 #define INCLUDE_FILERECORD_H
 
+#include <QMutex>
+
 #include <dsp/basebandsamplesink.h>
 #include <string>
 #include <iostream>
 #include <fstream>
 
 #include <ctime>
+#include "dsp/filerecordwriter.h"
+#include "dsp/compactrecordencoder.h"
 #include "export.h"
 
 class Message;
 
+namespace SWGSDRangel
+{
+    class SWGFileRecordReport;
+}
+
 class SDRBASE_API FileRecord : public BasebandSampleSink {
 public:
 
@@ -47,6 +56,11 @@ public:
 	virtual ~FileRecord();
 
     quint64 getByteCount() const { return m_byteCount; }
+    bool isRecording() const { return m_recordOn; }
+    FileRecordWriter::Stats getWriterStats() { return m_writer.getStats(); }
+    /** Options of the compact format used when the file name ends with .sdriqc (see CompactRecord::encodeBlock) */
+    void setCompactOptions(int sampleBits, bool compress) { m_compactEncoder.setOptions(sampleBits, compress); }
+    void webapiFormatReport(SWGSDRangel::SWGFileRecordReport *report);
 
     void setFileName(const QString& filename);
     void genUniqueFileName(uint deviceUID);
@@ -66,8 +80,11 @@ private:
 	quint64 m_centerFrequency;
 	bool m_recordOn;
     bool m_recordStart;
-    std::ofstream m_sampleFile;
+    FileRecordWriter m_writer; //!< the disk is accessed from the writer thread only
+    bool m_compact;            //!< recording in the compact format
+    CompactRecordEncoder m_compactEncoder;
     quint64 m_byteCount;
+    QMutex m_mutex;            //!< serializes feed() from the engine thread with start and stop of the recording
 
 	void handleConfigure(const QString& fileName);
     void writeHeader();
@@ -0,0 +1,316 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+#include <algorithm>
+#include <limits>
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include "filerecordwriter.h"
+
+FileRecordWriter::FileRecordWriter(QObject* parent) :
+    QThread(parent),
+    m_fillIndex(0),
+    m_fillSize(0),
+    m_writeIndex(0),
+    m_nbQueued(0),
+    m_open(false),
+    m_running(false),
+    m_error(false),
+    m_sumLatencyUs(0)
+#if defined(__linux__)
+    ,m_fd(-1),
+    m_directIO(false),
+    m_fileOffset(0),
+    m_allocatedSize(0)
+#endif
+{
+    std::fill(m_buffers, m_buffers + m_nbBuffers, (char *) 0);
+    std::fill(m_sizes, m_sizes + m_nbBuffers, 0);
+}
+
+FileRecordWriter::~FileRecordWriter()
+{
+    close();
+}
+
+bool FileRecordWriter::open(const QString& fileName, bool directIO)
+{
+    close();
+
+#if defined(__linux__)
+    int flags = O_WRONLY | O_CREAT | O_TRUNC;
+    m_fd = ::open(fileName.toStdString().c_str(), flags | (directIO ? O_DIRECT : 0), 0644);
+
+    if ((m_fd < 0) && directIO && (errno == EINVAL)) // file system without O_DIRECT support (e.g. tmpfs)
+    {
+        qWarning("FileRecordWriter::open: O_DIRECT not supported for %s", qPrintable(fileName));
+        directIO = false;
+        m_fd = ::open(fileName.toStdString().c_str(), flags, 0644);
+    }
+
+    if (m_fd < 0)
+    {
+        qCritical("FileRecordWriter::open: cannot open %s: %s", qPrintable(fileName), strerror(errno));
+        return false;
+    }
+
+    m_directIO = directIO;
+    m_fileOffset = 0;
+    m_allocatedSize = 0;
+#else
+    (void) directIO;
+    m_file.open(fileName.toStdString().c_str(), std::ios::binary);
+
+    if (!m_file.is_open())
+    {
+        qCritical("FileRecordWriter::open: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+#endif
+
+    // allocate and touch all the memory now rather than while recording
+    m_storage.assign(m_nbBuffers * m_bufferSize + m_alignment, 0);
+    quintptr base = (quintptr) m_storage.data();
+    base = (base + m_alignment - 1) & ~((quintptr) m_alignment - 1);
+
+    for (int i = 0; i < m_nbBuffers; i++) {
+        m_buffers[i] = (char *) base + i * m_bufferSize;
+    }
+
+    m_fillIndex = 0;
+    m_fillSize = 0;
+    m_writeIndex = 0;
+    m_nbQueued = 0;
+    m_error = false;
+    m_stats = Stats();
+    m_sumLatencyUs = 0;
+    m_running = true;
+    m_open = true;
+    start();
+
+    qDebug("FileRecordWriter::open: %s %s", qPrintable(fileName), directIO ? "(direct I/O)" : "");
+    return true;
+}
+
+void FileRecordWriter::close()
+{
+    if (!m_open) {
+        return;
+    }
+
+    m_mutex.lock();
+
+    if (m_fillSize > 0) // the last partial buffer is not dropped: wait for a free slot
+    {
+        while (m_nbQueued == m_nbBuffers - 1) {
+            m_queueCondition.wait(&m_mutex);
+        }
+
+        m_sizes[m_fillIndex] = m_fillSize;
+        m_nbQueued++;
+        m_fillIndex = (m_fillIndex + 1) % m_nbBuffers;
+        m_fillSize = 0;
+    }
+
+    m_running = false;
+    m_queueCondition.wakeAll();
+    m_mutex.unlock();
+    wait();
+
+#if defined(__linux__)
+    if (ftruncate(m_fd, m_fileOffset) < 0) { // give back the space reserved beyond the data
+        qWarning("FileRecordWriter::close: ftruncate: %s", strerror(errno));
+    }
+
+    ::close(m_fd);
+    m_fd = -1;
+#else
+    m_file.close();
+#endif
+
+    std::vector<char>().swap(m_storage);
+    std::fill(m_buffers, m_buffers + m_nbBuffers, (char *) 0);
+    m_open = false;
+
+    qDebug("FileRecordWriter::close: written: %llu bytes dropped: %llu blocks max latency: %u us",
+            m_stats.m_writtenBytes, m_stats.m_droppedBlocks, m_stats.m_maxLatencyUs);
+}
+
+void FileRecordWriter::write(const char *data, qint64 size)
+{
+    if (!m_open) {
+        return;
+    }
+
+    while (size > 0)
+    {
+        qint64 len = std::min(size, m_bufferSize - m_fillSize);
+        memcpy(m_buffers[m_fillIndex] + m_fillSize, data, len);
+        m_fillSize += len;
+        data += len;
+        size -= len;
+
+        if (m_fillSize == m_bufferSize) {
+            queueFillBuffer();
+        }
+    }
+}
+
+// Callers write whole samples and m_bufferSize is a multiple of the sample size so that
+// dropping a full buffer keeps the file aligned on samples.
+void FileRecordWriter::queueFillBuffer()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_nbQueued < m_nbBuffers - 1) // the last one is the one being filled
+    {
+        m_sizes[m_fillIndex] = m_fillSize;
+        m_nbQueued++;
+        m_fillIndex = (m_fillIndex + 1) % m_nbBuffers;
+        m_queueCondition.wakeAll();
+    }
+    else
+    {
+        m_stats.m_droppedBlocks++;
+        m_stats.m_droppedBytes += m_fillSize;
+    }
+
+    m_fillSize = 0;
+}
+
+FileRecordWriter::Stats FileRecordWriter::getStats()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    Stats stats = m_stats;
+    stats.m_pendingBlocks = m_nbQueued;
+    return stats;
+}
+
+void FileRecordWriter::run()
+{
+    QElapsedTimer timer;
+    m_mutex.lock();
+
+    while (true)
+    {
+        while ((m_nbQueued == 0) && m_running) {
+            m_queueCondition.wait(&m_mutex);
+        }
+
+        if (m_nbQueued == 0) { // stopped and drained
+            break;
+        }
+
+        int index = m_writeIndex;
+        qint64 size = m_sizes[index];
+        m_mutex.unlock();
+
+        timer.start();
+        bool ok = !m_error && writeBlock(m_buffers[index], size);
+        quint32 latencyUs = timer.nsecsElapsed() / 1000;
+
+        m_mutex.lock();
+
+        if (ok)
+        {
+            m_stats.m_writtenBytes += size;
+            m_stats.m_nbWrites++;
+            m_stats.m_lastLatencyUs = latencyUs;
+            m_stats.m_maxLatencyUs = std::max(m_stats.m_maxLatencyUs, latencyUs);
+            m_sumLatencyUs += latencyUs;
+            m_stats.m_avgLatencyUs = m_sumLatencyUs / m_stats.m_nbWrites;
+        }
+        else
+        {
+            m_stats.m_droppedBlocks++;
+            m_stats.m_droppedBytes += size;
+        }
+
+        m_writeIndex = (index + 1) % m_nbBuffers;
+        m_nbQueued--;
+        m_queueCondition.wakeAll();
+    }
+
+    m_mutex.unlock();
+}
+
+bool FileRecordWriter::writeBlock(const char *data, qint64 size)
+{
+#if defined(__linux__)
+    if (m_fileOffset + size > m_allocatedSize) // reserve the next chunk of disk space
+    {
+        if (fallocate(m_fd, FALLOC_FL_KEEP_SIZE, m_allocatedSize, m_preallocateSize) == 0)
+        {
+            m_allocatedSize += m_preallocateSize;
+        }
+        else
+        {
+            qDebug("FileRecordWriter::writeBlock: no preallocation: %s", strerror(errno));
+            m_allocatedSize = std::numeric_limits<qint64>::max();
+        }
+    }
+
+    if (m_directIO && (size % m_alignment != 0)) // only the last block can be partial
+    {
+        fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) & ~O_DIRECT);
+        m_directIO = false;
+    }
+
+    qint64 remaining = size;
+
+    while (remaining > 0)
+    {
+        ssize_t len = ::write(m_fd, data, remaining);
+
+        if (len < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            qCritical("FileRecordWriter::writeBlock: %s", strerror(errno));
+            m_error = true;
+            return false;
+        }
+
+        data += len;
+        remaining -= len;
+    }
+
+    m_fileOffset += size;
+    return true;
+#else
+    m_file.write(data, size);
+
+    if (!m_file)
+    {
+        qCritical("FileRecordWriter::writeBlock: write error");
+        m_error = true;
+        return false;
+    }
+
+    return true;
+#endif
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_FILERECORDWRITER_H_
+#define SDRBASE_DSP_FILERECORDWRITER_H_
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+#include <vector>
+#if !defined(__linux__)
+#include <fstream>
+#endif
+
+#include "export.h"
+
+/**
+ * Writes a byte stream to disk from a dedicated thread so that the caller (the DSP thread)
+ * never waits for the disk. Data is copied into a ring of large preallocated buffers aligned
+ * on m_alignment. Each full buffer is handed over to the writer thread. If the writer is too
+ * slow and all buffers are pending the content of the buffer being filled is dropped and
+ * accounted for in the statistics rather than stalling the caller.
+ *
+ * On Linux the file space is reserved ahead with fallocate and O_DIRECT can be requested
+ * to bypass the page cache. Elsewhere a plain std::ofstream is used in the writer thread.
+ */
+class SDRBASE_API FileRecordWriter : public QThread {
+    Q_OBJECT
+
+public:
+    struct Stats
+    {
+        quint64 m_writtenBytes;
+        quint64 m_droppedBlocks;
+        quint64 m_droppedBytes;
+        quint64 m_nbWrites;
+        quint32 m_lastLatencyUs;  //!< duration of the last block write
+        quint32 m_maxLatencyUs;   //!< longest block write since the file was opened
+        quint32 m_avgLatencyUs;   //!< average block write duration
+        quint32 m_pendingBlocks;  //!< blocks waiting to be written
+
+        Stats() :
+            m_writtenBytes(0),
+            m_droppedBlocks(0),
+            m_droppedBytes(0),
+            m_nbWrites(0),
+            m_lastLatencyUs(0),
+            m_maxLatencyUs(0),
+            m_avgLatencyUs(0),
+            m_pendingBlocks(0)
+        {}
+    };
+
+    FileRecordWriter(QObject* parent = 0);
+    ~FileRecordWriter();
+
+    bool open(const QString& fileName, bool directIO); //!< allocate buffers, create the file and start the writer thread
+    void close();                                     //!< write pending data, stop the thread and release buffers
+    bool isOpen() const { return m_open; }
+    void write(const char *data, qint64 size);        //!< never blocks. Called from a single producer thread
+    Stats getStats();
+
+    static const int m_nbBuffers = 8;
+    static const qint64 m_bufferSize = 8*1024*1024;       //!< a multiple of m_alignment
+    static const qint64 m_alignment = 4096;               //!< required by O_DIRECT
+    static const qint64 m_preallocateSize = 256*1024*1024; //!< file space reservation step
+
+private:
+    std::vector<char> m_storage;  //!< backing memory of all buffers
+    char *m_buffers[m_nbBuffers]; //!< aligned buffers in m_storage
+    qint64 m_sizes[m_nbBuffers];  //!< size of data in queued buffers
+    int m_fillIndex;              //!< buffer being filled by the producer
+    qint64 m_fillSize;            //!< data in buffer being filled
+    int m_writeIndex;             //!< next buffer to be written
+    int m_nbQueued;               //!< buffers handed to the writer
+    bool m_open;
+    bool m_running;
+    bool m_error;
+    QMutex m_mutex;
+    QWaitCondition m_queueCondition;
+    Stats m_stats;
+    quint64 m_sumLatencyUs;
+
+#if defined(__linux__)
+    int m_fd;
+    bool m_directIO;
+    qint64 m_fileOffset;
+    qint64 m_allocatedSize;
+#else
+    std::ofstream m_file;
+#endif
+
+    void queueFillBuffer();
+    bool writeBlock(const char *data, qint64 size);
+    void run();
+};
+
+#endif /* SDRBASE_DSP_FILERECORDWRITER_H_ */
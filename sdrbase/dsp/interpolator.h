@@ -19,6 +19,15 @@ public:
 	void create(int phaseSteps, double sampleRate, double cutoff, double nbTapsPerPhase = 4.5);
 	void free();
 
+	// prototype filter of the polyphase bank (also used by PolyphaseResampler)
+	static void createPolyphaseLowPass(
+		std::vector<Real>& taps,
+		int phaseSteps,
+		double gain,
+		double sampleRateHz,
+		double cutoffFreqHz,
+		double nbTapsPerPhase);
+
 	// Original code allowed for upsampling, but was never used that way
 	bool decimate(Real *distance, const Complex& next, Complex* result)
 	{
@@ -94,14 +103,6 @@ private:
 	    double transitionWidthHz,
 	    double oobAttenuationdB);
 
-    static void createPolyphaseLowPass(
-        std::vector<Real>& taps,
-        int phaseSteps,
-        double gain,
-        double sampleRateHz,
-        double cutoffFreqHz,
-        double nbTapsPerPhase);
-
 	void createTaps(int nTaps, double sampleRate, double cutoff, std::vector<Real>* taps);
 
 	void advanceFilter(const Complex& next)
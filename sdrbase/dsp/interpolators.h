@@ -18,6 +18,7 @@
 #define INCLUDE_GPL_DSP_INTERPOLATORS_H_
 
 #include "dsp/dsptypes.h"
+#include "dsp/interpolatorsblock.h"
 #ifdef USE_SSE4_1
 #include "dsp/inthalfbandfiltereo1.h"
 #else
@@ -129,6 +130,13 @@ private:
 	IntHalfbandFilterDB<qint32, INTERPOLATORS_HB_FILTER_ORDER_NEXT> m_interpolator32; // 5th stages
 	IntHalfbandFilterDB<qint32, INTERPOLATORS_HB_FILTER_ORDER_NEXT> m_interpolator64; // 6th stages
 #endif
+    InterpolatorsBlock m_block; // SIMD block cascades
+
+    /**
+     * Run the whole frames of the buffer through the SIMD block cascade when available.
+     * Returns false when the caller should fall back to the scalar per-frame code.
+     */
+    bool interpolateBlock(SampleVector::iterator* it, T* buf, qint32 len, unsigned int log2, uint pre, uint post);
 };
 
 template<typename T, uint SdrBits, uint OutputBits>
@@ -145,6 +153,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate1(SampleVector::iterator*
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate2_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 1, interpolation_shifts<SdrBits, OutputBits>::pre2, interpolation_shifts<SdrBits, OutputBits>::post2)) {
+        return;
+    }
+
 	qint32 intbuf[4];
 
     for (int pos = 0; pos < len - 3; pos += 4)
@@ -168,6 +180,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate2_cen(SampleVector::itera
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate4_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 2, interpolation_shifts<SdrBits, OutputBits>::pre4, interpolation_shifts<SdrBits, OutputBits>::post4)) {
+        return;
+    }
+
 	qint32 intbuf[8];
 
 	for (int pos = 0; pos < len - 7; pos += 8)
@@ -197,6 +213,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate4_cen(SampleVector::itera
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate8_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 3, interpolation_shifts<SdrBits, OutputBits>::pre8, interpolation_shifts<SdrBits, OutputBits>::post8)) {
+        return;
+    }
+
 	qint32 intbuf[16];
 
 	for (int pos = 0; pos < len - 15; pos += 16)
@@ -239,6 +259,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate8_cen(SampleVector::itera
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate16_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 4, interpolation_shifts<SdrBits, OutputBits>::pre16, interpolation_shifts<SdrBits, OutputBits>::post16)) {
+        return;
+    }
+
 	qint32 intbuf[32];
 
 	for (int pos = 0; pos < len - 31; pos += 32)
@@ -306,6 +330,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate16_cen(SampleVector::iter
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate32_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 5, interpolation_shifts<SdrBits, OutputBits>::pre32, interpolation_shifts<SdrBits, OutputBits>::post32)) {
+        return;
+    }
+
 	qint32 intbuf[64];
 
 	for (int pos = 0; pos < len - 63; pos += 64)
@@ -423,6 +451,10 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate32_cen(SampleVector::iter
 template<typename T, uint SdrBits, uint OutputBits>
 void Interpolators<T, SdrBits, OutputBits>::interpolate64_cen(SampleVector::iterator* it, T* buf, qint32 len)
 {
+    if (interpolateBlock(it, buf, len, 6, interpolation_shifts<SdrBits, OutputBits>::pre64, interpolation_shifts<SdrBits, OutputBits>::post64)) {
+        return;
+    }
+
 	qint32 intbuf[128];
 
 	for (int pos = 0; pos < len - 127; pos += 128)
@@ -609,9 +641,53 @@ void Interpolators<T, SdrBits, OutputBits>::interpolate64_cen(SampleVector::iter
         buf[pos+107] = intbuf[107] >> interpolation_shifts<SdrBits, OutputBits>::post64;
         buf[pos+108] = intbuf[108] >> interpolation_shifts<SdrBits, OutputBits>::post64;
         buf[pos+109] = intbuf[109] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+110] = intbuf[110] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+111] = intbuf[111] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+112] = intbuf[112] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+113] = intbuf[113] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+114] = intbuf[114] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+115] = intbuf[115] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+116] = intbuf[116] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+117] = intbuf[117] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+118] = intbuf[118] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+119] = intbuf[119] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+120] = intbuf[120] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+121] = intbuf[121] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+122] = intbuf[122] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+123] = intbuf[123] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+124] = intbuf[124] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+125] = intbuf[125] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+126] = intbuf[126] >> interpolation_shifts<SdrBits, OutputBits>::post64;
+        buf[pos+127] = intbuf[127] >> interpolation_shifts<SdrBits, OutputBits>::post64;
 
         ++(*it);
 	}
 }
 
+template<typename T, uint SdrBits, uint OutputBits>
+bool Interpolators<T, SdrBits, OutputBits>::interpolateBlock(SampleVector::iterator* it, T* buf, qint32 len, unsigned int log2, uint pre, uint post)
+{
+    if (!InterpolatorsBlock::isEnabled()) {
+        return false;
+    }
+
+    int nbSamples = len / (2 << log2);
+    int32_t *work = m_block.getBuffer(nbSamples);
+
+    for (int i = 0; i < nbSamples; i++)
+    {
+        work[2*i]   = (**it).m_real << pre;
+        work[2*i+1] = (**it).m_imag << pre;
+        ++(*it);
+    }
+
+    const int32_t *out = m_block.interpolate(nbSamples, log2);
+
+    for (int pos = 0; pos < nbSamples * (2 << log2); pos++) {
+        buf[pos] = out[pos] >> post;
+    }
+
+    return true;
+}
+
 #endif /* INCLUDE_GPL_DSP_INTERPOLATORS_H_ */
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <string.h>
+
+#include "dsp/hbfiltertraits.h"
+#include "interpolatorsblock.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define INTERPOLATORSBLOCK_X86
+#include <immintrin.h>
+#endif
+
+// The kernels are compiled for their instruction set whatever the target of the build
+#if defined(INTERPOLATORSBLOCK_X86) && (defined(__GNUC__) || defined(__clang__))
+#define INTERPOLATORSBLOCK_SSE41 __attribute__((target("sse4.1")))
+#define INTERPOLATORSBLOCK_AVX2 __attribute__((target("avx2")))
+#else
+#define INTERPOLATORSBLOCK_SSE41
+#define INTERPOLATORSBLOCK_AVX2
+#endif
+
+namespace {
+
+struct StageFilter
+{
+    const int32_t *m_coeffs;
+    int m_nbTaps;   //!< symmetric pairs of taps
+    int m_history;  //!< previous samples in the taps span
+    int m_shift;
+};
+
+// Orders of the Interpolators stages: INTERPOLATORS_HB_FILTER_ORDER_FIRST, _SECOND then _NEXT
+const StageFilter stageFilters[InterpolatorsBlock::m_maxLog2] = {
+    {HBFIRFilterTraits<64>::hbCoeffs, 16, 31, HBFIRFilterTraits<64>::hbShift - 1},
+    {HBFIRFilterTraits<32>::hbCoeffs,  8, 15, HBFIRFilterTraits<32>::hbShift - 1},
+    {HBFIRFilterTraits<16>::hbCoeffs,  4,  7, HBFIRFilterTraits<16>::hbShift - 1},
+    {HBFIRFilterTraits<16>::hbCoeffs,  4,  7, HBFIRFilterTraits<16>::hbShift - 1},
+    {HBFIRFilterTraits<16>::hbCoeffs,  4,  7, HBFIRFilterTraits<16>::hbShift - 1},
+    {HBFIRFilterTraits<16>::hbCoeffs,  4,  7, HBFIRFilterTraits<16>::hbShift - 1}
+};
+
+// Input sample n of the stage is in[2*(n + history)] (I) and the next value (Q). Output 2n is
+// the middle peak and output 2n+1 the FIR over the pairs of samples n + i and n + history - i
+// as IntHalfbandFilterEO1::myInterpolate computes them. Values j are 2n (I) or 2n+1 (Q).
+void interpolateScalar(const int32_t *in, int32_t *out, int from, int to, const StageFilter& f)
+{
+    for (int j = from; j < to; j++)
+    {
+        int32_t acc = 0;
+
+        for (int i = 0; i < f.m_nbTaps; i++) {
+            acc += (in[j + 2*i] + in[j + 2*(f.m_history - i)]) * f.m_coeffs[i];
+        }
+
+        int n = j / 2, c = j % 2;
+        out[4*n + c] = in[j + 2*(f.m_nbTaps - 1)];
+        out[4*n + 2 + c] = acc >> f.m_shift;
+    }
+}
+
+#if defined(INTERPOLATORSBLOCK_X86)
+
+INTERPOLATORSBLOCK_SSE41
+void interpolateSSE41(const int32_t *in, int32_t *out, int n, const StageFilter& f)
+{
+    int j = 0;
+
+    for (; j + 4 <= n; j += 4) // two I/Q inputs
+    {
+        __m128i acc = _mm_setzero_si128();
+
+        for (int i = 0; i < f.m_nbTaps; i++)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*) &in[j + 2*i]);
+            __m128i b = _mm_loadu_si128((const __m128i*) &in[j + 2*(f.m_history - i)]);
+            acc = _mm_add_epi32(acc, _mm_mullo_epi32(_mm_add_epi32(a, b), _mm_set1_epi32(f.m_coeffs[i])));
+        }
+
+        __m128i even = _mm_loadu_si128((const __m128i*) &in[j + 2*(f.m_nbTaps - 1)]);
+        __m128i odd = _mm_srai_epi32(acc, f.m_shift);
+        _mm_storeu_si128((__m128i*) &out[2*j], _mm_unpacklo_epi64(even, odd));
+        _mm_storeu_si128((__m128i*) &out[2*j+4], _mm_unpackhi_epi64(even, odd));
+    }
+
+    interpolateScalar(in, out, j, n, f);
+}
+
+INTERPOLATORSBLOCK_AVX2
+void interpolateAVX2(const int32_t *in, int32_t *out, int n, const StageFilter& f)
+{
+    int j = 0;
+
+    for (; j + 8 <= n; j += 8) // four I/Q inputs
+    {
+        __m256i acc = _mm256_setzero_si256();
+
+        for (int i = 0; i < f.m_nbTaps; i++)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*) &in[j + 2*i]);
+            __m256i b = _mm256_loadu_si256((const __m256i*) &in[j + 2*(f.m_history - i)]);
+            acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(_mm256_add_epi32(a, b), _mm256_set1_epi32(f.m_coeffs[i])));
+        }
+
+        __m256i even = _mm256_loadu_si256((const __m256i*) &in[j + 2*(f.m_nbTaps - 1)]);
+        __m256i odd = _mm256_srai_epi32(acc, f.m_shift);
+        // unpack works within 128 bit lanes: (e0 o0 | e2 o2) and (e1 o1 | e3 o3)
+        __m256i lo = _mm256_unpacklo_epi64(even, odd);
+        __m256i hi = _mm256_unpackhi_epi64(even, odd);
+        _mm256_storeu_si256((__m256i*) &out[2*j], _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i*) &out[2*j+8], _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+
+    interpolateScalar(in, out, j, n, f);
+}
+
+#endif // INTERPOLATORSBLOCK_X86
+
+int32_t *stageBuffer(std::vector<int32_t>& v, int history, int nbNew)
+{
+    std::size_t size = 2*(history + nbNew);
+
+    if (v.size() < size) {
+        v.resize(size); // new history is zero
+    }
+
+    return v.data();
+}
+
+} // namespace
+
+InterpolatorsBlock::InterpolatorsBlock()
+{}
+
+int32_t *InterpolatorsBlock::getBuffer(int nbSamples)
+{
+    int32_t *samples = stageBuffer(m_stages[0], stageFilters[0].m_history, nbSamples);
+    return &samples[2*stageFilters[0].m_history];
+}
+
+const int32_t *InterpolatorsBlock::interpolate(int nbSamples, unsigned int log2)
+{
+    CPUFeatures::SIMDLevel level = CPUFeatures::getSIMDLevel();
+    int nbIn = nbSamples;
+
+    if (log2 > m_maxLog2) {
+        log2 = m_maxLog2;
+    }
+
+    for (unsigned int s = 0; s < log2; s++)
+    {
+        const StageFilter& f = stageFilters[s];
+        int32_t *in = m_stages[s].data();
+        int32_t *out;
+
+        // the output goes right after the history of the next stage
+        if (s + 1 < log2) {
+            out = &stageBuffer(m_stages[s+1], stageFilters[s+1].m_history, 2*nbIn)[2*stageFilters[s+1].m_history];
+        } else {
+            out = stageBuffer(m_output, 0, 2*nbIn);
+        }
+
+        switch (level)
+        {
+#if defined(INTERPOLATORSBLOCK_X86)
+        case CPUFeatures::SIMDAVX2:
+            interpolateAVX2(in, out, 2*nbIn, f);
+            break;
+        case CPUFeatures::SIMDSSE41:
+            interpolateSSE41(in, out, 2*nbIn, f);
+            break;
+#endif
+        default:
+            interpolateScalar(in, out, 0, 2*nbIn, f);
+            break;
+        }
+
+        memmove(in, &in[2*nbIn], 2*f.m_history*sizeof(int32_t));
+        nbIn *= 2;
+    }
+
+    return log2 == 0 ? getBuffer(nbSamples) : m_output.data();
+}
+
+void InterpolatorsBlock::reset()
+{
+    for (unsigned int s = 0; s < m_maxLog2; s++) {
+        m_stages[s].clear();
+    }
+}
@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_INTERPOLATORSBLOCK_H_
+#define SDRBASE_DSP_INTERPOLATORSBLOCK_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "dsp/cpufeatures.h"
+#include "export.h"
+
+/**
+ * Block implementation of the half-band interpolation cascades of the Interpolators template.
+ * The whole buffer goes through one stage after the other and each stage computes several
+ * outputs at once with the SSE4.1 or AVX2 kernels selected at run time (see CPUFeatures).
+ *
+ * The stages are those of Interpolators (orders 64, 32 then 16) with the arithmetic of
+ * IntHalfbandFilterEO1::myInterpolate (32 bit accumulator, middle peak copied for the even
+ * outputs) so that the output is bit identical to the sample by sample cascades.
+ */
+class SDRBASE_API InterpolatorsBlock
+{
+public:
+    static const unsigned int m_maxLog2 = 6;
+
+    InterpolatorsBlock();
+
+    /** True if the block code should replace the sample by sample code */
+    static bool isEnabled() { return CPUFeatures::getSIMDLevel() != CPUFeatures::SIMDNone; }
+
+    /** Work buffer of nbSamples I/Q pairs to be filled before calling interpolate() */
+    int32_t *getBuffer(int nbSamples);
+    /**
+     * Interpolate by 2^log2 the nbSamples I/Q pairs of the work buffer. Returns the buffer
+     * that holds the nbSamples << log2 output I/Q pairs.
+     */
+    const int32_t *interpolate(int nbSamples, unsigned int log2);
+    /** Clear the stages history */
+    void reset();
+
+private:
+    std::vector<int32_t> m_stages[m_maxLog2]; //!< history then new input samples of each stage
+    std::vector<int32_t> m_output;
+};
+
+#endif /* SDRBASE_DSP_INTERPOLATORSBLOCK_H_ */
@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include "dsp/dsptypes.h"
 #include "dsp/hbfiltertraits.h"
+#include "dsp/inthalfbandfiltereo1i.h"
 #include "export.h"
 
 template<typename EOStorageType, typename AccuType, uint32_t HBFilterOrder>
@@ -62,6 +63,24 @@ public:
         }
     }
 
+    // downsample by 2 a block of samples, return center part of original spectrum
+    // in and out may be the same buffer. Returns the number of output samples
+    int workDecimateCenterBlock(const Sample* in, Sample* out, int nbIn)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbIn; i++)
+        {
+            Sample s(in[i]);
+
+            if (workDecimateCenter(&s)) {
+                out[nbOut++] = s;
+            }
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, return center part of original spectrum - double buffer variant
     bool workInterpolateCenterZeroStuffing(Sample* sampleIn, Sample *SampleOut)
     {
@@ -205,6 +224,24 @@ public:
         }
     }
 
+    // downsample by 2 a block of samples, return lower half of original spectrum
+    // in and out may be the same buffer. Returns the number of output samples
+    int workDecimateLowerHalfBlock(const Sample* in, Sample* out, int nbIn)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbIn; i++)
+        {
+            Sample s(in[i]);
+
+            if (workDecimateLowerHalf(&s)) {
+                out[nbOut++] = s;
+            }
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, from lower half of original spectrum - double buffer variant
     bool workInterpolateLowerHalfZeroStuffing(Sample* sampleIn, Sample *sampleOut)
     {
@@ -404,6 +441,24 @@ public:
         }
     }
 
+    // downsample by 2 a block of samples, return upper half of original spectrum
+    // in and out may be the same buffer. Returns the number of output samples
+    int workDecimateUpperHalfBlock(const Sample* in, Sample* out, int nbIn)
+    {
+        int nbOut = 0;
+
+        for (int i = 0; i < nbIn; i++)
+        {
+            Sample s(in[i]);
+
+            if (workDecimateUpperHalf(&s)) {
+                out[nbOut++] = s;
+            }
+        }
+
+        return nbOut;
+    }
+
     // upsample by 2, move original spectrum to upper half - double buffer variant
     bool workInterpolateUpperHalfZeroStuffing(Sample* sampleIn, Sample *sampleOut)
     {
@@ -789,29 +844,57 @@ protected:
         m_ptr = m_ptr + 1 < 2*m_size ? m_ptr + 1: 0;
     }
 
+    // SIMD symmetric taps for 32 bit storage and accumulator. Returns false if not available
+    static bool doFIRTaps(int ptr,
+            int32_t even[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder],
+            int32_t odd[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder],
+            int32_t& iAcc, int32_t& qAcc)
+    {
+#if defined(USE_SSE4_1)
+        IntHalfbandFilterEO1Intrisics<HBFilterOrder>::work(ptr, even, odd, iAcc, qAcc);
+        return true;
+#else
+        (void) ptr; (void) even; (void) odd; (void) iAcc; (void) qAcc;
+        return false;
+#endif
+    }
+
+    // other storage or accumulator types (24 bit samples) use the plain loop
+    template<typename StorageType, typename AccType>
+    static bool doFIRTaps(int,
+            StorageType[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder],
+            StorageType[2][HBFIRFilterTraits<HBFilterOrder>::hbOrder],
+            AccType&, AccType&)
+    {
+        return false;
+    }
+
     void doFIR(Sample* sample)
     {
         AccuType iAcc = 0;
         AccuType qAcc = 0;
 
-        int a = m_ptr/2 + m_size; // tip pointer
-        int b = m_ptr/2 + 1; // tail pointer
-
-        for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
+        if (!doFIRTaps(m_ptr, m_even, m_odd, iAcc, qAcc))
         {
-            if ((m_ptr % 2) == 0)
-            {
-                iAcc += (m_even[0][a] + m_even[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += (m_even[1][a] + m_even[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-            }
-            else
+            int a = m_ptr/2 + m_size; // tip pointer
+            int b = m_ptr/2 + 1; // tail pointer
+
+            for (int i = 0; i < HBFIRFilterTraits<HBFilterOrder>::hbOrder / 4; i++)
             {
-                iAcc += (m_odd[0][a] + m_odd[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
-                qAcc += (m_odd[1][a] + m_odd[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                if ((m_ptr % 2) == 0)
+                {
+                    iAcc += (m_even[0][a] + m_even[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                    qAcc += (m_even[1][a] + m_even[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                }
+                else
+                {
+                    iAcc += (m_odd[0][a] + m_odd[0][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                    qAcc += (m_odd[1][a] + m_odd[1][b]) * HBFIRFilterTraits<HBFilterOrder>::hbCoeffs[i];
+                }
+
+                a -= 1;
+                b += 1;
             }
-
-            a -= 1;
-            b += 1;
         }
 
         if ((m_ptr % 2) == 0)
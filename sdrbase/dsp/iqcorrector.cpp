@@ -0,0 +1,275 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+
+#include "iqcorrector.h"
+
+const float IQCorrector::m_dcTau = 1024.0f;
+const float IQCorrector::m_imbalanceTau = 4096.0f;
+
+namespace
+{
+
+inline FixReal clampSample(qint32 x)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    return (FixReal) x;
+#else
+    return (FixReal) (x > 32767 ? 32767 : x < -32768 ? -32768 : x);
+#endif
+}
+
+#if defined(USE_SSE2)
+inline __m128 swapIQ(__m128 v)
+{
+    return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+#endif
+
+} // namespace
+
+IQCorrector::IQCorrector()
+{
+    reset();
+}
+
+void IQCorrector::reset()
+{
+    m_iDC = 0.0f;
+    m_qDC = 0.0f;
+    m_II = 0.0;
+    m_IQ = 0.0;
+    m_QQ = 0.0;
+    m_phi = 0.0f;
+    m_amp = 1.0f;
+    m_dcInit = false;
+    m_imbalanceInit = false;
+}
+
+void IQCorrector::process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
+{
+    Sample *samples = &(*begin);
+    int nbSamples = end - begin;
+
+    while (nbSamples > 0)
+    {
+        int n = std::min(nbSamples, m_chunkSize);
+        processChunk(samples, n, imbalanceCorrection);
+        samples += n;
+        nbSamples -= n;
+    }
+}
+
+void IQCorrector::processChunk(Sample *samples, int nbSamples, bool imbalanceCorrection)
+{
+    double sumI, sumQ, sumII, sumIQ, sumQQ;
+    measure(samples, nbSamples, imbalanceCorrection, sumI, sumQ, sumII, sumIQ, sumQQ);
+
+    // chunk mean relative to the current DC estimate
+    double meanI = sumI / nbSamples;
+    double meanQ = sumQ / nbSamples;
+
+    if (imbalanceCorrection)
+    {
+        // moments about the chunk mean
+        double II = sumII / nbSamples - meanI*meanI;
+        double IQ = sumIQ / nbSamples - meanI*meanQ;
+        double QQ = sumQQ / nbSamples - meanQ*meanQ;
+        double alpha = m_imbalanceInit ? 1.0 - exp(-nbSamples / m_imbalanceTau) : 1.0;
+        m_II += alpha * (II - m_II);
+        m_IQ += alpha * (IQ - m_IQ);
+        m_QQ += alpha * (QQ - m_QQ);
+        m_imbalanceInit = true;
+
+        if (m_II > 0.0)
+        {
+            m_phi = m_IQ / m_II;
+            double yQQ = m_QQ - 2.0*m_phi*m_IQ + m_phi*m_phi*m_II; // <Q - phi*I, Q - phi*I>
+
+            if (yQQ > 0.0) {
+                m_amp = sqrt(m_II / yQQ);
+            }
+        }
+    }
+
+    float alpha = m_dcInit ? 1.0f - expf(-nbSamples / m_dcTau) : 1.0f;
+    m_iDC += alpha * meanI;
+    m_qDC += alpha * meanQ;
+    m_dcInit = true;
+
+    if (imbalanceCorrection) {
+        correctIQ(samples, nbSamples);
+    } else {
+        correctDC(samples, nbSamples);
+    }
+}
+
+// Sums of I, Q and of the second order products after removal of the current DC estimate
+void IQCorrector::measure(const Sample *samples, int nbSamples, bool imbalanceCorrection,
+    double& sumI, double& sumQ, double& sumII, double& sumIQ, double& sumQQ) const
+{
+    int i = 0;
+    sumI = 0.0;
+    sumQ = 0.0;
+    sumII = 0.0;
+    sumIQ = 0.0;
+    sumQQ = 0.0;
+
+#if defined(USE_SSE2)
+    const __m128 dc = _mm_setr_ps(m_iDC, m_qDC, m_iDC, m_qDC);
+    __m128 s = _mm_setzero_ps(), s2 = _mm_setzero_ps(), sx = _mm_setzero_ps();
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= nbSamples; i += 2) // 2 samples of 2x32 bits
+    {
+        __m128 f = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128((const __m128i*) &samples[i])), dc);
+        s = _mm_add_ps(s, f);
+
+        if (imbalanceCorrection)
+        {
+            s2 = _mm_add_ps(s2, _mm_mul_ps(f, f));
+            sx = _mm_add_ps(sx, _mm_mul_ps(f, swapIQ(f)));
+        }
+    }
+#else
+    for (; i + 4 <= nbSamples; i += 4) // 4 samples of 2x16 bits
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) &samples[i]);
+        __m128 f0 = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), dc);
+        __m128 f1 = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), dc);
+        s = _mm_add_ps(s, _mm_add_ps(f0, f1));
+
+        if (imbalanceCorrection)
+        {
+            s2 = _mm_add_ps(s2, _mm_add_ps(_mm_mul_ps(f0, f0), _mm_mul_ps(f1, f1)));
+            sx = _mm_add_ps(sx, _mm_add_ps(_mm_mul_ps(f0, swapIQ(f0)), _mm_mul_ps(f1, swapIQ(f1))));
+        }
+    }
+#endif
+    float t[4];
+    _mm_storeu_ps(t, s);
+    sumI = t[0] + t[2];
+    sumQ = t[1] + t[3];
+    _mm_storeu_ps(t, s2);
+    sumII = t[0] + t[2];
+    sumQQ = t[1] + t[3];
+    _mm_storeu_ps(t, sx);
+    sumIQ = t[0] + t[2];
+#endif
+
+    float tI = 0.0f, tQ = 0.0f, tII = 0.0f, tIQ = 0.0f, tQQ = 0.0f;
+
+    for (; i < nbSamples; i++)
+    {
+        float xi = samples[i].m_real - m_iDC;
+        float xq = samples[i].m_imag - m_qDC;
+        tI += xi;
+        tQ += xq;
+
+        if (imbalanceCorrection)
+        {
+            tII += xi*xi;
+            tIQ += xi*xq;
+            tQQ += xq*xq;
+        }
+    }
+
+    sumI += tI;
+    sumQ += tQ;
+    sumII += tII;
+    sumIQ += tIQ;
+    sumQQ += tQQ;
+}
+
+void IQCorrector::correctDC(Sample *samples, int nbSamples) const
+{
+    int i = 0;
+    qint32 iDC = lrintf(m_iDC);
+    qint32 qDC = lrintf(m_qDC);
+
+#if defined(USE_SSE2)
+#ifdef SDR_RX_SAMPLE_24BIT
+    const __m128i dc = _mm_setr_epi32(iDC, qDC, iDC, qDC);
+
+    for (; i + 2 <= nbSamples; i += 2)
+    {
+        __m128i *p = (__m128i*) &samples[i];
+        _mm_storeu_si128(p, _mm_sub_epi32(_mm_loadu_si128(p), dc));
+    }
+#else
+    const __m128i dc = _mm_set1_epi32((qint32) ((quint32) (quint16) qDC << 16 | (quint16) iDC));
+
+    for (; i + 4 <= nbSamples; i += 4)
+    {
+        __m128i *p = (__m128i*) &samples[i];
+        _mm_storeu_si128(p, _mm_subs_epi16(_mm_loadu_si128(p), dc));
+    }
+#endif
+#endif
+
+    for (; i < nbSamples; i++)
+    {
+        samples[i].m_real = clampSample(samples[i].m_real - iDC);
+        samples[i].m_imag = clampSample(samples[i].m_imag - qDC);
+    }
+}
+
+void IQCorrector::correctIQ(Sample *samples, int nbSamples) const
+{
+    int i = 0;
+    float a = m_amp;
+    float b = m_amp * m_phi;
+
+#if defined(USE_SSE2)
+    const __m128 dc = _mm_setr_ps(m_iDC, m_qDC, m_iDC, m_qDC);
+    const __m128 ca = _mm_setr_ps(1.0f, a, 1.0f, a);
+    const __m128 cb = _mm_setr_ps(0.0f, -b, 0.0f, -b);
+#ifdef SDR_RX_SAMPLE_24BIT
+    for (; i + 2 <= nbSamples; i += 2)
+    {
+        __m128i *p = (__m128i*) &samples[i];
+        __m128 f = _mm_sub_ps(_mm_cvtepi32_ps(_mm_loadu_si128(p)), dc);
+        __m128 r = _mm_add_ps(_mm_mul_ps(f, ca), _mm_mul_ps(swapIQ(f), cb));
+        _mm_storeu_si128(p, _mm_cvtps_epi32(r));
+    }
+#else
+    for (; i + 4 <= nbSamples; i += 4)
+    {
+        __m128i *p = (__m128i*) &samples[i];
+        __m128i v = _mm_loadu_si128(p);
+        __m128 f0 = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16)), dc);
+        __m128 f1 = _mm_sub_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16)), dc);
+        __m128 r0 = _mm_add_ps(_mm_mul_ps(f0, ca), _mm_mul_ps(swapIQ(f0), cb));
+        __m128 r1 = _mm_add_ps(_mm_mul_ps(f1, ca), _mm_mul_ps(swapIQ(f1), cb));
+        _mm_storeu_si128(p, _mm_packs_epi32(_mm_cvtps_epi32(r0), _mm_cvtps_epi32(r1)));
+    }
+#endif
+#endif
+
+    for (; i < nbSamples; i++)
+    {
+        float xi = samples[i].m_real - m_iDC;
+        float xq = samples[i].m_imag - m_qDC;
+        samples[i].m_real = clampSample(lrintf(xi));
+        samples[i].m_imag = clampSample(lrintf(a*xq - b*xi));
+    }
+}
@@ -0,0 +1,69 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_IQCORRECTOR_H_
+#define SDRBASE_DSP_IQCORRECTOR_H_
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block DC offset and IQ imbalance correction of the device samples.
+ *
+ * Samples are processed by chunks of at most m_chunkSize. For each chunk the DC, <I,I>, <I,Q> and <Q,Q>
+ * moments are measured in one pass and exponentially averaged. The phase and amplitude corrections are
+ * derived once per chunk and the correction is applied in a second pass as a 2x2 matrix:
+ *   I' = I - DCi
+ *   Q' = A * ((Q - DCq) - phi * (I - DCi)) with phi = <I,Q>/<I,I> and A the ratio of I and corrected Q RMS
+ * This is the same estimator as the previous per sample correction without the per sample
+ * divisions and square root. Both passes use SSE2 when available.
+ */
+class SDRBASE_API IQCorrector
+{
+public:
+    IQCorrector();
+
+    void reset();
+    void process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection);
+
+    float getIDC() const { return m_iDC; } //!< DC estimates in sample units
+    float getQDC() const { return m_qDC; }
+    float getPhase() const { return m_phi; }
+    float getAmplitude() const { return m_amp; }
+
+private:
+    float m_iDC;
+    float m_qDC;
+    double m_II;  //!< <I,I> without DC
+    double m_IQ;  //!< <I,Q> without DC
+    double m_QQ;  //!< <Q,Q> without DC
+    float m_phi;
+    float m_amp;
+    bool m_dcInit;
+    bool m_imbalanceInit;
+
+    static const int m_chunkSize = 1024;
+    static const float m_dcTau;        //!< DC averaging time constant in samples
+    static const float m_imbalanceTau; //!< moments averaging time constant in samples
+
+    void processChunk(Sample *samples, int nbSamples, bool imbalanceCorrection);
+    void measure(const Sample *samples, int nbSamples, bool imbalanceCorrection, double& sumI, double& sumQ, double& sumII, double& sumIQ, double& sumQQ) const;
+    void correctDC(Sample *samples, int nbSamples) const;
+    void correctIQ(Sample *samples, int nbSamples) const;
+};
+
+#endif /* SDRBASE_DSP_IQCORRECTOR_H_ */
@@ -25,6 +25,8 @@
 #define M_PI		3.14159265358979323846
 
 Real NCO::m_table[NCO::TableSize];
+Complex NCO::m_coarseTable[NCO::BlockTableSize];
+Complex NCO::m_fineTable[NCO::BlockTableSize];
 bool NCO::m_tableInitialized = false;
 
 void NCO::initTable()
@@ -35,6 +37,14 @@ void NCO::initTable()
 	for(int i = 0; i < TableSize; i++)
 		m_table[i] = cos((2.0 * M_PI * i) / TableSize);
 
+	for(int i = 0; i < BlockTableSize; i++)
+	{
+		double coarse = (2.0 * M_PI * i) / BlockTableSize;
+		double fine = coarse / BlockTableSize;
+		m_coarseTable[i] = Complex(cos(coarse), sin(coarse));
+		m_fineTable[i] = Complex(cos(fine), sin(fine));
+	}
+
 	m_tableInitialized = true;
 }
 
@@ -47,26 +57,27 @@ NCO::NCO()
 
 void NCO::setFreq(Real freq, Real sampleRate)
 {
-	m_phaseIncrement = (freq * TableSize) / sampleRate;
-	qDebug("NCO freq: %f phase inc %d", freq, m_phaseIncrement);
+	double turns = fmod((double) freq / sampleRate, 1.0); // negative frequencies wrap to the upper half turn
+	m_phaseIncrement = (quint32) llround((turns < 0 ? turns + 1.0 : turns) * 4294967296.0);
+	qDebug("NCO freq: %f phase inc %u", freq, m_phaseIncrement);
 }
 
 float NCO::next()
 {
 	nextPhase();
-	return m_table[m_phase];
+	return m_table[tableIndex()];
 }
 
 Complex NCO::nextIQ()
 {
 	nextPhase();
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	return Complex(m_table[tableIndex()], -m_table[tableIndexQuadrature()]);
 }
 
 Complex NCO::nextQI()
 {
 	nextPhase();
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	return Complex(-m_table[tableIndexQuadrature()], m_table[tableIndex()]);
 }
 
 void NCO::nextIQMul(Real& i, Real& q)
@@ -74,35 +85,69 @@ void NCO::nextIQMul(Real& i, Real& q)
     nextPhase();
     Real x = i;
     Real y = q;
-    const Real& u = m_table[m_phase];
-    const Real& v = -m_table[(m_phase + TableSize / 4) % TableSize];
+    const Real& u = m_table[tableIndex()];
+    const Real& v = -m_table[tableIndexQuadrature()];
     i = x*u - y*v;
     q = x*v + y*u;
 }
 
 float NCO::get()
 {
-	return m_table[m_phase];
+	return m_table[tableIndex()];
 }
 
 Complex NCO::getIQ()
 {
-	return Complex(m_table[m_phase], -m_table[(m_phase + TableSize / 4) % TableSize]);
+	return Complex(m_table[tableIndex()], -m_table[tableIndexQuadrature()]);
 }
 
 void NCO::getIQ(Complex& c)
 {
-	c.real(m_table[m_phase]);
-	c.imag(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	c.real(m_table[tableIndex()]);
+	c.imag(-m_table[tableIndexQuadrature()]);
 }
 
 Complex NCO::getQI()
 {
-	return Complex(-m_table[(m_phase + TableSize / 4) % TableSize], m_table[m_phase]);
+	return Complex(-m_table[tableIndexQuadrature()], m_table[tableIndex()]);
 }
 
 void NCO::getQI(Complex& c)
 {
-	c.imag(m_table[m_phase]);
-	c.real(-m_table[(m_phase + TableSize / 4) % TableSize]);
+	c.imag(m_table[tableIndex()]);
+	c.real(-m_table[tableIndexQuadrature()]);
+}
+
+void NCO::mixBlock(const Sample* in, Complex* out, int n)
+{
+	quint32 phase = m_phase;
+	Real loRe, loIm, x, y;
+
+	for (int k = 0; k < n; k++)
+	{
+		phase += m_phaseIncrement;
+		getLO(phase, loRe, loIm);
+		x = in[k].real();
+		y = in[k].imag();
+		out[k] = Complex(x*loRe - y*loIm, x*loIm + y*loRe);
+	}
+
+	m_phase = phase;
+}
+
+void NCO::mixBlock(const Complex* in, Complex* out, int n)
+{
+	quint32 phase = m_phase;
+	Real loRe, loIm, x, y;
+
+	for (int k = 0; k < n; k++)
+	{
+		phase += m_phaseIncrement;
+		getLO(phase, loRe, loIm);
+		x = in[k].real();
+		y = in[k].imag();
+		out[k] = Complex(x*loRe - y*loIm, x*loIm + y*loRe);
+	}
+
+	m_phase = phase;
 }
@@ -21,32 +21,55 @@
 #include "dsp/dsptypes.h"
 #include "export.h"
 
+/**
+ * Numerically controlled oscillator. The phase is a 32 bit accumulator that wraps naturally
+ * so the frequency resolution is sampleRate / 2^32.
+ *
+ * Sample by sample methods look up the top 12 bits of the phase in a cosine table.
+ * Block methods (mixBlock) split the phase in a 10 bit coarse and a 10 bit fine part and
+ * multiply the two complex table entries. The phase truncation is then 2^-20 turn which puts
+ * spurious responses below -100 dBc.
+ */
 class SDRBASE_API NCO {
 private:
 	enum {
-		TableSize = (1 << 12),
+		TableBits = 12,
+		TableSize = (1 << TableBits),
+		BlockTableBits = 10,
+		BlockTableSize = (1 << BlockTableBits)
 	};
 	static Real m_table[TableSize];
+	static Complex m_coarseTable[BlockTableSize]; //!< exp(j*2*pi*k/2^10)
+	static Complex m_fineTable[BlockTableSize];   //!< exp(j*2*pi*k/2^20)
 	static bool m_tableInitialized;
 
 	static void initTable();
 
-	int m_phaseIncrement;
-	int m_phase;
+	quint32 m_phaseIncrement;
+	quint32 m_phase;
+
+	int tableIndex() const { return m_phase >> (32 - TableBits); }
+	int tableIndexQuadrature() const { return (tableIndex() + TableSize / 4) & (TableSize - 1); }
+
+	/** Local oscillator exp(j*phase) with the coarse and fine tables */
+	void getLO(quint32 phase, Real& loRe, Real& loIm) const
+	{
+		phase += 1U << (31 - 2*BlockTableBits); // round to nearest fine step
+		const Complex& c = m_coarseTable[phase >> (32 - BlockTableBits)];
+		const Complex& f = m_fineTable[(phase >> (32 - 2*BlockTableBits)) & (BlockTableSize - 1)];
+		loRe = c.real()*f.real() - c.imag()*f.imag();
+		loIm = c.real()*f.imag() + c.imag()*f.real();
+	}
 
 public:
 	NCO();
 
 	void setFreq(Real freq, Real sampleRate);
-	void setPhase(int phase) { m_phase = phase; }
+	void setPhase(int phase) { m_phase = ((quint32) phase & (TableSize - 1)) << (32 - TableBits); } //!< phase in 1/4096 turn
 
 	void nextPhase()        //!< Increment phase
 	{
-		m_phase += m_phaseIncrement;
-		while(m_phase >= TableSize)
-			m_phase -= TableSize;
-		while(m_phase < 0)
-			m_phase += TableSize;
+		m_phase += m_phaseIncrement; // wraps modulo 2^32 i.e. one turn
 	}
 
 	Real next();            //!< Return next real sample
@@ -58,6 +81,11 @@ public:
 	void getIQ(Complex& c); //!< Sets to the current complex sample (no phase increment)
 	Complex getQI();        //!< Return current complex sample (no phase increment, reversed)
 	void getQI(Complex& c); //!< Sets to the current complex sample (no phase increment, reversed)
+
+	/** out[k] = in[k] * nextIQ() for n samples. in and out may not overlap. */
+	void mixBlock(const Sample* in, Complex* out, int n);
+	/** out[k] = in[k] * nextIQ() for n samples. in and out may be the same buffer. */
+	void mixBlock(const Complex* in, Complex* out, int n);
 };
 
 #endif // INCLUDE_NCO_H
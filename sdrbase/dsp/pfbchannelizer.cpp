@@ -0,0 +1,354 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+#include "dsp/dspcommands.h"
+#include "dsp/fftengine.h"
+#include "dsp/threadedbasebandsamplesink.h"
+#include "pfbchannelizer.h"
+
+PFBChannelizer::PFBChannelizer(int nbChannels, bool oversampled, int tapsPerChannel) :
+    BasebandSampleSink(),
+    m_nbChannels(nbChannels < 2 ? 2 : nbChannels),
+    m_oversampled(oversampled),
+    m_historyIndex(0),
+    m_decimationCount(0),
+    m_oddOutput(false),
+    m_fft(FFTEngine::create()),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_running(false)
+{
+    setObjectName("PFBChannelizer");
+
+    if (m_oversampled && (m_nbChannels % 2 == 1)) { // decimation by half the number of channels
+        m_nbChannels++;
+    }
+
+    m_decimation = m_oversampled ? m_nbChannels / 2 : m_nbChannels;
+    createTaps(tapsPerChannel < 2 ? 2 : tapsPerChannel);
+    m_history.assign(2 * m_nbTaps, Complex(0.0f, 0.0f));
+    m_fft->configure(m_nbChannels, true);
+    m_channelSamples.resize(m_nbChannels);
+    m_channelUsed.assign(m_nbChannels, false);
+
+    qDebug("PFBChannelizer::PFBChannelizer: %d channels %s with %d taps",
+            m_nbChannels, m_oversampled ? "2x oversampled" : "critically sampled", m_nbTaps);
+}
+
+PFBChannelizer::~PFBChannelizer()
+{
+    delete m_fft;
+}
+
+// Windowed sinc (Blackman-Harris) cut at half the channel spacing with unity gain at DC.
+// Neighbouring channels cross at -6 dB.
+void PFBChannelizer::createTaps(int tapsPerChannel)
+{
+    m_nbTaps = tapsPerChannel * m_nbChannels;
+    m_taps.resize(m_nbTaps);
+    double fc = 0.5 / m_nbChannels;
+    double center = (m_nbTaps - 1) / 2.0;
+    double sum = 0.0;
+
+    for (int i = 0; i < m_nbTaps; i++)
+    {
+        double t = i - center;
+        double sinc = t == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+        double window = 0.35875
+            - 0.48829 * cos((2.0 * M_PI * i) / (m_nbTaps - 1))
+            + 0.14128 * cos((4.0 * M_PI * i) / (m_nbTaps - 1))
+            - 0.01168 * cos((6.0 * M_PI * i) / (m_nbTaps - 1));
+        m_taps[i] = sinc * window;
+        sum += m_taps[i];
+    }
+
+    for (int i = 0; i < m_nbTaps; i++) {
+        m_taps[i] /= sum;
+    }
+}
+
+int PFBChannelizer::getChannelSampleRate() const
+{
+    return m_sampleRate / m_decimation;
+}
+
+qint64 PFBChannelizer::getChannelFrequencyOffset(int channel) const
+{
+    return ((qint64) (channel - m_nbChannels/2) * m_sampleRate) / m_nbChannels;
+}
+
+int PFBChannelizer::getChannelIndex(qint64 frequencyOffset) const
+{
+    if (m_sampleRate == 0) {
+        return -1;
+    }
+
+    int channel = m_nbChannels/2 + (int) round((double) frequencyOffset * m_nbChannels / m_sampleRate);
+    return channel < 0 ? -1 : channel >= m_nbChannels ? -1 : channel;
+}
+
+void PFBChannelizer::addSubscriber(int channel, BasebandSampleSink *sink)
+{
+    if ((channel < 0) || (channel >= m_nbChannels))
+    {
+        qWarning("PFBChannelizer::addSubscriber: invalid channel %d", channel);
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_subscribers.push_back(Subscriber(channel, sink, 0));
+    notifySubscriber(m_subscribers.back());
+
+    if (m_running) {
+        sink->start();
+    }
+
+    updateChannelsUsed();
+}
+
+void PFBChannelizer::removeSubscriber(BasebandSampleSink *sink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::list<Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        if (it->m_sink == sink)
+        {
+            if (m_running) {
+                sink->stop();
+            }
+
+            m_subscribers.erase(it);
+            break;
+        }
+    }
+
+    updateChannelsUsed();
+}
+
+void PFBChannelizer::addThreadedSubscriber(int channel, ThreadedBasebandSampleSink *threadedSink)
+{
+    if ((channel < 0) || (channel >= m_nbChannels))
+    {
+        qWarning("PFBChannelizer::addThreadedSubscriber: invalid channel %d", channel);
+        return;
+    }
+
+    QMutexLocker mutexLocker(&m_mutex);
+    m_subscribers.push_back(Subscriber(channel, 0, threadedSink));
+    notifySubscriber(m_subscribers.back());
+
+    if (m_running) {
+        threadedSink->start();
+    }
+
+    updateChannelsUsed();
+}
+
+void PFBChannelizer::removeThreadedSubscriber(ThreadedBasebandSampleSink *threadedSink)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::list<Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        if (it->m_threadedSink == threadedSink)
+        {
+            if (m_running) {
+                threadedSink->stop();
+            }
+
+            m_subscribers.erase(it);
+            break;
+        }
+    }
+
+    updateChannelsUsed();
+}
+
+int PFBChannelizer::getNbSubscribers() const
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_subscribers.size();
+}
+
+void PFBChannelizer::updateChannelsUsed()
+{
+    std::fill(m_channelUsed.begin(), m_channelUsed.end(), false);
+
+    for (std::list<Subscriber>::const_iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+        m_channelUsed[it->m_channel] = true;
+    }
+}
+
+void PFBChannelizer::notifySubscriber(const Subscriber& subscriber)
+{
+    DSPSignalNotification notif(getChannelSampleRate(), m_centerFrequency + getChannelFrequencyOffset(subscriber.m_channel));
+
+    if (subscriber.m_sink) {
+        subscriber.m_sink->handleMessage(notif);
+    } else {
+        subscriber.m_threadedSink->handleSinkMessage(notif);
+    }
+}
+
+void PFBChannelizer::start()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::list<Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        if (it->m_sink) {
+            it->m_sink->start();
+        } else {
+            it->m_threadedSink->start();
+        }
+    }
+
+    m_running = true;
+}
+
+void PFBChannelizer::stop()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (std::list<Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        if (it->m_sink) {
+            it->m_sink->stop();
+        } else {
+            it->m_threadedSink->stop();
+        }
+    }
+
+    m_running = false;
+}
+
+bool PFBChannelizer::handleMessage(const Message& cmd)
+{
+    if (DSPSignalNotification::match(cmd))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) cmd;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_sampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        qDebug("PFBChannelizer::handleMessage: DSPSignalNotification: sample rate: %d center frequency: %lld channel sample rate: %d",
+                m_sampleRate, m_centerFrequency, getChannelSampleRate());
+
+        for (std::list<Subscriber>::const_iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+            notifySubscriber(*it);
+        }
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void PFBChannelizer::feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    (void) positiveOnly;
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_subscribers.size() == 0) {
+        return;
+    }
+
+    std::size_t nbOutput = (m_decimationCount + (end - begin)) / m_decimation;
+
+    for (int c = 0; c < m_nbChannels; c++)
+    {
+        m_channelSamples[c].clear();
+
+        if (m_channelUsed[c]) {
+            m_channelSamples[c].reserve(nbOutput);
+        }
+    }
+
+    for (SampleVector::const_iterator it = begin; it < end; ++it)
+    {
+        // newest sample is at m_historyIndex + m_nbTaps
+        m_historyIndex = m_historyIndex == m_nbTaps - 1 ? 0 : m_historyIndex + 1;
+        Complex s(it->real() / SDR_RX_SCALEF, it->imag() / SDR_RX_SCALEF);
+        m_history[m_historyIndex] = s;
+        m_history[m_historyIndex + m_nbTaps] = s;
+
+        if (++m_decimationCount == m_decimation)
+        {
+            m_decimationCount = 0;
+            processOutput();
+        }
+    }
+
+    for (std::list<Subscriber>::iterator it = m_subscribers.begin(); it != m_subscribers.end(); ++it)
+    {
+        SampleVector& samples = m_channelSamples[it->m_channel];
+
+        if (samples.size() == 0) {
+            continue;
+        }
+
+        if (it->m_sink) {
+            it->m_sink->feed(samples.begin(), samples.end(), false);
+        } else {
+            it->m_threadedSink->feed(samples.begin(), samples.end(), false);
+        }
+    }
+}
+
+// With h the prototype filter of length L = P*M and D the decimation the output of channel k is:
+//   y_k[m] = sum_{l<L} h[l] x[mD-l] exp(-j2pi k (mD-l)/M)
+//          = exp(-j2pi k mD/M) IDFT_M(u)[k] with u[r] = sum_{p<P} h[pM+r] x[mD-pM-r]
+// The phase term is 1 when critically sampled (D=M) and (-1)^(k*m) when 2x oversampled (D=M/2)
+void PFBChannelizer::processOutput()
+{
+    const Complex *x = &m_history[m_historyIndex + m_nbTaps]; // x[mD-l] is x[-l]
+    Complex *u = m_fft->in();
+
+    for (int r = 0; r < m_nbChannels; r++)
+    {
+        Complex acc(0.0f, 0.0f);
+
+        for (int l = r; l < m_nbTaps; l += m_nbChannels) {
+            acc += x[-l] * m_taps[l];
+        }
+
+        u[r] = acc;
+    }
+
+    m_fft->transform();
+    const Complex *y = m_fft->out();
+    bool negateOdd = m_oversampled && m_oddOutput;
+    m_oddOutput = !m_oddOutput;
+
+    for (int c = 0; c < m_nbChannels; c++)
+    {
+        if (!m_channelUsed[c]) {
+            continue;
+        }
+
+        int k = (c + m_nbChannels - m_nbChannels/2) % m_nbChannels;
+        Complex v = (negateOdd && (k & 1)) ? -y[k] : y[k];
+        m_channelSamples[c].push_back(Sample((FixReal) (v.real() * SDR_RX_SCALEF), (FixReal) (v.imag() * SDR_RX_SCALEF)));
+    }
+}
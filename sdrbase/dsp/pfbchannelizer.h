@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_PFBCHANNELIZER_H_
+#define SDRBASE_DSP_PFBCHANNELIZER_H_
+
+#include <QMutex>
+#include <vector>
+#include <list>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+class FFTEngine;
+class ThreadedBasebandSampleSink;
+
+/**
+ * Polyphase filter bank channelizer. It splits the baseband in nbChannels equally spaced channels
+ * with one polyphase FIR and one FFT of nbChannels per output sample of all channels. The cost
+ * per channel decreases with the number of channels instead of the constant cost of a private
+ * DownChannelizer per channel.
+ *
+ * Channel c (0 to nbChannels-1) is centered at (c - nbChannels/2) * spacing from the device center
+ * frequency where spacing is the baseband sample rate divided by nbChannels. The channel sample rate
+ * is the spacing (critically sampled) or twice the spacing (2x oversampled). Oversampled channels
+ * have no aliasing in the passband and can be used for signals straddling the channel edges.
+ *
+ * It is attached to the device engine as a sink (DeviceSourceAPI::enablePFBChannelizer). Sinks
+ * subscribe to a channel and get its samples and a DSPSignalNotification with the channel sample rate
+ * and absolute center frequency. Threaded sinks get their samples through their private FIFO so
+ * that a channel plugin can subscribe its threaded channelizer instead of adding it to the device engine.
+ */
+class SDRBASE_API PFBChannelizer : public BasebandSampleSink {
+    Q_OBJECT
+
+public:
+    PFBChannelizer(int nbChannels, bool oversampled = true, int tapsPerChannel = 12);
+    virtual ~PFBChannelizer();
+
+    int getNbChannels() const { return m_nbChannels; }
+    bool getOversampled() const { return m_oversampled; }
+    int getChannelSampleRate() const; //!< 0 if the baseband sample rate is not known yet
+    qint64 getChannelFrequencyOffset(int channel) const; //!< from the device center frequency
+    int getChannelIndex(qint64 frequencyOffset) const;   //!< nearest channel to an offset from the device center frequency
+
+    void addSubscriber(int channel, BasebandSampleSink *sink); //!< sink fed in the device engine thread
+    void removeSubscriber(BasebandSampleSink *sink);
+    void addThreadedSubscriber(int channel, ThreadedBasebandSampleSink *threadedSink); //!< sink fed through its own thread
+    void removeThreadedSubscriber(ThreadedBasebandSampleSink *threadedSink);
+    int getNbSubscribers() const;
+
+    virtual void start();
+    virtual void stop();
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual bool handleMessage(const Message& cmd);
+
+private:
+    struct Subscriber
+    {
+        int m_channel;
+        BasebandSampleSink *m_sink;
+        ThreadedBasebandSampleSink *m_threadedSink;
+
+        Subscriber(int channel, BasebandSampleSink *sink, ThreadedBasebandSampleSink *threadedSink) :
+            m_channel(channel),
+            m_sink(sink),
+            m_threadedSink(threadedSink)
+        {}
+    };
+
+    int m_nbChannels;
+    bool m_oversampled;
+    int m_decimation;           //!< input samples per output sample: nbChannels or nbChannels/2 when oversampled
+    int m_nbTaps;               //!< prototype filter length
+    std::vector<Real> m_taps;   //!< prototype low pass filter
+    std::vector<Complex> m_history; //!< last m_nbTaps input samples stored twice so that they are contiguous from any position
+    int m_historyIndex;
+    int m_decimationCount;
+    bool m_oddOutput;           //!< output sample parity for the oversampled phase correction
+    FFTEngine *m_fft;
+
+    std::list<Subscriber> m_subscribers;
+    std::vector<SampleVector> m_channelSamples; //!< output of the current feed for each channel
+    std::vector<bool> m_channelUsed;            //!< has at least one subscriber
+    mutable QMutex m_mutex;
+
+    int m_sampleRate;
+    qint64 m_centerFrequency;
+    bool m_running;
+
+    void createTaps(int tapsPerChannel);
+    void processOutput();
+    void notifySubscriber(const Subscriber& subscriber);
+    void updateChannelsUsed();
+};
+
+#endif /* SDRBASE_DSP_PFBCHANNELIZER_H_ */
@@ -0,0 +1,246 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(USE_AVX2)
+#include <immintrin.h>
+#elif defined(USE_SSE2)
+#include <emmintrin.h>
+#endif
+#include <algorithm>
+#include <QtGlobal>
+
+#include "dsp/interpolator.h"
+#include "polyphaseresampler.h"
+
+PolyphaseResampler::PolyphaseResampler() :
+    m_taps(0),
+    m_alignedTaps(0),
+    m_phaseSteps(1),
+    m_nTaps(4),
+    m_L(1),
+    m_M(1),
+    m_position(1)
+{
+}
+
+PolyphaseResampler::~PolyphaseResampler()
+{
+    free();
+}
+
+void PolyphaseResampler::create(int phaseSteps, int inputSampleRate, int outputSampleRate, double cutoff, double nbTapsPerPhase)
+{
+    free();
+
+    if ((inputSampleRate <= 0) || (outputSampleRate <= 0))
+    {
+        qWarning("PolyphaseResampler::create: invalid rates %d -> %d", inputSampleRate, outputSampleRate);
+        inputSampleRate = 1;
+        outputSampleRate = 1;
+    }
+
+    std::vector<Real> taps;
+
+    Interpolator::createPolyphaseLowPass(
+        taps,
+        phaseSteps, // number of polyphases
+        1.0, // gain
+        phaseSteps * (double) inputSampleRate, // sampling frequency
+        cutoff, // hz beginning of transition band
+        nbTapsPerPhase);
+
+    int nTaps = taps.size() / phaseSteps;
+    m_phaseSteps = phaseSteps;
+    m_nTaps = (nTaps + 3) & ~3;
+
+    // reorder into polyphase and normalize each phase filter like Interpolator does
+    std::vector<Real> polyphase(taps.size());
+
+    for (int phase = 0; phase < phaseSteps; phase++)
+    {
+        Real sum = 0;
+
+        for (int i = 0; i < nTaps; i++)
+        {
+            polyphase[phase * nTaps + i] = taps[i * phaseSteps + phase];
+            sum += polyphase[phase * nTaps + i];
+        }
+
+        for (int i = 0; i < nTaps; i++) {
+            polyphase[phase * nTaps + i] /= sum;
+        }
+    }
+
+    // tap i of a phase applies to the sample i samples before the newest one. Store the
+    // filters in reverse so that they apply to contiguous samples oldest first.
+    int size = 2 * m_phaseSteps * m_nTaps;
+    m_taps = new float[size + 8];
+    std::fill(m_taps, m_taps + size + 8, 0.0f);
+    m_alignedTaps = (float*)((((quint64) m_taps) + 31) & ~31);
+
+    for (int phase = 0; phase < phaseSteps; phase++)
+    {
+        float *phaseTaps = &m_alignedTaps[2 * phase * m_nTaps];
+
+        for (int i = 0; i < nTaps; i++)
+        {
+            phaseTaps[2 * (m_nTaps - 1 - i) + 0] = polyphase[phase * nTaps + i];
+            phaseTaps[2 * (m_nTaps - 1 - i) + 1] = polyphase[phase * nTaps + i];
+        }
+    }
+
+    // reduced ratio
+    int a = inputSampleRate, b = outputSampleRate;
+
+    while (b != 0)
+    {
+        int t = a % b;
+        a = b;
+        b = t;
+    }
+
+    m_M = inputSampleRate / a;
+    m_L = outputSampleRate / a;
+
+    m_phaseIndex.clear();
+
+    if (m_L <= m_maxPhaseIndexSize)
+    {
+        m_phaseIndex.resize(m_L);
+
+        for (quint32 position = 0; position < m_L; position++) {
+            m_phaseIndex[position] = (int) (((qint64) position * m_phaseSteps) / m_L);
+        }
+    }
+
+    reset();
+
+    qDebug("PolyphaseResampler::create: %d -> %d L/M: %u/%u taps per phase: %d",
+            inputSampleRate, outputSampleRate, m_L, m_M, m_nTaps);
+}
+
+void PolyphaseResampler::reset()
+{
+    m_work.assign(m_nTaps - 1, Complex(0, 0));
+    m_position = m_L; // first input yields an output at phase 0
+}
+
+void PolyphaseResampler::free()
+{
+    if (m_taps)
+    {
+        delete[] m_taps;
+        m_taps = 0;
+        m_alignedTaps = 0;
+    }
+}
+
+int PolyphaseResampler::resample(const Complex *in, int nbInput, std::vector<Complex>& out)
+{
+    if (!m_alignedTaps) {
+        return 0;
+    }
+
+    int history = m_nTaps - 1;
+    m_work.resize(history + nbInput);
+    std::copy(in, in + nbInput, m_work.begin() + history);
+
+    int maxOutput = getMaxOutputSize(nbInput);
+
+    if ((int) out.size() < maxOutput) {
+        out.resize(maxOutput);
+    }
+
+    int nbOutput = 0;
+    int k = -1; // last consumed input sample
+    qint64 position = m_position;
+
+    for (;;)
+    {
+        if (position >= m_L) // consume input samples up to the next output
+        {
+            int step = (int) ((position - m_L) / m_L) + 1;
+
+            if (k + step >= nbInput)
+            {
+                position -= (qint64) (nbInput - 1 - k) * m_L;
+                break;
+            }
+
+            k += step;
+            position -= (qint64) step * m_L;
+        }
+
+        dotProduct(&m_work[k], phaseIndex(position), out[nbOutput++]);
+        position += m_M;
+    }
+
+    m_position = position;
+
+    // keep the last samples as history for the next block
+    std::copy(m_work.begin() + nbInput, m_work.begin() + nbInput + history, m_work.begin());
+    m_work.resize(history);
+
+    return nbOutput;
+}
+
+void PolyphaseResampler::dotProduct(const Complex *samples, int phase, Complex& result) const
+{
+    const float *src = (const float *) samples;
+    const float *taps = &m_alignedTaps[2 * phase * m_nTaps];
+#if defined(USE_AVX2)
+    __m256 sum = _mm256_setzero_ps();
+
+    for (int i = 0; i < m_nTaps; i += 4)
+    {
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(src), _mm256_load_ps(taps)));
+        src += 8;
+        taps += 8;
+    }
+
+    // four complex partial sums to one
+    __m128 sum4 = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    sum4 = _mm_add_ps(sum4, _mm_movehl_ps(sum4, sum4));
+    _mm_storel_pi((__m64*) &result, sum4);
+#elif defined(USE_SSE2)
+    __m128 sum0 = _mm_setzero_ps();
+    __m128 sum1 = _mm_setzero_ps();
+
+    for (int i = 0; i < m_nTaps; i += 4)
+    {
+        sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(src), _mm_load_ps(taps)));
+        sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(src + 4), _mm_load_ps(taps + 4)));
+        src += 8;
+        taps += 8;
+    }
+
+    // two complex partial sums to one
+    sum0 = _mm_add_ps(sum0, sum1);
+    _mm_storel_pi((__m64*) &result, _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0)));
+#else
+    Real rAcc = 0;
+    Real iAcc = 0;
+
+    for (int i = 0; i < m_nTaps; i++)
+    {
+        rAcc += taps[2*i] * src[2*i];
+        iAcc += taps[2*i] * src[2*i + 1];
+    }
+
+    result = Complex(rAcc, iAcc);
+#endif
+}
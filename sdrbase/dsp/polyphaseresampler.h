@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_POLYPHASERESAMPLER_H_
+#define SDRBASE_DSP_POLYPHASERESAMPLER_H_
+
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "export.h"
+
+/**
+ * Block version of Interpolator for a rational ratio inputRate/outputRate reduced to M/L.
+ *
+ * It uses the same polyphase low pass bank as Interpolator and the same phase convention
+ * so it can replace the Interpolator::decimate() / interpolate() loops of the demodulators.
+ * The fractional position of the next output is kept as an integer numerator over L so there
+ * is no drift between the output rate and the input rate. Phase indices are precomputed for
+ * all possible positions when L is small enough which is the case for usual sample rates.
+ *
+ * Input samples are appended to a linear history buffer so that each output is a straight
+ * dot product on contiguous memory (no ring buffer wrap). Phase filters are zero padded to a
+ * multiple of 4 taps and stored reversed with each coefficient duplicated for I and Q.
+ */
+class SDRBASE_API PolyphaseResampler {
+public:
+    PolyphaseResampler();
+    ~PolyphaseResampler();
+
+    /**
+     * Design the filter bank and set the ratio. Parameters are those of Interpolator::create()
+     * with the input and output sample rates instead of the distance.
+     */
+    void create(int phaseSteps, int inputSampleRate, int outputSampleRate, double cutoff, double nbTapsPerPhase = 4.5);
+    void reset(); //!< clear history and restart the output phase
+
+    /** Maximum number of output samples produced by nbInput input samples */
+    int getMaxOutputSize(int nbInput) const { return (int) ((((qint64) nbInput + 1) * m_L) / m_M) + 1; }
+
+    /** Resample nbInput samples. The output vector is grown if necessary. Returns the number of output samples. */
+    int resample(const Complex *in, int nbInput, std::vector<Complex>& out);
+
+    quint32 getL() const { return m_L; } //!< interpolation factor of the reduced ratio
+    quint32 getM() const { return m_M; } //!< decimation factor of the reduced ratio
+
+private:
+    float *m_taps;           //!< allocation of the phase filters
+    float *m_alignedTaps;    //!< phase filters aligned on 32 bytes: m_phaseSteps x m_nTaps x (h, h)
+    std::vector<Complex> m_work; //!< m_nTaps - 1 history samples followed by the current block
+    std::vector<int> m_phaseIndex; //!< phase filter index for each position numerator (empty if L is too large)
+    int m_phaseSteps;
+    int m_nTaps;             //!< taps per phase after padding (multiple of 4)
+    quint32 m_L;
+    quint32 m_M;
+    qint64 m_position;       //!< position of the next output in 1/L input samples relative to the last input
+
+    static const quint32 m_maxPhaseIndexSize = 1<<12;
+
+    int phaseIndex(qint64 position) const
+    {
+        return m_phaseIndex.size() > 0 ? m_phaseIndex[position] : (int) ((position * m_phaseSteps) / m_L);
+    }
+
+    void dotProduct(const Complex *samples, int phase, Complex& result) const;
+    void free();
+};
+
+#endif /* SDRBASE_DSP_POLYPHASERESAMPLER_H_ */
@@ -0,0 +1,198 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "samplemixer.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define SAMPLEMIXER_X86
+#include <immintrin.h>
+#endif
+
+// The kernels are compiled for their instruction set whatever the target of the build
+#if defined(SAMPLEMIXER_X86) && (defined(__GNUC__) || defined(__clang__))
+#define SAMPLEMIXER_SSE41 __attribute__((target("sse4.1")))
+#define SAMPLEMIXER_AVX2 __attribute__((target("avx2")))
+#else
+#define SAMPLEMIXER_SSE41
+#define SAMPLEMIXER_AVX2
+#endif
+
+namespace {
+
+const int32_t txMax = (1<<(SDR_TX_SAMP_SZ-1)) - 1;
+const int32_t txMin = -(1<<(SDR_TX_SAMP_SZ-1));
+const int32_t maxGain = (1<<(SampleMixer::m_gainShift+1)) - 1; // keeps the products within 32 bits
+
+// Values j are the I and Q values of the samples: 2n (I) and 2n+1 (Q)
+void mixScalar(const FixReal * const *sources, const int32_t *gains, unsigned int nbSources,
+        FixReal *dst, unsigned int from, unsigned int to)
+{
+    for (unsigned int j = from; j < to; j++)
+    {
+        int32_t acc = 0;
+
+        for (unsigned int s = 0; s < nbSources; s++) {
+            acc += (((int32_t) sources[s][j]) * gains[s]) >> SampleMixer::m_gainShift;
+        }
+
+        dst[j] = acc < txMin ? txMin : acc > txMax ? txMax : acc;
+    }
+}
+
+#if defined(SAMPLEMIXER_X86)
+
+// 16 bit samples are widened on load and narrowed with saturation on store (packs).
+// 32 bit samples (SDR_RX_SAMPLE_24BIT) are clamped to the Tx range before store.
+
+SAMPLEMIXER_SSE41
+inline __m128i load4(const FixReal *p)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    return _mm_loadu_si128((const __m128i*) p);
+#else
+    return _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*) p));
+#endif
+}
+
+SAMPLEMIXER_SSE41
+inline void store4(FixReal *p, __m128i v)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    v = _mm_min_epi32(_mm_max_epi32(v, _mm_set1_epi32(txMin)), _mm_set1_epi32(txMax));
+    _mm_storeu_si128((__m128i*) p, v);
+#else
+    _mm_storel_epi64((__m128i*) p, _mm_packs_epi32(v, v));
+#endif
+}
+
+SAMPLEMIXER_AVX2
+inline __m256i load8(const FixReal *p)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    return _mm256_loadu_si256((const __m256i*) p);
+#else
+    return _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*) p));
+#endif
+}
+
+SAMPLEMIXER_AVX2
+inline void store8(FixReal *p, __m256i v)
+{
+#ifdef SDR_RX_SAMPLE_24BIT
+    v = _mm256_min_epi32(_mm256_max_epi32(v, _mm256_set1_epi32(txMin)), _mm256_set1_epi32(txMax));
+    _mm256_storeu_si256((__m256i*) p, v);
+#else
+    _mm_storeu_si128((__m128i*) p, _mm_packs_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+#endif
+}
+
+SAMPLEMIXER_SSE41
+void mixSSE41(const FixReal * const *sources, const int32_t *gains, unsigned int nbSources,
+        FixReal *dst, unsigned int n)
+{
+    unsigned int j = 0;
+
+    for (; j + 4 <= n; j += 4) // two I/Q samples
+    {
+        __m128i acc = _mm_setzero_si128();
+
+        for (unsigned int s = 0; s < nbSources; s++)
+        {
+            __m128i p = _mm_mullo_epi32(load4(&sources[s][j]), _mm_set1_epi32(gains[s]));
+            acc = _mm_add_epi32(acc, _mm_srai_epi32(p, SampleMixer::m_gainShift));
+        }
+
+        store4(&dst[j], acc);
+    }
+
+    mixScalar(sources, gains, nbSources, dst, j, n);
+}
+
+SAMPLEMIXER_AVX2
+void mixAVX2(const FixReal * const *sources, const int32_t *gains, unsigned int nbSources,
+        FixReal *dst, unsigned int n)
+{
+    unsigned int j = 0;
+
+    for (; j + 8 <= n; j += 8) // four I/Q samples
+    {
+        __m256i acc = _mm256_setzero_si256();
+
+        for (unsigned int s = 0; s < nbSources; s++)
+        {
+            __m256i p = _mm256_mullo_epi32(load8(&sources[s][j]), _mm256_set1_epi32(gains[s]));
+            acc = _mm256_add_epi32(acc, _mm256_srai_epi32(p, SampleMixer::m_gainShift));
+        }
+
+        store8(&dst[j], acc);
+    }
+
+    mixScalar(sources, gains, nbSources, dst, j, n);
+}
+
+#endif // SAMPLEMIXER_X86
+
+} // namespace
+
+SampleMixer::SampleMixer()
+{}
+
+void SampleMixer::setNbSources(unsigned int nbSources)
+{
+    m_floatGains.resize(nbSources, 1.0f);
+    m_gains.resize(nbSources, 1<<m_gainShift);
+    m_values.resize(nbSources);
+}
+
+bool SampleMixer::setGain(unsigned int index, float gain)
+{
+    if ((index >= m_gains.size()) || (gain == m_floatGains[index])) {
+        return false;
+    }
+
+    long fixedGain = std::lround(gain * (1<<m_gainShift));
+    m_floatGains[index] = gain;
+    m_gains[index] = fixedGain < -maxGain ? -maxGain : fixedGain > maxGain ? maxGain : fixedGain;
+    return true;
+}
+
+void SampleMixer::mix(const Sample * const *sources, Sample *dst, unsigned int nbSamples)
+{
+    const unsigned int nbSources = m_gains.size();
+    const FixReal **values = m_values.data();
+    FixReal *out = reinterpret_cast<FixReal*>(dst); // I/Q values of the packed samples
+
+    for (unsigned int s = 0; s < nbSources; s++) {
+        values[s] = reinterpret_cast<const FixReal*>(sources[s]);
+    }
+
+    switch (CPUFeatures::getSIMDLevel())
+    {
+#if defined(SAMPLEMIXER_X86)
+    case CPUFeatures::SIMDAVX2:
+        mixAVX2(values, m_gains.data(), nbSources, out, 2*nbSamples);
+        break;
+    case CPUFeatures::SIMDSSE41:
+        mixSSE41(values, m_gains.data(), nbSources, out, 2*nbSamples);
+        break;
+#endif
+    default:
+        mixScalar(values, m_gains.data(), nbSources, out, 0, 2*nbSamples);
+        break;
+    }
+}
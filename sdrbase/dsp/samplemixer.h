@@ -0,0 +1,59 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 Edouard Griffiths, F4EXB                                   //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLEMIXER_H_
+#define SDRBASE_DSP_SAMPLEMIXER_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "dsp/cpufeatures.h"
+#include "export.h"
+
+/**
+ * Sums blocks of samples of several Tx sources into one block. Each source has its gain
+ * which already includes the overall division factor so that there is no division in the
+ * loop. The gains are applied in Q15 fixed point (range -2 to 2) and the sum is saturated
+ * to the SDR_TX_SAMP_SZ range. Blocks are mixed with the SSE4.1 or AVX2 kernels selected
+ * at run time (see CPUFeatures) and the output is the same as the plain code.
+ */
+class SDRBASE_API SampleMixer
+{
+public:
+    static const int m_gainShift = 15;
+
+    SampleMixer();
+
+    void setNbSources(unsigned int nbSources); //!< new sources have unit gain
+    unsigned int getNbSources() const { return m_gains.size(); }
+    /** Set the gain of one source. Returns true if it has changed */
+    bool setGain(unsigned int index, float gain);
+    int32_t getFixedGain(unsigned int index) const { return m_gains[index]; }
+
+    /**
+     * Sum nbSamples samples of each of the getNbSources() sources into dst. dst may be one
+     * of the sources. Source samples are expected within the SDR_TX_SAMP_SZ range.
+     */
+    void mix(const Sample * const *sources, Sample *dst, unsigned int nbSamples);
+
+private:
+    std::vector<float> m_floatGains;
+    std::vector<int32_t> m_gains; //!< Q15 gains
+    std::vector<const FixReal*> m_values; //!< I/Q values of the sources of the current mix
+};
+
+#endif /* SDRBASE_DSP_SAMPLEMIXER_H_ */
@@ -25,6 +25,10 @@ void SampleSinkFifo::create(uint s)
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	m_highWater = 0;
+	m_overflowCount = 0;
+	m_droppedSamples = 0;
+	m_underflowCount = 0;
 
 	m_data.resize(s);
 	m_size = m_data.size();
@@ -42,6 +46,10 @@ SampleSinkFifo::SampleSinkFifo(QObject* parent) :
 	m_fill = 0;
 	m_head = 0;
 	m_tail = 0;
+	m_highWater = 0;
+	m_overflowCount = 0;
+	m_droppedSamples = 0;
+	m_underflowCount = 0;
 }
 
 SampleSinkFifo::SampleSinkFifo(int size, QObject* parent) :
@@ -104,6 +112,8 @@ uint SampleSinkFifo::write(const quint8* data, uint count)
 		remaining -= len;
 	}
 
+	updateStats(count, total);
+
 	if(m_fill > 0)
 		emit dataReady();
 
@@ -146,6 +156,8 @@ uint SampleSinkFifo::write(SampleVector::const_iterator begin, SampleVector::con
 		remaining -= len;
 	}
 
+	updateStats(count, total);
+
 	if(m_fill > 0)
 		emit dataReady();
 
@@ -161,8 +173,10 @@ uint SampleSinkFifo::read(SampleVector::iterator begin, SampleVector::iterator e
 	uint len;
 
 	total = MIN(count, m_fill);
-	if(total < count)
+	if(total < count) {
+		m_underflowCount++;
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
+	}
 
 	remaining = total;
 	while(remaining > 0) {
@@ -189,8 +203,10 @@ uint SampleSinkFifo::readBegin(uint count,
 	uint head = m_head;
 
 	total = MIN(count, m_fill);
-	if(total < count)
+	if(total < count) {
+		m_underflowCount++;
 		qCritical("SampleSinkFifo: underflow - missing %u samples", count - total);
+	}
 
 	remaining = total;
 	if(remaining > 0) {
@@ -229,3 +245,26 @@ uint SampleSinkFifo::readCommit(uint count)
 
 	return count;
 }
+
+void SampleSinkFifo::updateStats(uint count, uint total)
+{
+	if(total < count) {
+		m_overflowCount++;
+		m_droppedSamples += count - total;
+	}
+
+	if(m_fill > m_highWater)
+		m_highWater = m_fill;
+}
+
+void SampleSinkFifo::getStats(SampleFifoStats& stats)
+{
+	QMutexLocker mutexLocker(&m_mutex);
+
+	stats.m_size = m_size;
+	stats.m_fill = m_fill;
+	stats.m_highWater = m_highWater;
+	stats.m_overflowCount = m_overflowCount;
+	stats.m_droppedSamples = m_droppedSamples;
+	stats.m_underflowCount = m_underflowCount;
+}
@@ -22,8 +22,15 @@
 #include <QMutex>
 #include <QTime>
 #include "dsp/dsptypes.h"
+#include "dsp/dspstats.h"
 #include "export.h"
 
+/**
+ * FIFO between a device (producer) and the DSP device engine (consumer). Devices and the engine
+ * use it through SampleSinkFifo pointers so the methods are virtual: SampleSinkFifoSPSC overrides
+ * them with a lock free implementation. This base implementation is protected by a mutex and
+ * accepts several writers and readers.
+ */
 class SDRBASE_API SampleSinkFifo : public QObject {
 	Q_OBJECT
 
@@ -39,26 +46,34 @@ private:
 	uint m_head;
 	uint m_tail;
 
+	uint m_highWater;
+	quint32 m_overflowCount;
+	quint64 m_droppedSamples;
+	quint32 m_underflowCount;
+
 	void create(uint s);
+	void updateStats(uint count, uint total);
 
 public:
 	SampleSinkFifo(QObject* parent = NULL);
 	SampleSinkFifo(int size, QObject* parent = NULL);
 	~SampleSinkFifo();
 
-	bool setSize(int size);
-	inline uint size() const { return m_size; }
-	inline uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
+	virtual bool setSize(int size);
+	virtual uint size() const { return m_size; }
+	virtual uint fill() { QMutexLocker mutexLocker(&m_mutex); uint fill = m_fill; return fill; }
 
-	uint write(const quint8* data, uint count);
-	uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+	virtual uint write(const quint8* data, uint count);
+	virtual uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
 
-	uint read(SampleVector::iterator begin, SampleVector::iterator end);
+	virtual uint read(SampleVector::iterator begin, SampleVector::iterator end);
 
-	uint readBegin(uint count,
+	virtual uint readBegin(uint count,
 		SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
 		SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
-	uint readCommit(uint count);
+	virtual uint readCommit(uint count);
+
+	virtual void getStats(SampleFifoStats& stats); //!< fill level, high water mark, overflows and underflows since creation or resize
 
 signals:
 	void dataReady();
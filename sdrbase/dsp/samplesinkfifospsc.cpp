@@ -0,0 +1,277 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "samplesinkfifospsc.h"
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+SampleSinkFifoSPSC::SampleSinkFifoSPSC(QObject* parent) :
+    SampleSinkFifo(parent),
+    m_suppressed(-1),
+    m_data(),
+    m_size(0),
+    m_mask(0),
+    m_head(0),
+    m_tail(0),
+    m_highWater(0),
+    m_overflowCount(0),
+    m_droppedSamples(0),
+    m_underflowCount(0)
+{
+}
+
+SampleSinkFifoSPSC::SampleSinkFifoSPSC(int size, QObject* parent) :
+    SampleSinkFifo(parent),
+    m_suppressed(-1),
+    m_data(),
+    m_size(0),
+    m_mask(0),
+    m_head(0),
+    m_tail(0),
+    m_highWater(0),
+    m_overflowCount(0),
+    m_droppedSamples(0),
+    m_underflowCount(0)
+{
+    create(size);
+}
+
+SampleSinkFifoSPSC::~SampleSinkFifoSPSC()
+{
+    m_size = 0;
+}
+
+void SampleSinkFifoSPSC::create(uint s)
+{
+    uint p2 = 1;
+
+    while ((p2 < s) && (p2 < (1U<<31))) {
+        p2 <<= 1;
+    }
+
+    m_size = 0;
+    m_mask = 0;
+    m_head.storeRelease(0);
+    m_tail.storeRelease(0);
+    m_highWater.storeRelease(0);
+    m_overflowCount.storeRelease(0);
+    m_droppedSamples.storeRelease(0);
+    m_underflowCount.storeRelease(0);
+
+    m_data.resize(p2);
+
+    if (m_data.size() != p2)
+    {
+        qCritical("SampleSinkFifoSPSC: out of memory");
+        return;
+    }
+
+    m_size = p2;
+    m_mask = p2 - 1;
+}
+
+bool SampleSinkFifoSPSC::setSize(int size)
+{
+    create(size);
+
+    return m_size >= (uint) size;
+}
+
+uint SampleSinkFifoSPSC::writeSamples(const Sample* begin, uint count)
+{
+    quint32 tail = m_tail.load(); // only this thread writes the tail
+    quint32 head = m_head.loadAcquire();
+    uint total;
+    uint remaining;
+    uint len;
+
+    total = MIN(count, m_size - (tail - head));
+
+    if (total < count)
+    {
+        m_overflowCount.fetchAndAddRelaxed(1);
+        m_droppedSamples.fetchAndAddRelaxed(count - total);
+
+        if (m_suppressed < 0)
+        {
+            m_suppressed = 0;
+            m_msgRateTimer.start();
+            qCritical("SampleSinkFifoSPSC: overflow - dropping %u samples", count - total);
+        }
+        else
+        {
+            if (m_msgRateTimer.elapsed() > 2500)
+            {
+                qCritical("SampleSinkFifoSPSC: %u messages dropped", m_suppressed);
+                qCritical("SampleSinkFifoSPSC: overflow - dropping %u samples", count - total);
+                m_suppressed = -1;
+            }
+            else
+            {
+                m_suppressed++;
+            }
+        }
+    }
+
+    remaining = total;
+    quint32 index = tail;
+
+    while (remaining > 0)
+    {
+        uint pos = index & m_mask;
+        len = MIN(remaining, m_size - pos);
+        std::copy(begin, begin + len, m_data.begin() + pos);
+        index += len;
+        begin += len;
+        remaining -= len;
+    }
+
+    m_tail.storeRelease(tail + total); // publish the samples to the consumer
+
+    if (tail + total - head > m_highWater.load()) {
+        m_highWater.storeRelease(tail + total - head);
+    }
+
+    if (tail + total != head) {
+        emit dataReady();
+    }
+
+    return total;
+}
+
+uint SampleSinkFifoSPSC::write(const quint8* data, uint count)
+{
+    return writeSamples((const Sample*) data, count / sizeof(Sample));
+}
+
+uint SampleSinkFifoSPSC::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    if (begin == end) {
+        return 0;
+    }
+
+    return writeSamples(&(*begin), end - begin);
+}
+
+uint SampleSinkFifoSPSC::read(SampleVector::iterator begin, SampleVector::iterator end)
+{
+    quint32 head = m_head.load(); // only this thread writes the head
+    quint32 tail = m_tail.loadAcquire();
+    uint count = end - begin;
+    uint total;
+    uint remaining;
+    uint len;
+
+    total = MIN(count, tail - head);
+    if (total < count)
+    {
+        m_underflowCount.fetchAndAddRelaxed(1);
+        qCritical("SampleSinkFifoSPSC: underflow - missing %u samples", count - total);
+    }
+
+    remaining = total;
+    quint32 index = head;
+
+    while (remaining > 0)
+    {
+        uint pos = index & m_mask;
+        len = MIN(remaining, m_size - pos);
+        std::copy(m_data.begin() + pos, m_data.begin() + pos + len, begin);
+        index += len;
+        begin += len;
+        remaining -= len;
+    }
+
+    m_head.storeRelease(head + total); // give the space back to the producer
+
+    return total;
+}
+
+uint SampleSinkFifoSPSC::readBegin(uint count,
+    SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+    SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
+{
+    quint32 head = m_head.load();
+    quint32 tail = m_tail.loadAcquire();
+    uint total;
+    uint remaining;
+    uint len;
+
+    total = MIN(count, tail - head);
+    if (total < count)
+    {
+        m_underflowCount.fetchAndAddRelaxed(1);
+        qCritical("SampleSinkFifoSPSC: underflow - missing %u samples", count - total);
+    }
+
+    remaining = total;
+    uint pos = head & m_mask;
+
+    if (remaining > 0)
+    {
+        len = MIN(remaining, m_size - pos);
+        *part1Begin = m_data.begin() + pos;
+        *part1End = m_data.begin() + pos + len;
+        pos = (pos + len) & m_mask;
+        remaining -= len;
+    }
+    else
+    {
+        *part1Begin = m_data.end();
+        *part1End = m_data.end();
+    }
+
+    if (remaining > 0)
+    {
+        len = MIN(remaining, m_size - pos);
+        *part2Begin = m_data.begin() + pos;
+        *part2End = m_data.begin() + pos + len;
+    }
+    else
+    {
+        *part2Begin = m_data.end();
+        *part2End = m_data.end();
+    }
+
+    return total;
+}
+
+uint SampleSinkFifoSPSC::readCommit(uint count)
+{
+    quint32 head = m_head.load();
+    quint32 tail = m_tail.loadAcquire();
+
+    if (count > tail - head)
+    {
+        qCritical("SampleSinkFifoSPSC: cannot commit more than available samples");
+        count = tail - head;
+    }
+
+    m_head.storeRelease(head + count);
+
+    return count;
+}
+
+void SampleSinkFifoSPSC::getStats(SampleFifoStats& stats)
+{
+    stats.m_size = m_size;
+    stats.m_fill = fill();
+    stats.m_highWater = m_highWater.loadAcquire();
+    stats.m_overflowCount = m_overflowCount.loadAcquire();
+    stats.m_droppedSamples = m_droppedSamples.loadAcquire();
+    stats.m_underflowCount = m_underflowCount.loadAcquire();
+}
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLESINKFIFOSPSC_H_
+#define SDRBASE_DSP_SAMPLESINKFIFOSPSC_H_
+
+#include <QObject>
+#include <QTime>
+#include <QAtomicInteger>
+
+#include "dsp/dsptypes.h"
+#include "dsp/samplesinkfifo.h"
+#include "export.h"
+
+/**
+ * Lock free single producer / single consumer implementation of SampleSinkFifo. It can be
+ * used wherever a SampleSinkFifo is expected (device thread to DSP device engine) as long as
+ * only one thread writes (the device thread) and only one thread reads (the DSP engine).
+ * Statistics may be read from any thread. Capacity is rounded up to a power of two so that
+ * the monotonic head and tail indexes can be masked into the buffer.
+ * setSize() is not thread safe and must be called with both ends stopped.
+ */
+class SDRBASE_API SampleSinkFifoSPSC : public SampleSinkFifo {
+    Q_OBJECT
+
+public:
+    SampleSinkFifoSPSC(QObject* parent = NULL);
+    SampleSinkFifoSPSC(int size, QObject* parent = NULL);
+    ~SampleSinkFifoSPSC();
+
+    virtual bool setSize(int size);
+    virtual uint size() const { return m_size; }
+    virtual uint fill()
+    {
+        quint32 head = m_head.loadAcquire(); // head first: a tail read later is never behind it
+        quint32 fill = m_tail.loadAcquire() - head;
+        return fill > m_size ? m_size : fill; // the head may have moved on after it was read
+    }
+
+    virtual uint write(const quint8* data, uint count);
+    virtual uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+    virtual uint read(SampleVector::iterator begin, SampleVector::iterator end);
+
+    virtual uint readBegin(uint count,
+        SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+        SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
+    virtual uint readCommit(uint count);
+
+    virtual void getStats(SampleFifoStats& stats);
+
+private:
+    QTime m_msgRateTimer; //!< producer side only
+    int m_suppressed;     //!< producer side only
+
+    SampleVector m_data;
+    uint m_size;
+    uint m_mask;
+
+    char m_pad0[64];
+    QAtomicInteger<quint32> m_head; //!< monotonic read index: written by the consumer only
+    char m_pad1[64];                //!< keep head and tail on separate cache lines
+    QAtomicInteger<quint32> m_tail; //!< monotonic write index: written by the producer only
+    char m_pad2[64];
+
+    QAtomicInteger<quint32> m_highWater;      //!< written by the producer only
+    QAtomicInteger<quint32> m_overflowCount;  //!< written by the producer only
+    QAtomicInteger<quint64> m_droppedSamples; //!< written by the producer only
+    QAtomicInteger<quint32> m_underflowCount; //!< written by the consumer only
+
+    void create(uint s);
+    uint writeSamples(const Sample* begin, uint count);
+};
+
+#endif /* SDRBASE_DSP_SAMPLESINKFIFOSPSC_H_ */
@@ -0,0 +1,387 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "samplesinkring.h"
+
+#define MIN(x, y) (((x) < (y)) ? (x) : (y))
+
+SampleSinkRing::SampleSinkRing(QObject* parent) :
+    QObject(parent),
+    m_suppressed(-1),
+    m_data(),
+    m_size(0),
+    m_writePos(0)
+{
+}
+
+SampleSinkRing::SampleSinkRing(int size, QObject* parent) :
+    QObject(parent),
+    m_suppressed(-1),
+    m_data(),
+    m_size(0),
+    m_writePos(0)
+{
+    create(size);
+}
+
+SampleSinkRing::~SampleSinkRing()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    m_size = 0;
+}
+
+void SampleSinkRing::create(uint s)
+{
+    m_size = 0;
+    m_writePos = 0;
+
+    for (std::vector<Reader>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        it->m_readPos = 0;
+        it->m_pending = 0;
+        it->m_highWater = 0;
+    }
+
+    m_data.resize(s);
+    m_size = m_data.size();
+
+    if (m_size != s) {
+        qCritical("SampleSinkRing: out of memory");
+    }
+}
+
+bool SampleSinkRing::setSize(int size)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    create(size);
+
+    return m_data.size() == (uint) size;
+}
+
+bool SampleSinkRing::isValidReader(int reader) const
+{
+    return (reader >= 0) && (reader < (int) m_readers.size()) && m_readers[reader].m_active;
+}
+
+int SampleSinkRing::addReader()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    int index = 0;
+
+    for (; index < (int) m_readers.size(); index++)
+    {
+        if (!m_readers[index].m_active) {
+            break;
+        }
+    }
+
+    if (index == (int) m_readers.size()) {
+        m_readers.push_back(Reader());
+    }
+
+    m_readers[index] = Reader();
+    m_readers[index].m_active = true;
+    m_readers[index].m_readPos = m_writePos; // new readers only see samples written from now on
+
+    return index;
+}
+
+void SampleSinkRing::removeReader(int reader)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (isValidReader(reader))
+    {
+        m_readers[reader].m_active = false;
+        m_consumed.wakeAll();
+    }
+}
+
+int SampleSinkRing::getNbReaders()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    int nbReaders = 0;
+
+    for (std::vector<Reader>::const_iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if (it->m_active) {
+            nbReaders++;
+        }
+    }
+
+    return nbReaders;
+}
+
+uint SampleSinkRing::write(SampleVector::const_iterator begin, SampleVector::const_iterator end)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (m_size == 0) { // not allocated
+        return 0;
+    }
+
+    uint count = end - begin;
+    uint total = MIN(count, m_size);
+    uint64_t minReadPos = m_writePos;
+    bool hasReaders = false;
+
+    // move forward the idle readers that would be overrun and find the slowest reader
+    for (std::vector<Reader>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if (!it->m_active) {
+            continue;
+        }
+
+        hasReaders = true;
+
+        if ((it->m_pending == 0) && (m_writePos + total - it->m_readPos > m_size))
+        {
+            uint64_t skipped = m_writePos + total - m_size - it->m_readPos;
+            it->m_readPos += skipped;
+            it->m_dropped += skipped;
+            it->m_overflowCount++;
+
+            if (m_suppressed < 0)
+            {
+                m_suppressed = 0;
+                m_msgRateTimer.start();
+                qCritical("SampleSinkRing: reader %d overflow - skipping %llu samples", (int) (it - m_readers.begin()), (unsigned long long) skipped);
+            }
+            else
+            {
+                if (m_msgRateTimer.elapsed() > 2500)
+                {
+                    qCritical("SampleSinkRing: %u messages dropped", m_suppressed);
+                    qCritical("SampleSinkRing: reader %d overflow - skipping %llu samples", (int) (it - m_readers.begin()), (unsigned long long) skipped);
+                    m_suppressed = -1;
+                }
+                else
+                {
+                    m_suppressed++;
+                }
+            }
+        }
+
+        if (it->m_readPos < minReadPos) {
+            minReadPos = it->m_readPos;
+        }
+    }
+
+    if (!hasReaders) { // nobody listening: nothing to store
+        return count;
+    }
+
+    // a reader still holding a block limits the space available
+    total = MIN(total, m_size - (uint) (m_writePos - minReadPos));
+
+    if (total < count)
+    {
+        for (std::vector<Reader>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+        {
+            if (it->m_active)
+            {
+                it->m_dropped += count - total;
+                it->m_overflowCount++;
+            }
+        }
+
+        if (m_suppressed < 0)
+        {
+            m_suppressed = 0;
+            m_msgRateTimer.start();
+            qCritical("SampleSinkRing: overflow - dropping %u samples", count - total);
+        }
+        else
+        {
+            if (m_msgRateTimer.elapsed() > 2500)
+            {
+                qCritical("SampleSinkRing: %u messages dropped", m_suppressed);
+                qCritical("SampleSinkRing: overflow - dropping %u samples", count - total);
+                m_suppressed = -1;
+            }
+            else
+            {
+                m_suppressed++;
+            }
+        }
+    }
+
+    uint remaining = total;
+    uint tail = m_writePos % m_size;
+    uint len;
+
+    while (remaining > 0)
+    {
+        len = MIN(remaining, m_size - tail);
+        std::copy(begin, begin + len, m_data.begin() + tail);
+        tail += len;
+        tail %= m_size;
+        m_writePos += len;
+        begin += len;
+        remaining -= len;
+    }
+
+    for (std::vector<Reader>::iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if (it->m_active && (m_writePos - it->m_readPos > it->m_highWater)) {
+            it->m_highWater = (uint) (m_writePos - it->m_readPos);
+        }
+    }
+
+    if (total > 0) {
+        emit dataReady();
+    }
+
+    return total;
+}
+
+uint SampleSinkRing::fill(int reader)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!isValidReader(reader)) {
+        return 0;
+    }
+
+    return (uint) (m_writePos - m_readers[reader].m_readPos);
+}
+
+uint SampleSinkRing::readBegin(int reader, uint count,
+    SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+    SampleVector::iterator* part2Begin, SampleVector::iterator* part2End)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    uint total;
+    uint remaining;
+    uint len;
+
+    *part1Begin = m_data.end();
+    *part1End = m_data.end();
+    *part2Begin = m_data.end();
+    *part2End = m_data.end();
+
+    if (!isValidReader(reader) || (m_size == 0)) {
+        return 0;
+    }
+
+    uint head = m_readers[reader].m_readPos % m_size;
+    uint fill = (uint) (m_writePos - m_readers[reader].m_readPos);
+
+    total = MIN(count, fill);
+    if (total < count)
+    {
+        m_readers[reader].m_underflowCount++;
+        qCritical("SampleSinkRing: reader %d underflow - missing %u samples", reader, count - total);
+    }
+
+    remaining = total;
+
+    if (remaining > 0)
+    {
+        len = MIN(remaining, m_size - head);
+        *part1Begin = m_data.begin() + head;
+        *part1End = m_data.begin() + head + len;
+        head += len;
+        head %= m_size;
+        remaining -= len;
+    }
+
+    if (remaining > 0)
+    {
+        len = MIN(remaining, m_size - head);
+        *part2Begin = m_data.begin() + head;
+        *part2End = m_data.begin() + head + len;
+    }
+
+    m_readers[reader].m_pending = total;
+
+    return total;
+}
+
+uint SampleSinkRing::readCommit(int reader, uint count)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!isValidReader(reader)) {
+        return 0;
+    }
+
+    Reader& r = m_readers[reader];
+    uint fill = (uint) (m_writePos - r.m_readPos);
+
+    if (count > fill)
+    {
+        qCritical("SampleSinkRing: reader %d cannot commit more than available samples", reader);
+        count = fill;
+    }
+
+    r.m_readPos += count;
+    r.m_pending = count < r.m_pending ? r.m_pending - count : 0; // the rest of the block is still being processed
+
+    if (r.m_readPos == m_writePos) {
+        m_consumed.wakeAll();
+    }
+
+    return count;
+}
+
+bool SampleSinkRing::isConsumed() const
+{
+    for (std::vector<Reader>::const_iterator it = m_readers.begin(); it != m_readers.end(); ++it)
+    {
+        if (it->m_active && ((it->m_readPos != m_writePos) || (it->m_pending != 0))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool SampleSinkRing::waitConsumed(unsigned long msecs)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (isConsumed()) {
+        return true;
+    }
+
+    if (!m_consumed.wait(&m_mutex, msecs) && !isConsumed()) {
+        emit dataReady(); // a reader may have stopped reading to process its messages: kick it again
+    }
+
+    return isConsumed();
+}
+
+bool SampleSinkRing::getReaderStats(int reader, SampleFifoStats& stats)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (!isValidReader(reader)) {
+        return false;
+    }
+
+    const Reader& r = m_readers[reader];
+    stats.m_size = m_size;
+    stats.m_fill = (uint) (m_writePos - r.m_readPos);
+    stats.m_highWater = r.m_highWater;
+    stats.m_overflowCount = r.m_overflowCount;
+    stats.m_droppedSamples = r.m_dropped;
+    stats.m_underflowCount = r.m_underflowCount;
+
+    return true;
+}
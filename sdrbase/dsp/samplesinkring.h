@@ -0,0 +1,106 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SAMPLESINKRING_H_
+#define SDRBASE_DSP_SAMPLESINKRING_H_
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QTime>
+#include <vector>
+#include <stdint.h>
+
+#include "dsp/dsptypes.h"
+#include "dsp/dspstats.h"
+#include "export.h"
+
+/**
+ * Single producer / multiple consumer baseband sample ring.
+ *
+ * The device engine writes the baseband stream once and every reader (channel thread)
+ * walks the same storage with its own read cursor. Cursors are monotonic sample counts
+ * so the space available for writing is given by the slowest reader. A reader that lags
+ * more than the ring size while not holding a read block is skipped forward so that it
+ * does not hold back the others.
+ */
+class SDRBASE_API SampleSinkRing : public QObject {
+    Q_OBJECT
+
+public:
+    SampleSinkRing(QObject* parent = NULL);
+    SampleSinkRing(int size, QObject* parent = NULL);
+    ~SampleSinkRing();
+
+    bool setSize(int size);
+    inline uint size() const { return m_size; }
+
+    int addReader();                //!< Register a new reader positioned at the current write point. Returns its index.
+    void removeReader(int reader);  //!< Unregister a reader
+    int getNbReaders();             //!< Number of active readers
+
+    uint write(SampleVector::const_iterator begin, SampleVector::const_iterator end);
+
+    uint fill(int reader);          //!< Samples available to this reader
+    uint readBegin(int reader, uint count,
+        SampleVector::iterator* part1Begin, SampleVector::iterator* part1End,
+        SampleVector::iterator* part2Begin, SampleVector::iterator* part2End);
+    uint readCommit(int reader, uint count);
+    bool waitConsumed(unsigned long msecs); //!< Wait until all readers have consumed all samples written. Returns false on timeout.
+    bool getReaderStats(int reader, SampleFifoStats& stats); //!< The ring as seen by this reader. Returns false if the reader is not active.
+
+signals:
+    void dataReady();
+
+private:
+    struct Reader
+    {
+        bool m_active;
+        uint m_pending;     //!< samples handed out by readBegin and not committed yet: they must not be overwritten
+        uint64_t m_readPos; //!< monotonic read cursor
+        uint64_t m_dropped; //!< samples skipped because this reader lagged behind or not written because of a full ring
+        uint32_t m_overflowCount;
+        uint32_t m_underflowCount;
+        uint m_highWater;   //!< highest lag behind the write cursor
+
+        Reader() :
+            m_active(false),
+            m_pending(0),
+            m_readPos(0),
+            m_dropped(0),
+            m_overflowCount(0),
+            m_underflowCount(0),
+            m_highWater(0)
+        {}
+    };
+
+    QMutex m_mutex;
+    QWaitCondition m_consumed;
+    QTime m_msgRateTimer;
+    int m_suppressed;
+
+    SampleVector m_data;
+    uint m_size;
+    uint64_t m_writePos; //!< monotonic write cursor
+    std::vector<Reader> m_readers;
+
+    void create(uint s);
+    bool isValidReader(int reader) const;
+    bool isConsumed() const;
+};
+
+#endif /* SDRBASE_DSP_SAMPLESINKRING_H_ */
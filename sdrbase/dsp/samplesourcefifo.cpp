@@ -80,6 +80,32 @@ void SampleSourceFifo::getWriteIterator(SampleVector::iterator& writeAt)
     writeAt = m_data.begin() + m_iw;
 }
 
+void SampleSourceFifo::getWriteIterators(unsigned int nbSamples,
+        SampleVector::iterator& part1Begin, SampleVector::iterator& part1End,
+        SampleVector::iterator& part2Begin, SampleVector::iterator& part2End)
+{
+    assert(nbSamples <= m_size);
+    unsigned int part1Length = std::min(nbSamples, m_size - m_iw);
+
+    part1Begin = m_data.begin() + m_iw;
+    part1End = part1Begin + part1Length;
+    part2Begin = m_data.begin();
+    part2End = part2Begin + (nbSamples - part1Length);
+}
+
+void SampleSourceFifo::writeAdvance(unsigned int nbSamples)
+{
+    unsigned int part1Length = std::min(nbSamples, m_size - m_iw);
+
+    std::copy(m_data.begin() + m_iw, m_data.begin() + m_iw + part1Length, m_data.begin() + m_size + m_iw);
+    std::copy(m_data.begin(), m_data.begin() + (nbSamples - part1Length), m_data.begin() + m_size);
+
+    {
+//        QMutexLocker mutexLocker(&m_mutex);
+        m_iw = (m_iw + nbSamples) % m_size;
+    }
+}
+
 void SampleSourceFifo::bumpIndex(SampleVector::iterator& writeAt)
 {
     m_data[m_iw+m_size] = m_data[m_iw];
@@ -40,6 +40,11 @@ public:
     void getReadIterator(SampleVector::iterator& readUntil); //!< get iterator past the last sample of a read advance operation (i.e. current read iterator)
     void getWriteIterator(SampleVector::iterator& writeAt);  //!< get iterator to current item for update - write phase 1
     void bumpIndex(SampleVector::iterator& writeAt);         //!< copy current item to second buffer and bump write index - write phase 2
+    /** get the write iterators for a block of nbSamples: part1 up to the end of the buffer and part2 wrapped around at start - block write phase 1 */
+    void getWriteIterators(unsigned int nbSamples,
+            SampleVector::iterator& part1Begin, SampleVector::iterator& part1End,
+            SampleVector::iterator& part2Begin, SampleVector::iterator& part2End);
+    void writeAdvance(unsigned int nbSamples);               //!< copy the block to second buffer and advance write index - block write phase 2
 
     void write(const Sample& sample);                        //!< write directly - phase 1 + phase 2
 
@@ -0,0 +1,349 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDateTime>
+#include <algorithm>
+
+#include "dsp/dspcommands.h"
+#include "util/messagequeue.h"
+#include "util/simpleserializer.h"
+#include "spectrumengine.h"
+
+#define MAX_FFT_SIZE 4096
+
+#ifndef LINUX
+inline double log2f(double n)
+{
+    return log(n) / log(2.0);
+}
+#endif
+
+MESSAGE_CLASS_DEFINITION(SpectrumEngine::MsgConfigureSpectrumEngine, Message)
+
+const Real SpectrumEngine::m_mult = (10.0f / log2f(10.0f));
+
+SpectrumEngine::SpectrumEngine(Real scalef) :
+    BasebandSampleSink(),
+    m_fft(FFTEngine::create()),
+    m_fftBuffer(MAX_FFT_SIZE),
+    m_powerSpectrum(MAX_FFT_SIZE),
+    m_maxHold(MAX_FFT_SIZE),
+    m_minHold(MAX_FFT_SIZE),
+    m_fftBufferFill(0),
+    m_scalef(scalef),
+    m_averageNb(0),
+    m_avgMode(AvgModeNone),
+    m_linear(false),
+    m_resetHold(1),
+    m_centerFrequency(0),
+    m_sampleRate(0),
+    m_ofs(0),
+    m_powFFTDiv(1.0),
+    m_sequence(0)
+{
+    setObjectName("SpectrumEngine");
+    handleConfigure(1024, 0, 0, AvgModeNone, FFTWindow::BlackmanHarris, false);
+}
+
+SpectrumEngine::~SpectrumEngine()
+{
+    delete m_fft;
+}
+
+void SpectrumEngine::configure(MessageQueue* msgQueue,
+        int fftSize,
+        int overlapPercent,
+        unsigned int averagingNb,
+        int averagingMode,
+        FFTWindow::Function window,
+        bool linear)
+{
+    MsgConfigureSpectrumEngine* cmd = new MsgConfigureSpectrumEngine(fftSize, overlapPercent, averagingNb, averagingMode, window, linear);
+    msgQueue->push(cmd);
+}
+
+bool SpectrumEngine::deserialize(const QByteArray& data)
+{
+    SimpleDeserializer d(data);
+
+    if (!d.isValid()) {
+        return false;
+    }
+
+    if (d.getVersion() == 1)
+    {
+        qint32 fftSize, fftOverlap, fftWindow, avgMode, avgNb;
+        bool linear;
+
+        d.readS32(1, &fftSize, 1024);
+        d.readS32(2, &fftOverlap, 0);
+        d.readS32(3, &fftWindow, FFTWindow::Hamming);
+        d.readS32(19, &avgMode, 0);
+        d.readS32(20, &avgNb, 0);
+        d.readBool(21, &linear, false);
+
+        handleConfigure(fftSize,
+                fftOverlap,
+                avgNb < 0 ? 0 : avgNb,
+                avgMode < 0 ? AvgModeNone : avgMode > 3 ? AvgModeMax : (AvgMode) avgMode,
+                (FFTWindow::Function) fftWindow,
+                linear);
+
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+bool SpectrumEngine::getFrame(Frame& frame, quint64 lastSequence)
+{
+    QMutexLocker mutexLocker(&m_frameMutex);
+
+    if ((m_frame.m_sequence == 0) || (m_frame.m_sequence == lastSequence)) {
+        return false;
+    }
+
+    frame = m_frame;
+    return true;
+}
+
+void SpectrumEngine::feed(const SampleVector::const_iterator& cbegin, const SampleVector::const_iterator& end, bool positiveOnly)
+{
+    SampleVector::const_iterator begin(cbegin);
+
+    while (begin < end)
+    {
+        std::size_t todo = end - begin;
+        std::size_t samplesNeeded = m_fftSize - m_fftBufferFill;
+
+        if (todo >= samplesNeeded)
+        {
+            QMutexLocker mutexLocker(&m_mutex);
+
+            // fill up the buffer
+            std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill;
+
+            for (std::size_t i = 0; i < samplesNeeded; ++i, ++begin)
+            {
+                *it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
+            }
+
+            // apply fft window (and copy from m_fftBuffer to m_fftIn)
+            m_window.apply(&m_fftBuffer[0], m_fft->in());
+
+            // calculate FFT
+            m_fft->transform();
+
+            if (processFFT(positiveOnly)) {
+                publishFrame();
+            }
+
+            // advance buffer respecting the fft overlap factor
+            std::copy(m_fftBuffer.begin() + m_refillSize, m_fftBuffer.begin() + m_fftSize, m_fftBuffer.begin());
+
+            // start over
+            m_fftBufferFill = m_overlapSize;
+        }
+        else
+        {
+            // not enough samples for FFT - just fill in new data and return
+            for (std::vector<Complex>::iterator it = m_fftBuffer.begin() + m_fftBufferFill; begin < end; ++begin)
+            {
+                *it++ = Complex(begin->real() / m_scalef, begin->imag() / m_scalef);
+            }
+
+            m_fftBufferFill += todo;
+        }
+    }
+}
+
+bool SpectrumEngine::processFFT(bool positiveOnly)
+{
+    // extract power spectrum and reorder buckets. Averaging state is indexed by FFT bucket.
+    const Complex* fftOut = m_fft->out();
+    std::size_t halfSize = m_fftSize / 2;
+    std::size_t nbBuckets = positiveOnly ? halfSize : m_fftSize;
+    double v;
+    bool available;
+
+    for (std::size_t i = 0; i < nbBuckets; i++)
+    {
+        const Complex& c = fftOut[i];
+        v = c.real() * c.real() + c.imag() * c.imag();
+
+        switch (m_avgMode)
+        {
+        case AvgModeMovingAvg:
+            v = m_movingAverage.storeAndGetAvg(v, i);
+            available = true;
+            break;
+        case AvgModeFixedAvg:
+            available = m_fixedAverage.storeAndGetAvg(v, v, i);
+            break;
+        case AvgModeMax:
+            available = m_max.storeAndGetMax(v, v, i);
+            break;
+        case AvgModeNone:
+        default:
+            available = true;
+            break;
+        }
+
+        if (!available) {
+            continue;
+        }
+
+        v = m_linear ? v/m_powFFTDiv : m_mult * log2f(v) + m_ofs;
+
+        if (positiveOnly)
+        {
+            m_powerSpectrum[i * 2] = v;
+            m_powerSpectrum[i * 2 + 1] = v;
+        }
+        else
+        {
+            m_powerSpectrum[i < halfSize ? i + halfSize : i - halfSize] = v;
+        }
+    }
+
+    switch (m_avgMode)
+    {
+    case AvgModeMovingAvg:
+        m_movingAverage.nextAverage();
+        return true;
+    case AvgModeFixedAvg:
+        return m_fixedAverage.nextAverage();
+    case AvgModeMax:
+        return m_max.nextMax();
+    case AvgModeNone:
+    default:
+        return true;
+    }
+}
+
+void SpectrumEngine::publishFrame()
+{
+    std::vector<Real>::const_iterator powBegin = m_powerSpectrum.begin();
+    std::vector<Real>::const_iterator powEnd = m_powerSpectrum.begin() + m_fftSize;
+
+    if (m_resetHold.testAndSetAcquire(1, 0))
+    {
+        std::copy(powBegin, powEnd, m_maxHold.begin());
+        std::copy(powBegin, powEnd, m_minHold.begin());
+    }
+    else
+    {
+        for (std::size_t i = 0; i < m_fftSize; i++)
+        {
+            m_maxHold[i] = std::max(m_maxHold[i], m_powerSpectrum[i]);
+            m_minHold[i] = std::min(m_minHold[i], m_powerSpectrum[i]);
+        }
+    }
+
+    QMutexLocker mutexLocker(&m_frameMutex);
+
+    m_frame.m_power.assign(powBegin, powEnd);
+    m_frame.m_maxHold.assign(m_maxHold.begin(), m_maxHold.begin() + m_fftSize);
+    m_frame.m_minHold.assign(m_minHold.begin(), m_minHold.begin() + m_fftSize);
+    m_frame.m_fftSize = m_fftSize;
+    m_frame.m_centerFrequency = m_centerFrequency;
+    m_frame.m_sampleRate = m_sampleRate;
+    m_frame.m_sequence++;
+    m_frame.m_timestamp = QDateTime::currentMSecsSinceEpoch();
+    m_frame.m_linear = m_linear;
+    m_sequence.storeRelease(m_frame.m_sequence);
+}
+
+void SpectrumEngine::start()
+{
+}
+
+void SpectrumEngine::stop()
+{
+}
+
+bool SpectrumEngine::handleMessage(const Message& message)
+{
+    if (MsgConfigureSpectrumEngine::match(message))
+    {
+        MsgConfigureSpectrumEngine& conf = (MsgConfigureSpectrumEngine&) message;
+        handleConfigure(conf.getFFTSize(),
+                conf.getOverlapPercent(),
+                conf.getAverageNb(),
+                conf.getAvgMode(),
+                conf.getWindow(),
+                conf.getLinear());
+        return true;
+    }
+    else if (DSPSignalNotification::match(message))
+    {
+        DSPSignalNotification& notif = (DSPSignalNotification&) message;
+        QMutexLocker mutexLocker(&m_mutex);
+        m_sampleRate = notif.getSampleRate();
+        m_centerFrequency = notif.getCenterFrequency();
+        m_resetHold.storeRelease(1); // holds are meaningless across a frequency change
+        return true;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void SpectrumEngine::handleConfigure(int fftSize,
+        int overlapPercent,
+        unsigned int averageNb,
+        AvgMode averagingMode,
+        FFTWindow::Function window,
+        bool linear)
+{
+    qDebug("SpectrumEngine::handleConfigure, fftSize: %d overlapPercent: %d averageNb: %u averagingMode: %d window: %d linear: %s",
+            fftSize, overlapPercent, averageNb, (int) averagingMode, (int) window, linear ? "true" : "false");
+    QMutexLocker mutexLocker(&m_mutex);
+
+    if (fftSize > MAX_FFT_SIZE) {
+        fftSize = MAX_FFT_SIZE;
+    } else if (fftSize < 64) {
+        fftSize = 64;
+    }
+
+    if (overlapPercent > 100) {
+        m_overlapPercent = 100;
+    } else if (overlapPercent < 0) {
+        m_overlapPercent = 0;
+    } else {
+        m_overlapPercent = overlapPercent;
+    }
+
+    m_fftSize = fftSize;
+    m_fft->configure(m_fftSize, false);
+    m_window.create(window, m_fftSize);
+    m_overlapSize = (m_fftSize * m_overlapPercent) / 100;
+    m_refillSize = m_fftSize - m_overlapSize;
+    m_fftBufferFill = m_overlapSize;
+    m_movingAverage.resize(fftSize, averageNb > 1000 ? 1000 : averageNb); // Capping to avoid out of memory condition
+    m_fixedAverage.resize(fftSize, averageNb);
+    m_max.resize(fftSize, averageNb);
+    m_averageNb = averageNb;
+    m_avgMode = averagingMode;
+    m_linear = linear;
+    m_ofs = 20.0f * log10f(1.0f / m_fftSize);
+    m_powFFTDiv = m_fftSize*m_fftSize;
+    m_resetHold.storeRelease(1);
+}
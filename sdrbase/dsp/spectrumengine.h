@@ -0,0 +1,184 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMENGINE_H_
+#define SDRBASE_DSP_SPECTRUMENGINE_H_
+
+#include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <vector>
+
+#include "dsp/basebandsamplesink.h"
+#include "dsp/fftengine.h"
+#include "dsp/fftwindow.h"
+#include "util/message.h"
+#include "util/movingaverage2d.h"
+#include "util/fixedaverage2d.h"
+#include "util/max2d.h"
+#include "export.h"
+
+class MessageQueue;
+
+/**
+ * GUI independent spectrum computation. This is the same processing as SpectrumVis
+ * (windowed FFT with overlap, averaging modes, log or linear scale) plus min and max hold.
+ * Instead of pushing the result to a display the latest frame is kept and can be
+ * polled from any thread with getFrame(). This is what the server uses for the
+ * WebAPI spectrum endpoint and the spectrum stream (see SpectrumStreamer).
+ */
+class SDRBASE_API SpectrumEngine : public BasebandSampleSink {
+public:
+    enum AvgMode
+    {
+        AvgModeNone,
+        AvgModeMovingAvg,
+        AvgModeFixedAvg,
+        AvgModeMax
+    };
+
+    class MsgConfigureSpectrumEngine : public Message {
+        MESSAGE_CLASS_DECLARATION
+
+    public:
+        MsgConfigureSpectrumEngine(
+                int fftSize,
+                int overlapPercent,
+                unsigned int averageNb,
+                int avgMode,
+                FFTWindow::Function window,
+                bool linear) :
+            Message(),
+            m_fftSize(fftSize),
+            m_overlapPercent(overlapPercent),
+            m_averageNb(averageNb),
+            m_window(window),
+            m_linear(linear)
+        {
+            m_avgMode = avgMode < 0 ? AvgModeNone : avgMode > 3 ? AvgModeMax : (SpectrumEngine::AvgMode) avgMode;
+        }
+
+        int getFFTSize() const { return m_fftSize; }
+        int getOverlapPercent() const { return m_overlapPercent; }
+        unsigned int getAverageNb() const { return m_averageNb; }
+        SpectrumEngine::AvgMode getAvgMode() const { return m_avgMode; }
+        FFTWindow::Function getWindow() const { return m_window; }
+        bool getLinear() const { return m_linear; }
+
+    private:
+        int m_fftSize;
+        int m_overlapPercent;
+        unsigned int m_averageNb;
+        SpectrumEngine::AvgMode m_avgMode;
+        FFTWindow::Function m_window;
+        bool m_linear;
+    };
+
+    /** Snapshot of the last computed spectrum. Bins go from lowest to highest frequency. */
+    struct Frame
+    {
+        std::vector<Real> m_power;
+        std::vector<Real> m_maxHold;
+        std::vector<Real> m_minHold;
+        int m_fftSize;
+        qint64 m_centerFrequency;
+        int m_sampleRate;
+        quint64 m_sequence;  //!< incremented at each new frame. 0 means no frame yet
+        qint64 m_timestamp;  //!< ms since epoch
+        bool m_linear;
+
+        Frame() :
+            m_fftSize(0),
+            m_centerFrequency(0),
+            m_sampleRate(0),
+            m_sequence(0),
+            m_timestamp(0),
+            m_linear(false)
+        {}
+    };
+
+    SpectrumEngine(Real scalef);
+    virtual ~SpectrumEngine();
+
+    void configure(MessageQueue* msgQueue,
+            int fftSize,
+            int overlapPercent,
+            unsigned int averagingNb,
+            int averagingMode,
+            FFTWindow::Function window,
+            bool linear);
+    /** Apply the spectrum part of a preset. This is the blob saved by GLSpectrumGUI so that GUI and server presets are interchangeable */
+    bool deserialize(const QByteArray& data);
+    void resetHold() { m_resetHold.storeRelease(1); } //!< min and max hold restart from the next frame
+
+    /** Copy the latest frame if it is newer than lastSequence. Returns false if there is nothing new. */
+    bool getFrame(Frame& frame, quint64 lastSequence = 0);
+    quint64 getSequence() const { return m_sequence.loadAcquire(); }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly);
+    virtual void start();
+    virtual void stop();
+    virtual bool handleMessage(const Message& message);
+
+private:
+    FFTEngine* m_fft;
+    FFTWindow m_window;
+
+    std::vector<Complex> m_fftBuffer;
+    std::vector<Real> m_powerSpectrum;
+    std::vector<Real> m_maxHold;
+    std::vector<Real> m_minHold;
+
+    std::size_t m_fftSize;
+    std::size_t m_overlapPercent;
+    std::size_t m_overlapSize;
+    std::size_t m_refillSize;
+    std::size_t m_fftBufferFill;
+
+    Real m_scalef;
+    MovingAverage2D<double> m_movingAverage;
+    FixedAverage2D<double> m_fixedAverage;
+    Max2D<double> m_max;
+    unsigned int m_averageNb;
+    AvgMode m_avgMode;
+    bool m_linear;
+    QAtomicInt m_resetHold;
+
+    qint64 m_centerFrequency;
+    int m_sampleRate;
+
+    Real m_ofs;
+    Real m_powFFTDiv;
+    static const Real m_mult;
+
+    QMutex m_mutex;      //!< processing state
+    QMutex m_frameMutex; //!< published frame
+    Frame m_frame;
+    QAtomicInteger<quint64> m_sequence;
+
+    bool processFFT(bool positiveOnly);
+    void publishFrame();
+    void handleConfigure(int fftSize,
+            int overlapPercent,
+            unsigned int averageNb,
+            AvgMode averagingMode,
+            FFTWindow::Function window,
+            bool linear);
+};
+
+#endif /* SDRBASE_DSP_SPECTRUMENGINE_H_ */
@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QDataStream>
+#include <QDebug>
+
+#include "spectrumstreamer.h"
+
+SpectrumStreamer::SpectrumStreamer(SpectrumEngine *spectrumEngine, QObject *parent) :
+    QObject(parent),
+    m_spectrumEngine(spectrumEngine),
+    m_server(0),
+    m_lastSequence(0),
+    m_sendHolds(true)
+{
+    connect(&m_timer, SIGNAL(timeout()), this, SLOT(tick()));
+}
+
+SpectrumStreamer::~SpectrumStreamer()
+{
+    stop();
+}
+
+bool SpectrumStreamer::start(const QString& serverName, int frameRate)
+{
+    stop();
+
+    QLocalServer::removeServer(serverName); // clean up a socket left over by a crashed instance
+    m_server = new QLocalServer(this);
+
+    if (!m_server->listen(serverName))
+    {
+        qWarning("SpectrumStreamer::start: cannot listen on %s: %s",
+                qPrintable(serverName), qPrintable(m_server->errorString()));
+        delete m_server;
+        m_server = 0;
+        return false;
+    }
+
+    connect(m_server, SIGNAL(newConnection()), this, SLOT(handleNewConnection()));
+    setFrameRate(frameRate);
+    qDebug("SpectrumStreamer::start: listening on %s at %d frames/s", qPrintable(m_server->fullServerName()), frameRate);
+
+    return true;
+}
+
+void SpectrumStreamer::stop()
+{
+    m_timer.stop();
+
+    for (QList<QLocalSocket*>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        disconnect(*it, SIGNAL(disconnected()), this, SLOT(handleDisconnected()));
+        (*it)->abort();
+        (*it)->deleteLater();
+    }
+
+    m_clients.clear();
+
+    if (m_server)
+    {
+        m_server->close();
+        delete m_server;
+        m_server = 0;
+    }
+}
+
+void SpectrumStreamer::setFrameRate(int frameRate)
+{
+    if (frameRate < 1) {
+        frameRate = 1;
+    } else if (frameRate > 100) {
+        frameRate = 100;
+    }
+
+    m_timer.start(1000 / frameRate);
+}
+
+void SpectrumStreamer::handleNewConnection()
+{
+    QLocalSocket *socket;
+
+    while ((socket = m_server->nextPendingConnection()) != 0)
+    {
+        connect(socket, SIGNAL(disconnected()), this, SLOT(handleDisconnected()));
+        m_clients.append(socket);
+        qDebug("SpectrumStreamer::handleNewConnection: %d clients", m_clients.size());
+    }
+}
+
+void SpectrumStreamer::handleDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket*>(sender());
+
+    if (socket)
+    {
+        m_clients.removeAll(socket);
+        socket->deleteLater();
+        qDebug("SpectrumStreamer::handleDisconnected: %d clients", m_clients.size());
+    }
+}
+
+void SpectrumStreamer::tick()
+{
+    if (m_clients.size() == 0) {
+        return;
+    }
+
+    if (!m_spectrumEngine->getFrame(m_frame, m_lastSequence)) {
+        return; // no new frame since last tick
+    }
+
+    m_lastSequence = m_frame.m_sequence;
+    QByteArray bytes = serializeFrame(m_frame, m_sendHolds);
+
+    for (QList<QLocalSocket*>::iterator it = m_clients.begin(); it != m_clients.end(); ++it)
+    {
+        if ((*it)->bytesToWrite() < m_maxPendingBytes) { // slow clients skip frames rather than buffering them
+            (*it)->write(bytes);
+        }
+    }
+}
+
+QByteArray SpectrumStreamer::serializeFrame(const SpectrumEngine::Frame& frame, bool holds)
+{
+    QByteArray bytes;
+    bytes.reserve(40 + frame.m_fftSize * (holds ? 3 : 1) * sizeof(float));
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    stream << m_magic
+        << m_version
+        << (quint8) ((frame.m_linear ? 1 : 0) | (holds ? 2 : 0))
+        << (quint16) 0
+        << (quint32) frame.m_fftSize
+        << (quint32) frame.m_sampleRate
+        << frame.m_centerFrequency
+        << frame.m_sequence
+        << frame.m_timestamp;
+
+    for (std::vector<Real>::const_iterator it = frame.m_power.begin(); it != frame.m_power.end(); ++it) {
+        stream << *it;
+    }
+
+    if (holds)
+    {
+        for (std::vector<Real>::const_iterator it = frame.m_maxHold.begin(); it != frame.m_maxHold.end(); ++it) {
+            stream << *it;
+        }
+        for (std::vector<Real>::const_iterator it = frame.m_minHold.begin(); it != frame.m_minHold.end(); ++it) {
+            stream << *it;
+        }
+    }
+
+    return bytes;
+}
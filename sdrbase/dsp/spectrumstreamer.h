@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_DSP_SPECTRUMSTREAMER_H_
+#define SDRBASE_DSP_SPECTRUMSTREAMER_H_
+
+#include <QObject>
+#include <QTimer>
+#include <QList>
+#include <QByteArray>
+
+#include "dsp/spectrumengine.h"
+#include "export.h"
+
+class QLocalServer;
+class QLocalSocket;
+
+/**
+ * Pushes the frames of a SpectrumEngine to the clients of a local socket (named pipe on Windows)
+ * at a fixed rate. A frame is only sent if a new one was computed since the last tick. Clients
+ * that do not keep up do not receive new frames until their pending data has been written.
+ *
+ * Frame layout (little endian):
+ *   0  magic "SDRS"
+ *   4  quint8  version (1)
+ *   5  quint8  flags: bit 0 linear scale, bit 1 holds present
+ *   6  quint16 reserved
+ *   8  quint32 FFT size N
+ *  12  quint32 sample rate (S/s)
+ *  16  qint64  center frequency (Hz)
+ *  24  quint64 sequence number
+ *  32  qint64  timestamp (ms since epoch)
+ *  40  float32[N] power then float32[N] max hold and float32[N] min hold if flagged
+ */
+class SDRBASE_API SpectrumStreamer : public QObject {
+    Q_OBJECT
+
+public:
+    SpectrumStreamer(SpectrumEngine *spectrumEngine, QObject *parent = 0);
+    ~SpectrumStreamer();
+
+    bool start(const QString& serverName, int frameRate); //!< frame rate in frames per second
+    void stop();
+    void setFrameRate(int frameRate);
+    void setSendHolds(bool sendHolds) { m_sendHolds = sendHolds; }
+    bool isRunning() const { return m_server != 0; }
+    int getNbClients() const { return m_clients.size(); }
+
+    static QByteArray serializeFrame(const SpectrumEngine::Frame& frame, bool holds);
+
+    static const quint32 m_magic = 0x53524453; //!< "SDRS" once written little endian
+    static const quint8 m_version = 1;
+
+private:
+    SpectrumEngine *m_spectrumEngine;
+    QLocalServer *m_server;
+    QList<QLocalSocket*> m_clients;
+    QTimer m_timer;
+    SpectrumEngine::Frame m_frame;
+    quint64 m_lastSequence;
+    bool m_sendHolds;
+
+    static const qint64 m_maxPendingBytes = 1<<20;
+
+private slots:
+    void handleNewConnection();
+    void handleDisconnected();
+    void tick();
+};
+
+#endif /* SDRBASE_DSP_SPECTRUMSTREAMER_H_ */
@@ -1,31 +1,77 @@
 #include "threadedbasebandsamplesink.h"
 
 #include <QThread>
+#include <QElapsedTimer>
 #include <QDebug>
 #include "dsp/dspcommands.h"
+#include "dsp/dspengine.h"
+#include "dsp/dspscheduler.h"
+#include "util/threadroles.h"
 #include "util/message.h"
 
 ThreadedBasebandSampleSinkFifo::ThreadedBasebandSampleSinkFifo(BasebandSampleSink *sampleSink, std::size_t size) :
-	m_sampleSink(sampleSink)
+	m_sampleSink(sampleSink),
+	m_sampleFifoSize(size),
+	m_sampleRing(0),
+	m_ringReader(-1),
+	m_running(0),
+	m_sharedThread(false)
 {
 	connect(&m_sampleFifo, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
-	m_sampleFifo.setSize(size);
 }
 
 ThreadedBasebandSampleSinkFifo::~ThreadedBasebandSampleSinkFifo()
 {
+	detachRing();
 	m_sampleFifo.readCommit(m_sampleFifo.fill());
 }
 
 void ThreadedBasebandSampleSinkFifo::writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end)
 {
+	if (m_sampleFifo.size() == 0) { // allocate only when the private FIFO is actually used
+		m_sampleFifo.setSize(m_sampleFifoSize);
+	}
+
 	m_sampleFifo.write(begin, end);
 }
 
+void ThreadedBasebandSampleSinkFifo::attachRing(SampleSinkRing *sampleRing)
+{
+	detachRing();
+
+	if (sampleRing)
+	{
+		m_sampleRing = sampleRing;
+		m_ringReader = m_sampleRing->addReader();
+		connect(m_sampleRing, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::detachRing()
+{
+	if (m_sampleRing)
+	{
+		disconnect(m_sampleRing, SIGNAL(dataReady()), this, SLOT(handleFifoData()));
+		m_sampleRing->removeReader(m_ringReader);
+		m_sampleRing = 0;
+		m_ringReader = -1;
+	}
+}
+
 void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it to the new threadable sink class
 {
 	bool positiveOnly = false;
 
+	if (!m_running.loadAcquire()) {
+		return;
+	}
+
+	if (m_sampleRing)
+	{
+		handleRingData();
+		return;
+	}
+
 	while ((m_sampleFifo.fill() > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
 	{
 		SampleVector::iterator part1begin;
@@ -42,7 +88,7 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 			// handle data
 			if(m_sampleSink != NULL)
 			{
-				m_sampleSink->feed(part1begin, part1end, positiveOnly);
+				feedSink(part1begin, part1end, positiveOnly);
 			}
 
 			m_sampleFifo.readCommit(part1end - part1begin);
@@ -55,7 +101,7 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 			// handle data
 			if(m_sampleSink != NULL)
 			{
-				m_sampleSink->feed(part2begin, part2end, positiveOnly);
+				feedSink(part2begin, part2end, positiveOnly);
 			}
 
 			m_sampleFifo.readCommit(part2end - part2begin);
@@ -63,6 +109,76 @@ void ThreadedBasebandSampleSinkFifo::handleFifoData() // FIXME: Fixed? Move it t
 	}
 }
 
+void ThreadedBasebandSampleSinkFifo::handleRingData()
+{
+	bool positiveOnly = false;
+
+	while ((m_sampleRing->fill(m_ringReader) > 0) && (m_sampleSink->getInputMessageQueue()->size() == 0))
+	{
+		SampleVector::iterator part1begin;
+		SampleVector::iterator part1end;
+		SampleVector::iterator part2begin;
+		SampleVector::iterator part2end;
+
+		std::size_t count = m_sampleRing->readBegin(m_ringReader, m_sampleRing->fill(m_ringReader), &part1begin, &part1end, &part2begin, &part2end);
+
+		// samples are processed in place in the shared ring: the block stays protected until committed
+
+		if (count > 0)
+		{
+			if (m_sampleSink != NULL)
+			{
+				feedSink(part1begin, part1end, positiveOnly);
+			}
+
+			m_sampleRing->readCommit(m_ringReader, part1end - part1begin);
+		}
+
+		// second part of ring data (used when block wraps around)
+
+		if (part2begin != part2end)
+		{
+			if (m_sampleSink != NULL)
+			{
+				feedSink(part2begin, part2end, positiveOnly);
+			}
+
+			m_sampleRing->readCommit(m_ringReader, part2end - part2begin);
+		}
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::feedSink(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly)
+{
+	QElapsedTimer timer;
+	timer.start();
+	m_sampleSink->feed(begin, end, positiveOnly);
+	qint64 elapsedNs = timer.nsecsElapsed();
+	qint64 threadCpuTimeNs = m_sharedThread ? -1 : SampleSinkFeedStats::getThreadCpuTimeNs();
+
+	QMutexLocker mutexLocker(&m_feedStatsMutex);
+	m_feedStats.add(end - begin, elapsedNs);
+
+	if (!m_sharedThread) {
+		m_feedStats.m_threadCpuTimeNs = threadCpuTimeNs;
+	}
+}
+
+void ThreadedBasebandSampleSinkFifo::getFeedStats(SampleSinkFeedStats& stats)
+{
+	QMutexLocker mutexLocker(&m_feedStatsMutex);
+	stats = m_feedStats;
+}
+
+void ThreadedBasebandSampleSinkFifo::getFifoStats(SampleFifoStats& stats)
+{
+	if (m_sampleRing) {
+		m_sampleRing->getReaderStats(m_ringReader, stats);
+	} else {
+		m_sampleFifo.getStats(stats);
+	}
+}
+
 ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampleSink, QObject *parent) :
 	m_basebandSampleSink(sampleSink)
 {
@@ -71,8 +187,15 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 	qDebug() << "ThreadedBasebandSampleSink::ThreadedBasebandSampleSink: " << name;
 
-	m_thread = new QThread(parent);
+	m_thread = DSPEngine::instance()->getScheduler()->acquireThread();
+	m_pooled = m_thread != 0;
+
+	if (!m_pooled) {
+		m_thread = new RoleThread(ThreadRoles::RoleChannelDSP, parent);
+	}
+
 	m_threadedBasebandSampleSinkFifo = new ThreadedBasebandSampleSinkFifo(m_basebandSampleSink);
+	m_threadedBasebandSampleSinkFifo->m_sharedThread = m_pooled;
 	//moveToThread(m_thread); // FIXME: Fixed? the intermediate FIFO should be handled within the sink. Define a new type of sink that is compatible with threading
 	m_basebandSampleSink->moveToThread(m_thread);
 	m_threadedBasebandSampleSinkFifo->moveToThread(m_thread);
@@ -88,6 +211,22 @@ ThreadedBasebandSampleSink::ThreadedBasebandSampleSink(BasebandSampleSink* sampl
 
 ThreadedBasebandSampleSink::~ThreadedBasebandSampleSink()
 {
+	if (m_pooled)
+	{
+		DSPScheduler *scheduler = DSPEngine::instance()->getScheduler();
+
+		if (m_threadedBasebandSampleSinkFifo->m_running.loadAcquire()) {
+			stop();
+		}
+
+		// the scheduler thread keeps running: bring the objects back before they are deleted
+		scheduler->recall(m_threadedBasebandSampleSinkFifo, m_thread, thread());
+		scheduler->recall(m_basebandSampleSink, m_thread, thread());
+		scheduler->releaseThread(m_thread);
+		delete m_threadedBasebandSampleSinkFifo;
+		return;
+	}
+
     if (m_thread->isRunning()) {
         stop();
     }
@@ -99,7 +238,12 @@ ThreadedBasebandSampleSink::~ThreadedBasebandSampleSink()
 void ThreadedBasebandSampleSink::start()
 {
 	qDebug() << "ThreadedBasebandSampleSink::start";
-	m_thread->start();
+	m_threadedBasebandSampleSinkFifo->m_running.storeRelease(1);
+
+	if (!m_pooled) {
+		m_thread->start();
+	}
+
 	m_basebandSampleSink->start();
 }
 
@@ -107,8 +251,17 @@ void ThreadedBasebandSampleSink::stop()
 {
 	qDebug() << "ThreadedBasebandSampleSink::stop";
 	m_basebandSampleSink->stop();
-	m_thread->exit();
-	m_thread->wait();
+	m_threadedBasebandSampleSinkFifo->m_running.storeRelease(0);
+
+	if (m_pooled)
+	{
+		DSPEngine::instance()->getScheduler()->sync(m_thread); // a feed in progress is finished
+	}
+	else
+	{
+		m_thread->exit();
+		m_thread->wait();
+	}
 }
 
 void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly __attribute__((unused)))
@@ -118,11 +271,33 @@ void ThreadedBasebandSampleSink::feed(SampleVector::const_iterator begin, Sample
 	m_threadedBasebandSampleSinkFifo->writeToFifo(begin, end);
 }
 
+void ThreadedBasebandSampleSink::attachRing(SampleSinkRing *sampleRing)
+{
+	qDebug() << "ThreadedBasebandSampleSink::attachRing: " << m_basebandSampleSink->objectName();
+	m_threadedBasebandSampleSinkFifo->attachRing(sampleRing);
+}
+
+void ThreadedBasebandSampleSink::detachRing()
+{
+	qDebug() << "ThreadedBasebandSampleSink::detachRing: " << m_basebandSampleSink->objectName();
+	m_threadedBasebandSampleSinkFifo->detachRing();
+}
+
 bool ThreadedBasebandSampleSink::handleSinkMessage(const Message& cmd)
 {
 	return m_basebandSampleSink->handleMessage(cmd);
 }
 
+void ThreadedBasebandSampleSink::getFeedStats(SampleSinkFeedStats& stats) const
+{
+	m_threadedBasebandSampleSinkFifo->getFeedStats(stats);
+}
+
+void ThreadedBasebandSampleSink::getFifoStats(SampleFifoStats& stats) const
+{
+	m_threadedBasebandSampleSinkFifo->getFifoStats(stats);
+}
+
 QString ThreadedBasebandSampleSink::getSampleSinkObjectName() const
 {
 	return m_basebandSampleSink->objectName();
@@ -20,8 +20,11 @@
 
 #include <dsp/basebandsamplesink.h>
 #include <QMutex>
+#include <QAtomicInt>
 
 #include "samplesinkfifo.h"
+#include "samplesinkring.h"
+#include "dspstats.h"
 #include "util/messagequeue.h"
 #include "export.h"
 
@@ -39,12 +42,28 @@ public:
 	ThreadedBasebandSampleSinkFifo(BasebandSampleSink* sampleSink, std::size_t size = 1<<18);
 	~ThreadedBasebandSampleSinkFifo();
 	void writeToFifo(SampleVector::const_iterator& begin, SampleVector::const_iterator& end);
+	void attachRing(SampleSinkRing *sampleRing); //!< Read from the shared baseband ring instead of the private FIFO
+	void detachRing();
 
 	BasebandSampleSink* m_sampleSink;
-	SampleSinkFifo m_sampleFifo;
+	SampleSinkFifo m_sampleFifo; //!< private FIFO sized on first use only when not reading from a ring
+	std::size_t m_sampleFifoSize;
+	SampleSinkRing *m_sampleRing;
+	int m_ringReader;
+	SampleSinkFeedStats m_feedStats; //!< written by the sink thread only. Read by others for statistics with m_feedStatsMutex.
+	QMutex m_feedStatsMutex;
+	QAtomicInt m_running;            //!< data is not processed when stopped as the thread may be shared and keep running
+	bool m_sharedThread;             //!< runs in a DSP scheduler thread: the thread CPU time is not the one of this sink
+
+	void getFifoStats(SampleFifoStats& stats); //!< the private FIFO or the view of this reader on the ring
+	void getFeedStats(SampleSinkFeedStats& stats);
 
 public slots:
 	void handleFifoData();
+
+private:
+	void handleRingData();
+	void feedSink(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly);
 };
 
 /**
@@ -60,17 +79,22 @@ public:
 	const BasebandSampleSink *getSink() const { return m_basebandSampleSink; }
 
 	void start(); //!< this thread start()
-	void stop();  //!< this thread exit() and wait()
+	void stop();  //!< this thread exit() and wait() or wait for the scheduler thread to be done with the sink
 
 	bool handleSinkMessage(const Message& cmd); //!< Send message to sink synchronously
-	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples
+	void feed(SampleVector::const_iterator begin, SampleVector::const_iterator end, bool positiveOnly); //!< Feed sink with samples through its private FIFO
+	void attachRing(SampleSinkRing *sampleRing); //!< Take samples from a baseband ring shared with other sinks. Must be done with this thread stopped.
+	void detachRing(); //!< Go back to the private FIFO. Must be done with this thread stopped.
 
 	QString getSampleSinkObjectName() const;
+	void getFeedStats(SampleSinkFeedStats& stats) const; //!< samples fed to the sink, time spent in it since creation and CPU time of this thread
+	void getFifoStats(SampleFifoStats& stats) const;      //!< health of the FIFO or ring this sink reads from
     const QThread *getThread() const { return m_thread; }
 
 protected:
 
 	QThread *m_thread; //!< The thead object
+	bool m_pooled;     //!< m_thread belongs to the DSP scheduler and is shared with other channels
 	ThreadedBasebandSampleSinkFifo *m_threadedBasebandSampleSinkFifo;
 	BasebandSampleSink* m_basebandSampleSink;
 };
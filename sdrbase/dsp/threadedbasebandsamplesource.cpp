@@ -19,8 +19,12 @@
 #include <QThread>
 
 #include "dsp/threadedbasebandsamplesource.h"
+#include "dsp/dspengine.h"
+#include "dsp/dspscheduler.h"
+#include "util/threadroles.h"
 
 ThreadedBasebandSampleSource::ThreadedBasebandSampleSource(BasebandSampleSource* sampleSource, QObject *parent) :
+        m_running(false),
         m_basebandSampleSource(sampleSource)
 {
     QString name = "ThreadedBasebandSampleSource(" + m_basebandSampleSource->objectName() + ")";
@@ -28,7 +32,13 @@ ThreadedBasebandSampleSource::ThreadedBasebandSampleSource(BasebandSampleSource*
 
     qDebug() << "ThreadedBasebandSampleSource::ThreadedBasebandSampleSource: " << name;
 
-    m_thread = new QThread(parent);
+    m_thread = DSPEngine::instance()->getScheduler()->acquireThread();
+    m_pooled = m_thread != 0;
+
+    if (!m_pooled) {
+        m_thread = new RoleThread(ThreadRoles::RoleChannelDSP, parent);
+    }
+
     m_basebandSampleSource->moveToThread(m_thread);
 
     qDebug() << "ThreadedBasebandSampleSource::ThreadedBasebandSampleSource: thread: " << thread() << " m_thread: " << m_thread;
@@ -36,6 +46,20 @@ ThreadedBasebandSampleSource::ThreadedBasebandSampleSource(BasebandSampleSource*
 
 ThreadedBasebandSampleSource::~ThreadedBasebandSampleSource()
 {
+    if (m_pooled)
+    {
+        DSPScheduler *scheduler = DSPEngine::instance()->getScheduler();
+
+        if (m_running) {
+            stop();
+        }
+
+        // the scheduler thread keeps running: bring the source back before it is deleted
+        scheduler->recall(m_basebandSampleSource, m_thread, thread());
+        scheduler->releaseThread(m_thread);
+        return;
+    }
+
     if (m_thread->isRunning()) {
         stop();
     }
@@ -46,16 +70,30 @@ ThreadedBasebandSampleSource::~ThreadedBasebandSampleSource()
 void ThreadedBasebandSampleSource::start()
 {
     qDebug() << "ThreadedBasebandSampleSource::start";
-    m_thread->start();
+
+    if (!m_pooled) {
+        m_thread->start();
+    }
+
     m_basebandSampleSource->start();
+    m_running = true;
 }
 
 void ThreadedBasebandSampleSource::stop()
 {
     qDebug() << "ThreadedBasebandSampleSource::stop";
     m_basebandSampleSource->stop();
-    m_thread->exit();
-    m_thread->wait();
+    m_running = false;
+
+    if (m_pooled)
+    {
+        DSPEngine::instance()->getScheduler()->sync(m_thread);
+    }
+    else
+    {
+        m_thread->exit();
+        m_thread->wait();
+    }
 }
 
 void ThreadedBasebandSampleSource::pull(Sample& sample)
@@ -63,6 +101,11 @@ void ThreadedBasebandSampleSource::pull(Sample& sample)
 	m_basebandSampleSource->pull(sample);
 }
 
+void ThreadedBasebandSampleSource::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+	m_basebandSampleSource->pullBlock(begin, count);
+}
+
 void ThreadedBasebandSampleSource::feed(SampleSourceFifo* sampleFifo,
 	int nbSamples)
 {
@@ -40,10 +40,11 @@ public:
 	const BasebandSampleSource *getSource() const { return m_basebandSampleSource; }
 
 	void start(); //!< this thread start()
-	void stop();  //!< this thread exit() and wait()
+	void stop();  //!< this thread exit() and wait() or wait for the scheduler thread to be done with the source
 
 	bool handleSourceMessage(const Message& cmd);  //!< Send message to source synchronously
 	void pull(Sample& sample);                     //!< Pull one sample from source
+	void pullBlock(SampleVector::iterator begin, unsigned int count); //!< Pull a block of samples from source
 	void pullAudio(int nbSamples) { if (m_basebandSampleSource) m_basebandSampleSource->pullAudio(nbSamples); }
 
     /** direct feeding of sample source FIFO */
@@ -52,11 +53,14 @@ public:
 
 	SampleSourceFifo& getSampleSourceFifo() { return m_basebandSampleSource->getSampleSourceFifo(); }
 	void setDeviceSampleSourceFifo(SampleSourceFifo *deviceSampleFifo) { m_basebandSampleSource->setDeviceSampleSourceFifo(deviceSampleFifo); }
+	float getMixerGain() const { return m_basebandSampleSource->getMixerGain(); }
 
 	QString getSampleSourceObjectName() const;
 
 protected:
 	QThread *m_thread; //!< The thead object
+	bool m_pooled;     //!< m_thread belongs to the DSP scheduler and is shared with other channels
+	bool m_running;
 	BasebandSampleSource* m_basebandSampleSource;
 };
 
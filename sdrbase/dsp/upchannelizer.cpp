@@ -19,11 +19,13 @@
 #include <dsp/upchannelizer.h>
 #include "dsp/inthalfbandfilter.h"
 #include "dsp/dspcommands.h"
+#include "util/messagepool.h"
 
 #include <QString>
 #include <QDebug>
 
 MESSAGE_CLASS_DEFINITION(UpChannelizer::MsgChannelizerNotification, Message)
+MESSAGE_CLASS_POOLED_DEFINITION(UpChannelizer::MsgChannelizerNotification)
 
 UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
     m_sampleSource(sampleSource),
@@ -31,7 +33,8 @@ UpChannelizer::UpChannelizer(BasebandSampleSource* sampleSource) :
     m_requestedInputSampleRate(0),
     m_requestedCenterFrequency(0),
     m_currentInputSampleRate(0),
-    m_currentCenterFrequency(0)
+    m_currentCenterFrequency(0),
+    m_inputIndex(0)
 {
     QString name = "UpChannelizer(" + m_sampleSource->objectName() + ")";
     setObjectName(name);
@@ -62,44 +65,67 @@ void UpChannelizer::pull(Sample& sample)
     else
     {
         m_mutex.lock();
+        pullStages(sample, 1);
+        m_mutex.unlock();
+    }
+}
 
-        FilterStages::iterator stage = m_filterStages.begin();
-        std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+void UpChannelizer::pullBlock(SampleVector::iterator begin, unsigned int count)
+{
+    if(m_sampleSource == 0) {
+        m_sampleBuffer.clear();
+        return;
+    }
 
-        for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    if (m_filterStages.size() == 0) // optimization when no downsampling is done anyway
+    {
+        m_sampleSource->pullBlock(begin, count);
+    }
+    else
+    {
+        m_mutex.lock(); // filter chain cannot change during the block
+
+        for (unsigned int i = 0; i < count; i++, ++begin) {
+            pullStages(*begin, count - i);
+        }
+
+        m_mutex.unlock();
+    }
+}
+
+void UpChannelizer::pullStages(Sample& sample, unsigned int remaining)
+{
+    FilterStages::iterator stage = m_filterStages.begin();
+    std::vector<Sample>::iterator stageSample = m_stageSamples.begin();
+
+    for (; stage != m_filterStages.end(); ++stage, ++stageSample)
+    {
+        if(stage == m_filterStages.end() - 1)
         {
-            if(stage == m_filterStages.end() - 1)
+            if ((*stage)->work(&m_sampleIn, &(*stageSample)))
             {
-                if ((*stage)->work(&m_sampleIn, &(*stageSample)))
+                if (m_inputIndex >= m_inputBuffer.size())
                 {
-                    m_sampleSource->pull(m_sampleIn); // get new input sample
+                    // fetch the modulator samples needed for the rest of the output block in one call
+                    unsigned int nbInput = remaining >> m_filterStages.size();
+                    m_inputBuffer.resize(nbInput < 1 ? 1 : nbInput);
+                    m_sampleSource->pullBlock(m_inputBuffer.begin(), m_inputBuffer.size());
+                    m_inputIndex = 0;
                 }
+
+                m_sampleIn = m_inputBuffer[m_inputIndex++]; // get new input sample
             }
-            else
+        }
+        else
+        {
+            if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
             {
-                if (!(*stage)->work(&(*(stageSample+1)), &(*stageSample)))
-                {
-                    break;
-                }
+                break;
             }
         }
-
-        sample = *m_stageSamples.begin();
-
-//		for (; stage != m_filterStages.end(); ++stage)
-//		{
-//			// let's make it work for one stage only (96 kS/s < SR < 192 kS/s)
-//			if(stage == m_filterStages.end() - 1)
-//			{
-//				if ((*stage)->work(&m_sampleIn, &sample))
-//				{
-//					m_sampleSource->pull(m_sampleIn); // get new input sample
-//				}
-//			}
-//		}
-
-        m_mutex.unlock();
     }
+
+    sample = *m_stageSamples.begin();
 }
 
 void UpChannelizer::start()
@@ -189,6 +215,7 @@ void UpChannelizer::applyConfiguration()
     m_currentCenterFrequency = createFilterChain(
         m_outputSampleRate / -2, m_outputSampleRate / 2,
         m_requestedCenterFrequency - m_requestedInputSampleRate / 2, m_requestedCenterFrequency + m_requestedInputSampleRate / 2);
+    m_inputIndex = m_inputBuffer.size(); // drop the modulator samples fetched for the previous configuration
 
     m_mutex.unlock();
 
@@ -38,6 +38,7 @@ class SDRBASE_API UpChannelizer : public BasebandSampleSource {
 public:
     class MsgChannelizerNotification : public Message {
         MESSAGE_CLASS_DECLARATION
+        MESSAGE_CLASS_POOLED
 
     public:
         MsgChannelizerNotification(int basebandSampleRate, int samplerate, qint64 frequencyOffset) :
@@ -71,6 +72,7 @@ public:
     virtual void start();
     virtual void stop();
     virtual void pull(Sample& sample);
+    virtual void pullBlock(SampleVector::iterator begin, unsigned int count);
     virtual void pullAudio(int nbSamples) { if (m_sampleSource) m_sampleSource->pullAudio(nbSamples); }
 
     virtual bool handleMessage(const Message& cmd);
@@ -111,8 +113,11 @@ protected:
     int m_currentCenterFrequency;
     SampleVector m_sampleBuffer;
     Sample m_sampleIn;
+    SampleVector m_inputBuffer;      //!< block of modulator samples fetched ahead for the last stage
+    unsigned int m_inputIndex;       //!< next sample to consume in m_inputBuffer
     QMutex m_mutex;
 
+    void pullStages(Sample& sample, unsigned int remaining); //!< run the filter chain for one output sample. Mutex must be held.
     void applyConfiguration();
     bool signalContainsChannel(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd) const;
     Real createFilterChain(Real sigStart, Real sigEnd, Real chanStart, Real chanEnd);
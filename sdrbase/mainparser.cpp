@@ -20,8 +20,10 @@
 #include <QDebug>
 
 #include "mainparser.h"
+#include "util/threadroles.h"
 
-MainParser::MainParser() :
+MainParser::MainParser(bool server) :
+    m_server(server),
     m_serverAddressOption(QStringList() << "a" << "api-address",
         "Web API server address.",
         "address",
@@ -29,10 +31,28 @@ MainParser::MainParser() :
     m_serverPortOption(QStringList() << "p" << "api-port",
         "Web API server port.",
         "port",
-        "8091")
+        "8091"),
+    m_spectrumRateOption(QStringList() << "s" << "spectrum-rate",
+        "Spectrum stream rate in frames per second on local socket sdrangel.<api-port>.spectrum.<device set index>. 0 to disable.",
+        "rate",
+        "0"),
+    m_threadRoleOption(QStringList() << "thread-role",
+        "Scheduling of a role of threads as role:key=value,... e.g. deviceio:cpus=2-3,policy=fifo,priority=50. "
+        "Roles: deviceio, devicedsp, channeldsp, audio, network. Keys: cpus (e.g. 0-1+4), policy (other, fifo, rr), priority (1-99), nice (-20-19). "
+        "Can be repeated. Overrides the preferences.",
+        "spec"),
+    m_dspThreadsOption(QStringList() << "dsp-threads",
+        "Channels run in a pool of this number of threads (0: one thread per channel, -1: one thread per core). Overrides the preferences.",
+        "threads"),
+    m_dspPinCoresOption(QStringList() << "dsp-pin-cores",
+        "Pin the threads of the channels pool to cores. Overrides the preferences.")
 {
     m_serverAddress = "127.0.0.1";
     m_serverPort = 8091;
+    m_spectrumRate = 0;
+    m_hasDSPThreads = false;
+    m_dspThreads = 0;
+    m_dspPinCores = false;
 
     m_parser.setApplicationDescription("Software Defined Radio application");
     m_parser.addHelpOption();
@@ -40,6 +60,14 @@ MainParser::MainParser() :
 
     m_parser.addOption(m_serverAddressOption);
     m_parser.addOption(m_serverPortOption);
+
+    if (m_server) {
+        m_parser.addOption(m_spectrumRateOption);
+    }
+
+    m_parser.addOption(m_threadRoleOption);
+    m_parser.addOption(m_dspThreadsOption);
+    m_parser.addOption(m_dspPinCoresOption);
 }
 
 MainParser::~MainParser()
@@ -79,4 +107,54 @@ void MainParser::parse(const QCoreApplication& app)
     } else {
         qWarning() << "MainParser::parse: server port invalid. Defaulting to " << m_serverPort;
     }
+
+    // spectrum stream rate
+
+    if (m_server)
+    {
+        QString spectrumRateStr = m_parser.value(m_spectrumRateOption);
+        int spectrumRate = spectrumRateStr.toInt(&ok);
+
+        if (ok && (spectrumRate >= 0) && (spectrumRate <= 100)) {
+            m_spectrumRate = spectrumRate;
+        } else {
+            qWarning() << "MainParser::parse: spectrum rate invalid. Defaulting to " << m_spectrumRate;
+        }
+    }
+
+    // thread roles
+
+    QStringList threadRoles = m_parser.values(m_threadRoleOption);
+
+    for (QStringList::const_iterator it = threadRoles.begin(); it != threadRoles.end(); ++it)
+    {
+        ThreadRoles::Role role;
+        ThreadRoles::RoleSettings roleSettings;
+
+        if (ThreadRoles::getRoleByName(it->section(':', 0, 0), role) && roleSettings.fromString(it->section(':', 1))) {
+            m_threadRoles.append(*it);
+        } else {
+            qWarning() << "MainParser::parse: thread role invalid. Ignoring " << *it;
+        }
+    }
+
+    // channels threads pool
+
+    if (m_parser.isSet(m_dspThreadsOption))
+    {
+        QString dspThreadsStr = m_parser.value(m_dspThreadsOption);
+        int dspThreads = dspThreadsStr.toInt(&ok);
+
+        if (ok && (dspThreads >= -1) && (dspThreads <= 64))
+        {
+            m_hasDSPThreads = true;
+            m_dspThreads = dspThreads;
+        }
+        else
+        {
+            qWarning() << "MainParser::parse: number of DSP threads invalid. Using the preferences";
+        }
+    }
+
+    m_dspPinCores = m_parser.isSet(m_dspPinCoresOption);
 }
@@ -19,6 +19,7 @@
 #define SDRBASE_MAINPARSER_H_
 
 #include <QCommandLineParser>
+#include <QStringList>
 #include <stdint.h>
 
 #include "export.h"
@@ -26,21 +27,36 @@
 class SDRBASE_API MainParser
 {
 public:
-    MainParser();
+    explicit MainParser(bool server = false); //!< server: register the options of the server only (sdrangelsrv)
     ~MainParser();
 
     void parse(const QCoreApplication& app);
 
     const QString& getServerAddress() const { return m_serverAddress; }
     uint16_t getServerPort() const { return m_serverPort; }
+    int getSpectrumRate() const { return m_spectrumRate; } //!< server only
+    const QStringList& getThreadRoles() const { return m_threadRoles; } //!< override the thread roles of the preferences
+    bool hasDSPThreads() const { return m_hasDSPThreads; } //!< the channels threads pool size overrides the preferences
+    int getDSPThreads() const { return m_dspThreads; }
+    bool getDSPPinCores() const { return m_dspPinCores; }  //!< pin the threads of the pool to cores whatever the preferences
 
 private:
+    bool     m_server;
     QString  m_serverAddress;
     uint16_t m_serverPort;
+    int      m_spectrumRate;
+    QStringList m_threadRoles;
+    bool     m_hasDSPThreads;
+    int      m_dspThreads;
+    bool     m_dspPinCores;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_serverAddressOption;
     QCommandLineOption m_serverPortOption;
+    QCommandLineOption m_spectrumRateOption;
+    QCommandLineOption m_threadRoleOption;
+    QCommandLineOption m_dspThreadsOption;
+    QCommandLineOption m_dspPinCoresOption;
 };
 
 
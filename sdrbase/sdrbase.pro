@@ -4,7 +4,7 @@
 #
 #--------------------------------------------------------
 
-QT += core multimedia
+QT += core multimedia network
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
 TEMPLATE = lib
@@ -68,12 +68,19 @@ SOURCES += audio/audiodevicemanager.cpp\
         dsp/downchannelizer.cpp\
         dsp/upchannelizer.cpp\
         dsp/channelmarker.cpp\
+        dsp/compactrecord.cpp\
+        dsp/compactrecordencoder.cpp\
+        dsp/compactrecordreader.cpp\
+        dsp/cpufeatures.cpp\
         dsp/ctcssdetector.cpp\
         dsp/cwkeyer.cpp\
         dsp/cwkeyersettings.cpp\
+        dsp/decimatorsblock.cpp\
         dsp/decimatorsfi.cpp\
         dsp/dspcommands.cpp\
         dsp/dspengine.cpp\
+        dsp/dspscheduler.cpp\
+        dsp/dspstats.cpp\
         dsp/dspdevicesourceengine.cpp\
         dsp/dspdevicesinkengine.cpp\
         dsp/fftengine.cpp\
@@ -84,22 +91,32 @@ SOURCES += audio/audiodevicemanager.cpp\
         dsp/filterrc.cpp\
         dsp/filtermbe.cpp\
         dsp/filerecord.cpp\
+        dsp/filerecordwriter.cpp\
         dsp/freqlockcomplex.cpp\
         dsp/interpolator.cpp\
+        dsp/interpolatorsblock.cpp\
+        dsp/iqcorrector.cpp\
         dsp/hbfiltertraits.cpp\
         dsp/lowpass.cpp\
         dsp/nco.cpp\
         dsp/ncof.cpp\
         dsp/phaselock.cpp\
         dsp/phaselockcomplex.cpp\
+        dsp/pfbchannelizer.cpp\
+        dsp/polyphaseresampler.cpp\
         dsp/projector.cpp\
         dsp/recursivefilters.cpp\
+        dsp/samplemixer.cpp\
         dsp/samplesinkfifo.cpp\
         dsp/samplesourcefifo.cpp\
         dsp/samplesinkfifodoublebuffered.cpp\
+        dsp/samplesinkfifospsc.cpp\
+        dsp/samplesinkring.cpp\
         dsp/basebandsamplesink.cpp\
         dsp/basebandsamplesource.cpp\
         dsp/nullsink.cpp\
+        dsp/spectrumengine.cpp\
+        dsp/spectrumstreamer.cpp\
         dsp/threadedbasebandsamplesink.cpp\
         dsp/threadedbasebandsamplesource.cpp\
         dsp/wfir.cpp\
@@ -111,13 +128,16 @@ SOURCES += audio/audiodevicemanager.cpp\
         util/CRC64.cpp\
         util/db.cpp\
         util/message.cpp\
+        util/messagepool.cpp\
         util/messagequeue.cpp\
         util/prettyprint.cpp\
         util/rtpsink.cpp\
         util/syncmessenger.cpp\
+        util/threadroles.cpp\
         util/samplesourceserializer.cpp\
         util/simpleserializer.cpp\
         util/uid.cpp\
+        util/udpbatchsender.cpp\
         plugin/plugininterface.cpp\
         plugin/pluginapi.cpp\
         plugin/pluginmanager.cpp\
@@ -146,13 +166,21 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/downchannelizer.h\
         dsp/upchannelizer.h\
         dsp/channelmarker.h\
+        dsp/compactrecord.h\
+        dsp/compactrecordencoder.h\
+        dsp/compactrecordreader.h\
         dsp/cwkeyer.h\
         dsp/cwkeyersettings.h\
         dsp/complex.h\
+        dsp/cpufeatures.h\
         dsp/decimators.h\
+        dsp/decimatorsblock.h\
         dsp/interpolators.h\
+        dsp/interpolatorsblock.h\
         dsp/dspcommands.h\
         dsp/dspengine.h\
+        dsp/dspscheduler.h\
+        dsp/dspstats.h\
         dsp/dspdevicesourceengine.h\
         dsp/dspdevicesinkengine.h\
         dsp/dsptypes.h\
@@ -164,11 +192,13 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/filterrc.h\
         dsp/filtermbe.h\
         dsp/filerecord.h\
+        dsp/filerecordwriter.h\
         dsp/freqlockcomplex.h\
         dsp/gfft.h\
         dsp/hbfiltertraits.h\
         dsp/iirfilter.h\
         dsp/interpolator.h\
+        dsp/iqcorrector.h\
         dsp/inthalfbandfilter.h\
         dsp/inthalfbandfilterdb.h\
         dsp/inthalfbandfiltereo1.h\
@@ -185,15 +215,22 @@ HEADERS  += audio/audiodevicemanager.h\
         dsp/phasediscri.h\
         dsp/phaselock.h\
         dsp/phaselockcomplex.h\
+        dsp/pfbchannelizer.h\
+        dsp/polyphaseresampler.h\
         dsp/projector.h\
         dsp/recursivefilters.h\
+        dsp/samplemixer.h\
         dsp/samplesinkfifo.h\
         dsp/samplesourcefifo.h\
         dsp/samplesinkfifodoublebuffered.h\
+        dsp/samplesinkfifospsc.h\
+        dsp/samplesinkring.h\
         dsp/samplesinkfifodecimator.h\
         dsp/basebandsamplesink.h\
         dsp/basebandsamplesource.h\
         dsp/nullsink.h\
+        dsp/spectrumengine.h\
+        dsp/spectrumstreamer.h\
         dsp/threadedbasebandsamplesink.h\
         dsp/threadedbasebandsamplesource.h\
         dsp/wfir.h\
@@ -209,13 +246,16 @@ HEADERS  += audio/audiodevicemanager.h\
         util/CRC64.h\
         util/db.h\
         util/message.h\
+        util/messagepool.h\
         util/messagequeue.h\
         util/prettyprint.h\
         util/rtpsink.h\
         util/syncmessenger.h\
+        util/threadroles.h\
         util/samplesourceserializer.h\
         util/simpleserializer.h\
         util/uid.h\
+        util/udpbatchsender.h\
         webapi/webapiadapterinterface.h\
         webapi/webapirequestmapper.h\
         webapi/webapiserver.h\
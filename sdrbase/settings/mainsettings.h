@@ -56,6 +56,16 @@ public:
     QtMsgType getFileMinLogLevel() const { return m_preferences.getFileMinLogLevel(); }
     bool getUseLogFile() const { return m_preferences.getUseLogFile(); }
     const QString& getLogFileName() const { return m_preferences.getLogFileName(); }
+    void setFFTWPrePlanning(bool fftwPrePlanning) { m_preferences.setFFTWPrePlanning(fftwPrePlanning); }
+    bool getFFTWPrePlanning() const { return m_preferences.getFFTWPrePlanning(); }
+    void setDSPSchedulerThreads(int nbThreads) { m_preferences.setDSPSchedulerThreads(nbThreads); }
+    int getDSPSchedulerThreads() const { return m_preferences.getDSPSchedulerThreads(); }
+    void setDSPSchedulerPinCores(bool pinCores) { m_preferences.setDSPSchedulerPinCores(pinCores); }
+    bool getDSPSchedulerPinCores() const { return m_preferences.getDSPSchedulerPinCores(); }
+    void setRecordDirectIO(bool recordDirectIO) { m_preferences.setRecordDirectIO(recordDirectIO); }
+    bool getRecordDirectIO() const { return m_preferences.getRecordDirectIO(); }
+    void setThreadRoles(const QString& threadRoles) { m_preferences.setThreadRoles(threadRoles); }
+    const QString& getThreadRoles() const { return m_preferences.getThreadRoles(); }
 
 	const AudioDeviceManager *getAudioDeviceManager() const { return m_audioDeviceManager; }
 	void setAudioDeviceManager(AudioDeviceManager *audioDeviceManager) { m_audioDeviceManager = audioDeviceManager; }
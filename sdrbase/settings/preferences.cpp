@@ -19,6 +19,11 @@ void Preferences::resetToDefaults()
 	m_logFileName = "sdrangel.log";
 	m_consoleMinLogLevel = QtDebugMsg;
     m_fileMinLogLevel = QtDebugMsg;
+    m_fftwPrePlanning = false;
+    m_dspSchedulerThreads = 0;
+    m_dspSchedulerPinCores = false;
+    m_threadRoles = "";
+    m_recordDirectIO = false;
 }
 
 QByteArray Preferences::serialize() const
@@ -35,6 +40,11 @@ QByteArray Preferences::serialize() const
 	s.writeBool(9, m_useLogFile);
 	s.writeString(10, m_logFileName);
     s.writeS32(11, (int) m_fileMinLogLevel);
+    s.writeBool(12, m_fftwPrePlanning);
+    s.writeS32(13, m_dspSchedulerThreads);
+    s.writeBool(14, m_dspSchedulerPinCores);
+    s.writeString(15, m_threadRoles);
+    s.writeBool(16, m_recordDirectIO);
 	return s.final();
 }
 
@@ -86,6 +96,12 @@ bool Preferences::deserialize(const QByteArray& data)
             m_fileMinLogLevel = QtDebugMsg;
         }
 
+        d.readBool(12, &m_fftwPrePlanning, false);
+        d.readS32(13, &m_dspSchedulerThreads, 0);
+        d.readBool(14, &m_dspSchedulerPinCores, false);
+        d.readString(15, &m_threadRoles, "");
+        d.readBool(16, &m_recordDirectIO, false);
+
 		return true;
 	} else
 	{
@@ -39,6 +39,20 @@ public:
 	bool getUseLogFile() const { return m_useLogFile; }
 	const QString& getLogFileName() const { return m_logFileName; }
 
+	void setFFTWPrePlanning(bool fftwPrePlanning) { m_fftwPrePlanning = fftwPrePlanning; }
+	bool getFFTWPrePlanning() const { return m_fftwPrePlanning; }
+
+	void setDSPSchedulerThreads(int nbThreads) { m_dspSchedulerThreads = nbThreads; }
+	int getDSPSchedulerThreads() const { return m_dspSchedulerThreads; }
+	void setDSPSchedulerPinCores(bool pinCores) { m_dspSchedulerPinCores = pinCores; }
+	bool getDSPSchedulerPinCores() const { return m_dspSchedulerPinCores; }
+
+	void setRecordDirectIO(bool recordDirectIO) { m_recordDirectIO = recordDirectIO; }
+	bool getRecordDirectIO() const { return m_recordDirectIO; }
+
+	void setThreadRoles(const QString& threadRoles) { m_threadRoles = threadRoles; }
+	const QString& getThreadRoles() const { return m_threadRoles; }
+
 protected:
 	QString m_sourceType;
 	QString m_sourceDevice;
@@ -54,6 +68,12 @@ protected:
     QtMsgType m_fileMinLogLevel;
 	bool m_useLogFile;
 	QString m_logFileName;
+
+	bool m_fftwPrePlanning; //!< plan common FFT sizes in the background at start
+	int m_dspSchedulerThreads;   //!< channels threads pool size. 0: one thread per channel, negative: one thread per core
+	bool m_dspSchedulerPinCores; //!< pin each pool thread to a core
+	QString m_threadRoles;       //!< scheduling of the threads by role (see ThreadRoles)
+	bool m_recordDirectIO;       //!< file recordings bypass the page cache
 };
 
 #endif // INCLUDE_PREFERENCES_H
@@ -17,16 +17,30 @@
 
 #include <QWaitCondition>
 #include <QMutex>
+#include <QAtomicInt>
 #include "util/message.h"
 #include "util/messagequeue.h"
 
 const char* Message::m_identifier = 0;
 
 Message::Message() :
-	m_destination(0)
+	m_destination(0),
+	m_queueNext(0)
 {
 }
 
+Message::Message(const Message& other) :
+	m_destination(other.m_destination),
+	m_queueNext(0)
+{
+}
+
+Message& Message::operator=(const Message& other)
+{
+	m_destination = other.m_destination;
+	return *this;
+}
+
 Message::~Message()
 {
 }
@@ -45,3 +59,14 @@ bool Message::match(const Message* message)
 {
 	return message->matchIdentifier(m_identifier);
 }
+
+int Message::getTypeId() const
+{
+	return 0;
+}
+
+int Message::registerTypeId()
+{
+	static QAtomicInt lastTypeId(0);
+	return lastTypeId.fetchAndAddRelaxed(1) + 1;
+}
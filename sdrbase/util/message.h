@@ -19,16 +19,26 @@
 #define INCLUDE_MESSAGE_H
 
 #include <stdlib.h>
+#include <cstddef>
+#include <QAtomicPointer>
 #include "export.h"
 
+class MessagePool;
+
 class SDRBASE_API Message {
 public:
 	Message();
+	Message(const Message& other); //!< copies do not inherit the queue link
 	virtual ~Message();
 
+	Message& operator=(const Message& other);
+
 	virtual const char* getIdentifier() const;
 	virtual bool matchIdentifier(const char* identifier) const;
 	static bool match(const Message* message);
+	virtual int getTypeId() const; //!< Integer identifying the class of the message. Usable as an index for table based dispatch.
+	static int typeId() { return 0; }
+	static int registerTypeId(); //!< Allocate the next type ID. Only used by MESSAGE_CLASS_DEFINITION.
 
 	void* getDestination() const { return m_destination; }
 	void setDestination(void *destination) { m_destination = destination; }
@@ -37,6 +47,10 @@ protected:
 	// addressing
 	static const char* m_identifier;
 	void* m_destination;
+
+private:
+	QAtomicPointer<Message> m_queueNext; //!< link used by MessageQueue
+	friend class MessageQueue;
 };
 
 #define MESSAGE_CLASS_DECLARATION \
@@ -44,16 +58,43 @@ protected:
 		const char* getIdentifier() const; \
 		bool matchIdentifier(const char* identifier) const; \
 		static bool match(const Message& message); \
+		int getTypeId() const; \
+		static int typeId(); \
 	protected: \
 		static const char* m_identifier; \
+		static const int m_typeId; \
 	private:
 
 #define MESSAGE_CLASS_DEFINITION(Name, BaseClass) \
 	const char* Name::m_identifier = #Name; \
+	const int Name::m_typeId = Message::registerTypeId(); \
 	const char* Name::getIdentifier() const { return m_identifier; } \
 	bool Name::matchIdentifier(const char* identifier) const {\
 		return (m_identifier == identifier) ? true : BaseClass::matchIdentifier(identifier); \
 	} \
-	bool Name::match(const Message& message) { return message.matchIdentifier(m_identifier); }
+	bool Name::match(const Message& message) { return message.matchIdentifier(m_identifier); } \
+	int Name::getTypeId() const { return m_typeId; } \
+	int Name::typeId() { return m_typeId; }
+
+/**
+ * Add to the declaration of a message class that is created often (reports, notifications) so that
+ * its instances are recycled through a free list instead of going to the heap each time. The class
+ * must also use MESSAGE_CLASS_POOLED_DEFINITION. Derived classes that do not declare their own pool
+ * are allocated normally.
+ */
+#define MESSAGE_CLASS_POOLED \
+	public: \
+		static void* operator new(std::size_t size); \
+		static void operator delete(void* p, std::size_t size); \
+	private: \
+		static MessagePool& messagePool();
+
+#define MESSAGE_CLASS_POOLED_DEFINITION(Name) \
+	MessagePool& Name::messagePool() { \
+		static MessagePool *pool = new MessagePool(sizeof(Name)); \
+		return *pool; \
+	} \
+	void* Name::operator new(std::size_t size) { return messagePool().allocate(size); } \
+	void Name::operator delete(void* p, std::size_t size) { messagePool().release(p, size); }
 
 #endif // INCLUDE_MESSAGE_H
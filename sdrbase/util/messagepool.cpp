@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+
+#include "messagepool.h"
+
+MessagePool::MessagePool(std::size_t blockSize, unsigned int maxFree) :
+    m_blockSize(blockSize < sizeof(Block) ? sizeof(Block) : blockSize),
+    m_maxFree(maxFree),
+    m_free(0),
+    m_nbFree(0)
+{
+}
+
+MessagePool::~MessagePool()
+{
+    while (m_free)
+    {
+        Block *block = m_free;
+        m_free = block->m_next;
+        ::operator delete(block);
+    }
+}
+
+void *MessagePool::allocate(std::size_t size)
+{
+    if (size == m_blockSize)
+    {
+        SpinlockHolder holder(&m_lock);
+        Block *block = m_free;
+
+        if (block)
+        {
+            m_free = block->m_next;
+            m_nbFree--;
+            return block;
+        }
+    }
+
+    return ::operator new(size < m_blockSize ? m_blockSize : size);
+}
+
+void MessagePool::release(void *p, std::size_t size)
+{
+    if (!p) {
+        return;
+    }
+
+    if (size == m_blockSize)
+    {
+        SpinlockHolder holder(&m_lock);
+
+        if (m_nbFree < m_maxFree)
+        {
+            Block *block = (Block *) p;
+            block->m_next = m_free;
+            m_free = block;
+            m_nbFree++;
+            return;
+        }
+    }
+
+    ::operator delete(p);
+}
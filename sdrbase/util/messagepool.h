@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_MESSAGEPOOL_H_
+#define SDRBASE_UTIL_MESSAGEPOOL_H_
+
+#include <cstddef>
+
+#include "util/spinlock.h"
+#include "export.h"
+
+/**
+ * Free list of fixed size memory blocks backing the allocation of one message class
+ * (see MESSAGE_CLASS_POOLED). Blocks can be allocated and released from any thread. Requests
+ * of another size (derived classes) go straight to the heap. At most maxFree blocks are
+ * kept for reuse, the excess is returned to the heap.
+ *
+ * Pools are created on first use and never destroyed so that messages deleted at exit
+ * still find their pool.
+ */
+class SDRBASE_API MessagePool
+{
+public:
+    MessagePool(std::size_t blockSize, unsigned int maxFree = 1024);
+    ~MessagePool();
+
+    void *allocate(std::size_t size);
+    void release(void *p, std::size_t size);
+
+    unsigned int getNbFree() const { return m_nbFree; }
+
+private:
+    struct Block {
+        Block *m_next;
+    };
+
+    std::size_t m_blockSize;
+    unsigned int m_maxFree;
+    Block *m_free;
+    unsigned int m_nbFree;
+    Spinlock m_lock;
+};
+
+#endif /* SDRBASE_UTIL_MESSAGEPOOL_H_ */
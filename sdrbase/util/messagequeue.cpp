@@ -16,14 +16,15 @@
 ///////////////////////////////////////////////////////////////////////////////////
 
 #include <QDebug>
-#include <QMutexLocker>
 #include "util/messagequeue.h"
 #include "util/message.h"
 
 MessageQueue::MessageQueue(QObject* parent) :
 	QObject(parent),
-	m_lock(QMutex::Recursive),
-	m_queue()
+	m_head(&m_stub),
+	m_tail(&m_stub),
+	m_size(0),
+	m_signalPending(0)
 {
 }
 
@@ -38,16 +39,23 @@ MessageQueue::~MessageQueue()
 	}
 }
 
+void MessageQueue::pushLink(Message* message)
+{
+	message->m_queueNext.store(0);
+	Message* prev = m_head.fetchAndStoreOrdered(message); // serialization point for the producers
+	prev->m_queueNext.fetchAndStoreOrdered(message);      // until then the consumer sees the queue as empty after prev
+}
+
 void MessageQueue::push(Message* message, bool emitSignal)
 {
 	if (message)
 	{
-		m_lock.lock();
-		m_queue.append(message);
-		m_lock.unlock();
+		m_size.fetchAndAddRelaxed(1);
+		pushLink(message);
 	}
 
-	if (emitSignal)
+	// coalescing: emit only if the consumer has popped since the last emission
+	if (emitSignal && m_signalPending.testAndSetOrdered(0, 1))
 	{
 		emit messageEnqueued();
 	}
@@ -55,27 +63,53 @@ void MessageQueue::push(Message* message, bool emitSignal)
 
 Message* MessageQueue::pop()
 {
-	QMutexLocker locker(&m_lock);
+	// re-arm the signal before looking at the queue so that a message pushed from now on is signaled
+	m_signalPending.fetchAndStoreOrdered(0);
+
+	Message* tail = m_tail;
+	Message* next = tail->m_queueNext.loadAcquire();
 
-	if (m_queue.isEmpty())
+	if (tail == &m_stub)
 	{
-		return 0;
+		if (next == 0) {
+			return 0;
+		}
+
+		m_tail = next;
+		tail = next;
+		next = next->m_queueNext.loadAcquire();
 	}
-	else
+
+	if (next == 0)
 	{
-		return m_queue.takeFirst();
+		if (tail != m_head.loadAcquire()) {
+			return 0; // a producer is linking a message after tail: it will signal
+		}
+
+		pushLink(&m_stub); // put back the stub so that tail can be detached
+		next = tail->m_queueNext.loadAcquire();
+
+		if (next == 0) {
+			return 0;
+		}
 	}
+
+	m_tail = next;
+	m_size.fetchAndAddRelaxed(-1);
+	return tail;
 }
 
 int MessageQueue::size()
 {
-	QMutexLocker locker(&m_lock);
-
-	return m_queue.size();
+	int size = m_size.loadAcquire();
+	return size < 0 ? 0 : size;
 }
 
 void MessageQueue::clear()
 {
-	QMutexLocker locker(&m_lock);
-	m_queue.clear();
+	Message* message;
+
+	while ((message = pop()) != 0) {
+		delete message;
+	}
 }
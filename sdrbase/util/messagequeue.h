@@ -21,10 +21,22 @@
 #include <QObject>
 #include <QQueue>
 #include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include "util/message.h"
 #include "export.h"
 
-class Message;
-
+/**
+ * Lock-free multiple producers single consumer message queue (intrusive queue of D. Vyukov
+ * linking the messages through Message::m_queueNext).
+ *
+ * Any thread may push. Only one thread at a time may pop which is the case when messages are
+ * popped by the slot connected to messageEnqueued() as it runs in the thread of its receiver.
+ *
+ * The messageEnqueued() signal is coalesced: while a signal is pending i.e. the consumer has not
+ * popped since the last emission further pushes do not emit again. The consumer is expected to
+ * pop until the queue is empty when it is signaled.
+ */
 class SDRBASE_API MessageQueue : public QObject {
 	Q_OBJECT
 
@@ -33,17 +45,22 @@ public:
 	~MessageQueue();
 
 	void push(Message* message, bool emitSignal = true);  //!< Push message onto queue
-	Message* pop(); //!< Pop message from queue
+	Message* pop(); //!< Pop message from queue. Consumer thread only.
 
-	int size(); //!< Returns queue size
-	void clear(); //!< Empty queue
+	int size(); //!< Returns queue size. Approximate while messages are being pushed or popped.
+	void clear(); //!< Empty queue. Consumer thread only.
 
 signals:
 	void messageEnqueued();
 
 private:
-	QMutex m_lock;
-	QQueue<Message*> m_queue;
+	QAtomicPointer<Message> m_head; //!< last pushed message (producers side)
+	Message* m_tail;                //!< next message to pop (consumer side)
+	Message m_stub;                 //!< placeholder keeping the list non empty
+	QAtomicInt m_size;
+	QAtomicInt m_signalPending;
+
+	void pushLink(Message* message);
 };
 
 #endif // INCLUDE_MESSAGEQUEUE_H
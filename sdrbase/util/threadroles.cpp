@@ -0,0 +1,461 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <QStringList>
+#include <QMutexLocker>
+#include <QDebug>
+
+#include "SWGThreadRoles.h"
+#include "SWGThreadRole.h"
+
+#include "threadroles.h"
+
+ThreadRoles::RoleSettings ThreadRoles::m_roleSettings[ThreadRoles::NbRoles];
+QMutex ThreadRoles::m_mutex;
+QAtomicInt ThreadRoles::m_generation(0);
+
+static const char *roleNames[ThreadRoles::NbRoles] = {"deviceio", "devicedsp", "channeldsp", "audio", "network"};
+static const char *policyNames[3] = {"other", "fifo", "rr"};
+static thread_local int appliedGeneration[ThreadRoles::NbRoles] = {0, 0, 0, 0, 0}; //!< settings generation applied in this thread
+static thread_local bool appliedNonDefault[ThreadRoles::NbRoles] = {false, false, false, false, false}; //!< this thread runs with non default settings
+
+QString ThreadRoles::RoleSettings::toString() const
+{
+    QStringList keys;
+
+    if (m_affinityMask != 0) {
+        keys.append(QString("cpus=%1").arg(formatCpus(m_affinityMask)));
+    }
+
+    if (m_policy != PolicyOther) {
+        keys.append(QString("policy=%1,priority=%2").arg(getPolicyName(m_policy)).arg(m_priority));
+    } else if (m_nice != 0) {
+        keys.append(QString("nice=%1").arg(m_nice));
+    }
+
+    return keys.join(",");
+}
+
+bool ThreadRoles::RoleSettings::fromString(const QString& settingsStr)
+{
+    RoleSettings settings;
+    QStringList keys = settingsStr.split(",", QString::SkipEmptyParts);
+
+    for (QStringList::const_iterator it = keys.begin(); it != keys.end(); ++it)
+    {
+        QString key = it->section('=', 0, 0).trimmed().toLower();
+        QString value = it->section('=', 1).trimmed();
+        bool ok = true;
+
+        if (key == "cpus") {
+            ok = parseCpus(value, settings.m_affinityMask);
+        } else if (key == "policy") {
+            ok = getPolicyByName(value, settings.m_policy);
+        } else if (key == "priority") {
+            settings.m_priority = value.toInt(&ok);
+            ok = ok && (settings.m_priority >= 0) && (settings.m_priority <= 99);
+        } else if (key == "nice") {
+            settings.m_nice = value.toInt(&ok);
+            ok = ok && (settings.m_nice >= -20) && (settings.m_nice <= 19);
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            return false;
+        }
+    }
+
+    if ((settings.m_policy != PolicyOther) && (settings.m_priority == 0)) {
+        settings.m_priority = 1; // lowest real time priority
+    }
+
+    *this = settings;
+    return true;
+}
+
+void ThreadRoles::setRoleSettings(Role role, const RoleSettings& settings)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    m_roleSettings[role] = settings;
+    m_generation.fetchAndAddOrdered(1);
+}
+
+ThreadRoles::RoleSettings ThreadRoles::getRoleSettings(Role role)
+{
+    QMutexLocker mutexLocker(&m_mutex);
+    return m_roleSettings[role];
+}
+
+void ThreadRoles::resetRoleSettings()
+{
+    QMutexLocker mutexLocker(&m_mutex);
+
+    for (int i = 0; i < NbRoles; i++) {
+        m_roleSettings[i] = RoleSettings();
+    }
+
+    m_generation.fetchAndAddOrdered(1);
+}
+
+bool ThreadRoles::setRole(const QString& roleStr)
+{
+    Role role;
+    RoleSettings settings;
+
+    if (!getRoleByName(roleStr.section(':', 0, 0).trimmed(), role) || !settings.fromString(roleStr.section(':', 1)))
+    {
+        qWarning("ThreadRoles::setRole: invalid thread role: %s", qPrintable(roleStr));
+        return false;
+    }
+
+    setRoleSettings(role, settings);
+    qDebug("ThreadRoles::setRole: %s", qPrintable(getRole(role)));
+    return true;
+}
+
+QString ThreadRoles::getRole(Role role)
+{
+    return QString("%1:%2").arg(getRoleName(role)).arg(getRoleSettings(role).toString());
+}
+
+bool ThreadRoles::deserialize(const QString& rolesStr)
+{
+    QStringList roles = rolesStr.split(" ", QString::SkipEmptyParts);
+    bool ok = true;
+
+    resetRoleSettings();
+
+    for (QStringList::const_iterator it = roles.begin(); it != roles.end(); ++it) {
+        ok = setRole(*it) && ok;
+    }
+
+    return ok;
+}
+
+QString ThreadRoles::serialize()
+{
+    QStringList roles;
+
+    for (int i = 0; i < NbRoles; i++)
+    {
+        if (!getRoleSettings((Role) i).isDefault()) {
+            roles.append(getRole((Role) i));
+        }
+    }
+
+    return roles.join(" ");
+}
+
+bool ThreadRoles::applyToCurrentThread(Role role)
+{
+    appliedGeneration[role] = m_generation.loadAcquire();
+    RoleSettings settings = getRoleSettings(role);
+    bool wasNonDefault = appliedNonDefault[role];
+    bool ok = true;
+
+    if (settings.isDefault() && !wasNonDefault) { // leave the thread untouched
+        return true;
+    }
+
+    // when back to default the settings below explicitly undo the previous ones (other policy, nice 0, any core)
+    appliedNonDefault[role] = !settings.isDefault();
+
+    if (((settings.m_affinityMask != 0) || wasNonDefault) && !setCurrentThreadAffinity(settings.m_affinityMask))
+    {
+        qWarning("ThreadRoles::applyToCurrentThread: %s: cannot set affinity to cpus %s",
+                getRoleName(role), settings.m_affinityMask == 0 ? "any" : qPrintable(formatCpus(settings.m_affinityMask)));
+        ok = false;
+    }
+
+#if defined(_WIN32)
+    int priority;
+
+    if (settings.m_policy != PolicyOther) {
+        priority = settings.m_priority >= 90 ? THREAD_PRIORITY_TIME_CRITICAL : settings.m_priority >= 50 ? THREAD_PRIORITY_HIGHEST : THREAD_PRIORITY_ABOVE_NORMAL;
+    } else {
+        priority = settings.m_nice < -10 ? THREAD_PRIORITY_HIGHEST : settings.m_nice < 0 ? THREAD_PRIORITY_ABOVE_NORMAL :
+            settings.m_nice > 10 ? THREAD_PRIORITY_LOWEST : settings.m_nice > 0 ? THREAD_PRIORITY_BELOW_NORMAL : THREAD_PRIORITY_NORMAL;
+    }
+
+    if (!SetThreadPriority(GetCurrentThread(), priority))
+    {
+        qWarning("ThreadRoles::applyToCurrentThread: %s: cannot set thread priority %d", getRoleName(role), priority);
+        ok = false;
+    }
+#else
+    struct sched_param param;
+    int policy = settings.m_policy == PolicyFIFO ? SCHED_FIFO : settings.m_policy == PolicyRR ? SCHED_RR : SCHED_OTHER;
+    param.sched_priority = settings.m_policy == PolicyOther ? 0 :
+        qBound(sched_get_priority_min(policy), settings.m_priority, sched_get_priority_max(policy));
+    int error = pthread_setschedparam(pthread_self(), policy, &param);
+
+    if (error != 0)
+    {
+        qWarning("ThreadRoles::applyToCurrentThread: %s: cannot set policy %s priority %d (error %d: missing CAP_SYS_NICE or rtprio limit?)",
+                getRoleName(role), getPolicyName(settings.m_policy), param.sched_priority, error);
+        ok = false;
+    }
+#if defined(__linux__)
+    // Linux applies nice levels to threads identified by their kernel thread id
+    else if ((settings.m_policy == PolicyOther) && (setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), settings.m_nice) != 0))
+    {
+        qWarning("ThreadRoles::applyToCurrentThread: %s: cannot set nice level %d", getRoleName(role), settings.m_nice);
+        ok = false;
+    }
+#endif
+#endif
+
+    return ok;
+}
+
+void ThreadRoles::applyOnce(Role role)
+{
+    if (appliedGeneration[role] != m_generation.loadAcquire()) {
+        applyToCurrentThread(role);
+    }
+}
+
+bool ThreadRoles::setCurrentThreadAffinity(quint64 affinityMask)
+{
+#if defined(_WIN32)
+    if (affinityMask == 0) // any core of the process
+    {
+        DWORD_PTR processMask, systemMask;
+
+        if (!GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+            return false;
+        }
+
+        return SetThreadAffinityMask(GetCurrentThread(), processMask) != 0;
+    }
+
+    if ((sizeof(DWORD_PTR) < sizeof(quint64)) && (affinityMask >> (8 * sizeof(DWORD_PTR)))) {
+        return false;
+    }
+
+    return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR) affinityMask) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+
+    for (int core = 0; core < CPU_SETSIZE; core++)
+    {
+        if ((affinityMask == 0) || ((core < 64) && (affinityMask & (((quint64) 1) << core)))) {
+            CPU_SET(core, &cpuSet);
+        }
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) == 0;
+#else
+    return affinityMask == 0; // affinity is never set
+#endif
+}
+
+const char *ThreadRoles::getRoleName(Role role)
+{
+    return roleNames[role];
+}
+
+bool ThreadRoles::getRoleByName(const QString& name, Role& role)
+{
+    for (int i = 0; i < NbRoles; i++)
+    {
+        if (name.compare(roleNames[i], Qt::CaseInsensitive) == 0)
+        {
+            role = (Role) i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char *ThreadRoles::getPolicyName(Policy policy)
+{
+    return policyNames[policy];
+}
+
+bool ThreadRoles::getPolicyByName(const QString& name, Policy& policy)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        if (name.compare(policyNames[i], Qt::CaseInsensitive) == 0)
+        {
+            policy = (Policy) i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QString ThreadRoles::formatCpus(quint64 affinityMask)
+{
+    QStringList ranges;
+    int core = 0;
+
+    while (core < 64)
+    {
+        if ((affinityMask & (((quint64) 1) << core)) == 0)
+        {
+            core++;
+            continue;
+        }
+
+        int last = core;
+
+        while ((last < 63) && (affinityMask & (((quint64) 1) << (last + 1)))) {
+            last++;
+        }
+
+        ranges.append(last == core ? QString::number(core) : QString("%1-%2").arg(core).arg(last));
+        core = last + 1;
+    }
+
+    return ranges.join("+");
+}
+
+bool ThreadRoles::parseCpus(const QString& cpusStr, quint64& affinityMask)
+{
+    QStringList ranges = cpusStr.split("+", QString::SkipEmptyParts);
+    quint64 mask = 0;
+
+    for (QStringList::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+    {
+        bool okFirst, okLast = true;
+        int first = it->section('-', 0, 0).toInt(&okFirst);
+        int last = first;
+
+        if (it->contains('-')) {
+            last = it->section('-', 1).toInt(&okLast);
+        }
+
+        if (!okFirst || !okLast || (first < 0) || (last > 63) || (first > last)) {
+            return false;
+        }
+
+        for (int core = first; core <= last; core++) {
+            mask |= ((quint64) 1) << core;
+        }
+    }
+
+    affinityMask = mask;
+    return true;
+}
+
+void ThreadRoles::webapiFormat(SWGSDRangel::SWGThreadRoles& response)
+{
+    response.cleanup(); // may hold the query
+    response.init();
+
+    for (int i = 0; i < NbRoles; i++)
+    {
+        RoleSettings settings = getRoleSettings((Role) i);
+        SWGSDRangel::SWGThreadRole *swgRole = new SWGSDRangel::SWGThreadRole();
+        swgRole->setRole(new QString(getRoleName((Role) i)));
+        swgRole->setCpus(new QString(formatCpus(settings.m_affinityMask)));
+        swgRole->setPolicy(new QString(getPolicyName(settings.m_policy)));
+        swgRole->setPriority(settings.m_priority);
+        swgRole->setNice(settings.m_nice);
+        response.getRoles()->append(swgRole);
+    }
+}
+
+bool ThreadRoles::webapiUpdate(const QList<QStringList>& rolesKeys, SWGSDRangel::SWGThreadRoles& query, QString& errorMessage)
+{
+    QList<SWGSDRangel::SWGThreadRole*> *swgRoles = query.getRoles();
+    RoleSettings updates[NbRoles];
+    bool updated[NbRoles];
+
+    for (int i = 0; i < NbRoles; i++)
+    {
+        updates[i] = getRoleSettings((Role) i);
+        updated[i] = false;
+    }
+
+    for (int i = 0; i < swgRoles->size(); i++)
+    {
+        SWGSDRangel::SWGThreadRole *swgRole = swgRoles->at(i);
+        QStringList roleKeys = i < rolesKeys.size() ? rolesKeys.at(i) : QStringList();
+        Role role;
+        QString roleName = swgRole->getRole() ? *swgRole->getRole() : "";
+
+        if (!getRoleByName(roleName, role))
+        {
+            errorMessage = QString("Invalid role: %1").arg(roleName);
+            return false;
+        }
+
+        RoleSettings& settings = updates[role]; // fields not in the query keep their value
+
+        if (roleKeys.contains("cpus") && swgRole->getCpus() && !parseCpus(*swgRole->getCpus(), settings.m_affinityMask))
+        {
+            errorMessage = QString("%1: invalid cpus: %2").arg(roleName).arg(*swgRole->getCpus());
+            return false;
+        }
+
+        if (roleKeys.contains("policy") && swgRole->getPolicy() && !swgRole->getPolicy()->isEmpty()
+            && !getPolicyByName(*swgRole->getPolicy(), settings.m_policy))
+        {
+            errorMessage = QString("%1: invalid policy: %2").arg(roleName).arg(*swgRole->getPolicy());
+            return false;
+        }
+
+        if (roleKeys.contains("priority")) {
+            settings.m_priority = swgRole->getPriority();
+        }
+
+        if (roleKeys.contains("nice")) {
+            settings.m_nice = swgRole->getNice();
+        }
+
+        if ((settings.m_priority < 0) || (settings.m_priority > 99) || (settings.m_nice < -20) || (settings.m_nice > 19))
+        {
+            errorMessage = QString("%1: priority or nice level out of range").arg(roleName);
+            return false;
+        }
+
+        if ((settings.m_policy != PolicyOther) && (settings.m_priority == 0)) {
+            settings.m_priority = 1;
+        }
+
+        updated[role] = true;
+    }
+
+    for (int i = 0; i < NbRoles; i++)
+    {
+        if (updated[i]) {
+            setRoleSettings((Role) i, updates[i]);
+        }
+    }
+
+    return true;
+}
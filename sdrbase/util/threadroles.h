@@ -0,0 +1,146 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_THREADROLES_H_
+#define SDRBASE_UTIL_THREADROLES_H_
+
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "export.h"
+
+namespace SWGSDRangel
+{
+    class SWGThreadRoles;
+}
+
+/**
+ * Registry of the scheduling parameters applied to the threads according to what they do:
+ * CPU affinity, real time policy and priority or nice level. A thread applies the settings of
+ * its role when it starts. Threads that are not created by SDRangel (library callbacks) or that
+ * live as long as the device set call applyOnce() in their processing loop to pick up changes.
+ *
+ * Text form of the settings of one role: role:key=value,key=value... with keys
+ *   cpus     cores the threads may run on e.g. 2-3+6 (any core when empty)
+ *   policy   other (default), fifo or rr
+ *   priority real time priority 1 to 99 (fifo and rr policies)
+ *   nice     nice level -20 to 19 (other policy)
+ * e.g. deviceio:cpus=2,policy=fifo,priority=50. Several roles are separated by spaces.
+ *
+ * Default settings leave the threads untouched. A thread that had non default settings applied
+ * goes back to the other policy, nice level 0 and any core when its role returns to default.
+ */
+class SDRBASE_API ThreadRoles
+{
+public:
+    enum Role
+    {
+        RoleDeviceIO,   //!< device sample reader and writer threads
+        RoleDeviceDSP,  //!< device DSP engines
+        RoleChannelDSP, //!< channel threads and DSP scheduler pool
+        RoleAudio,      //!< audio device callbacks
+        RoleNetwork,    //!< network sample streaming threads
+        NbRoles
+    };
+
+    enum Policy
+    {
+        PolicyOther,
+        PolicyFIFO,
+        PolicyRR
+    };
+
+    struct SDRBASE_API RoleSettings
+    {
+        quint64 m_affinityMask; //!< bit n for core n. 0 for any core
+        Policy m_policy;
+        int m_priority;
+        int m_nice;
+
+        RoleSettings() :
+            m_affinityMask(0),
+            m_policy(PolicyOther),
+            m_priority(0),
+            m_nice(0)
+        {}
+
+        bool isDefault() const { return (m_affinityMask == 0) && (m_policy == PolicyOther) && (m_nice == 0); }
+        QString toString() const;                    //!< key=value list
+        bool fromString(const QString& settingsStr); //!< key=value list. Returns false on syntax error leaving this untouched
+    };
+
+    static void setRoleSettings(Role role, const RoleSettings& settings);
+    static RoleSettings getRoleSettings(Role role);
+    static void resetRoleSettings(); //!< all roles back to default
+
+    static bool setRole(const QString& roleStr);  //!< role:key=value... Returns false on syntax error
+    static QString getRole(Role role);            //!< role:key=value...
+    static bool deserialize(const QString& rolesStr); //!< roles separated by spaces. Roles not listed are reset to default
+    static QString serialize();                   //!< non default roles separated by spaces
+
+    static bool applyToCurrentThread(Role role); //!< Returns false if a setting could not be applied
+    static void applyOnce(Role role);            //!< Apply if not done yet in the current thread since the last change. Cheap enough for processing loops
+    static bool setCurrentThreadAffinity(quint64 affinityMask); //!< 0 for any core
+
+    static const char *getRoleName(Role role);
+    static bool getRoleByName(const QString& name, Role& role);
+    static const char *getPolicyName(Policy policy);
+    static bool getPolicyByName(const QString& name, Policy& policy);
+    static QString formatCpus(quint64 affinityMask); //!< e.g. 0-1+4
+    static bool parseCpus(const QString& cpusStr, quint64& affinityMask);
+
+    static void webapiFormat(SWGSDRangel::SWGThreadRoles& response); //!< settings of all roles
+    /**
+     * Update the settings of the roles listed with the fields present in the query. rolesKeys has the
+     * JSON keys of each role of the query. Fields not present keep their current value. Nothing is
+     * changed on error.
+     */
+    static bool webapiUpdate(const QList<QStringList>& rolesKeys, SWGSDRangel::SWGThreadRoles& query, QString& errorMessage);
+
+private:
+    static RoleSettings m_roleSettings[NbRoles];
+    static QMutex m_mutex;
+    static QAtomicInt m_generation; //!< incremented at each change
+};
+
+/**
+ * Thread applying the settings of its role when it starts
+ */
+class SDRBASE_API RoleThread : public QThread {
+    Q_OBJECT
+
+public:
+    RoleThread(ThreadRoles::Role role, QObject *parent = 0) :
+        QThread(parent),
+        m_role(role)
+    {}
+
+protected:
+    void run()
+    {
+        ThreadRoles::applyToCurrentThread(m_role);
+        exec();
+    }
+
+private:
+    ThreadRoles::Role m_role;
+};
+
+#endif /* SDRBASE_UTIL_THREADROLES_H_ */
@@ -0,0 +1,255 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#endif
+
+#include <algorithm>
+
+#include <QUdpSocket>
+#include <QDebug>
+
+#include "udpbatchsender.h"
+
+#if defined(__linux__)
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 // from linux/udp.h (4.18)
+#endif
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#endif
+
+UDPBatchSender::UDPBatchSender(QUdpSocket *fallbackSocket) :
+    m_fallbackSocket(fallbackSocket),
+    m_address(QHostAddress::LocalHost),
+    m_port(9090),
+    m_ipv4Address(0),
+    m_fd(-1),
+    m_useGSO(false),
+    m_nbDatagramsSent(0),
+    m_nbDatagramsDropped(0),
+    m_nbSystemCalls(0)
+{
+#if defined(__linux__)
+    m_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+    if (m_fd < 0) {
+        qWarning("UDPBatchSender::UDPBatchSender: cannot create socket: %s. Sending datagrams one by one", strerror(errno));
+    }
+#endif
+    setDestination(m_address, m_port);
+}
+
+UDPBatchSender::~UDPBatchSender()
+{
+#if defined(__linux__)
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+#endif
+}
+
+void UDPBatchSender::setDestination(const QHostAddress& address, quint16 port)
+{
+    m_address = address;
+    m_port = port;
+    bool ok = false;
+    m_ipv4Address = address.toIPv4Address(&ok);
+
+    if (!ok) {
+        m_ipv4Address = 0; // IPv6 destinations go through the Qt socket
+    }
+}
+
+bool UDPBatchSender::isBatching() const
+{
+    return (m_fd >= 0) && (m_ipv4Address != 0);
+}
+
+int UDPBatchSender::send(const char *data, int datagramSize, int nbDatagrams)
+{
+    if ((nbDatagrams <= 0) || (datagramSize <= 0)) {
+        return 0;
+    }
+
+    int sent = 0;
+
+    if (isBatching())
+    {
+        bool bufferFull = false;
+
+        if (m_useGSO) {
+            sent = sendSegmented(data, datagramSize, nbDatagrams, bufferFull);
+        }
+
+        if (!bufferFull && (sent < nbDatagrams)) {
+            sent += sendMultiple(data + sent * datagramSize, datagramSize, nbDatagrams - sent);
+        }
+    }
+    else
+    {
+        sent = sendFallback(data, datagramSize, nbDatagrams);
+    }
+
+    m_nbDatagramsSent += sent;
+    m_nbDatagramsDropped += nbDatagrams - sent;
+
+    return sent;
+}
+
+int UDPBatchSender::sendMultiple(const char *data, int datagramSize, int nbDatagrams)
+{
+#if defined(__linux__)
+    struct sockaddr_in to;
+    struct mmsghdr msgs[m_maxBatch];
+    struct iovec iovecs[m_maxBatch];
+    int sent = 0;
+
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(m_port);
+    to.sin_addr.s_addr = htonl(m_ipv4Address);
+
+    while (sent < nbDatagrams)
+    {
+        int batch = std::min((int) m_maxBatch, nbDatagrams - sent);
+        memset(msgs, 0, batch * sizeof(struct mmsghdr));
+
+        for (int i = 0; i < batch; i++)
+        {
+            iovecs[i].iov_base = (void *) (data + (sent + i) * datagramSize);
+            iovecs[i].iov_len = datagramSize;
+            msgs[i].msg_hdr.msg_name = &to;
+            msgs[i].msg_hdr.msg_namelen = sizeof(to);
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int ret = sendmmsg(m_fd, msgs, batch, MSG_DONTWAIT);
+        m_nbSystemCalls++;
+
+        if (ret < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+                qWarning("UDPBatchSender::sendMultiple: %s", strerror(errno));
+            }
+
+            break; // socket buffer full: drop the rest like QUdpSocket would
+        }
+
+        sent += ret;
+    }
+
+    return sent;
+#else
+    return sendFallback(data, datagramSize, nbDatagrams);
+#endif
+}
+
+int UDPBatchSender::sendSegmented(const char *data, int datagramSize, int nbDatagrams, bool& bufferFull)
+{
+#if defined(__linux__)
+    struct sockaddr_in to;
+    struct msghdr msg;
+    struct iovec iov;
+    char control[CMSG_SPACE(sizeof(uint16_t))];
+    int segments = std::max(1, std::min((int) m_maxSegments, 65507 / datagramSize)); // one IP packet at most before segmentation
+    int sent = 0;
+
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(m_port);
+    to.sin_addr.s_addr = htonl(m_ipv4Address);
+
+    while (sent < nbDatagrams)
+    {
+        int batch = std::min(segments, nbDatagrams - sent);
+        iov.iov_base = (void *) (data + sent * datagramSize);
+        iov.iov_len = batch * datagramSize;
+
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_name = &to;
+        msg.msg_namelen = sizeof(to);
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        *((uint16_t *) CMSG_DATA(cmsg)) = datagramSize;
+
+        ssize_t ret = sendmsg(m_fd, &msg, MSG_DONTWAIT);
+        m_nbSystemCalls++;
+
+        if (ret < 0)
+        {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+            {
+                qWarning("UDPBatchSender::sendSegmented: GSO not available (%s). Use sendmmsg", strerror(errno));
+                m_useGSO = false;
+                return sent; // the rest is sent with sendmmsg
+            }
+
+            bufferFull = true;
+            return sent;
+        }
+
+        sent += batch;
+    }
+
+    return sent;
+#else
+    (void) bufferFull;
+    return sendFallback(data, datagramSize, nbDatagrams);
+#endif
+}
+
+int UDPBatchSender::sendFallback(const char *data, int datagramSize, int nbDatagrams)
+{
+    int sent = 0;
+
+    for (int i = 0; i < nbDatagrams; i++)
+    {
+        if (m_fallbackSocket->writeDatagram(data + i * datagramSize, (qint64) datagramSize, m_address, m_port) == datagramSize) {
+            sent++;
+        }
+    }
+
+    m_nbSystemCalls += nbDatagrams;
+
+    return sent;
+}
@@ -0,0 +1,76 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRBASE_UTIL_UDPBATCHSENDER_H_
+#define SDRBASE_UTIL_UDPBATCHSENDER_H_
+
+#include <QtGlobal>
+#include <QHostAddress>
+
+#include "export.h"
+
+class QUdpSocket;
+
+/**
+ * Sends a series of datagrams of equal size stored contiguously with as few system calls as possible.
+ *
+ * On Linux with an IPv4 destination the datagrams go through a dedicated socket with sendmmsg
+ * (one call for up to 256 datagrams) or if enabled with UDP generic segmentation offload
+ * (GSO, Linux 4.18+, one call for up to 64 datagrams that are split by the kernel or the NIC).
+ * GSO is turned off by itself if the kernel or the interface does not support it.
+ * In all other cases datagrams are sent one by one with QUdpSocket::writeDatagram on the fallback socket.
+ *
+ * As with QUdpSocket sending does not block: datagrams that do not fit in the socket buffer are dropped.
+ */
+class SDRBASE_API UDPBatchSender
+{
+public:
+    UDPBatchSender(QUdpSocket *fallbackSocket); //!< fallback socket is not owned
+    ~UDPBatchSender();
+
+    void setDestination(const QHostAddress& address, quint16 port);
+    void setUseGSO(bool useGSO) { m_useGSO = useGSO; }
+    bool getUseGSO() const { return m_useGSO; }
+    bool isBatching() const; //!< false if datagrams are sent one by one
+
+    /** Send nbDatagrams datagrams of datagramSize bytes stored one after the other from data. Returns the number of datagrams sent. */
+    int send(const char *data, int datagramSize, int nbDatagrams);
+
+    quint64 getNbDatagramsSent() const { return m_nbDatagramsSent; }
+    quint64 getNbDatagramsDropped() const { return m_nbDatagramsDropped; }
+    quint64 getNbSystemCalls() const { return m_nbSystemCalls; }
+
+private:
+    QUdpSocket *m_fallbackSocket;
+    QHostAddress m_address;
+    quint16 m_port;
+    quint32 m_ipv4Address; //!< host order. 0 if destination is not IPv4
+    int m_fd;              //!< native socket. -1 if not available
+    bool m_useGSO;
+    quint64 m_nbDatagramsSent;
+    quint64 m_nbDatagramsDropped;
+    quint64 m_nbSystemCalls;
+
+    static const int m_maxBatch = 256;   //!< datagrams per sendmmsg call
+    static const int m_maxSegments = 64; //!< datagrams per GSO call (kernel limit)
+
+    int sendMultiple(const char *data, int datagramSize, int nbDatagrams);
+    int sendSegmented(const char *data, int datagramSize, int nbDatagrams, bool& bufferFull);
+    int sendFallback(const char *data, int datagramSize, int nbDatagrams);
+};
+
+#endif /* SDRBASE_UTIL_UDPBATCHSENDER_H_ */
@@ -19,12 +19,21 @@
 #define INCLUDE_UTIL_UDPSINK_H_
 
 #include <stdint.h>
+#include <string.h>
+#include <algorithm>
 #include <QObject>
 #include <QUdpSocket>
 #include <QHostAddress>
 
 #include <cassert>
 
+#include "util/udpbatchsender.h"
+
+/**
+ * Cuts a stream of samples into datagrams of udpSize bytes. Complete datagrams are kept
+ * until a batch is full or flush() is called and are then sent with as few system calls
+ * as possible (see UDPBatchSender).
+ */
 template<typename T>
 class UDPSinkUtil
 {
@@ -36,9 +45,7 @@ public:
 		m_port(9999),
 		m_sampleBufferIndex(0)
 	{
-        assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+        init(parent);
 	}
 
     UDPSinkUtil(QObject *parent, unsigned int udpSize, unsigned int port) :
@@ -48,9 +55,7 @@ public:
         m_port(port),
         m_sampleBufferIndex(0)
     {
-        assert(m_udpSamples > 0);
-        m_sampleBuffer = new T[m_udpSamples];
-        m_socket = new QUdpSocket(parent);
+        init(parent);
     }
 
 	UDPSinkUtil (QObject *parent, unsigned int udpSize, QHostAddress& address, unsigned int port) :
@@ -60,14 +65,13 @@ public:
 		m_port(port),
 		m_sampleBufferIndex(0)
 	{
-		assert(m_udpSamples > 0);
-		m_sampleBuffer = new T[m_udpSamples];
-		m_socket = new QUdpSocket(parent);
+        init(parent);
 	}
 
 	~UDPSinkUtil()
 	{
 		delete[] m_sampleBuffer;
+		delete m_batchSender;
 		delete m_socket;
 	}
 
@@ -76,13 +80,14 @@ public:
 	    m_socket->moveToThread(thread);
 	}
 
-	void setAddress(QString& address) { m_address.setAddress(address); }
-	void setPort(unsigned int port) { m_port = port; }
+	void setAddress(QString& address) { m_address.setAddress(address); m_batchSender->setDestination(m_address, m_port); }
+	void setPort(unsigned int port) { m_port = port; m_batchSender->setDestination(m_address, m_port); }
 
 	void setDestination(const QString& address, int port)
 	{
 	    m_address.setAddress(const_cast<QString&>(address));
 	    m_port = port;
+	    m_batchSender->setDestination(m_address, m_port);
 	}
 
 	/**
@@ -90,16 +95,11 @@ public:
 	 */
 	void write(T sample)
 	{
-		if (m_sampleBufferIndex < m_udpSamples)
-		{
-			m_sampleBuffer[m_sampleBufferIndex] = sample;
-			m_sampleBufferIndex++;
-		}
-		else
-		{
-			m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port);
-			m_sampleBuffer[0] = sample;
-			m_sampleBufferIndex = 1;
+		m_sampleBuffer[m_sampleBufferIndex] = sample;
+		m_sampleBufferIndex++;
+
+		if (m_sampleBufferIndex == m_batchSamples) {
+		    flush();
 		}
 	}
 
@@ -110,33 +110,60 @@ public:
 	{
 	    int samplesIndex = 0;
 
-	    if (m_sampleBufferIndex + nbSamples > m_udpSamples) // fill remainder of buffer and send it
+	    while (nbSamples > 0)
 	    {
-	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], (m_udpSamples - m_sampleBufferIndex)*sizeof(T)); // fill remainder of buffer
-	        m_socket->writeDatagram((const char*)&m_sampleBuffer[0], (qint64 ) m_udpSize, m_address, m_port); // send buffer
-            samplesIndex += (m_udpSamples - m_sampleBufferIndex);
-            nbSamples -= (m_udpSamples - m_sampleBufferIndex);
-	        m_sampleBufferIndex = 0;
+	        int nbCopy = std::min(nbSamples, m_batchSamples - m_sampleBufferIndex);
+	        memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], nbCopy*sizeof(T));
+	        m_sampleBufferIndex += nbCopy;
+	        samplesIndex += nbCopy;
+	        nbSamples -= nbCopy;
+
+	        if (m_sampleBufferIndex == m_batchSamples) {
+	            flush();
+	        }
 	    }
+	}
 
-	    while (nbSamples > m_udpSamples) // send directly from input without buffering
-	    {
-	        m_socket->writeDatagram((const char*)&samples[samplesIndex], (qint64 ) m_udpSize, m_address, m_port);
-	        samplesIndex += m_udpSamples;
-	        nbSamples -= m_udpSamples;
+	/**
+	 * Send all complete datagrams. The samples of an incomplete datagram are kept for the next one.
+	 */
+	void flush()
+	{
+	    int nbDatagrams = m_sampleBufferIndex / m_udpSamples;
+
+	    if (nbDatagrams == 0) {
+	        return;
 	    }
 
-	    memcpy(&m_sampleBuffer[m_sampleBufferIndex], &samples[samplesIndex], nbSamples*sizeof(T)); // copy remainder of input to buffer
+	    m_batchSender->send((const char*) &m_sampleBuffer[0], m_udpSize, nbDatagrams);
+	    int remainder = m_sampleBufferIndex - nbDatagrams*m_udpSamples;
+	    memmove(&m_sampleBuffer[0], &m_sampleBuffer[nbDatagrams*m_udpSamples], remainder*sizeof(T));
+	    m_sampleBufferIndex = remainder;
 	}
 
 private:
 	int m_udpSize;
     int m_udpSamples;
+    int m_batchSamples;
 	QHostAddress m_address;
 	unsigned int m_port;
 	QUdpSocket *m_socket;
-	T *m_sampleBuffer;;
+	UDPBatchSender *m_batchSender;
+	T *m_sampleBuffer;
 	int m_sampleBufferIndex;
+
+	static const int m_nbBatchDatagrams = 16; //!< datagrams sent at once at most
+
+	void init(QObject *parent)
+	{
+        assert(m_udpSamples > 0);
+        m_udpSize = m_udpSamples * sizeof(T); // whole number of samples per datagram
+        m_batchSamples = m_udpSamples * m_nbBatchDatagrams;
+        m_sampleBuffer = new T[m_batchSamples];
+        m_socket = new QUdpSocket(parent);
+        m_batchSender = new UDPBatchSender(m_socket);
+        m_batchSender->setDestination(m_address, m_port);
+	}
 };
 
 
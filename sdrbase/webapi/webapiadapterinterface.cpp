@@ -28,6 +28,7 @@ QString WebAPIAdapterInterface::instanceAudioOutputParametersURL = "/sdrangel/au
 QString WebAPIAdapterInterface::instanceAudioInputCleanupURL = "/sdrangel/audio/input/cleanup";
 QString WebAPIAdapterInterface::instanceAudioOutputCleanupURL = "/sdrangel/audio/output/cleanup";
 QString WebAPIAdapterInterface::instanceLocationURL = "/sdrangel/location";
+QString WebAPIAdapterInterface::instanceThreadRolesURL = "/sdrangel/threadroles";
 QString WebAPIAdapterInterface::instanceDVSerialURL = "/sdrangel/dvserial";
 QString WebAPIAdapterInterface::instancePresetsURL = "/sdrangel/presets";
 QString WebAPIAdapterInterface::instancePresetURL = "/sdrangel/preset";
@@ -41,6 +42,7 @@ std::regex WebAPIAdapterInterface::devicesetDeviceURLRe("^/sdrangel/deviceset/([
 std::regex WebAPIAdapterInterface::devicesetDeviceSettingsURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/settings$");
 std::regex WebAPIAdapterInterface::devicesetDeviceRunURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/run");
 std::regex WebAPIAdapterInterface::devicesetDeviceReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/device/report$");
+std::regex WebAPIAdapterInterface::devicesetSpectrumURLRe("^/sdrangel/deviceset/([0-9]{1,2})/spectrum$");
 std::regex WebAPIAdapterInterface::devicesetChannelsReportURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channels/report$");
 std::regex WebAPIAdapterInterface::devicesetChannelURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel$");
 std::regex WebAPIAdapterInterface::devicesetChannelIndexURLRe("^/sdrangel/deviceset/([0-9]{1,2})/channel/([0-9]{1,2})$");
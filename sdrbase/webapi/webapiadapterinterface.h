@@ -37,6 +37,7 @@ namespace SWGSDRangel
     class SWGAudioOutputDevice;
     class SWGLocationInformation;
     class SWGDVSeralDevices;
+    class SWGThreadRoles;
     class SWGPresets;
     class SWGPresetTransfer;
     class SWGPresetIdentifier;
@@ -48,6 +49,7 @@ namespace SWGSDRangel
     class SWGDeviceSettings;
     class SWGDeviceState;
     class SWGDeviceReport;
+    class SWGSpectrumFrame;
     class SWGChannelsDetail;
     class SWGChannelSettings;
     class SWGChannelReport;
@@ -259,6 +261,33 @@ public:
     	return 501;
     }
 
+    /**
+     * Handler of /sdrangel/threadroles (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceThreadRolesGet(
+            SWGSDRangel::SWGThreadRoles& response __attribute__((unused)),
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
+    /**
+     * Handler of /sdrangel/threadroles (PATCH) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int instanceThreadRolesPatch(
+            const QList<QStringList>& rolesKeys __attribute__((unused)),
+            SWGSDRangel::SWGThreadRoles& response __attribute__((unused)),
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/dvserial (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -551,6 +580,20 @@ public:
         return 501;
     }
 
+    /**
+     * Handler of /sdrangel/deviceset/{devicesetIndex}/spectrum (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
+     * returns the Http status code (default 501: not implemented)
+     */
+    virtual int devicesetSpectrumGet(
+            int deviceSetIndex __attribute__((unused)),
+            SWGSDRangel::SWGSpectrumFrame& response __attribute__((unused)),
+            SWGSDRangel::SWGErrorResponse& error)
+    {
+        error.init();
+        *error.getMessage() = QString("Function not implemented");
+        return 501;
+    }
+
     /**
      * Handler of /sdrangel/deviceset/{devicesetIndex}/channels/report (GET) swagger/sdrangel/code/html2/index.html#api-Default-instanceChannels
      * returns the Http status code (default 501: not implemented)
@@ -653,6 +696,7 @@ public:
     static QString instanceAudioInputCleanupURL;
     static QString instanceAudioOutputCleanupURL;
     static QString instanceLocationURL;
+    static QString instanceThreadRolesURL;
     static QString instanceDVSerialURL;
     static QString instancePresetsURL;
     static QString instancePresetURL;
@@ -665,6 +709,7 @@ public:
     static std::regex devicesetDeviceSettingsURLRe;
     static std::regex devicesetDeviceRunURLRe;
     static std::regex devicesetDeviceReportURLRe;
+    static std::regex devicesetSpectrumURLRe;
     static std::regex devicesetChannelURLRe;
     static std::regex devicesetChannelIndexURLRe;
     static std::regex devicesetChannelSettingsURLRe;
@@ -29,6 +29,7 @@
 #include "SWGInstanceChannelsResponse.h"
 #include "SWGAudioDevices.h"
 #include "SWGLocationInformation.h"
+#include "SWGThreadRoles.h"
 #include "SWGDVSeralDevices.h"
 #include "SWGPresets.h"
 #include "SWGPresetTransfer.h"
@@ -38,6 +39,7 @@
 #include "SWGDeviceSettings.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGSpectrumFrame.h"
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
@@ -116,6 +118,8 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
             instanceAudioOutputCleanupService(request, response);
         } else if (path == WebAPIAdapterInterface::instanceLocationURL) {
             instanceLocationService(request, response);
+        } else if (path == WebAPIAdapterInterface::instanceThreadRolesURL) {
+            instanceThreadRolesService(request, response);
         } else if (path == WebAPIAdapterInterface::instanceDVSerialURL) {
             instanceDVSerialService(request, response);
         } else if (path == WebAPIAdapterInterface::instancePresetsURL) {
@@ -146,6 +150,8 @@ void WebAPIRequestMapper::service(qtwebapp::HttpRequest& request, qtwebapp::Http
                 devicesetDeviceRunService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetDeviceReportURLRe)) {
                 devicesetDeviceReportService(std::string(desc_match[1]), request, response);
+            } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetSpectrumURLRe)) {
+                devicesetSpectrumService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelsReportURLRe)) {
                 devicesetChannelsReportService(std::string(desc_match[1]), request, response);
             } else if (std::regex_match(pathStr, desc_match, WebAPIAdapterInterface::devicesetChannelURLRe)) {
@@ -610,6 +616,68 @@ void WebAPIRequestMapper::instanceLocationService(qtwebapp::HttpRequest& request
     }
 }
 
+void WebAPIRequestMapper::instanceThreadRolesService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        SWGSDRangel::SWGThreadRoles normalResponse;
+
+        int status = m_adapter->instanceThreadRolesGet(normalResponse, errorResponse);
+        response.setStatus(status);
+
+        if (status/100 == 2) {
+            response.write(normalResponse.asJson().toUtf8());
+        } else {
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else if (request.getMethod() == "PATCH")
+    {
+        SWGSDRangel::SWGThreadRoles normalResponse;
+        QString jsonStr = request.getBody();
+        QJsonObject jsonObject;
+
+        if (parseJsonBody(jsonStr, jsonObject, response))
+        {
+            QList<QStringList> rolesKeys; // JSON keys of each role to update only the fields given
+            QJsonArray rolesArray = jsonObject["roles"].toArray();
+
+            for (QJsonArray::const_iterator it = rolesArray.begin(); it != rolesArray.end(); ++it) {
+                rolesKeys.append((*it).toObject().keys());
+            }
+
+            normalResponse.init();
+            normalResponse.fromJson(jsonStr);
+            int status = m_adapter->instanceThreadRolesPatch(rolesKeys, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        else
+        {
+            response.setStatus(400,"Invalid JSON format");
+            errorResponse.init();
+            *errorResponse.getMessage() = "Invalid JSON format";
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::instanceDVSerialService(qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -1338,6 +1406,45 @@ void WebAPIRequestMapper::devicesetDeviceReportService(const std::string& indexS
     }
 }
 
+void WebAPIRequestMapper::devicesetSpectrumService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
+{
+    SWGSDRangel::SWGErrorResponse errorResponse;
+    response.setHeader("Content-Type", "application/json");
+    response.setHeader("Access-Control-Allow-Origin", "*");
+
+    if (request.getMethod() == "GET")
+    {
+        try
+        {
+            SWGSDRangel::SWGSpectrumFrame normalResponse;
+            normalResponse.init();
+            int deviceSetIndex = boost::lexical_cast<int>(indexStr);
+            int status = m_adapter->devicesetSpectrumGet(deviceSetIndex, normalResponse, errorResponse);
+            response.setStatus(status);
+
+            if (status/100 == 2) {
+                response.write(normalResponse.asJson().toUtf8());
+            } else {
+                response.write(errorResponse.asJson().toUtf8());
+            }
+        }
+        catch (const boost::bad_lexical_cast &e)
+        {
+            errorResponse.init();
+            *errorResponse.getMessage() = "Wrong integer conversion on device set index";
+            response.setStatus(400,"Invalid data");
+            response.write(errorResponse.asJson().toUtf8());
+        }
+    }
+    else
+    {
+        response.setStatus(405,"Invalid HTTP method");
+        errorResponse.init();
+        *errorResponse.getMessage() = "Invalid HTTP method";
+        response.write(errorResponse.asJson().toUtf8());
+    }
+}
+
 void WebAPIRequestMapper::devicesetChannelsReportService(const std::string& indexStr, qtwebapp::HttpRequest& request, qtwebapp::HttpResponse& response)
 {
     SWGSDRangel::SWGErrorResponse errorResponse;
@@ -1539,6 +1646,12 @@ void WebAPIRequestMapper::devicesetChannelSettingsService(
 
                 if (validateChannelSettings(normalResponse, jsonObject, channelSettingsKeys))
                 {
+                    if (jsonObject.contains("mixerGain")) // common to all Tx channels
+                    {
+                        normalResponse.setMixerGain(jsonObject["mixerGain"].toDouble());
+                        channelSettingsKeys.append("mixerGain");
+                    }
+
                     int status = m_adapter->devicesetChannelSettingsPutPatch(
                             deviceSetIndex,
                             channelIndex,
@@ -2439,6 +2552,7 @@ void WebAPIRequestMapper::resetChannelReport(SWGSDRangel::SWGChannelReport& chan
     channelReport.setUdpSinkReport(0);
     channelReport.setWfmDemodReport(0);
     channelReport.setWfmModReport(0);
+    channelReport.setDspStats(0);
 }
 
 void WebAPIRequestMapper::resetAudioInputDevice(SWGSDRangel::SWGAudioInputDevice& audioInputDevice)
@@ -45,7 +45,10 @@ void MainBench::run()
         << " testType: " << (int) m_parser.getTestType()
         << " nsamples: " << m_parser.getNbSamples()
         << " repet: " << m_parser.getRepetition()
-        << " log2f: " << m_parser.getLog2Factor();
+        << " log2f: " << m_parser.getLog2Factor()
+        << " channels: " << m_parser.getNbChannels()
+        << " dspThreads: " << m_parser.getDSPThreads()
+        << " pinCores: " << m_parser.getPinCores();
 
     if (m_parser.getTestType() == ParserBench::TestDecimatorsII) {
         testDecimateII();
@@ -59,6 +62,32 @@ void MainBench::run()
         testDecimateFI();
     } else if (m_parser.getTestType() == ParserBench::TestDecimatorsFF) {
         testDecimateFF();
+    } else if (m_parser.getTestType() == ParserBench::TestInterpolatorsII) {
+        testInterpolateII();
+    } else if (m_parser.getTestType() == ParserBench::TestInterpolatorsII8) {
+        testInterpolateII8();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleSinkFifo) {
+        testSampleSinkFifo();
+    } else if (m_parser.getTestType() == ParserBench::TestSampleMixer) {
+        testSampleMixer();
+    } else if (m_parser.getTestType() == ParserBench::TestDownChannelizer) {
+        testDownChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestPFBChannelizer) {
+        testPFBChannelizer();
+    } else if (m_parser.getTestType() == ParserBench::TestNCO) {
+        testNCO();
+    } else if (m_parser.getTestType() == ParserBench::TestResampler) {
+        testResampler();
+    } else if (m_parser.getTestType() == ParserBench::TestUDPBatch) {
+        testUDPBatch();
+    } else if (m_parser.getTestType() == ParserBench::TestCompactRecord) {
+        testCompactRecord();
+    } else if (m_parser.getTestType() == ParserBench::TestFFTFilt) {
+        testFFTFilt();
+    } else if (m_parser.getTestType() == ParserBench::TestIQCorrection) {
+        testIQCorrection();
+    } else if ((m_parser.getTestType() >= ParserBench::TestDemodAM) && (m_parser.getTestType() <= ParserBench::TestDemodDSD)) {
+        testDemod(m_parser.getTestType());
     } else {
         qDebug() << "MainBench::run: unknown test type: " << m_parser.getTestType();
     }
@@ -79,31 +108,40 @@ void MainBench::testDecimateII(ParserBench::TestType testType)
     std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand);
 
     qDebug() << "MainBench::testDecimateII: run test";
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
 
-    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    for (unsigned int l = 0; l < levels.size(); l++)
     {
-        switch (testType)
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
         {
-        case ParserBench::TestDecimatorsInfII:
-            timer.start();
-            decimateInfII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
-        case ParserBench::TestDecimatorsSupII:
-            timer.start();
-            decimateSupII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
-        case ParserBench::TestDecimatorsII:
-        default:
-            timer.start();
-            decimateII(buf, m_parser.getNbSamples()*2);
-            nsecs += timer.nsecsElapsed();
-            break;
+            switch (testType)
+            {
+            case ParserBench::TestDecimatorsInfII:
+                timer.start();
+                decimateInfII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            case ParserBench::TestDecimatorsSupII:
+                timer.start();
+                decimateSupII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            case ParserBench::TestDecimatorsII:
+            default:
+                timer.start();
+                decimateII(buf, m_parser.getNbSamples()*2);
+                nsecs += timer.nsecsElapsed();
+                break;
+            }
         }
+
+        printResults(QString("MainBench::testDecimateII: %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
     }
 
-    printResults("MainBench::testDecimateII", nsecs);
+    checkDecimateII(testType, buf, m_parser.getNbSamples()*2);
 
     qDebug() << "MainBench::testDecimateII: cleanup test data";
     delete[] buf;
@@ -122,15 +160,24 @@ void MainBench::testDecimateIF()
     std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand);
 
     qDebug() << "MainBench::testDecimateIF: run test";
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
 
-    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    for (unsigned int l = 0; l < levels.size(); l++)
     {
-        timer.start();
-        decimateIF(buf, m_parser.getNbSamples()*2);
-        nsecs += timer.nsecsElapsed();
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            decimateIF(buf, m_parser.getNbSamples()*2);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("MainBench::testDecimateIF: %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
     }
 
-    printResults("MainBench::testDecimateIF", nsecs);
+    checkDecimateIF(buf, m_parser.getNbSamples()*2);
 
     qDebug() << "MainBench::testDecimateIF: cleanup test data";
     delete[] buf;
@@ -149,15 +196,24 @@ void MainBench::testDecimateFI()
     std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand); // make sure data is in [-1.0..1.0] range
 
     qDebug() << "MainBench::testDecimateFI: run test";
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
 
-    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    for (unsigned int l = 0; l < levels.size(); l++)
     {
-        timer.start();
-        decimateFI(buf, m_parser.getNbSamples()*2);
-        nsecs += timer.nsecsElapsed();
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            decimateFI(buf, m_parser.getNbSamples()*2);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("MainBench::testDecimateFI: %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
     }
 
-    printResults("MainBench::testDecimateFI", nsecs);
+    checkDecimateFI(buf, m_parser.getNbSamples()*2);
 
     qDebug() << "MainBench::testDecimateFI: cleanup test data";
     delete[] buf;
@@ -176,15 +232,24 @@ void MainBench::testDecimateFF()
     std::generate(buf, buf + m_parser.getNbSamples()*2 - 1, my_rand); // make sure data is in [-1.0..1.0] range
 
     qDebug() << "MainBench::testDecimateFF: run test";
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
 
-    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    for (unsigned int l = 0; l < levels.size(); l++)
     {
-        timer.start();
-        decimateFF(buf, m_parser.getNbSamples()*2);
-        nsecs += timer.nsecsElapsed();
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            decimateFF(buf, m_parser.getNbSamples()*2);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("MainBench::testDecimateFF: %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
     }
 
-    printResults("MainBench::testDecimateFF", nsecs);
+    checkDecimateFF(buf, m_parser.getNbSamples()*2);
 
     qDebug() << "MainBench::testDecimateFF: cleanup test data";
     delete[] buf;
@@ -217,6 +282,12 @@ void MainBench::decimateII(const qint16* buf, int len)
     case 6:
         m_decimatorsII.decimate64_cen(&it, buf, len);
         break;
+    case 7:
+        m_decimatorsII.decimate128_cen(&it, buf, len);
+        break;
+    case 8:
+        m_decimatorsII.decimate256_cen(&it, buf, len);
+        break;
     default:
         break;
     }
@@ -249,6 +320,12 @@ void MainBench::decimateInfII(const qint16* buf, int len)
     case 6:
         m_decimatorsII.decimate64_inf(&it, buf, len);
         break;
+    case 7:
+        m_decimatorsII.decimate128_inf(&it, buf, len);
+        break;
+    case 8:
+        m_decimatorsII.decimate256_inf(&it, buf, len);
+        break;
     default:
         break;
     }
@@ -281,6 +358,12 @@ void MainBench::decimateSupII(const qint16* buf, int len)
     case 6:
         m_decimatorsII.decimate64_sup(&it, buf, len);
         break;
+    case 7:
+        m_decimatorsII.decimate128_sup(&it, buf, len);
+        break;
+    case 8:
+        m_decimatorsII.decimate256_sup(&it, buf, len);
+        break;
     default:
         break;
     }
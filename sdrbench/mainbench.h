@@ -22,11 +22,13 @@
 #include <QObject>
 #include <random>
 #include <functional>
+#include <vector>
 
 #include "dsp/decimators.h"
 #include "dsp/decimatorsif.h"
 #include "dsp/decimatorsfi.h"
 #include "dsp/decimatorsff.h"
+#include "dsp/cpufeatures.h"
 #include "parserbench.h"
 
 namespace qtwebapp {
@@ -51,14 +53,37 @@ private:
     void testDecimateIF();
     void testDecimateFI();
     void testDecimateFF();
+    void testInterpolateII();
+    void testInterpolateII8();
+    void testSampleSinkFifo();
+    void testSampleMixer();
+    void testDownChannelizer();
+    void testPFBChannelizer();
+    void testNCO();
+    void testResampler();
+    void testUDPBatch();
+    void testCompactRecord();
+    void testFFTFilt();
+    void testIQCorrection();
+    void testDemod(ParserBench::TestType testType);
     void decimateII(const qint16 *buf, int len);
     void decimateInfII(const qint16 *buf, int len);
     void decimateSupII(const qint16 *buf, int len);
     void decimateIF(const qint16 *buf, int len);
     void decimateFI(const float *buf, int len);
     void decimateFF(const float *buf, int len);
+    void checkDecimateII(ParserBench::TestType testType, const qint16 *buf, int len);
+    void checkDecimateIF(const qint16 *buf, int len);
+    void checkDecimateFI(const float *buf, int len);
+    void checkDecimateFF(const float *buf, int len);
+    static std::vector<CPUFeatures::SIMDLevel> getSIMDLevels();
     void printResults(const QString& prefix, qint64 nsecs);
 
+    template<typename Fifo>
+    void runSampleSinkFifoTest(const QString& prefix, Fifo *fifo, const SampleVector& samples);
+    template<typename T, uint OutputBits>
+    void runInterpolateTest(const QString& prefix);
+
     static MainBench *m_instance;
     qtwebapp::LoggerWithFile *m_logger;
     const ParserBench& m_parser;
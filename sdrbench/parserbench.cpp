@@ -37,12 +37,25 @@ ParserBench::ParserBench() :
     m_log2FactorOption(QStringList() << "l" << "log2-factor",
         "Log2 factor for rate conversion.",
         "log2",
-        "2")
+        "2"),
+    m_nbChannelsOption(QStringList() << "c" << "channels",
+        "Maximum number of channels of demodulator tests (runs with 1, 2, 4... channels up to this number).",
+        "channels",
+        "1"),
+    m_dspThreadsOption(QStringList() << "d" << "dsp-threads",
+        "Channels of demodulator tests run in a pool of this number of threads (0: one thread per channel, -1: one thread per core).",
+        "threads",
+        "0"),
+    m_pinCoresOption(QStringList() << "p" << "pin-cores",
+        "Pin the threads of the pool to cores.")
 {
     m_testStr = "decimateii";
     m_nbSamples = 1048576;
     m_repetition = 1;
     m_log2Factor = 4;
+    m_nbChannels = 1;
+    m_dspThreads = 0;
+    m_pinCores = false;
 
     m_parser.setApplicationDescription("Software Defined Radio application benchmarks");
     m_parser.addHelpOption();
@@ -52,6 +65,9 @@ ParserBench::ParserBench() :
     m_parser.addOption(m_nbSamplesOption);
     m_parser.addOption(m_repetitionOption);
     m_parser.addOption(m_log2FactorOption);
+    m_parser.addOption(m_nbChannelsOption);
+    m_parser.addOption(m_dspThreadsOption);
+    m_parser.addOption(m_pinCoresOption);
 }
 
 ParserBench::~ParserBench()
@@ -68,7 +84,7 @@ void ParserBench::parse(const QCoreApplication& app)
 
     QString test = m_parser.value(m_testOption);
 
-    QString testStr = "([a-z]+)";
+    QString testStr = "([a-z0-9]+)";
     QRegExp ipRegex ("^" + testStr + "$");
     QRegExpValidator ipValidator(ipRegex);
 
@@ -105,11 +121,35 @@ void ParserBench::parse(const QCoreApplication& app)
     QString log2FactorStr = m_parser.value(m_log2FactorOption);
     int log2Factor = log2FactorStr.toInt(&ok);
 
-    if (ok && (log2Factor >= 0) && (log2Factor <= 6)) {
+    if (ok && (log2Factor >= 0) && (log2Factor <= 8)) {
         m_log2Factor = log2Factor;
     } else {
         qWarning() << "ParserBench::parse: repetilog2 factortion invalid. Defaulting to " << m_log2Factor;
     }
+
+    // number of channels
+
+    QString nbChannelsStr = m_parser.value(m_nbChannelsOption);
+    int nbChannels = nbChannelsStr.toInt(&ok);
+
+    if (ok && (nbChannels > 0) && (nbChannels <= 64)) {
+        m_nbChannels = nbChannels;
+    } else {
+        qWarning() << "ParserBench::parse: number of channels invalid. Defaulting to " << m_nbChannels;
+    }
+
+    // DSP threads pool
+
+    QString dspThreadsStr = m_parser.value(m_dspThreadsOption);
+    int dspThreads = dspThreadsStr.toInt(&ok);
+
+    if (ok && (dspThreads >= -1) && (dspThreads <= 64)) {
+        m_dspThreads = dspThreads;
+    } else {
+        qWarning() << "ParserBench::parse: number of DSP threads invalid. Defaulting to " << m_dspThreads;
+    }
+
+    m_pinCores = m_parser.isSet(m_pinCoresOption);
 }
 
 ParserBench::TestType ParserBench::getTestType() const
@@ -124,6 +164,42 @@ ParserBench::TestType ParserBench::getTestType() const
         return TestDecimatorsInfII;
     } else if (m_testStr == "decimatesupii") {
         return TestDecimatorsSupII;
+    } else if (m_testStr == "interpolateii") {
+        return TestInterpolatorsII;
+    } else if (m_testStr == "interpolateii8") {
+        return TestInterpolatorsII8;
+    } else if (m_testStr == "samplefifo") {
+        return TestSampleSinkFifo;
+    } else if (m_testStr == "mixer") {
+        return TestSampleMixer;
+    } else if (m_testStr == "channelizer") {
+        return TestDownChannelizer;
+    } else if (m_testStr == "pfb") {
+        return TestPFBChannelizer;
+    } else if (m_testStr == "nco") {
+        return TestNCO;
+    } else if (m_testStr == "resampler") {
+        return TestResampler;
+    } else if (m_testStr == "udpbatch") {
+        return TestUDPBatch;
+    } else if (m_testStr == "compactrecord") {
+        return TestCompactRecord;
+    } else if (m_testStr == "fftfilt") {
+        return TestFFTFilt;
+    } else if (m_testStr == "iqcorrection") {
+        return TestIQCorrection;
+    } else if (m_testStr == "amdemod") {
+        return TestDemodAM;
+    } else if (m_testStr == "nfmdemod") {
+        return TestDemodNFM;
+    } else if (m_testStr == "ssbdemod") {
+        return TestDemodSSB;
+    } else if (m_testStr == "wfmdemod") {
+        return TestDemodWFM;
+    } else if (m_testStr == "bfmdemod") {
+        return TestDemodBFM;
+    } else if (m_testStr == "dsddemod") {
+        return TestDemodDSD;
     } else {
         return TestDecimatorsII;
     }
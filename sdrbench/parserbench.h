@@ -31,7 +31,25 @@ public:
         TestDecimatorsFI,
         TestDecimatorsFF,
         TestDecimatorsInfII,
-        TestDecimatorsSupII
+        TestDecimatorsSupII,
+        TestInterpolatorsII,
+        TestInterpolatorsII8,
+        TestSampleSinkFifo,
+        TestSampleMixer,
+        TestDownChannelizer,
+        TestPFBChannelizer,
+        TestNCO,
+        TestResampler,
+        TestUDPBatch,
+        TestCompactRecord,
+        TestFFTFilt,
+        TestIQCorrection,
+        TestDemodAM,
+        TestDemodNFM,
+        TestDemodSSB,
+        TestDemodWFM,
+        TestDemodBFM,
+        TestDemodDSD
     } TestType;
 
     ParserBench();
@@ -44,18 +62,27 @@ public:
     uint32_t getNbSamples() const { return m_nbSamples; }
     uint32_t getRepetition() const { return m_repetition; }
     uint32_t getLog2Factor() const { return m_log2Factor; }
+    uint32_t getNbChannels() const { return m_nbChannels; }
+    int getDSPThreads() const { return m_dspThreads; }
+    bool getPinCores() const { return m_pinCores; }
 
 private:
     QString  m_testStr;
     uint32_t m_nbSamples;
     uint32_t m_repetition;
     uint32_t m_log2Factor;
+    uint32_t m_nbChannels;
+    int      m_dspThreads;
+    bool     m_pinCores;
 
     QCommandLineParser m_parser;
     QCommandLineOption m_testOption;
     QCommandLineOption m_nbSamplesOption;
     QCommandLineOption m_repetitionOption;
     QCommandLineOption m_log2FactorOption;
+    QCommandLineOption m_nbChannelsOption;
+    QCommandLineOption m_dspThreadsOption;
+    QCommandLineOption m_pinCoresOption;
 };
 
 
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <algorithm>
+#include <string.h>
+
+#include "dsp/compactrecord.h"
+#include "mainbench.h"
+
+namespace {
+
+const FixReal fullScaleMax = (1 << (SDR_RX_SAMP_SZ - 1)) - 1;
+const FixReal fullScaleMin = -(1 << (SDR_RX_SAMP_SZ - 1));
+
+/** Value expected after decoding a sample recorded with sampleBits (0: lossless) */
+FixReal expectedValue(FixReal v, int sampleBits)
+{
+    if ((sampleBits <= 0) || (sampleBits >= SDR_RX_SAMP_SZ)) {
+        return v;
+    }
+
+    int shift = SDR_RX_SAMP_SZ - sampleBits;
+    qint32 maxValue = (1 << (sampleBits - 1)) - 1;
+    qint32 minValue = -(1 << (sampleBits - 1));
+    qint32 r = std::max(minValue, std::min(maxValue, (((qint32) v) + (1 << (shift - 1))) >> shift));
+    return r << shift;
+}
+
+/**
+ * Encodes the samples in blocks of blockSamples, decodes them back and counts the values that
+ * differ from the expected ones. Blocks that cannot be decoded count all their values as mismatches.
+ */
+int roundTrip(const SampleVector& samples, quint32 blockSamples, int sampleBits, bool compress, int& nbRiceBlocks, int& nbBlocks)
+{
+    std::vector<quint8> encoded;
+    SampleVector decoded(blockSamples);
+    int mismatches = 0;
+    nbRiceBlocks = 0;
+    nbBlocks = 0;
+
+    for (quint32 i = 0; i < samples.size(); i += blockSamples)
+    {
+        quint32 nbSamples = std::min(blockSamples, (quint32) samples.size() - i);
+        encoded.clear();
+        CompactRecord::encodeBlock(&samples[i], nbSamples, sampleBits, compress, encoded);
+        CompactRecord::BlockHeader blockHeader;
+        memcpy(&blockHeader, encoded.data(), sizeof(CompactRecord::BlockHeader));
+        nbBlocks++;
+        nbRiceBlocks += blockHeader.codec == CompactRecord::CodecDeltaRice ? 1 : 0;
+
+        if ((blockHeader.nbSamples != nbSamples)
+            || (encoded.size() != sizeof(CompactRecord::BlockHeader) + blockHeader.payloadSize)
+            || !CompactRecord::decodeBlock(blockHeader, &encoded[sizeof(CompactRecord::BlockHeader)], decoded.data(), 0))
+        {
+            mismatches += 2 * nbSamples;
+            continue;
+        }
+
+        for (quint32 j = 0; j < nbSamples; j++)
+        {
+            mismatches += decoded[j].m_real != expectedValue(samples[i+j].m_real, sampleBits) ? 1 : 0;
+            mismatches += decoded[j].m_imag != expectedValue(samples[i+j].m_imag, sampleBits) ? 1 : 0;
+        }
+    }
+
+    return mismatches;
+}
+
+void printRoundTrip(const QString& prefix, int mismatches, int nbValues, int nbRiceBlocks, int nbBlocks)
+{
+    QDebug info = qInfo();
+    info.noquote();
+    info << QString("%1: %2 mismatches over %3 values - %4 of %5 blocks delta Rice coded")
+        .arg(prefix).arg(mismatches).arg(nbValues).arg(nbRiceBlocks).arg(nbBlocks);
+}
+
+} // namespace
+
+void MainBench::testCompactRecord()
+{
+    qDebug() << "MainBench::testCompactRecord: create test data";
+
+    quint32 nbSamples = m_parser.getNbSamples();
+    const quint32 blockSamples = CompactRecord::m_defaultBlockSamples;
+    std::uniform_int_distribution<qint32> fullScale(fullScaleMin, fullScaleMax);
+    std::uniform_int_distribution<qint32> smallNoise(-3, 3);
+    std::uniform_int_distribution<qint32> spike(0, 96);
+
+    // uniform noise over the full range: does not compress and falls back to bit packing
+    SampleVector random(nbSamples);
+
+    for (quint32 i = 0; i < nbSamples; i++)
+    {
+        random[i].setReal(fullScale(m_generator));
+        random[i].setImag(fullScale(m_generator));
+    }
+
+    // full scale square wave with the extreme values: widest residuals of the delta coder
+    SampleVector extremes(nbSamples);
+
+    for (quint32 i = 0; i < nbSamples; i++)
+    {
+        extremes[i].setReal((i / 3) % 2 == 0 ? fullScaleMax : fullScaleMin);
+        extremes[i].setImag(i % 2 == 0 ? fullScaleMin : fullScaleMax);
+    }
+
+    // slow low level signal with occasional full scale spikes (extreme values on I): Rice codes with escapes
+    SampleVector spikes(nbSamples);
+    qint32 levelI = 0, levelQ = 0;
+
+    for (quint32 i = 0; i < nbSamples; i++)
+    {
+        levelI = std::max(-64, std::min(64, levelI + smallNoise(m_generator)));
+        levelQ = std::max(-64, std::min(64, levelQ + smallNoise(m_generator)));
+        bool isSpike = spike(m_generator) == 0;
+        spikes[i].setReal(isSpike ? (i % 2 == 0 ? fullScaleMax : fullScaleMin) : levelI);
+        spikes[i].setImag(isSpike ? fullScale(m_generator) : levelQ);
+    }
+
+    qDebug() << "MainBench::testCompactRecord: run round trip checks";
+    int nbValues = 2 * nbSamples;
+    int mismatches, nbRiceBlocks, nbBlocks;
+
+    mismatches = roundTrip(random, blockSamples, 0, false, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: random packed", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(random, blockSamples, 0, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: random compressed (packed fallback)", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(extremes, blockSamples, 0, false, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: full scale packed", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(extremes, blockSamples, 0, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: full scale compressed", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(spikes, blockSamples, 0, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: spikes compressed (escape codes)", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(spikes, 1, 0, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: spikes compressed in blocks of 1 sample", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(random, 1001, 12, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: random rounded to 12 bits", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+    mismatches = roundTrip(extremes, 1001, 12, true, nbRiceBlocks, nbBlocks);
+    printRoundTrip("MainBench::testCompactRecord: full scale rounded to 12 bits", mismatches, nbValues, nbRiceBlocks, nbBlocks);
+
+    qDebug() << "MainBench::testCompactRecord: run encoder";
+    std::vector<quint8> encoded;
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        encoded.clear();
+        timer.start();
+
+        for (quint32 i = 0; i < nbSamples; i += blockSamples) {
+            CompactRecord::encodeBlock(&spikes[i], std::min(blockSamples, nbSamples - i), 0, true, encoded);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testCompactRecord: encode", nsecs);
+    qInfo("MainBench::testCompactRecord: compressed size %.1f%% of the 16 bit I/Q size",
+        (100.0 * encoded.size()) / (4.0 * nbSamples));
+}
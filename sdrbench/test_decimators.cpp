@@ -0,0 +1,201 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+#include "dsp/decimatorsblock.h"
+#include "mainbench.h"
+
+namespace
+{
+
+const int nbChunks = 4; // consecutive buffers so that the filters history is checked too
+
+/**
+ * Run the same decimation on fresh scalar and SIMD instances over consecutive chunks of
+ * the buffer and count the output samples that differ by more than the tolerance.
+ */
+template<typename D, typename V, typename T, typename F>
+int compareLevels(F decimate, const T *buf, int len, double tolerance, int& nbCompared)
+{
+    D *scalar = new D();
+    D *simd = new D();
+    int chunk = (len / nbChunks) & ~1;
+    V outScalar(chunk/2 + 1);
+    V outSIMD(chunk/2 + 1);
+    int mismatches = 0;
+
+    for (int c = 0; c < nbChunks; c++)
+    {
+        typename V::iterator itScalar = outScalar.begin();
+        typename V::iterator itSIMD = outSIMD.begin();
+
+        CPUFeatures::setMaxSIMDLevel(CPUFeatures::SIMDNone);
+        (scalar->*decimate)(&itScalar, &buf[c*chunk], chunk);
+        CPUFeatures::setMaxSIMDLevel(CPUFeatures::SIMDAVX2);
+        (simd->*decimate)(&itSIMD, &buf[c*chunk], chunk);
+
+        int nbScalar = itScalar - outScalar.begin();
+        int nbSIMD = itSIMD - outSIMD.begin();
+
+        if (nbScalar != nbSIMD)
+        {
+            mismatches += std::abs(nbScalar - nbSIMD);
+            continue;
+        }
+
+        for (int i = 0; i < nbScalar; i++)
+        {
+            if ((std::fabs((double) outScalar[i].real() - (double) outSIMD[i].real()) > tolerance)
+             || (std::fabs((double) outScalar[i].imag() - (double) outSIMD[i].imag()) > tolerance)) {
+                mismatches++;
+            }
+        }
+
+        nbCompared += nbScalar;
+    }
+
+    delete simd;
+    delete scalar;
+    return mismatches;
+}
+
+template<typename D, typename T>
+int compareII(ParserBench::TestType testType, unsigned int log2, const T *buf, int len, int& nbCompared)
+{
+    typedef void (D::*F)(SampleVector::iterator*, const T*, qint32);
+    static const F decimate[3][9] = {
+        {&D::decimate1, &D::decimate2_cen, &D::decimate4_cen, &D::decimate8_cen, &D::decimate16_cen,
+         &D::decimate32_cen, &D::decimate64_cen, &D::decimate128_cen, &D::decimate256_cen},
+        {&D::decimate1, &D::decimate2_inf, &D::decimate4_inf, &D::decimate8_inf, &D::decimate16_inf,
+         &D::decimate32_inf, &D::decimate64_inf, &D::decimate128_inf, &D::decimate256_inf},
+        {&D::decimate1, &D::decimate2_sup, &D::decimate4_sup, &D::decimate8_sup, &D::decimate16_sup,
+         &D::decimate32_sup, &D::decimate64_sup, &D::decimate128_sup, &D::decimate256_sup}
+    };
+    int mode = testType == ParserBench::TestDecimatorsInfII ? 1 : testType == ParserBench::TestDecimatorsSupII ? 2 : 0;
+
+    return compareLevels<D, SampleVector>(decimate[mode][log2], buf, len, 0.0, nbCompared);
+}
+
+template<typename D, typename V, typename T>
+int compareCen(unsigned int log2, const T *buf, int len, double tolerance, int& nbCompared)
+{
+    typedef void (D::*F)(typename V::iterator*, const T*, qint32);
+    static const F decimate[7] = {
+        &D::decimate1, &D::decimate2_cen, &D::decimate4_cen, &D::decimate8_cen,
+        &D::decimate16_cen, &D::decimate32_cen, &D::decimate64_cen
+    };
+
+    if (log2 > 6) {
+        return 0;
+    }
+
+    return compareLevels<D, V>(decimate[log2], buf, len, tolerance, nbCompared);
+}
+
+void printCheck(const QString& prefix, int mismatches, int nbCompared)
+{
+    QDebug info = qInfo();
+    info.noquote();
+    info << QString("%1: %2 mismatches over %3 samples against the scalar path at %4 level")
+        .arg(prefix).arg(mismatches).arg(nbCompared).arg(CPUFeatures::getSIMDLevelName(CPUFeatures::getDetectedSIMDLevel()));
+}
+
+} // namespace
+
+std::vector<CPUFeatures::SIMDLevel> MainBench::getSIMDLevels()
+{
+    std::vector<CPUFeatures::SIMDLevel> levels;
+    levels.push_back(CPUFeatures::SIMDNone);
+
+    if (CPUFeatures::getDetectedSIMDLevel() != CPUFeatures::SIMDNone) {
+        levels.push_back(CPUFeatures::getDetectedSIMDLevel());
+    }
+
+    return levels;
+}
+
+void MainBench::checkDecimateII(ParserBench::TestType testType, const qint16 *buf, int len)
+{
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    unsigned int log2 = m_parser.getLog2Factor();
+    int nbCompared = 0;
+
+    // 12 bit samples (LimeSDR)
+    int mismatches = compareII<Decimators<qint32, qint16, SDR_RX_SAMP_SZ, 12> >(testType, log2, buf, len, nbCompared);
+    printCheck("MainBench::checkDecimateII: 12 bit", mismatches, nbCompared);
+
+    // 8 bit samples (HackRF)
+    std::vector<qint8> buf8(len);
+    std::vector<quint8> bufU8(len);
+
+    for (int i = 0; i < len; i++)
+    {
+        buf8[i] = buf[i] >> 4;
+        bufU8[i] = (buf[i] >> 4) + 128;
+    }
+
+    nbCompared = 0;
+    mismatches = compareII<Decimators<qint32, qint8, SDR_RX_SAMP_SZ, 8> >(testType, log2, buf8.data(), len, nbCompared);
+    printCheck("MainBench::checkDecimateII: 8 bit", mismatches, nbCompared);
+
+    // unsigned 8 bit conversion (RTLSDR)
+    std::vector<int32_t> convScalar(len);
+    std::vector<int32_t> convSIMD(len);
+    DecimatorsBlock::convertUnsigned<quint8>(bufU8.data(), convScalar.data(), len, 127, 7);
+    CPUFeatures::setMaxSIMDLevel(CPUFeatures::SIMDAVX2);
+    DecimatorsBlock::convertUnsigned(bufU8.data(), convSIMD.data(), len, 127, 7);
+    mismatches = 0;
+
+    for (int i = 0; i < len; i++) {
+        mismatches += convScalar[i] != convSIMD[i] ? 1 : 0;
+    }
+
+    printCheck("MainBench::checkDecimateII: unsigned 8 bit conversion", mismatches, len);
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+}
+
+void MainBench::checkDecimateIF(const qint16 *buf, int len)
+{
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    int nbCompared = 0;
+    // -ffast-math lets the compiler reorder the scalar sums so allow for rounding differences
+    int mismatches = compareCen<DecimatorsIF<qint16, 12>, FSampleVector>(m_parser.getLog2Factor(), buf, len, 1e-5, nbCompared);
+    printCheck("MainBench::checkDecimateIF", mismatches, nbCompared);
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+}
+
+void MainBench::checkDecimateFI(const float *buf, int len)
+{
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    int nbCompared = 0;
+    int mismatches = compareCen<DecimatorsFI, SampleVector>(m_parser.getLog2Factor(), buf, len, 1.0, nbCompared);
+    printCheck("MainBench::checkDecimateFI", mismatches, nbCompared);
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+}
+
+void MainBench::checkDecimateFF(const float *buf, int len)
+{
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    int nbCompared = 0;
+    int mismatches = compareCen<DecimatorsFF, FSampleVector>(m_parser.getLog2Factor(), buf, len, 1e-5, nbCompared);
+    printCheck("MainBench::checkDecimateFF", mismatches, nbCompared);
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+}
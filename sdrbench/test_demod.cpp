@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QThread>
+#include <vector>
+#include <cmath>
+
+#include "SWGChannelSettings.h"
+#include "SWGBFMDemodSettings.h"
+
+#include "dsp/dspengine.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "audio/audiodevicemanager.h"
+#include "audio/audiofifo.h"
+#include "device/devicesourceapi.h"
+#include "channel/channelsinkapi.h"
+#include "plugin/pluginmanager.h"
+#include "plugin/pluginapi.h"
+#include "plugin/plugininterface.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Synthetic signal suited to each demodulator */
+typedef enum
+{
+    SignalAM,       //!< 1 kHz tone at 50% modulation depth
+    SignalNFM,      //!< 1 kHz tone at 2.5 kHz deviation
+    SignalSSB,      //!< 1 kHz tone in the upper side band
+    SignalWFM,      //!< 1 kHz tone at 75 kHz deviation
+    SignalBFM,      //!< WFM with a 19 kHz pilot and random bits on the 57 kHz RDS subcarrier
+    Signal4FSK      //!< random 4800 baud 4FSK symbols at +/-600 and +/-1800 Hz deviation (C4FM like)
+} DemodSignal;
+
+struct DemodBenchConfig
+{
+    const char *m_channelIdURI;
+    DemodSignal m_signal;
+    int m_channelSampleRate; //!< baseband sample rate with a log2 factor of 0
+};
+
+DemodBenchConfig getDemodBenchConfig(ParserBench::TestType testType)
+{
+    switch (testType)
+    {
+    case ParserBench::TestDemodNFM:
+        return DemodBenchConfig{"sdrangel.channel.nfmdemod", SignalNFM, 48000};
+    case ParserBench::TestDemodSSB:
+        return DemodBenchConfig{"sdrangel.channel.ssbdemod", SignalSSB, 48000};
+    case ParserBench::TestDemodWFM:
+        return DemodBenchConfig{"sdrangel.channel.wfmdemod", SignalWFM, 384000};
+    case ParserBench::TestDemodBFM:
+        return DemodBenchConfig{"sdrangel.channel.bfm", SignalBFM, 384000};
+    case ParserBench::TestDemodDSD:
+        return DemodBenchConfig{"sdrangel.channel.dsddemod", Signal4FSK, 48000};
+    case ParserBench::TestDemodAM:
+    default:
+        return DemodBenchConfig{"sdrangel.channel.amdemod", SignalAM, 48000};
+    }
+}
+
+/** Modulated signal at the center of the baseband (where the channels sit by default) at -10 dBFS with noise at -50 dBFS */
+void generateSignal(SampleVector& samples, DemodSignal signal, int sampleRate, std::mt19937& generator)
+{
+    std::normal_distribution<float> noise(0.0f, 0.003f * SDR_RX_SCALEF);
+    std::uniform_int_distribution<int> symbols(0, 3);
+    const double amplitude = 0.3 * SDR_RX_SCALEF;
+    const double fmDeviation[4] = {-1800.0, -600.0, 600.0, 1800.0};
+    double phase = 0.0;
+    double symbolPhase = 1.0;
+    double rdsBitPhase = 1.0;
+    int symbol = 0;
+    int rdsBit = 1;
+
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        double t = i / (double) sampleRate;
+        double tone = cos(2.0 * M_PI * 1000.0 * t);
+        double re, im;
+
+        switch (signal)
+        {
+        case SignalAM:
+            re = amplitude * (1.0 + 0.5 * tone);
+            im = 0.0;
+            break;
+        case SignalSSB:
+            re = amplitude * tone;
+            im = amplitude * sin(2.0 * M_PI * 1000.0 * t);
+            break;
+        case SignalNFM:
+            phase += 2.0 * M_PI * 2500.0 * tone / sampleRate;
+            re = amplitude * cos(phase);
+            im = amplitude * sin(phase);
+            break;
+        case SignalWFM:
+            phase += 2.0 * M_PI * 75000.0 * tone / sampleRate;
+            re = amplitude * cos(phase);
+            im = amplitude * sin(phase);
+            break;
+        case SignalBFM:
+        {
+            rdsBitPhase += 1187.5 / sampleRate;
+
+            if (rdsBitPhase >= 1.0)
+            {
+                rdsBitPhase -= 1.0;
+                rdsBit = symbols(generator) < 2 ? -1 : 1;
+            }
+
+            double composite = 0.8 * tone
+                + 0.1 * cos(2.0 * M_PI * 19000.0 * t)
+                + 0.05 * rdsBit * cos(2.0 * M_PI * 57000.0 * t);
+            phase += 2.0 * M_PI * 75000.0 * composite / sampleRate;
+            re = amplitude * cos(phase);
+            im = amplitude * sin(phase);
+            break;
+        }
+        case Signal4FSK:
+        default:
+            symbolPhase += 4800.0 / sampleRate;
+
+            if (symbolPhase >= 1.0)
+            {
+                symbolPhase -= 1.0;
+                symbol = symbols(generator);
+            }
+
+            phase += 2.0 * M_PI * fmDeviation[symbol] / sampleRate;
+            re = amplitude * cos(phase);
+            im = amplitude * sin(phase);
+            break;
+        }
+
+        phase = fmod(phase, 2.0 * M_PI);
+        samples[i].setReal(re + noise(generator));
+        samples[i].setImag(im + noise(generator));
+    }
+}
+
+/**
+ * Channels of one type on a device engine that is fed offline as in sdrangelproc: each block is fully
+ * processed by all channels before the next one is pushed. There is no sample source and the audio
+ * FIFOs are detached from the audio devices and emptied after each block.
+ */
+class DemodBenchDeviceSet
+{
+public:
+    DemodBenchDeviceSet(PluginInterface *plugin, ParserBench::TestType testType, int nbChannels) :
+        m_dspEngine(DSPEngine::instance())
+    {
+        m_deviceSourceEngine = m_dspEngine->addDeviceSourceEngine();
+        m_deviceSourceEngine->start();
+        m_deviceSourceAPI = new DeviceSourceAPI(0, m_deviceSourceEngine);
+
+        for (int i = 0; i < nbChannels; i++)
+        {
+            ChannelSinkAPI *channel = plugin->createRxChannelCS(m_deviceSourceAPI);
+            configureChannel(channel, testType);
+            m_channels.push_back(channel);
+        }
+
+        QCoreApplication::processEvents(); // channels apply their settings and attach their audio FIFOs
+
+        AudioDeviceManager *audioDeviceManager = m_dspEngine->getAudioDeviceManager();
+        m_audioFifos = audioDeviceManager->getAudioSinkFifos();
+
+        for (QList<AudioFifo*>::const_iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it) {
+            audioDeviceManager->removeAudioSink(*it);
+        }
+    }
+
+    ~DemodBenchDeviceSet()
+    {
+        for (std::vector<ChannelSinkAPI*>::iterator it = m_channels.begin(); it != m_channels.end(); ++it) {
+            (*it)->destroy();
+        }
+
+        m_deviceSourceEngine->stop();
+        m_dspEngine->removeLastDeviceSourceEngine();
+        delete m_deviceSourceAPI;
+    }
+
+    bool start(uint sampleRate)
+    {
+        if (!m_deviceSourceEngine->startOffline(sampleRate, 0)) {
+            return false;
+        }
+
+        // let the channelizers get their configuration and notify their demodulators before the first samples
+        for (int i = 0; i < 10; i++)
+        {
+            QThread::msleep(10);
+            QCoreApplication::processEvents();
+        }
+
+        return true;
+    }
+
+    void feed(SampleVector& samples, uint32_t blockSize)
+    {
+        for (std::size_t i = 0; i < samples.size(); i += blockSize)
+        {
+            std::size_t len = samples.size() - i < blockSize ? samples.size() - i : blockSize;
+            m_deviceSourceEngine->feedOffline(samples.begin() + i, samples.begin() + i + len);
+            drainAudio();
+        }
+    }
+
+    void stop()
+    {
+        m_deviceSourceEngine->stopOffline();
+        drainAudio();
+    }
+
+    void getStats(std::vector<DSPDeviceSourceEngine::SinkStats>& sinksStats) const
+    {
+        m_deviceSourceEngine->getSinksStats(sinksStats);
+    }
+
+private:
+    DSPEngine *m_dspEngine;
+    DSPDeviceSourceEngine *m_deviceSourceEngine;
+    DeviceSourceAPI *m_deviceSourceAPI;
+    std::vector<ChannelSinkAPI*> m_channels;
+    QList<AudioFifo*> m_audioFifos;
+    std::vector<AudioSample> m_audioBuffer;
+
+    /** Apply the settings through the API as the server does so the channelizer is configured. BFM runs with RDS. */
+    void configureChannel(ChannelSinkAPI *channel, ParserBench::TestType testType)
+    {
+        SWGSDRangel::SWGChannelSettings channelSettings;
+        QStringList channelSettingsKeys;
+        QString errorMessage;
+
+        channel->webapiSettingsGet(channelSettings, errorMessage);
+        channelSettingsKeys << "inputFrequencyOffset";
+
+        if ((testType == ParserBench::TestDemodBFM) && channelSettings.getBfmDemodSettings())
+        {
+            channelSettings.getBfmDemodSettings()->setRdsActive(1);
+            channelSettingsKeys << "rdsActive";
+        }
+
+        channel->webapiSettingsPutPatch(true, channelSettingsKeys, channelSettings, errorMessage);
+    }
+
+    void drainAudio()
+    {
+        for (QList<AudioFifo*>::const_iterator it = m_audioFifos.begin(); it != m_audioFifos.end(); ++it)
+        {
+            uint32_t fill = (*it)->fill();
+
+            if (m_audioBuffer.size() < fill) {
+                m_audioBuffer.resize(fill);
+            }
+
+            (*it)->read((quint8 *) m_audioBuffer.data(), fill);
+        }
+    }
+};
+
+} // namespace
+
+void MainBench::testDemod(ParserBench::TestType testType)
+{
+    DemodBenchConfig config = getDemodBenchConfig(testType);
+    uint sampleRate = config.m_channelSampleRate << m_parser.getLog2Factor();
+    DSPEngine::instance()->setDSPScheduler(m_parser.getDSPThreads(), m_parser.getPinCores());
+    PluginManager pluginManager;
+    pluginManager.loadPlugins(QString("pluginssrv"));
+    PluginAPI::ChannelRegistrations *channelRegistrations = pluginManager.getPluginAPI()->getRxChannelRegistrations();
+    PluginInterface *plugin = 0;
+
+    for (int i = 0; i < channelRegistrations->size(); i++)
+    {
+        if ((*channelRegistrations)[i].m_channelIdURI == config.m_channelIdURI)
+        {
+            plugin = (*channelRegistrations)[i].m_plugin;
+            break;
+        }
+    }
+
+    if (!plugin)
+    {
+        qWarning("MainBench::testDemod: channel plugin %s not found", config.m_channelIdURI);
+        return;
+    }
+
+    qDebug() << "MainBench::testDemod: create test data at " << sampleRate << " S/s";
+
+    SampleVector samples(m_parser.getNbSamples());
+    generateSignal(samples, config.m_signal, sampleRate, m_generator);
+    uint32_t blockSize = sampleRate / 10; // 100 ms as a device would deliver
+    qint64 nsecsOneChannel = 0;
+
+    for (uint32_t nbChannels = 1; ; nbChannels = 2*nbChannels > m_parser.getNbChannels() ? m_parser.getNbChannels() : 2*nbChannels)
+    {
+        qDebug() << "MainBench::testDemod: run test with " << nbChannels << " channel(s)";
+
+        DemodBenchDeviceSet deviceSet(plugin, testType, nbChannels);
+
+        if (!deviceSet.start(sampleRate)) {
+            return;
+        }
+
+        QElapsedTimer timer;
+        qint64 nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            deviceSet.feed(samples, blockSize);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        deviceSet.stop();
+
+        // channels run in parallel in their own threads: each one is reported with the time it actually spent on the samples
+        std::vector<DSPDeviceSourceEngine::SinkStats> sinksStats;
+        deviceSet.getStats(sinksStats);
+        double nsPerSampleSum = 0.0;
+        double nsPerSampleMax = 0.0;
+        unsigned int nbThreadedSinks = 0;
+
+        for (std::vector<DSPDeviceSourceEngine::SinkStats>::const_iterator it = sinksStats.begin(); it != sinksStats.end(); ++it)
+        {
+            if (!it->m_threaded) {
+                continue;
+            }
+
+            const SampleSinkFeedStats& feedStats = it->m_feedStats;
+            double nsPerSample = feedStats.m_nbSamples > 0 ? feedStats.m_processingTimeNs / (double) feedStats.m_nbSamples : 0.0;
+            nsPerSampleSum += nsPerSample;
+            nsPerSampleMax = nsPerSample > nsPerSampleMax ? nsPerSample : nsPerSampleMax;
+            nbThreadedSinks++;
+        }
+
+        double nbSamples = (double) m_parser.getNbSamples() * m_parser.getRepetition();
+        double nsPerSampleWall = nbSamples > 0 ? nsecs / nbSamples : 0.0;
+        double realTime = nsPerSampleWall > 0 ? 1e9 / (nsPerSampleWall * sampleRate) : 0.0;
+
+        if (nbChannels == 1) {
+            nsecsOneChannel = nsecs;
+        }
+
+        printResults(QString("MainBench::testDemod: %1 %2 channel(s)").arg(config.m_channelIdURI).arg(nbChannels), nsecs);
+        qInfo("MainBench::testDemod: %u channel(s): %.1f ns/sample %.1f x real time - per channel %.1f ns/sample (max %.1f) %.1f x real time - scaling %.0f%%",
+                nbChannels,
+                nsPerSampleWall,
+                realTime,
+                nbThreadedSinks > 0 ? nsPerSampleSum / nbThreadedSinks : 0.0,
+                nsPerSampleMax,
+                nsPerSampleSum > 0 ? (1e9 * nbThreadedSinks) / (nsPerSampleSum * sampleRate) : 0.0,
+                nsecs > 0 ? (100.0 * nsecsOneChannel) / nsecs : 0.0);
+
+        if (nbChannels == m_parser.getNbChannels()) {
+            break;
+        }
+    }
+}
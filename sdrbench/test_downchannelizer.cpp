@@ -0,0 +1,177 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+
+#include "dsp/downchannelizer.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/dspcommands.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Collects the channelizer output */
+class ChannelizerBenchSink : public BasebandSampleSink
+{
+public:
+    ChannelizerBenchSink() { setObjectName("ChannelizerBenchSink"); }
+    virtual ~ChannelizerBenchSink() {}
+
+    virtual void start() {}
+    virtual void stop() {}
+    virtual bool handleMessage(const Message& cmd __attribute__((unused))) { return true; }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
+    {
+        m_samples.insert(m_samples.end(), begin, end);
+    }
+
+    SampleVector m_samples;
+};
+
+/** Former sample by sample processing: one member function pointer call per stage and per sample */
+class ChannelizerBenchReference
+{
+public:
+#ifdef SDR_RX_SAMPLE_24BIT
+    typedef IntHalfbandFilterEO<qint64, qint64, DOWNCHANNELIZER_HB_FILTER_ORDER> Filter;
+#else
+    typedef IntHalfbandFilterEO<qint32, qint32, DOWNCHANNELIZER_HB_FILTER_ORDER> Filter;
+#endif
+    typedef bool (Filter::*WorkFunction)(Sample* s);
+
+    ChannelizerBenchReference(unsigned int nbStages) :
+        m_filters(nbStages)
+    {}
+
+    void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end)
+    {
+        WorkFunction workFunction = &Filter::workDecimateCenter;
+
+        for (SampleVector::const_iterator sample = begin; sample != end; ++sample)
+        {
+            Sample s(*sample);
+            std::vector<Filter>::iterator stage = m_filters.begin();
+
+            for (; stage != m_filters.end(); ++stage)
+            {
+                if (!((*stage).*workFunction)(&s)) {
+                    break;
+                }
+            }
+
+            if (stage == m_filters.end())
+            {
+                s.m_real /= (1<<(m_filters.size()));
+                s.m_imag /= (1<<(m_filters.size()));
+                m_samples.push_back(s);
+            }
+        }
+    }
+
+    std::vector<Filter> m_filters;
+    SampleVector m_samples;
+};
+
+} // namespace
+
+void MainBench::testDownChannelizer()
+{
+    qDebug() << "MainBench::testDownChannelizer: create test data";
+
+    const int inputSampleRate = 3072000;
+    int outputSampleRate = inputSampleRate >> m_parser.getLog2Factor();
+    uint blockSize = (1<<14) - 1; // about a device engine block. Odd so that the stages carry a sample over
+    SampleVector samples(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        it->setReal(my_rand());
+        it->setImag(my_rand());
+    }
+
+    qDebug() << "MainBench::testDownChannelizer: run test with output rate " << outputSampleRate;
+
+    QElapsedTimer timer;
+    qint64 nsecsReference = 0;
+    ChannelizerBenchReference *reference = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        delete reference;
+        reference = new ChannelizerBenchReference(m_parser.getLog2Factor());
+        reference->m_samples.reserve(samples.size());
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j += blockSize)
+        {
+            uint len = samples.size() - j < blockSize ? samples.size() - j : blockSize;
+            reference->feed(samples.begin() + j, samples.begin() + j + len);
+        }
+
+        nsecsReference += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testDownChannelizer: sample by sample", nsecsReference);
+
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
+
+    for (unsigned int l = 0; l < levels.size(); l++)
+    {
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        qint64 nsecsBlock = 0;
+        bool identical = true;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            ChannelizerBenchSink sink;
+            DownChannelizer channelizer(&sink);
+            channelizer.handleMessage(DSPSignalNotification(inputSampleRate, 0));
+            channelizer.handleMessage(DSPConfigureChannelizer(outputSampleRate, 0));
+            sink.m_samples.reserve(samples.size());
+
+            timer.start();
+
+            for (uint j = 0; j < samples.size(); j += blockSize)
+            {
+                uint len = samples.size() - j < blockSize ? samples.size() - j : blockSize;
+                channelizer.feed(samples.begin() + j, samples.begin() + j + len, false);
+            }
+
+            nsecsBlock += timer.nsecsElapsed();
+            identical = identical && (sink.m_samples.size() == reference->m_samples.size());
+
+            for (uint j = 0; identical && (j < sink.m_samples.size()); j++)
+            {
+                identical = (sink.m_samples[j].m_real == reference->m_samples[j].m_real)
+                    && (sink.m_samples[j].m_imag == reference->m_samples[j].m_imag);
+            }
+        }
+
+        printResults(QString("MainBench::testDownChannelizer: block %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecsBlock);
+        qInfo("MainBench::testDownChannelizer: block output at %s level %s sample by sample output",
+            CPUFeatures::getSIMDLevelName(levels[l]), identical ? "matches" : "DIFFERS from");
+    }
+
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+    delete reference;
+}
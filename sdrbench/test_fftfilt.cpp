@@ -0,0 +1,222 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <cmath>
+
+#include "dsp/fftfilt.h"
+#include "dsp/gfft.h"
+#include "mainbench.h"
+
+namespace {
+
+/** SSB filter as fftfilt did it before with the g_fft radix code, sample by sample. Reference for speed and results. */
+class LegacySSBFilter
+{
+public:
+    typedef std::complex<float> cmplx;
+
+    LegacySSBFilter(float f1, float f2, int len) :
+        m_flen(len),
+        m_flen2(len >> 1),
+        m_fft(len),
+        m_filter(len),
+        m_data(len),
+        m_output(len >> 1),
+        m_ovlbuf(len >> 1),
+        m_inptr(0)
+    {
+        for (int i = 0; i < m_flen2; i++) {
+            m_filter[i] = (fsinc(f2, i, m_flen2) - fsinc(f1, i, m_flen2)) * blackman(i, m_flen2);
+        }
+
+        m_fft.ComplexFFT(m_filter.data());
+        float scale = 0;
+
+        for (int i = 0; i < m_flen2; i++) {
+            scale = std::max(scale, std::abs(m_filter[i]));
+        }
+
+        for (int i = 0; i < m_flen; i++) {
+            m_filter[i] /= scale;
+        }
+    }
+
+    int runSSB(const cmplx& in, cmplx **out, bool usb)
+    {
+        m_data[m_inptr++] = in;
+
+        if (m_inptr < m_flen2) {
+            return 0;
+        }
+
+        m_inptr = 0;
+        m_fft.ComplexFFT(m_data.data());
+        m_data[0] *= m_filter[0];
+
+        for (int i = 1; i < m_flen2; i++)
+        {
+            if (usb) {
+                m_data[i] *= m_filter[i];
+                m_data[m_flen2 + i] = 0;
+            } else {
+                m_data[i] = 0;
+                m_data[m_flen2 + i] *= m_filter[m_flen2 + i];
+            }
+        }
+
+        m_fft.InverseComplexFFT(m_data.data());
+
+        for (int i = 0; i < m_flen2; i++)
+        {
+            m_output[i] = m_ovlbuf[i] + m_data[i];
+            m_ovlbuf[i] = m_data[i + m_flen2];
+        }
+
+        std::fill(m_data.begin(), m_data.end(), 0);
+        *out = m_output.data();
+        return m_flen2;
+    }
+
+private:
+    int m_flen;
+    int m_flen2;
+    g_fft<float> m_fft;
+    std::vector<cmplx> m_filter;
+    std::vector<cmplx> m_data;
+    std::vector<cmplx> m_output;
+    std::vector<cmplx> m_ovlbuf;
+    int m_inptr;
+
+    static float fsinc(float fc, int i, int len)
+    {
+        int len2 = len/2;
+        return (i == len2) ? 2.0 * fc : sin(2 * M_PI * fc * (i - len2)) / (M_PI * (i - len2));
+    }
+
+    static float blackman(int i, int len)
+    {
+        return 0.42 - 0.50 * cos(2.0 * M_PI * i / len) + 0.08 * cos(4.0 * M_PI * i / len);
+    }
+};
+
+double deviationdB(const std::vector<fftfilt::cmplx>& ref, const std::vector<fftfilt::cmplx>& other)
+{
+    std::size_t n = std::min(ref.size(), other.size());
+    double peak = 0.0, maxDiff = 0.0;
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        peak = std::max(peak, (double) std::abs(ref[i]));
+        maxDiff = std::max(maxDiff, (double) std::abs(ref[i] - other[i]));
+    }
+
+    return maxDiff == 0.0 ? -999.0 : 20.0 * log10(maxDiff / peak);
+}
+
+} // namespace
+
+void MainBench::testFFTFilt()
+{
+    qDebug() << "MainBench::testFFTFilt: create test data";
+
+    // SSB demodulator filter: 300 to 3000 Hz at 48 kS/s with a FFT of 1024
+    const float lowCutoff = 300.0f / 48000.0f;
+    const float highCutoff = 3000.0f / 48000.0f;
+    const int fftLen = 1024;
+    const int blockSize = 1<<10;
+    std::vector<fftfilt::cmplx> samples(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (std::vector<fftfilt::cmplx>::iterator it = samples.begin(); it != samples.end(); ++it) {
+        *it = fftfilt::cmplx(my_rand(), my_rand());
+    }
+
+    qDebug() << "MainBench::testFFTFilt: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecsLegacy = 0, nsecsSample = 0, nsecsBlock = 0, nsecsOverlapSave = 0;
+    std::vector<fftfilt::cmplx> legacyOutput, sampleOutput, blockOutput, overlapSaveOutput, out;
+    fftfilt::cmplx *sideband;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        LegacySSBFilter legacyFilter(lowCutoff, highCutoff, fftLen);
+        legacyOutput.clear();
+        timer.start();
+
+        for (std::size_t j = 0; j < samples.size(); j++)
+        {
+            int n_out = legacyFilter.runSSB(samples[j], &sideband, true);
+            legacyOutput.insert(legacyOutput.end(), sideband, sideband + n_out);
+        }
+
+        nsecsLegacy += timer.nsecsElapsed();
+
+        fftfilt sampleFilter(lowCutoff, highCutoff, fftLen);
+        sampleOutput.clear();
+        timer.start();
+
+        for (std::size_t j = 0; j < samples.size(); j++)
+        {
+            int n_out = sampleFilter.runSSB(samples[j], &sideband, true);
+            sampleOutput.insert(sampleOutput.end(), sideband, sideband + n_out);
+        }
+
+        nsecsSample += timer.nsecsElapsed();
+
+        fftfilt blockFilter(lowCutoff, highCutoff, fftLen);
+        blockOutput.clear();
+        timer.start();
+
+        for (std::size_t j = 0; j < samples.size(); j += blockSize)
+        {
+            int len = std::min(samples.size() - j, (std::size_t) blockSize);
+            int n_out = blockFilter.runSSB(&samples[j], len, out, true);
+            blockOutput.insert(blockOutput.end(), out.begin(), out.begin() + n_out);
+        }
+
+        nsecsBlock += timer.nsecsElapsed();
+
+        fftfilt overlapSaveFilter(lowCutoff, highCutoff, fftLen);
+        overlapSaveFilter.setOverlapSave(4*fftLen);
+        overlapSaveOutput.clear();
+        timer.start();
+
+        for (std::size_t j = 0; j < samples.size(); j += blockSize)
+        {
+            int len = std::min(samples.size() - j, (std::size_t) blockSize);
+            int n_out = overlapSaveFilter.runSSB(&samples[j], len, out, true);
+            overlapSaveOutput.insert(overlapSaveOutput.end(), out.begin(), out.begin() + n_out);
+        }
+
+        nsecsOverlapSave += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testFFTFilt: g_fft sample by sample", nsecsLegacy);
+    printResults("MainBench::testFFTFilt: FFT engine sample by sample", nsecsSample);
+    printResults("MainBench::testFFTFilt: FFT engine block", nsecsBlock);
+    printResults("MainBench::testFFTFilt: FFT engine block overlap-save x4", nsecsOverlapSave);
+
+    // overlap-add wraps the tails of the single sideband response and overlap-save does not
+    // so the later is only close to the others
+    qInfo("MainBench::testFFTFilt: deviation from g_fft: sample by sample: %.1f dB block: %.1f dB overlap-save: %.1f dB",
+        deviationdB(legacyOutput, sampleOutput),
+        deviationdB(legacyOutput, blockOutput),
+        deviationdB(legacyOutput, overlapSaveOutput));
+}
@@ -0,0 +1,160 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <cstring>
+
+#include "dsp/interpolators.h"
+#include "mainbench.h"
+
+namespace
+{
+
+const int nbChunks = 4; // consecutive buffers so that the filters history is checked too
+
+template<typename I, typename T>
+void interpolate(I& interpolators, unsigned int log2, SampleVector::iterator* it, T *buf, int len)
+{
+    switch (log2)
+    {
+    case 0:
+        interpolators.interpolate1(it, buf, len);
+        break;
+    case 1:
+        interpolators.interpolate2_cen(it, buf, len);
+        break;
+    case 2:
+        interpolators.interpolate4_cen(it, buf, len);
+        break;
+    case 3:
+        interpolators.interpolate8_cen(it, buf, len);
+        break;
+    case 4:
+        interpolators.interpolate16_cen(it, buf, len);
+        break;
+    case 5:
+        interpolators.interpolate32_cen(it, buf, len);
+        break;
+    case 6:
+        interpolators.interpolate64_cen(it, buf, len);
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+void MainBench::testInterpolateII()
+{
+    runInterpolateTest<qint16, 12>("MainBench::testInterpolateII");
+}
+
+void MainBench::testInterpolateII8()
+{
+    runInterpolateTest<qint8, 8>("MainBench::testInterpolateII8");
+}
+
+template<typename T, uint OutputBits>
+void MainBench::runInterpolateTest(const QString& prefix)
+{
+    typedef Interpolators<T, SDR_TX_SAMP_SZ, OutputBits> InterpolatorsType;
+    unsigned int log2 = m_parser.getLog2Factor();
+
+    if (log2 > InterpolatorsBlock::m_maxLog2)
+    {
+        qWarning() << prefix << ": interpolation by" << (1<<log2) << "is not supported";
+        return;
+    }
+
+    qDebug() << prefix << ": create test data";
+
+    SampleVector samples(m_parser.getNbSamples());
+    std::vector<T> buf(2*samples.size() << log2);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        it->setReal(my_rand() << 4); // full 16 bit range
+        it->setImag(my_rand() << 4);
+    }
+
+    qDebug() << prefix << ": run test";
+
+    QElapsedTimer timer;
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
+
+    for (unsigned int l = 0; l < levels.size(); l++)
+    {
+        InterpolatorsType *interpolators = new InterpolatorsType();
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        qint64 nsecs = 0;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            SampleVector::iterator it = samples.begin();
+            timer.start();
+            interpolate(*interpolators, log2, &it, buf.data(), buf.size());
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("%1: %2").arg(prefix).arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
+        delete interpolators;
+    }
+
+    // fresh scalar and SIMD instances fed with the same consecutive chunks
+    InterpolatorsType *scalar = new InterpolatorsType();
+    InterpolatorsType *simd = new InterpolatorsType();
+    int chunkSamples = samples.size() / nbChunks;
+    int chunkLen = 2*chunkSamples << log2;
+    std::vector<T> outScalar(chunkLen);
+    std::vector<T> outSIMD(chunkLen);
+    int mismatches = 0;
+
+    for (int c = 0; c < nbChunks; c++)
+    {
+        SampleVector::iterator itScalar = samples.begin() + c*chunkSamples;
+        SampleVector::iterator itSIMD = itScalar;
+
+        CPUFeatures::setMaxSIMDLevel(CPUFeatures::SIMDNone);
+        interpolate(*scalar, log2, &itScalar, outScalar.data(), chunkLen);
+        CPUFeatures::setMaxSIMDLevel(CPUFeatures::SIMDAVX2);
+        interpolate(*simd, log2, &itSIMD, outSIMD.data(), chunkLen);
+
+        if (itScalar != itSIMD)
+        {
+            mismatches += chunkLen;
+            continue;
+        }
+
+        for (int i = 0; i < chunkLen; i++) {
+            mismatches += outScalar[i] != outSIMD[i] ? 1 : 0;
+        }
+    }
+
+    delete simd;
+    delete scalar;
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << QString("%1: %2 mismatches over %3 values against the scalar path at %4 level")
+        .arg(prefix).arg(mismatches).arg(nbChunks*chunkLen).arg(CPUFeatures::getSIMDLevelName(CPUFeatures::getDetectedSIMDLevel()));
+}
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+#include "dsp/iqcorrector.h"
+#include "util/movingaverage.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Per sample correction as DSPDeviceSourceEngine::iqCorrections did it before (floating point version). Reference for speed and results. */
+class LegacyIQCorrector
+{
+public:
+    void process(SampleVector::iterator begin, SampleVector::iterator end, bool imbalanceCorrection)
+    {
+        for (SampleVector::iterator it = begin; it < end; it++)
+        {
+            m_iBeta(it->real());
+            m_qBeta(it->imag());
+
+            if (imbalanceCorrection)
+            {
+                float xi = (it->m_real - (int32_t) m_iBeta) / SDR_RX_SCALEF;
+                float xq = (it->m_imag - (int32_t) m_qBeta) / SDR_RX_SCALEF;
+
+                m_avgII(xi*xi);
+                m_avgIQ(xi*xq);
+
+                if (m_avgII.asDouble() != 0) {
+                    m_avgPhi(m_avgIQ.asDouble()/m_avgII.asDouble());
+                }
+
+                float& yi = xi;
+                float yq = xq - m_avgPhi.asDouble()*xi;
+
+                m_avgII2(yi*yi);
+                m_avgQQ2(yq*yq);
+
+                if (m_avgQQ2.asDouble() != 0) {
+                    m_avgAmp(sqrt(m_avgII2.asDouble() / m_avgQQ2.asDouble()));
+                }
+
+                float& zi = yi;
+                float zq = m_avgAmp.asDouble() * yq;
+
+                it->m_real = zi * SDR_RX_SCALEF;
+                it->m_imag = zq * SDR_RX_SCALEF;
+            }
+            else
+            {
+                it->m_real -= (int32_t) m_iBeta;
+                it->m_imag -= (int32_t) m_qBeta;
+            }
+        }
+    }
+
+private:
+    MovingAverageUtil<int32_t, int64_t, 1024> m_iBeta;
+    MovingAverageUtil<int32_t, int64_t, 1024> m_qBeta;
+    MovingAverageUtil<float, double, 128> m_avgII;
+    MovingAverageUtil<float, double, 128> m_avgIQ;
+    MovingAverageUtil<float, double, 128> m_avgII2;
+    MovingAverageUtil<float, double, 128> m_avgQQ2;
+    MovingAverageUtil<double, double, 128> m_avgPhi;
+    MovingAverageUtil<double, double, 128> m_avgAmp;
+};
+
+/** Ratio in dB of the image to the tone at frequency f (relative to the sample rate) over the second half of the samples */
+double imageRejectiondB(const SampleVector& samples, double f)
+{
+    std::complex<double> tone(0.0, 0.0), image(0.0, 0.0);
+
+    for (std::size_t i = samples.size()/2; i < samples.size(); i++)
+    {
+        std::complex<double> s(samples[i].real(), samples[i].imag());
+        std::complex<double> w = std::polar(1.0, -2.0 * M_PI * f * i);
+        tone += s * w;
+        image += s * std::conj(w);
+    }
+
+    return 20.0 * log10(std::abs(image) / std::abs(tone));
+}
+
+} // namespace
+
+void MainBench::testIQCorrection()
+{
+    qDebug() << "MainBench::testIQCorrection: create test data";
+
+    // tone at fs/10 with 10% amplitude and 5 degrees phase imbalance, DC offset and noise
+    const double f = 0.1;
+    const double amplitude = SDR_RX_SCALED / 4.0;
+    const double phase = 5.0 * M_PI / 180.0;
+    SampleVector samples(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (std::size_t i = 0; i < samples.size(); i++)
+    {
+        double a = 2.0 * M_PI * f * i;
+        double noiseI = my_rand() / 256.0;
+        double noiseQ = my_rand() / 256.0;
+        samples[i].setReal((FixReal) (amplitude * cos(a) + noiseI + SDR_RX_SCALED / 50.0));
+        samples[i].setImag((FixReal) (1.1 * amplitude * sin(a + phase) + noiseQ - SDR_RX_SCALED / 80.0));
+    }
+
+    qDebug() << "MainBench::testIQCorrection: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecsLegacyDC = 0, nsecsLegacyIQ = 0, nsecsBlockDC = 0, nsecsBlockIQ = 0;
+    SampleVector work;
+    double rejectionNone = imageRejectiondB(samples, f);
+    double rejectionLegacy = 0.0, rejectionBlock = 0.0;
+    const int blockSize = 1<<14; // typical device FIFO read
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        LegacyIQCorrector legacyDC, legacyIQ;
+        IQCorrector blockDC, blockIQ;
+
+        work = samples;
+        timer.start();
+        for (std::size_t j = 0; j < work.size(); j += blockSize) {
+            legacyDC.process(work.begin() + j, work.begin() + std::min(work.size(), j + blockSize), false);
+        }
+        nsecsLegacyDC += timer.nsecsElapsed();
+
+        work = samples;
+        timer.start();
+        for (std::size_t j = 0; j < work.size(); j += blockSize) {
+            legacyIQ.process(work.begin() + j, work.begin() + std::min(work.size(), j + blockSize), true);
+        }
+        nsecsLegacyIQ += timer.nsecsElapsed();
+        rejectionLegacy = imageRejectiondB(work, f);
+
+        work = samples;
+        timer.start();
+        for (std::size_t j = 0; j < work.size(); j += blockSize) {
+            blockDC.process(work.begin() + j, work.begin() + std::min(work.size(), j + blockSize), false);
+        }
+        nsecsBlockDC += timer.nsecsElapsed();
+
+        work = samples;
+        timer.start();
+        for (std::size_t j = 0; j < work.size(); j += blockSize) {
+            blockIQ.process(work.begin() + j, work.begin() + std::min(work.size(), j + blockSize), true);
+        }
+        nsecsBlockIQ += timer.nsecsElapsed();
+        rejectionBlock = imageRejectiondB(work, f);
+    }
+
+    printResults("MainBench::testIQCorrection: per sample DC", nsecsLegacyDC);
+    printResults("MainBench::testIQCorrection: per sample DC+IQ", nsecsLegacyIQ);
+    printResults("MainBench::testIQCorrection: block DC", nsecsBlockDC);
+    printResults("MainBench::testIQCorrection: block DC+IQ", nsecsBlockIQ);
+
+    qInfo("MainBench::testIQCorrection: image rejection: none: %.1f dB per sample: %.1f dB block: %.1f dB",
+        rejectionNone, rejectionLegacy, rejectionBlock);
+}
@@ -0,0 +1,96 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <cmath>
+
+#include "dsp/nco.h"
+#include "mainbench.h"
+
+void MainBench::testNCO()
+{
+    qDebug() << "MainBench::testNCO: create test data";
+
+    // sample rate and frequency are chosen so that the phase increment is exactly 0xABCDEF
+    // and the reference phase can be computed without rounding
+    const Real sampleRate = 65536.0f;
+    const quint32 phaseIncrement = 0x00ABCDEF;
+    const Real frequency = phaseIncrement / 65536.0f;
+    SampleVector samples(m_parser.getNbSamples());
+    std::vector<Complex> mixed(samples.size());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        it->setReal(my_rand());
+        it->setImag(my_rand());
+    }
+
+    qDebug() << "MainBench::testNCO: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecsBlock = 0;
+    qint64 nsecsSample = 0;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        NCO nco;
+        nco.setFreq(frequency, sampleRate);
+
+        timer.start();
+        nco.mixBlock(&samples[0], &mixed[0], samples.size());
+        nsecsBlock += timer.nsecsElapsed();
+
+        nco.setFreq(frequency, sampleRate);
+        nco.setPhase(0);
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j++)
+        {
+            Complex c(samples[j].real(), samples[j].imag());
+            c *= nco.nextIQ();
+            mixed[j] = c;
+        }
+
+        nsecsSample += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testNCO: block", nsecsBlock);
+    printResults("MainBench::testNCO: sample by sample", nsecsSample);
+
+    // spurious level: mix a unit tone and compare with the exact oscillator
+    NCO nco;
+    nco.setFreq(frequency, sampleRate);
+    std::vector<Complex> unit(samples.size(), Complex(1.0f, 0.0f));
+    nco.mixBlock(&unit[0], &mixed[0], unit.size());
+    quint32 phase = 0;
+    double maxError = 0.0;
+
+    for (uint j = 0; j < mixed.size(); j++)
+    {
+        phase += phaseIncrement;
+        double phi = (2.0 * M_PI * phase) / 4294967296.0;
+        double re = mixed[j].real() - cos(phi);
+        double im = mixed[j].imag() - sin(phi);
+        maxError = std::max(maxError, sqrt(re*re + im*im));
+    }
+
+    qInfo("MainBench::testNCO: block oscillator worst case error: %.1f dBc", 20.0 * log10(maxError));
+}
@@ -0,0 +1,225 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <complex>
+#include <cmath>
+
+#include "dsp/pfbchannelizer.h"
+#include "dsp/downchannelizer.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/dspcommands.h"
+#include "mainbench.h"
+
+namespace {
+
+/** Collects a channel output and, behind a DownChannelizer, the position of the channel in the output */
+class PFBBenchSink : public BasebandSampleSink
+{
+public:
+    PFBBenchSink() :
+        m_sampleRate(0),
+        m_frequencyOffset(0)
+    {
+        setObjectName("PFBBenchSink");
+    }
+
+    virtual ~PFBBenchSink() {}
+
+    virtual void start() {}
+    virtual void stop() {}
+
+    virtual bool handleMessage(const Message& cmd)
+    {
+        if (DownChannelizer::MsgChannelizerNotification::match(cmd))
+        {
+            const DownChannelizer::MsgChannelizerNotification& notif = (const DownChannelizer::MsgChannelizerNotification&) cmd;
+            m_sampleRate = notif.getSampleRate();
+            m_frequencyOffset = notif.getFrequencyOffset();
+        }
+
+        return true;
+    }
+
+    virtual void feed(const SampleVector::const_iterator& begin, const SampleVector::const_iterator& end, bool positiveOnly __attribute__((unused)))
+    {
+        m_samples.insert(m_samples.end(), begin, end);
+    }
+
+    SampleVector m_samples;
+    int m_sampleRate;         //!< DownChannelizer output sample rate
+    qint64 m_frequencyOffset; //!< channel center in the DownChannelizer output
+};
+
+/**
+ * Amplitude of the tone at frequency (Hz) in the second half of the samples (filters settled)
+ * and ratio in dB of its power to the power of everything else (neighbouring channels leakage)
+ */
+void measureTone(const SampleVector& samples, double frequency, int sampleRate, double& amplitude, double& sirDB)
+{
+    int start = samples.size() / 2;
+    int count = samples.size() - start;
+    std::complex<double> acc(0.0, 0.0);
+    double power = 0.0;
+
+    for (int i = start; i < (int) samples.size(); i++)
+    {
+        std::complex<double> s(samples[i].real(), samples[i].imag());
+        double phi = -2.0 * M_PI * frequency * i / sampleRate;
+        acc += s * std::complex<double>(cos(phi), sin(phi));
+        power += std::norm(s);
+    }
+
+    amplitude = count == 0 ? 0.0 : std::abs(acc) / count;
+    double tonePower = amplitude * amplitude;
+    double restPower = count == 0 ? 0.0 : power / count - tonePower;
+    sirDB = 10.0 * log10(tonePower / (restPower < 1e-3 ? 1e-3 : restPower));
+}
+
+} // namespace
+
+void MainBench::testPFBChannelizer()
+{
+    int nbChannels = m_parser.getNbChannels() < 4 ? 16 : m_parser.getNbChannels();
+    nbChannels += nbChannels % 2; // as the oversampled filter bank
+    const int spacing = 25000;
+    const int inputSampleRate = nbChannels * spacing;
+    const double toneShift = spacing / 8.0; // within the passband of both channelizers
+    uint blockSize = (1<<14) - 1; // about a device engine block
+    SampleVector samples(m_parser.getNbSamples());
+    std::vector<double> amplitudes(nbChannels);
+
+    qDebug() << "MainBench::testPFBChannelizer: create test data with one tone per channel for" << nbChannels << "channels";
+
+    for (int c = 0; c < nbChannels; c++) { // different level in each channel. Total fits the 16 bit range
+        amplitudes[c] = (0.9 * 32767.0 / nbChannels) * (0.25 + (0.75 * c) / nbChannels);
+    }
+
+    for (uint i = 0; i < samples.size(); i++)
+    {
+        std::complex<double> s(0.0, 0.0);
+
+        for (int c = 0; c < nbChannels; c++)
+        {
+            double f = (c - nbChannels/2) * spacing + toneShift;
+            double phi = 2.0 * M_PI * f * i / inputSampleRate + c; // arbitrary phase per channel
+            s += amplitudes[c] * std::complex<double>(cos(phi), sin(phi));
+        }
+
+        samples[i].setReal((FixReal) s.real());
+        samples[i].setImag((FixReal) s.imag());
+    }
+
+    QElapsedTimer timer;
+    qint64 nsecs;
+    std::vector<PFBBenchSink> sinks(nbChannels);
+
+    // one DownChannelizer per channel
+
+    nsecs = 0;
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        std::vector<DownChannelizer*> channelizers(nbChannels);
+
+        for (int c = 0; c < nbChannels; c++)
+        {
+            sinks[c].m_samples.clear();
+            channelizers[c] = new DownChannelizer(&sinks[c]);
+            channelizers[c]->handleMessage(DSPSignalNotification(inputSampleRate, 0));
+            channelizers[c]->handleMessage(DSPConfigureChannelizer(2*spacing, (c - nbChannels/2) * spacing));
+        }
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j += blockSize)
+        {
+            uint len = samples.size() - j < blockSize ? samples.size() - j : blockSize;
+
+            for (int c = 0; c < nbChannels; c++) {
+                channelizers[c]->feed(samples.begin() + j, samples.begin() + j + len, false);
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+
+        for (int c = 0; c < nbChannels; c++) {
+            delete channelizers[c];
+        }
+    }
+
+    printResults(QString("MainBench::testPFBChannelizer: %1 DownChannelizer").arg(nbChannels), nsecs);
+    double maxErrorDB = 0.0;
+    double minSIRDB = 1000.0;
+    int maxSampleRate = 0;
+
+    for (int c = 0; c < nbChannels; c++) // the output band is often wider than the channel so no leakage figure here
+    {
+        double amplitude, sirDB;
+        measureTone(sinks[c].m_samples, sinks[c].m_frequencyOffset + toneShift, sinks[c].m_sampleRate, amplitude, sirDB);
+        double errorDB = fabs(20.0 * log10(amplitude / amplitudes[c]));
+        maxErrorDB = errorDB > maxErrorDB ? errorDB : maxErrorDB;
+        maxSampleRate = sinks[c].m_sampleRate > maxSampleRate ? sinks[c].m_sampleRate : maxSampleRate;
+    }
+
+    qInfo("MainBench::testPFBChannelizer: DownChannelizer: max level error %.2f dB max output rate %d S/s", maxErrorDB, maxSampleRate);
+
+    // filter bank with all channels subscribed
+
+    nsecs = 0;
+    int channelSampleRate = 0;
+
+    for (uint32_t r = 0; r < m_parser.getRepetition(); r++)
+    {
+        PFBChannelizer pfb(nbChannels, true);
+        pfb.handleMessage(DSPSignalNotification(inputSampleRate, 0));
+        channelSampleRate = pfb.getChannelSampleRate();
+
+        for (int c = 0; c < nbChannels; c++)
+        {
+            sinks[c].m_samples.clear();
+            pfb.addSubscriber(c, &sinks[c]);
+        }
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j += blockSize)
+        {
+            uint len = samples.size() - j < blockSize ? samples.size() - j : blockSize;
+            pfb.feed(samples.begin() + j, samples.begin() + j + len, false);
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults(QString("MainBench::testPFBChannelizer: filter bank of %1 channels").arg(nbChannels), nsecs);
+    maxErrorDB = 0.0;
+
+    for (int c = 0; c < nbChannels; c++)
+    {
+        double amplitude, sirDB;
+        measureTone(sinks[c].m_samples, toneShift, channelSampleRate, amplitude, sirDB);
+        double errorDB = fabs(20.0 * log10(amplitude / amplitudes[c]));
+        maxErrorDB = errorDB > maxErrorDB ? errorDB : maxErrorDB;
+        minSIRDB = sirDB < minSIRDB ? sirDB : minSIRDB;
+    }
+
+    qInfo("MainBench::testPFBChannelizer: filter bank: max level error %.2f dB min signal to neighbours %.1f dB output rate %d S/s",
+        maxErrorDB, minSIRDB, channelSampleRate);
+}
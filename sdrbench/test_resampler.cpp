@@ -0,0 +1,108 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+#include <cmath>
+
+#include "dsp/interpolator.h"
+#include "dsp/polyphaseresampler.h"
+#include "mainbench.h"
+
+void MainBench::testResampler()
+{
+    qDebug() << "MainBench::testResampler: create test data";
+
+    // typical NFM channel: 200 kS/s channel to 48 kS/s audio with 5 kHz RF bandwidth
+    const int inputSampleRate = 200000;
+    const int outputSampleRate = 48000;
+    const Real cutoff = 5000 / 2.2f;
+    int blockSize = 1<<12;
+    std::vector<Complex> samples(m_parser.getNbSamples());
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (std::vector<Complex>::iterator it = samples.begin(); it != samples.end(); ++it) {
+        *it = Complex(my_rand(), my_rand());
+    }
+
+    qDebug() << "MainBench::testResampler: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecsBlock = 0;
+    qint64 nsecsInterpolator = 0;
+    std::vector<Complex> blockOutput;
+    std::vector<Complex> interpolatorOutput;
+    std::vector<Complex> out;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        PolyphaseResampler resampler;
+        resampler.create(16, inputSampleRate, outputSampleRate, cutoff);
+        blockOutput.clear();
+        blockOutput.reserve(samples.size());
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j += blockSize)
+        {
+            int len = samples.size() - j < (uint) blockSize ? samples.size() - j : blockSize;
+            int nbOutput = resampler.resample(&samples[j], len, out);
+            blockOutput.insert(blockOutput.end(), out.begin(), out.begin() + nbOutput);
+        }
+
+        nsecsBlock += timer.nsecsElapsed();
+
+        Interpolator interpolator;
+        interpolator.create(16, inputSampleRate, cutoff);
+        Real distance = (Real) inputSampleRate / (Real) outputSampleRate;
+        Real distanceRemain = 1.0; // first output on first input like the resampler
+        Complex ci;
+        interpolatorOutput.clear();
+        interpolatorOutput.reserve(samples.size());
+
+        timer.start();
+
+        for (uint j = 0; j < samples.size(); j++)
+        {
+            if (interpolator.decimate(&distanceRemain, samples[j], &ci))
+            {
+                interpolatorOutput.push_back(ci);
+                distanceRemain += distance;
+            }
+        }
+
+        nsecsInterpolator += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testResampler: block", nsecsBlock);
+    printResults("MainBench::testResampler: Interpolator::decimate", nsecsInterpolator);
+
+    // the Interpolator distance accumulates rounding errors so it may pick a neighbouring phase
+    std::size_t nbCompared = std::min(blockOutput.size(), interpolatorOutput.size());
+    double maxDiff = 0.0;
+
+    for (std::size_t j = 0; j < nbCompared; j++) {
+        maxDiff = std::max(maxDiff, (double) std::abs(blockOutput[j] - interpolatorOutput[j]));
+    }
+
+    qInfo("MainBench::testResampler: outputs: block: %lu expected: %lu Interpolator: %lu max deviation: %.1f dB",
+        blockOutput.size(),
+        (samples.size() * outputSampleRate) / inputSampleRate,
+        interpolatorOutput.size(),
+        20.0 * log10(maxDiff / 32768.0));
+}
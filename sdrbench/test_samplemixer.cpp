@@ -0,0 +1,121 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <vector>
+
+#include "dsp/samplemixer.h"
+#include "mainbench.h"
+
+void MainBench::testSampleMixer()
+{
+    unsigned int nbSources = m_parser.getNbChannels() < 2 ? 2 : m_parser.getNbChannels();
+    unsigned int nbSamples = m_parser.getNbSamples();
+
+    qDebug() << "MainBench::testSampleMixer: create test data for" << nbSources << "sources";
+
+    std::vector<SampleVector> sources(nbSources, SampleVector(nbSamples));
+    std::vector<const Sample*> sourcePtrs(nbSources);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (unsigned int s = 0; s < nbSources; s++)
+    {
+        for (SampleVector::iterator it = sources[s].begin(); it != sources[s].end(); ++it)
+        {
+            it->setReal(my_rand() << 4); // full 16 bit range
+            it->setImag(my_rand() << 4);
+        }
+
+        sourcePtrs[s] = sources[s].data();
+    }
+
+    qDebug() << "MainBench::testSampleMixer: run test";
+
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    SampleVector out(nbSamples);
+    unsigned int divisionFactor = nbSources < 3 ? nbSources : 1<<nbSources; // as DSPDeviceSinkEngine
+
+    // sample by sample loop that the mixer replaces
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        timer.start();
+
+        for (unsigned int is = 0; is < nbSamples; is++)
+        {
+            for (unsigned int s = 0; s < nbSources; s++)
+            {
+                Sample sample = sources[s][is];
+                sample /= divisionFactor;
+
+                if (s == 0) {
+                    out[is] = sample;
+                } else {
+                    out[is] += sample;
+                }
+            }
+        }
+
+        nsecs += timer.nsecsElapsed();
+    }
+
+    printResults("MainBench::testSampleMixer: sample by sample", nsecs);
+
+    CPUFeatures::SIMDLevel maxLevel = CPUFeatures::getMaxSIMDLevel();
+    std::vector<CPUFeatures::SIMDLevel> levels = getSIMDLevels();
+    std::vector<SampleVector> outLevels(levels.size(), SampleVector(nbSamples));
+
+    for (unsigned int l = 0; l < levels.size(); l++)
+    {
+        SampleMixer mixer;
+        mixer.setNbSources(nbSources);
+        CPUFeatures::setMaxSIMDLevel(levels[l]);
+        nsecs = 0;
+
+        for (unsigned int s = 0; s < nbSources; s++) {
+            mixer.setGain(s, (1.0f + 0.25f*s) / divisionFactor); // different gains per source
+        }
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            timer.start();
+            mixer.mix(sourcePtrs.data(), outLevels[l].data(), nbSamples);
+            nsecs += timer.nsecsElapsed();
+        }
+
+        printResults(QString("MainBench::testSampleMixer: %1").arg(CPUFeatures::getSIMDLevelName(levels[l])), nsecs);
+    }
+
+    CPUFeatures::setMaxSIMDLevel(maxLevel);
+    int mismatches = 0;
+
+    for (unsigned int l = 1; l < levels.size(); l++)
+    {
+        for (unsigned int is = 0; is < nbSamples; is++)
+        {
+            if ((outLevels[l][is].real() != outLevels[0][is].real()) || (outLevels[l][is].imag() != outLevels[0][is].imag())) {
+                mismatches++;
+            }
+        }
+    }
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << QString("MainBench::testSampleMixer: %1 mismatches over %2 samples against the scalar path at %3 level")
+        .arg(mismatches).arg(nbSamples).arg(CPUFeatures::getSIMDLevelName(CPUFeatures::getDetectedSIMDLevel()));
+}
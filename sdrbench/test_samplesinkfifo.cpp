@@ -0,0 +1,210 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QThread>
+#include <cmath>
+
+#include "dsp/samplesinkfifo.h"
+#include "dsp/samplesinkfifospsc.h"
+#include "mainbench.h"
+
+namespace {
+
+struct FifoCallStats
+{
+    FifoCallStats() : m_calls(0), m_sum(0.0), m_sum2(0.0), m_max(0) {}
+
+    void add(qint64 nsecs)
+    {
+        m_calls++;
+        m_sum += nsecs;
+        m_sum2 += ((double) nsecs) * nsecs;
+        m_max = nsecs > m_max ? nsecs : m_max;
+    }
+
+    double mean() const { return m_calls ? m_sum / m_calls : 0.0; }
+    double stddev() const { return m_calls ? sqrt(m_sum2 / m_calls - mean()*mean()) : 0.0; }
+
+    quint64 m_calls;
+    double m_sum;
+    double m_sum2;
+    qint64 m_max;
+};
+
+template<typename Fifo>
+class FifoBenchProducer : public QThread
+{
+public:
+    FifoBenchProducer(Fifo *fifo, const SampleVector& samples, quint64 nbSamples, uint blockSize) :
+        m_fifo(fifo),
+        m_samples(samples),
+        m_nbSamples(nbSamples),
+        m_blockSize(blockSize)
+    {}
+
+    const FifoCallStats& getStats() const { return m_stats; }
+
+protected:
+    virtual void run()
+    {
+        QElapsedTimer timer;
+        quint64 done = 0;
+
+        while (done < m_nbSamples)
+        {
+            uint len = m_nbSamples - done < m_blockSize ? m_nbSamples - done : m_blockSize;
+
+            while (m_fifo->size() - m_fifo->fill() < len) { // measure transfers only: wait for room instead of dropping
+                QThread::yieldCurrentThread();
+            }
+
+            timer.start();
+            uint written = m_fifo->write(m_samples.begin(), m_samples.begin() + len);
+            m_stats.add(timer.nsecsElapsed());
+            done += written;
+        }
+    }
+
+private:
+    Fifo *m_fifo;
+    const SampleVector& m_samples;
+    quint64 m_nbSamples;
+    uint m_blockSize;
+    FifoCallStats m_stats;
+};
+
+template<typename Fifo>
+class FifoBenchConsumer : public QThread
+{
+public:
+    FifoBenchConsumer(Fifo *fifo, quint64 nbSamples) :
+        m_fifo(fifo),
+        m_nbSamples(nbSamples),
+        m_checksum(0)
+    {}
+
+    const FifoCallStats& getStats() const { return m_stats; }
+    qint64 getChecksum() const { return m_checksum; }
+
+protected:
+    virtual void run()
+    {
+        QElapsedTimer timer;
+        quint64 done = 0;
+
+        while (done < m_nbSamples)
+        {
+            uint fill = m_fifo->fill();
+
+            if (fill == 0)
+            {
+                QThread::yieldCurrentThread();
+                continue;
+            }
+
+            SampleVector::iterator part1begin;
+            SampleVector::iterator part1end;
+            SampleVector::iterator part2begin;
+            SampleVector::iterator part2end;
+
+            timer.start();
+            uint count = m_fifo->readBegin(fill, &part1begin, &part1end, &part2begin, &part2end);
+
+            if (part1begin != part1end) { // touch the data as a sink would
+                m_checksum += part1begin->m_real;
+            }
+            if (part2begin != part2end) {
+                m_checksum += part2begin->m_real;
+            }
+
+            m_fifo->readCommit(count);
+            m_stats.add(timer.nsecsElapsed());
+            done += count;
+        }
+    }
+
+private:
+    Fifo *m_fifo;
+    quint64 m_nbSamples;
+    qint64 m_checksum;
+    FifoCallStats m_stats;
+};
+
+} // namespace
+
+void MainBench::testSampleSinkFifo()
+{
+    qDebug() << "MainBench::testSampleSinkFifo: create test data";
+
+    uint blockSize = 1<<(m_parser.getLog2Factor() + 10);
+    SampleVector samples(blockSize);
+    auto my_rand = std::bind(m_uniform_distribution_s16, m_generator);
+
+    for (SampleVector::iterator it = samples.begin(); it != samples.end(); ++it)
+    {
+        it->setReal(my_rand());
+        it->setImag(my_rand());
+    }
+
+    qDebug() << "MainBench::testSampleSinkFifo: run test with block size " << blockSize;
+
+    SampleSinkFifo sampleSinkFifo(1<<18);
+    runSampleSinkFifoTest<SampleSinkFifo>("MainBench::testSampleSinkFifo: mutex", &sampleSinkFifo, samples);
+
+    SampleSinkFifoSPSC sampleSinkFifoSPSC(1<<18);
+    runSampleSinkFifoTest<SampleSinkFifoSPSC>("MainBench::testSampleSinkFifo: lock free", &sampleSinkFifoSPSC, samples);
+}
+
+template<typename Fifo>
+void MainBench::runSampleSinkFifoTest(const QString& prefix, Fifo *fifo, const SampleVector& samples)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    quint64 nbSamples = m_parser.getNbSamples();
+    FifoCallStats producerStats;
+    FifoCallStats consumerStats;
+
+    for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+    {
+        FifoBenchProducer<Fifo> producer(fifo, samples, nbSamples, samples.size());
+        FifoBenchConsumer<Fifo> consumer(fifo, nbSamples);
+
+        timer.start();
+        consumer.start();
+        producer.start();
+        producer.wait();
+        consumer.wait();
+        nsecs += timer.nsecsElapsed();
+
+        if (i == 0) // keep stats of the first run only
+        {
+            producerStats = producer.getStats();
+            consumerStats = consumer.getStats();
+        }
+    }
+
+    printResults(prefix, nsecs);
+
+    QDebug info = qInfo();
+    info.noquote();
+    info << tr("%1: write: %2 calls mean %3 ns stddev %4 ns max %5 ns - read: %6 calls mean %7 ns stddev %8 ns max %9 ns")
+        .arg(prefix)
+        .arg(producerStats.m_calls).arg(producerStats.mean(), 0, 'f', 1).arg(producerStats.stddev(), 0, 'f', 1).arg(producerStats.m_max)
+        .arg(consumerStats.m_calls).arg(consumerStats.mean(), 0, 'f', 1).arg(consumerStats.stddev(), 0, 'f', 1).arg(consumerStats.m_max);
+}
@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QUdpSocket>
+#include <QHostAddress>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <time.h>
+#endif
+
+#include "util/udpbatchsender.h"
+#include "mainbench.h"
+
+#if defined(__linux__)
+
+namespace {
+
+/** Counts the datagrams received on a loopback socket until stopped */
+class UDPBatchReceiver
+{
+public:
+    UDPBatchReceiver() : m_fd(-1), m_port(0), m_stop(false), m_nbReceived(0)
+    {
+        m_fd = socket(AF_INET, SOCK_DGRAM, 0);
+        int rcvBuf = 1<<24;
+        setsockopt(m_fd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+        struct timeval tv = {0, 100000};
+        setsockopt(m_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_fd, (struct sockaddr *) &addr, sizeof(addr));
+        socklen_t len = sizeof(addr);
+        getsockname(m_fd, (struct sockaddr *) &addr, &len);
+        m_port = ntohs(addr.sin_port);
+        m_thread = std::thread(&UDPBatchReceiver::run, this);
+    }
+
+    ~UDPBatchReceiver()
+    {
+        m_stop = true;
+        m_thread.join();
+        close(m_fd);
+    }
+
+    quint16 getPort() const { return m_port; }
+    quint64 getNbReceived() const { return m_nbReceived; }
+    void reset() { m_nbReceived = 0; }
+
+private:
+    int m_fd;
+    quint16 m_port;
+    std::atomic<bool> m_stop;
+    std::atomic<quint64> m_nbReceived;
+    std::thread m_thread;
+
+    void run()
+    {
+        char buf[65536];
+
+        while (!m_stop)
+        {
+            if (recv(m_fd, buf, sizeof(buf), 0) > 0) {
+                m_nbReceived++;
+            }
+        }
+    }
+};
+
+qint64 threadCPUNanoseconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+} // namespace
+
+#endif
+
+void MainBench::testUDPBatch()
+{
+#if defined(__linux__)
+    qDebug() << "MainBench::testUDPBatch: create test data";
+
+    // same framing as the daemon sink: frames of 128 data + 8 FEC blocks of 512 bytes
+    const int datagramSize = 512;
+    const int datagramsPerFrame = 136;
+    int nbFrames = m_parser.getNbSamples() / datagramsPerFrame;
+    nbFrames = nbFrames < 1 ? 1 : nbFrames;
+    std::vector<char> frame(datagramSize * datagramsPerFrame);
+
+    for (std::size_t i = 0; i < frame.size(); i++) {
+        frame[i] = (char) i;
+    }
+
+    UDPBatchReceiver receiver;
+    QHostAddress loopback(QHostAddress::LocalHost);
+    QUdpSocket socket;
+
+    qDebug() << "MainBench::testUDPBatch: run test with" << nbFrames << "frames of" << datagramsPerFrame << "datagrams to port" << receiver.getPort();
+
+    for (int mode = 0; mode < 3; mode++)
+    {
+        UDPBatchSender sender(&socket);
+        sender.setDestination(loopback, receiver.getPort());
+        sender.setUseGSO(mode == 2);
+        receiver.reset();
+        quint64 nbSent = 0;
+        qint64 nsecs = 0;
+        qint64 cpuNsecs = 0;
+        QElapsedTimer timer;
+
+        for (uint32_t i = 0; i < m_parser.getRepetition(); i++)
+        {
+            qint64 cpuStart = threadCPUNanoseconds();
+            timer.start();
+
+            for (int f = 0; f < nbFrames; f++)
+            {
+                if (mode == 0) // what the daemon sink used to do
+                {
+                    for (int j = 0; j < datagramsPerFrame; j++)
+                    {
+                        if (socket.writeDatagram(&frame[j*datagramSize], datagramSize, loopback, receiver.getPort()) == datagramSize) {
+                            nbSent++;
+                        }
+                    }
+                }
+                else
+                {
+                    nbSent += sender.send(frame.data(), datagramSize, datagramsPerFrame);
+                }
+            }
+
+            nsecs += timer.nsecsElapsed();
+            cpuNsecs += threadCPUNanoseconds() - cpuStart;
+        }
+
+        usleep(200000); // let the receiver drain its buffer
+        const char *modeStr = mode == 0 ? "writeDatagram" : mode == 1 ? "sendmmsg" : "GSO";
+        quint64 nbCalls = mode == 0 ? nbFrames * datagramsPerFrame * m_parser.getRepetition() : sender.getNbSystemCalls();
+        double kdgs = (nbSent / (double) nsecs) * 1e6;
+
+        qInfo("MainBench::testUDPBatch: %s: sent: %llu received: %llu in %lld ns - %.1f kdatagrams/s - sender CPU: %.1f%% - datagrams per system call: %.1f%s",
+            modeStr,
+            nbSent,
+            receiver.getNbReceived(),
+            nsecs,
+            kdgs,
+            (100.0 * cpuNsecs) / nsecs,
+            nbCalls == 0 ? 0.0 : nbSent / (double) nbCalls,
+            (mode == 2) && !sender.getUseGSO() ? " (GSO not supported: fell back to sendmmsg)" : "");
+    }
+#else
+    qInfo("MainBench::testUDPBatch: batched UDP transmission is only available on Linux");
+#endif
+}
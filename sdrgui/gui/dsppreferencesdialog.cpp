@@ -0,0 +1,45 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "dsppreferencesdialog.h"
+#include "ui_dsppreferencesdialog.h"
+
+DSPPreferencesDialog::DSPPreferencesDialog(MainSettings& mainSettings, QWidget* parent) :
+    QDialog(parent),
+    ui(new Ui::DSPPreferencesDialog),
+    m_mainSettings(mainSettings)
+{
+    ui->setupUi(this);
+    ui->fftwPrePlanning->setChecked(m_mainSettings.getFFTWPrePlanning());
+    ui->dspSchedulerThreads->setValue(m_mainSettings.getDSPSchedulerThreads());
+    ui->dspSchedulerPinCores->setChecked(m_mainSettings.getDSPSchedulerPinCores());
+    ui->recordDirectIO->setChecked(m_mainSettings.getRecordDirectIO());
+}
+
+DSPPreferencesDialog::~DSPPreferencesDialog()
+{
+    delete ui;
+}
+
+void DSPPreferencesDialog::accept()
+{
+    m_mainSettings.setFFTWPrePlanning(ui->fftwPrePlanning->isChecked());
+    m_mainSettings.setDSPSchedulerThreads(ui->dspSchedulerThreads->value());
+    m_mainSettings.setDSPSchedulerPinCores(ui->dspSchedulerPinCores->isChecked());
+    m_mainSettings.setRecordDirectIO(ui->recordDirectIO->isChecked());
+    QDialog::accept();
+}
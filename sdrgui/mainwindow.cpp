@@ -47,6 +47,7 @@
 #include "gui/channelwindow.h"
 #include "gui/audiodialog.h"
 #include "gui/loggingdialog.h"
+#include "gui/dsppreferencesdialog.h"
 #include "gui/samplingdevicecontrol.h"
 #include "gui/mypositiondialog.h"
 #include "dsp/dspengine.h"
@@ -62,6 +63,7 @@
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptergui.h"
 #include "commands/command.h"
+#include "util/threadroles.h"
 
 #include "mainwindow.h"
 
@@ -168,6 +170,17 @@ MainWindow::MainWindow(qtwebapp::LoggerWithFile *logger, const MainParser& parse
 
 	loadSettings();
 
+    for (QStringList::const_iterator it = parser.getThreadRoles().begin(); it != parser.getThreadRoles().end(); ++it) {
+        ThreadRoles::setRole(*it); // command line overrides the preferences
+    }
+
+    if (parser.hasDSPThreads() || parser.getDSPPinCores()) // command line overrides the preferences
+    {
+        m_dspEngine->setDSPScheduler(
+            parser.hasDSPThreads() ? parser.getDSPThreads() : m_settings.getDSPSchedulerThreads(),
+            parser.getDSPPinCores() || m_settings.getDSPSchedulerPinCores());
+    }
+
     qDebug() << "MainWindow::MainWindow: load plugins...";
 
     m_pluginManager = new PluginManager(this);
@@ -564,6 +577,10 @@ void MainWindow::loadSettings()
     }
 
     setLoggingOptions();
+    m_dspEngine->setFFTWPrePlanning(m_settings.getFFTWPrePlanning());
+    m_dspEngine->setDSPScheduler(m_settings.getDSPSchedulerThreads(), m_settings.getDSPSchedulerPinCores());
+    m_dspEngine->setRecordDirectIO(m_settings.getRecordDirectIO());
+    ThreadRoles::deserialize(m_settings.getThreadRoles());
 }
 
 void MainWindow::loadPresetSettings(const Preset* preset, int tabIndex)
@@ -1439,6 +1456,18 @@ void MainWindow::on_action_My_Position_triggered()
 	myPositionDialog.exec();
 }
 
+void MainWindow::on_action_DSP_triggered()
+{
+    DSPPreferencesDialog dspPreferencesDialog(m_settings, this);
+
+    if (dspPreferencesDialog.exec() == QDialog::Accepted)
+    {
+        m_dspEngine->setFFTWPrePlanning(m_settings.getFFTWPrePlanning());
+        m_dspEngine->setDSPScheduler(m_settings.getDSPSchedulerThreads(), m_settings.getDSPSchedulerPinCores());
+        m_dspEngine->setRecordDirectIO(m_settings.getRecordDirectIO());
+    }
+}
+
 void MainWindow::on_action_DV_Serial_triggered(bool checked)
 {
     m_dspEngine->setDVSerialSupport(checked);
@@ -68,6 +68,7 @@ SOURCES += mainwindow.cpp\
         gui/indicator.cpp\
         gui/levelmeter.cpp\
         gui/loggingdialog.cpp\
+        gui/dsppreferencesdialog.cpp\
         gui/pluginsdialog.cpp\
         gui/audiodialog.cpp\
         gui/audioselectdialog.cpp\
@@ -118,6 +119,7 @@ HEADERS  += mainwindow.h\
         gui/indicator.h\
         gui/levelmeter.h\
         gui/loggingdialog.h\
+        gui/dsppreferencesdialog.h\
         gui/physicalunit.h\
         gui/pluginsdialog.h\
         gui/presetitem.h\
@@ -151,6 +153,7 @@ FORMS    += mainwindow.ui\
         gui/samplingdevicedialog.ui\
         gui/myposdialog.ui\
         gui/loggingdialog.ui\
+        gui/dsppreferencesdialog.ui\
         gui/glspectrumgui.ui\
         gui/transverterdialog.ui\
         mainwindow.ui
@@ -31,11 +31,15 @@
 #include "device/deviceenumerator.h"
 #include "dsp/devicesamplesource.h"
 #include "dsp/devicesamplesink.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/basebandsamplesource.h"
+#include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspengine.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
 #include "channel/channelsinkapi.h"
 #include "channel/channelsourceapi.h"
+#include "util/threadroles.h"
 
 #include "SWGInstanceSummaryResponse.h"
 #include "SWGInstanceDevicesResponse.h"
@@ -43,6 +47,7 @@
 #include "SWGDeviceListItem.h"
 #include "SWGAudioDevices.h"
 #include "SWGLocationInformation.h"
+#include "SWGThreadRoles.h"
 #include "SWGDVSeralDevices.h"
 #include "SWGDVSerialDevice.h"
 #include "SWGPresets.h"
@@ -56,6 +61,7 @@
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
+#include "SWGDSPSinkStats.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
@@ -506,6 +512,34 @@ int WebAPIAdapterGUI::instanceLocationPut(
     return 200;
 }
 
+int WebAPIAdapterGUI::instanceThreadRolesGet(
+        SWGSDRangel::SWGThreadRoles& response,
+        SWGSDRangel::SWGErrorResponse& error __attribute__((unused)))
+{
+    ThreadRoles::webapiFormat(response);
+    return 200;
+}
+
+int WebAPIAdapterGUI::instanceThreadRolesPatch(
+        const QList<QStringList>& rolesKeys,
+        SWGSDRangel::SWGThreadRoles& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    QString errorMessage;
+
+    if (!ThreadRoles::webapiUpdate(rolesKeys, response, errorMessage))
+    {
+        error.init();
+        *error.getMessage() = errorMessage;
+        return 400;
+    }
+
+    m_mainWindow.m_settings.setThreadRoles(ThreadRoles::serialize());
+    ThreadRoles::webapiFormat(response);
+
+    return 200;
+}
+
 int WebAPIAdapterGUI::instanceDVSerialGet(
             SWGSDRangel::SWGDVSeralDevices& response,
             SWGSDRangel::SWGErrorResponse& error __attribute__((unused)))
@@ -1453,7 +1487,14 @@ int WebAPIAdapterGUI::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setTx(1);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int status = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+                if (source && (status/100 == 2)) {
+                    response.setMixerGain(source->getMixerGain());
+                }
+
+                return status;
             }
         }
         else
@@ -1496,7 +1537,20 @@ int WebAPIAdapterGUI::devicesetChannelReportGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setTx(0);
-                return channelAPI->webapiReportGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiReportGet(response, *error.getMessage());
+
+                if (httpRC / 100 == 2)
+                {
+                    response.setDspStats(new SWGSDRangel::SWGDSPSinkStats());
+
+                    if (!deviceSet->m_deviceSourceEngine->webapiFormatChannelStats(*response.getDspStats(), dynamic_cast<BasebandSampleSink*>(channelAPI)))
+                    {
+                        delete response.getDspStats();
+                        response.setDspStats(0);
+                    }
+                }
+
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceSinkEngine) // Tx
@@ -1587,7 +1641,19 @@ int WebAPIAdapterGUI::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+                    if (source && channelSettingsKeys.contains("mixerGain")) {
+                        source->setMixerGain(response.getMixerGain());
+                    }
+
+                    int status = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+
+                    if (source && (status/100 == 2)) {
+                        response.setMixerGain(source->getMixerGain());
+                    }
+
+                    return status;
                 }
                 else
                 {
@@ -1701,6 +1767,8 @@ void WebAPIAdapterGUI::getDeviceSet(SWGSDRangel::SWGDeviceSet *deviceSet, const
             channel->getIdentifier(*channels->back()->getId());
             channel->getTitle(*channels->back()->getTitle());
         }
+
+        deviceUISet->m_deviceSourceEngine->webapiFormatStats(*deviceSet);
     }
 }
 
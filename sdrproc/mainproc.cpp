@@ -0,0 +1,483 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QThread>
+#include <algorithm>
+
+#include "dsp/dspengine.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/dspdevicesourceengine.h"
+#include "dsp/filerecord.h"
+#include "audio/audiodevicemanager.h"
+#include "audio/audiofifo.h"
+#include "device/devicesourceapi.h"
+#include "device/deviceenumerator.h"
+#include "device/deviceset.h"
+#include "channel/channelsinkapi.h"
+#include "plugin/pluginmanager.h"
+#include "plugin/plugininterface.h"
+#include "settings/preset.h"
+#include "wavfilewriter.h"
+
+#include "mainproc.h"
+
+MainProc::MainProc(qtwebapp::LoggerWithFile *logger, const ParserProc& parser, QObject *parent) :
+    QObject(parent),
+    m_logger(logger),
+    m_parser(parser),
+    m_dspEngine(DSPEngine::instance()),
+    m_pluginManager(0),
+    m_deviceSet(0),
+    m_fileRecord(0),
+    m_compact(false),
+    m_sampleRate(0),
+    m_centerFrequency(0),
+    m_sampleSize(0),
+    m_nbSamplesDone(0),
+    m_blockSize(0),
+    m_running(false),
+    m_exitCode(0)
+{
+    qDebug() << "MainProc::MainProc: start";
+
+    m_pluginManager = new PluginManager(this);
+    m_pluginManager->loadPlugins(QString("pluginssrv"));
+    connect(&m_blockTimer, SIGNAL(timeout()), this, SLOT(processBlock()));
+
+    qDebug() << "MainProc::MainProc: end";
+}
+
+MainProc::~MainProc()
+{
+    if (m_running) { // interrupted
+        finish();
+    }
+
+    cleanup();
+    delete m_pluginManager;
+}
+
+void MainProc::run()
+{
+    qDebug() << "MainProc::run: parameters:"
+        << " preset: " << m_parser.getPresetFileName()
+        << " input: " << m_parser.getInputFileName()
+        << " output: " << m_parser.getOutputDirectory()
+        << " iq: " << m_parser.getIQFileName()
+        << " block: " << m_parser.getBlockMs();
+
+    Preset preset;
+
+    if (!openInput() || !loadPreset(preset))
+    {
+        m_exitCode = 1;
+        emit finished();
+        return;
+    }
+
+    createDeviceSet(preset);
+    QCoreApplication::processEvents(); // channels apply their settings and attach their audio FIFOs
+    openAudioOutputs();
+
+    DSPDeviceSourceEngine *deviceSourceEngine = m_deviceSet->m_deviceSourceEngine;
+
+    if (!m_parser.getIQFileName().isEmpty())
+    {
+        m_fileRecord = new FileRecord(m_parser.getIQFileName());
+        deviceSourceEngine->addSink(m_fileRecord);
+    }
+
+    m_blockSize = std::max(1024U, (m_sampleRate / 1000) * m_parser.getBlockMs());
+    m_samples.resize(m_blockSize);
+
+    if (!deviceSourceEngine->startOffline(m_sampleRate, m_centerFrequency))
+    {
+        m_exitCode = 1;
+        cleanup();
+        emit finished();
+        return;
+    }
+
+    // let the channelizers get their configuration and notify their demodulators before the first samples
+    for (int i = 0; i < 10; i++)
+    {
+        QThread::msleep(10);
+        QCoreApplication::processEvents();
+    }
+
+    if (m_fileRecord) {
+        m_fileRecord->startRecording();
+    }
+
+    qInfo("MainProc::run: processing %s: %u S/s at %llu Hz with %d channel(s)",
+            qPrintable(m_parser.getInputFileName()),
+            m_sampleRate,
+            m_centerFrequency,
+            m_deviceSet->m_deviceSourceAPI->getNbChannels());
+
+    m_running = true;
+    m_elapsedTimer.start();
+    m_blockTimer.start(0);
+}
+
+bool MainProc::openInput()
+{
+    const QString& fileName = m_parser.getInputFileName();
+    m_ifstream.open(fileName.toStdString().c_str(), std::ios::binary);
+
+    if (!m_ifstream.is_open())
+    {
+        qCritical("MainProc::openInput: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    m_compact = m_compactReader.open(&m_ifstream);
+
+    if (m_compact)
+    {
+        const CompactRecord::Header& header = m_compactReader.getHeader();
+        m_sampleRate = header.sampleRate;
+        m_centerFrequency = header.centerFrequency;
+        m_sampleSize = SDR_RX_SAMP_SZ; // the reader scales the samples
+    }
+    else
+    {
+        FileRecord::Header header;
+        m_ifstream.clear();
+        m_ifstream.seekg(0, std::ios::beg);
+
+        if (!FileRecord::readHeader(m_ifstream, header)) {
+            qWarning("MainProc::openInput: %s: header CRC error", qPrintable(fileName));
+        }
+
+        if ((header.sampleSize != 16) && (header.sampleSize != 24))
+        {
+            qCritical("MainProc::openInput: %s: invalid sample size %u", qPrintable(fileName), header.sampleSize);
+            return false;
+        }
+
+        m_sampleRate = header.sampleRate;
+        m_centerFrequency = header.centerFrequency;
+        m_sampleSize = header.sampleSize;
+    }
+
+    if (m_sampleRate == 0)
+    {
+        qCritical("MainProc::openInput: %s: null sample rate", qPrintable(fileName));
+        return false;
+    }
+
+    return true;
+}
+
+bool MainProc::loadPreset(Preset& preset)
+{
+    QFile exportFile(m_parser.getPresetFileName());
+
+    if (!exportFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qCritical("MainProc::loadPreset: cannot open %s", qPrintable(m_parser.getPresetFileName()));
+        return false;
+    }
+
+    QByteArray base64Str;
+    QTextStream instream(&exportFile);
+    instream >> base64Str;
+    exportFile.close();
+
+    if (!preset.deserialize(QByteArray::fromBase64(base64Str)))
+    {
+        qCritical("MainProc::loadPreset: %s: invalid preset", qPrintable(m_parser.getPresetFileName()));
+        return false;
+    }
+
+    if (!preset.isSourcePreset())
+    {
+        qCritical("MainProc::loadPreset: %s: not a receive preset", qPrintable(m_parser.getPresetFileName()));
+        return false;
+    }
+
+    qDebug("MainProc::loadPreset: preset [%s | %s] %d channel(s)",
+        qPrintable(preset.getGroup()),
+        qPrintable(preset.getDescription()),
+        preset.getChannelCount());
+
+    return true;
+}
+
+void MainProc::createDeviceSet(const Preset& preset)
+{
+    DSPDeviceSourceEngine *dspDeviceSourceEngine = m_dspEngine->addDeviceSourceEngine();
+    dspDeviceSourceEngine->start();
+
+    m_deviceSet = new DeviceSet(0);
+    m_deviceSet->m_deviceSourceEngine = dspDeviceSourceEngine;
+    m_deviceSet->m_deviceSourceAPI = new DeviceSourceAPI(0, dspDeviceSourceEngine);
+
+    // a file source instance stands for the device as in the server. It is never started.
+    DeviceSourceAPI *deviceSourceAPI = m_deviceSet->m_deviceSourceAPI;
+    int fileSourceDeviceIndex = DeviceEnumerator::instance()->getFileSourceDeviceIndex();
+    PluginInterface::SamplingDevice samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(fileSourceDeviceIndex);
+    deviceSourceAPI->setSampleSourceSequence(samplingDevice.sequence);
+    deviceSourceAPI->setNbItems(samplingDevice.deviceNbItems);
+    deviceSourceAPI->setItemIndex(samplingDevice.deviceItemIndex);
+    deviceSourceAPI->setHardwareId(samplingDevice.hardwareId);
+    deviceSourceAPI->setSampleSourceId(samplingDevice.id);
+    deviceSourceAPI->setSampleSourceSerial(samplingDevice.serial);
+    deviceSourceAPI->setSampleSourceDisplayName(samplingDevice.displayedName);
+    deviceSourceAPI->setSampleSourcePluginInterface(DeviceEnumerator::instance()->getRxPluginInterface(fileSourceDeviceIndex));
+
+    DeviceSampleSource *source = deviceSourceAPI->getPluginInterface()->createSampleSourcePluginInstanceInput(
+            deviceSourceAPI->getSampleSourceId(), deviceSourceAPI);
+    deviceSourceAPI->setSampleSource(source);
+
+    m_deviceSet->loadRxChannelSettings(&preset, m_pluginManager->getPluginAPI());
+}
+
+void MainProc::openAudioOutputs()
+{
+    AudioDeviceManager *audioDeviceManager = m_dspEngine->getAudioDeviceManager();
+    QList<AudioFifo*> audioFifos = audioDeviceManager->getAudioSinkFifos();
+    DeviceSourceAPI *deviceSourceAPI = m_deviceSet->m_deviceSourceAPI;
+    QString baseName = QFileInfo(m_parser.getInputFileName()).completeBaseName();
+    QDir outputDir(m_parser.getOutputDirectory());
+
+    for (QList<AudioFifo*>::const_iterator it = audioFifos.begin(); it != audioFifos.end(); ++it)
+    {
+        MessageQueue *messageQueue = audioDeviceManager->getAudioSinkMessageQueue(*it);
+        int sampleRate = audioDeviceManager->getOutputSampleRate(audioDeviceManager->getAudioSinkOutputDeviceIndex(*it));
+        QString channelStr = "audio";
+
+        // the audio FIFO is attached with the input message queue of its channel
+        for (int i = 0; i < deviceSourceAPI->getNbChannels(); i++)
+        {
+            ChannelSinkAPI *channelAPI = deviceSourceAPI->getChanelAPIAt(i);
+            BasebandSampleSink *channelSink = dynamic_cast<BasebandSampleSink*>(channelAPI);
+
+            if (channelSink && (channelSink->getInputMessageQueue() == messageQueue))
+            {
+                QString id;
+                channelAPI->getIdentifier(id);
+                channelStr = QString("%1_%2").arg(channelAPI->getIndexInDeviceSet()).arg(id);
+                break;
+            }
+        }
+
+        audioDeviceManager->removeAudioSink(*it); // audio goes to the file instead of the audio device
+
+        AudioOutputFile audioOutputFile;
+        audioOutputFile.m_audioFifo = *it;
+        audioOutputFile.m_writer = new WavFileWriter();
+        audioOutputFile.m_fileName = outputDir.filePath(QString("%1_%2.wav").arg(baseName).arg(channelStr));
+
+        if (audioOutputFile.m_writer->open(audioOutputFile.m_fileName, sampleRate))
+        {
+            qDebug("MainProc::openAudioOutputs: %s at %d S/s", qPrintable(audioOutputFile.m_fileName), sampleRate);
+            m_audioOutputFiles.push_back(audioOutputFile);
+        }
+        else
+        {
+            delete audioOutputFile.m_writer;
+        }
+    }
+}
+
+uint32_t MainProc::readSamples(uint32_t nbSamples)
+{
+    if (m_compact) {
+        return (uint32_t) m_compactReader.read(&m_samples[0], nbSamples);
+    }
+
+    int sampleBytes = m_sampleSize == 24 ? 8 : 4;
+    m_fileBuffer.resize(nbSamples * sampleBytes);
+    m_ifstream.read((char *) m_fileBuffer.data(), nbSamples * sampleBytes);
+    uint32_t nbRead = m_ifstream.gcount() / sampleBytes;
+    FixReal *samples = (FixReal *) &m_samples[0];
+
+    if (m_sampleSize == SDR_RX_SAMP_SZ)
+    {
+        std::copy(m_fileBuffer.begin(), m_fileBuffer.begin() + nbRead * sampleBytes, (quint8 *) samples);
+    }
+    else if (m_sampleSize == 16) // 16 bit file in 24 bit build
+    {
+        const int16_t *fileBuf = (const int16_t *) m_fileBuffer.data();
+
+        for (uint32_t is = 0; is < 2*nbRead; is++) {
+            samples[is] = fileBuf[is] << 8;
+        }
+    }
+    else // 24 bit file in 16 bit build
+    {
+        const int32_t *fileBuf = (const int32_t *) m_fileBuffer.data();
+
+        for (uint32_t is = 0; is < 2*nbRead; is++) {
+            samples[is] = fileBuf[is] >> 8;
+        }
+    }
+
+    return nbRead;
+}
+
+void MainProc::processBlock()
+{
+    uint32_t nbSamples = readSamples(m_blockSize);
+
+    if (nbSamples > 0)
+    {
+        m_deviceSet->m_deviceSourceEngine->feedOffline(m_samples.begin(), m_samples.begin() + nbSamples);
+        m_nbSamplesDone += nbSamples;
+        writeAudio();
+
+        // give the writer thread of the baseband recording time to catch up rather than dropping blocks
+        while (m_fileRecord && (m_fileRecord->getWriterStats().m_pendingBlocks > (quint32) FileRecordWriter::m_nbBuffers / 2)) {
+            QThread::msleep(1);
+        }
+    }
+
+    if (nbSamples < m_blockSize) // end of file
+    {
+        finish();
+        emit finished();
+    }
+}
+
+void MainProc::writeAudio()
+{
+    for (std::vector<AudioOutputFile>::iterator it = m_audioOutputFiles.begin(); it != m_audioOutputFiles.end(); ++it)
+    {
+        uint32_t fill = it->m_audioFifo->fill();
+
+        if (fill > 0)
+        {
+            if (m_audioBuffer.size() < fill) {
+                m_audioBuffer.resize(fill);
+            }
+
+            uint32_t nbRead = it->m_audioFifo->read((quint8 *) m_audioBuffer.data(), fill);
+            it->m_writer->write(m_audioBuffer.data(), nbRead);
+        }
+    }
+}
+
+void MainProc::finish()
+{
+    qint64 elapsedNs = m_elapsedTimer.nsecsElapsed();
+    m_running = false;
+    m_blockTimer.stop();
+    m_deviceSet->m_deviceSourceEngine->stopOffline();
+    writeAudio();
+
+    if (m_fileRecord) {
+        m_fileRecord->stopRecording();
+    }
+
+    for (std::vector<AudioOutputFile>::iterator it = m_audioOutputFiles.begin(); it != m_audioOutputFiles.end(); ++it) {
+        it->m_writer->close();
+    }
+
+    report(elapsedNs);
+}
+
+void MainProc::report(qint64 elapsedNs)
+{
+    double elapsedS = elapsedNs / 1e9;
+    double signalS = m_nbSamplesDone / (double) m_sampleRate;
+
+    qInfo("MainProc::report: %llu samples (%.3f s of signal) in %.3f s: %.3f MS/s %.1f x real time",
+            m_nbSamplesDone,
+            signalS,
+            elapsedS,
+            elapsedS > 0 ? (m_nbSamplesDone / elapsedS) / 1e6 : 0.0,
+            elapsedS > 0 ? signalS / elapsedS : 0.0);
+
+    // channels run in parallel: each one is reported with the time it actually spent on the samples
+    std::vector<DSPDeviceSourceEngine::SinkStats> sinksStats;
+    m_deviceSet->m_deviceSourceEngine->getSinksStats(sinksStats);
+
+    for (unsigned int i = 0; i < sinksStats.size(); i++)
+    {
+        const DSPDeviceSourceEngine::SinkStats& stats = sinksStats[i];
+        double busyS = stats.m_feedStats.m_processingTimeNs / 1e9;
+
+        qInfo("MainProc::report: sink %u %s: %llu samples in %.3f s: %.3f MS/s %.1f x real time",
+                i,
+                qPrintable(stats.m_name),
+                stats.m_feedStats.m_nbSamples,
+                busyS,
+                busyS > 0 ? (stats.m_feedStats.m_nbSamples / busyS) / 1e6 : 0.0,
+                busyS > 0 ? (stats.m_feedStats.m_nbSamples / (double) m_sampleRate) / busyS : 0.0);
+    }
+
+    for (std::vector<AudioOutputFile>::const_iterator it = m_audioOutputFiles.begin(); it != m_audioOutputFiles.end(); ++it)
+    {
+        qInfo("MainProc::report: %s: %llu audio samples",
+                qPrintable(it->m_fileName),
+                (unsigned long long) it->m_writer->getNbSamples());
+    }
+
+    if (m_fileRecord)
+    {
+        FileRecordWriter::Stats stats = m_fileRecord->getWriterStats();
+        qInfo("MainProc::report: %s: %llu bytes %llu dropped blocks",
+                qPrintable(m_parser.getIQFileName()),
+                (unsigned long long) stats.m_writtenBytes,
+                (unsigned long long) stats.m_droppedBlocks);
+    }
+}
+
+void MainProc::cleanup()
+{
+    for (std::vector<AudioOutputFile>::iterator it = m_audioOutputFiles.begin(); it != m_audioOutputFiles.end(); ++it) {
+        delete it->m_writer;
+    }
+
+    m_audioOutputFiles.clear();
+
+    if (!m_deviceSet) {
+        return;
+    }
+
+    DSPDeviceSourceEngine *deviceSourceEngine = m_deviceSet->m_deviceSourceEngine;
+
+    if (m_fileRecord)
+    {
+        deviceSourceEngine->removeSink(m_fileRecord);
+        delete m_fileRecord;
+        m_fileRecord = 0;
+    }
+
+    m_deviceSet->freeRxChannels(); // destroys the channel instances
+    m_deviceSet->m_deviceSourceAPI->resetSampleSourceId();
+    m_deviceSet->m_deviceSourceAPI->getPluginInterface()->deleteSampleSourcePluginInstanceInput(
+            m_deviceSet->m_deviceSourceAPI->getSampleSource());
+    m_deviceSet->m_deviceSourceAPI->clearBuddiesLists();
+
+    DeviceSourceAPI *sourceAPI = m_deviceSet->m_deviceSourceAPI;
+    delete m_deviceSet;
+    m_deviceSet = 0;
+
+    deviceSourceEngine->stop();
+    m_dspEngine->removeLastDeviceSourceEngine();
+
+    delete sourceAPI;
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRPROC_MAINPROC_H_
+#define SDRPROC_MAINPROC_H_
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <fstream>
+#include <vector>
+
+#include "dsp/dsptypes.h"
+#include "dsp/compactrecordreader.h"
+#include "parserproc.h"
+
+class DSPEngine;
+class PluginManager;
+class DeviceSet;
+class AudioFifo;
+class FileRecord;
+class Preset;
+class WavFileWriter;
+
+namespace qtwebapp {
+    class LoggerWithFile;
+}
+
+/**
+ * Offline processing of a recording through the channels of a preset without the real time pacing
+ * of a device. The samples are read from the file and pushed into the device engine block by block.
+ * Each block is fully processed by the channels before the next one is pushed so nothing is lost and
+ * the results do not depend on the machine load. Audio produced by the channels goes to WAV files.
+ */
+class MainProc: public QObject {
+    Q_OBJECT
+
+public:
+    explicit MainProc(qtwebapp::LoggerWithFile *logger, const ParserProc& parser, QObject *parent = 0);
+    ~MainProc();
+
+    int getExitCode() const { return m_exitCode; }
+
+public slots:
+    void run();
+
+signals:
+    void finished();
+
+private:
+    struct AudioOutputFile
+    {
+        AudioFifo *m_audioFifo;
+        WavFileWriter *m_writer;
+        QString m_fileName;
+    };
+
+    qtwebapp::LoggerWithFile *m_logger;
+    const ParserProc& m_parser;
+    DSPEngine *m_dspEngine;
+    PluginManager *m_pluginManager;
+    DeviceSet *m_deviceSet;
+    FileRecord *m_fileRecord;             //!< optional recording of the corrected baseband
+    std::vector<AudioOutputFile> m_audioOutputFiles;
+    std::vector<AudioSample> m_audioBuffer;
+
+    std::ifstream m_ifstream;
+    CompactRecordReader m_compactReader;
+    bool m_compact;
+    quint32 m_sampleRate;
+    quint64 m_centerFrequency;
+    quint32 m_sampleSize;                 //!< sample size in bits of a .sdriq file
+    quint64 m_nbSamplesDone;
+    SampleVector m_samples;
+    std::vector<quint8> m_fileBuffer;
+    uint32_t m_blockSize;
+
+    QTimer m_blockTimer;                  //!< one block is processed on each turn of the event loop
+    QElapsedTimer m_elapsedTimer;
+    bool m_running;
+    int m_exitCode;
+
+    bool openInput();
+    bool loadPreset(Preset& preset);
+    void createDeviceSet(const Preset& preset);
+    void openAudioOutputs();
+    uint32_t readSamples(uint32_t nbSamples);
+    void writeAudio();
+    void finish();
+    void report(qint64 elapsedNs);
+    void cleanup();
+
+private slots:
+    void processBlock();
+};
+
+#endif /* SDRPROC_MAINPROC_H_ */
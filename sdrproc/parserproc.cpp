@@ -0,0 +1,86 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QCommandLineOption>
+#include <QDebug>
+
+#include "parserproc.h"
+
+ParserProc::ParserProc() :
+    m_presetOption(QStringList() << "p" << "preset",
+        "Preset export file (.prex) giving the channels and their settings.",
+        "file"),
+    m_inputOption(QStringList() << "i" << "input",
+        "Recording to process (.sdriq or .sdriqc).",
+        "file"),
+    m_outputOption(QStringList() << "o" << "output",
+        "Directory of the output files.",
+        "directory",
+        "."),
+    m_iqOption(QStringList() << "q" << "iq",
+        "Record the corrected baseband to this file (.sdriq or .sdriqc).",
+        "file"),
+    m_blockOption(QStringList() << "b" << "block",
+        "Duration of the blocks pushed through the channels in milliseconds.",
+        "ms",
+        "100")
+{
+    m_outputDirectory = ".";
+    m_blockMs = 100;
+
+    m_parser.setApplicationDescription("Software Defined Radio offline processing of recordings through channel plugins");
+    m_parser.addHelpOption();
+    m_parser.addVersionOption();
+
+    m_parser.addOption(m_presetOption);
+    m_parser.addOption(m_inputOption);
+    m_parser.addOption(m_outputOption);
+    m_parser.addOption(m_iqOption);
+    m_parser.addOption(m_blockOption);
+}
+
+ParserProc::~ParserProc()
+{ }
+
+void ParserProc::parse(const QCoreApplication& app)
+{
+    m_parser.process(app);
+
+    bool ok;
+
+    m_presetFileName = m_parser.value(m_presetOption);
+    m_inputFileName = m_parser.value(m_inputOption);
+    m_outputDirectory = m_parser.value(m_outputOption);
+    m_iqFileName = m_parser.value(m_iqOption);
+
+    if (m_presetFileName.isEmpty() || m_inputFileName.isEmpty())
+    {
+        qCritical() << "ParserProc::parse: a preset file and an input file are required";
+        m_parser.showHelp(1);
+    }
+
+    // block duration
+
+    QString blockStr = m_parser.value(m_blockOption);
+    int blockMs = blockStr.toInt(&ok);
+
+    if (ok && (blockMs >= 1) && (blockMs <= 250)) { // audio is collected after each block and the smallest channel audio FIFOs hold 500 ms
+        m_blockMs = blockMs;
+    } else {
+        qWarning() << "ParserProc::parse: block duration invalid. Defaulting to " << m_blockMs;
+    }
+}
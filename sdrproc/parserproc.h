@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRPROC_PARSERPROC_H_
+#define SDRPROC_PARSERPROC_H_
+
+#include <QCommandLineParser>
+#include <stdint.h>
+
+class ParserProc
+{
+public:
+    ParserProc();
+    ~ParserProc();
+
+    void parse(const QCoreApplication& app);
+
+    const QString& getPresetFileName() const { return m_presetFileName; }
+    const QString& getInputFileName() const { return m_inputFileName; }
+    const QString& getOutputDirectory() const { return m_outputDirectory; }
+    const QString& getIQFileName() const { return m_iqFileName; }
+    uint32_t getBlockMs() const { return m_blockMs; }
+
+private:
+    QString  m_presetFileName;
+    QString  m_inputFileName;
+    QString  m_outputDirectory;
+    QString  m_iqFileName;
+    uint32_t m_blockMs;
+
+    QCommandLineParser m_parser;
+    QCommandLineOption m_presetOption;
+    QCommandLineOption m_inputOption;
+    QCommandLineOption m_outputOption;
+    QCommandLineOption m_iqOption;
+    QCommandLineOption m_blockOption;
+};
+
+#endif /* SDRPROC_PARSERPROC_H_ */
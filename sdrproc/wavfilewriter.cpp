@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <QDebug>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#include "wavfilewriter.h"
+
+#pragma pack(push, 1)
+struct WavHeader
+{
+    char     riffId[4];
+    uint32_t riffSize;
+    char     waveId[4];
+    char     fmtId[4];
+    uint32_t fmtSize;
+    uint16_t audioFormat;
+    uint16_t nbChannels;
+    uint32_t sampleRate;
+    uint32_t byteRate;
+    uint16_t blockAlign;
+    uint16_t bitsPerSample;
+    char     dataId[4];
+    uint32_t dataSize;
+};
+#pragma pack(pop)
+
+WavFileWriter::WavFileWriter() :
+    m_nbSamples(0)
+{
+}
+
+WavFileWriter::~WavFileWriter()
+{
+    close();
+}
+
+bool WavFileWriter::open(const QString& fileName, int sampleRate)
+{
+    close();
+    m_file.open(fileName.toStdString().c_str(), std::ios::binary);
+
+    if (!m_file.is_open())
+    {
+        qCritical("WavFileWriter::open: cannot open %s", qPrintable(fileName));
+        return false;
+    }
+
+    m_nbSamples = 0;
+    writeHeader(sampleRate, 0);
+    return true;
+}
+
+void WavFileWriter::write(const AudioSample *samples, uint32_t nbSamples)
+{
+    if (m_file.is_open())
+    {
+        m_file.write((const char *) samples, nbSamples * sizeof(AudioSample));
+        m_nbSamples += nbSamples;
+    }
+}
+
+void WavFileWriter::close()
+{
+    if (!m_file.is_open()) {
+        return;
+    }
+
+    // sizes are 32 bit: files longer than 4 GiB of audio are not valid but still readable by most tools
+    uint64_t dataSize = m_nbSamples * sizeof(AudioSample);
+    uint32_t riffSize = (uint32_t) std::min(dataSize + sizeof(WavHeader) - 8, (uint64_t) 0xFFFFFFFF);
+    uint32_t dataSize32 = (uint32_t) std::min(dataSize, (uint64_t) 0xFFFFFFFF);
+
+    m_file.seekp(offsetof(WavHeader, riffSize), std::ios::beg);
+    m_file.write((const char *) &riffSize, sizeof(riffSize));
+    m_file.seekp(offsetof(WavHeader, dataSize), std::ios::beg);
+    m_file.write((const char *) &dataSize32, sizeof(dataSize32));
+    m_file.close();
+}
+
+void WavFileWriter::writeHeader(int sampleRate, uint32_t dataSize)
+{
+    WavHeader header;
+
+    memcpy(header.riffId, "RIFF", 4);
+    header.riffSize = dataSize + sizeof(WavHeader) - 8;
+    memcpy(header.waveId, "WAVE", 4);
+    memcpy(header.fmtId, "fmt ", 4);
+    header.fmtSize = 16;
+    header.audioFormat = 1; // PCM
+    header.nbChannels = 2;
+    header.sampleRate = sampleRate;
+    header.byteRate = sampleRate * sizeof(AudioSample);
+    header.blockAlign = sizeof(AudioSample);
+    header.bitsPerSample = 16;
+    memcpy(header.dataId, "data", 4);
+    header.dataSize = dataSize;
+
+    m_file.write((const char *) &header, sizeof(WavHeader));
+}
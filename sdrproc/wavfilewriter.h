@@ -0,0 +1,49 @@
+///////////////////////////////////////////////////////////////////////////////////
+// Copyright (C) 2018 F4EXB                                                      //
+// written by Edouard Griffiths                                                  //
+//                                                                               //
+// This program is free software; you can redistribute it and/or modify          //
+// it under the terms of the GNU General Public License as published by          //
+// the Free Software Foundation as version 3 of the License, or                  //
+//                                                                               //
+// This program is distributed in the hope that it will be useful,               //
+// but WITHOUT ANY WARRANTY; without even the implied warranty of                //
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the                  //
+// GNU General Public License V3 for more details.                               //
+//                                                                               //
+// You should have received a copy of the GNU General Public License             //
+// along with this program. If not, see <http://www.gnu.org/licenses/>.          //
+///////////////////////////////////////////////////////////////////////////////////
+
+#ifndef SDRPROC_WAVFILEWRITER_H_
+#define SDRPROC_WAVFILEWRITER_H_
+
+#include <QString>
+#include <fstream>
+#include <stdint.h>
+
+#include "dsp/dsptypes.h"
+
+/**
+ * Writes stereo 16 bit PCM audio samples to a WAV file. The sizes in the header are set on close.
+ */
+class WavFileWriter
+{
+public:
+    WavFileWriter();
+    ~WavFileWriter();
+
+    bool open(const QString& fileName, int sampleRate);
+    void write(const AudioSample *samples, uint32_t nbSamples);
+    void close();
+    bool isOpen() const { return m_file.is_open(); }
+    uint64_t getNbSamples() const { return m_nbSamples; }
+
+private:
+    std::ofstream m_file;
+    uint64_t m_nbSamples;
+
+    void writeHeader(int sampleRate, uint32_t dataSize);
+};
+
+#endif /* SDRPROC_WAVFILEWRITER_H_ */
@@ -16,6 +16,8 @@
 
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/spectrumengine.h"
+#include "dsp/spectrumstreamer.h"
 #include "device/devicesourceapi.h"
 #include "device/devicesinkapi.h"
 #include "plugin/pluginapi.h"
@@ -34,11 +36,15 @@ DeviceSet::DeviceSet(int tabIndex)
     m_deviceSourceAPI = 0;
     m_deviceSinkEngine = 0;
     m_deviceSinkAPI = 0;
+    m_spectrumEngine = 0;
+    m_spectrumStreamer = 0;
     m_deviceTabIndex = tabIndex;
 }
 
 DeviceSet::~DeviceSet()
 {
+    delete m_spectrumStreamer;
+    delete m_spectrumEngine;
 }
 
 void DeviceSet::registerRxChannelInstance(const QString& channelName, ChannelSinkAPI* channelAPI)
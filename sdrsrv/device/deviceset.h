@@ -27,6 +27,8 @@ class PluginAPI;
 class ChannelSinkAPI;
 class ChannelSourceAPI;
 class Preset;
+class SpectrumEngine;
+class SpectrumStreamer;
 
 class DeviceSet
 {
@@ -35,6 +37,8 @@ public:
     DeviceSourceAPI *m_deviceSourceAPI;
     DSPDeviceSinkEngine *m_deviceSinkEngine;
     DeviceSinkAPI *m_deviceSinkAPI;
+    SpectrumEngine *m_spectrumEngine;     //!< Rx device sets only
+    SpectrumStreamer *m_spectrumStreamer; //!< Rx device sets only and if spectrum streaming is enabled
 
     DeviceSet(int tabIndex);
     ~DeviceSet();
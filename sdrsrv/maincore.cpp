@@ -24,6 +24,8 @@
 #include "dsp/dspengine.h"
 #include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspdevicesinkengine.h"
+#include "dsp/spectrumengine.h"
+#include "dsp/spectrumstreamer.h"
 #include "device/devicesourceapi.h"
 #include "device/devicesinkapi.h"
 #include "device/deviceset.h"
@@ -33,6 +35,7 @@
 #include "webapi/webapirequestmapper.h"
 #include "webapi/webapiserver.h"
 #include "webapi/webapiadaptersrv.h"
+#include "util/threadroles.h"
 
 #include "maincore.h"
 
@@ -54,7 +57,9 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
     m_masterTabIndex(-1),
     m_dspEngine(DSPEngine::instance()),
     m_lastEngineState(DSPDeviceSourceEngine::StNotStarted),
-    m_logger(logger)
+    m_logger(logger),
+    m_spectrumRate(parser.getSpectrumRate()),
+    m_apiPort(parser.getServerPort())
 {
     qDebug() << "MainCore::MainCore: start";
 
@@ -69,6 +74,17 @@ MainCore::MainCore(qtwebapp::LoggerWithFile *logger, const MainParser& parser, Q
 
 	loadSettings();
 
+    for (QStringList::const_iterator it = parser.getThreadRoles().begin(); it != parser.getThreadRoles().end(); ++it) {
+        ThreadRoles::setRole(*it); // command line overrides the preferences
+    }
+
+    if (parser.hasDSPThreads() || parser.getDSPPinCores()) // command line overrides the preferences
+    {
+        m_dspEngine->setDSPScheduler(
+            parser.hasDSPThreads() ? parser.getDSPThreads() : m_settings.getDSPSchedulerThreads(),
+            parser.getDSPPinCores() || m_settings.getDSPSchedulerPinCores());
+    }
+
     QString applicationDirPath = QCoreApplication::instance()->applicationDirPath();
 
     if (QResource::registerResource(applicationDirPath + "/sdrbase.rcc")) {
@@ -207,6 +223,10 @@ void MainCore::loadSettings()
     m_settings.load();
     m_settings.sortPresets();
     setLoggingOptions();
+    m_dspEngine->setFFTWPrePlanning(m_settings.getFFTWPrePlanning());
+    m_dspEngine->setDSPScheduler(m_settings.getDSPSchedulerThreads(), m_settings.getDSPSchedulerPinCores());
+    m_dspEngine->setRecordDirectIO(m_settings.getRecordDirectIO());
+    ThreadRoles::deserialize(m_settings.getThreadRoles());
 }
 
 void MainCore::setLoggingOptions()
@@ -321,6 +341,19 @@ void MainCore::addSourceDevice()
 
     m_deviceSets.back()->m_deviceSourceAPI = deviceSourceAPI;
 
+    // headless spectrum
+    SpectrumEngine *spectrumEngine = new SpectrumEngine(SDR_RX_SCALEF);
+    dspDeviceSourceEngine->addSink(spectrumEngine);
+    m_deviceSets.back()->m_spectrumEngine = spectrumEngine;
+
+    if (m_spectrumRate > 0)
+    {
+        m_deviceSets.back()->m_spectrumStreamer = new SpectrumStreamer(spectrumEngine);
+        m_deviceSets.back()->m_spectrumStreamer->start(
+                QString("sdrangel.%1.spectrum.%2").arg(m_apiPort).arg(deviceTabIndex),
+                m_spectrumRate);
+    }
+
     // Create a file source instance by default
     int fileSourceDeviceIndex = DeviceEnumerator::instance()->getFileSourceDeviceIndex();
     PluginInterface::SamplingDevice samplingDevice = DeviceEnumerator::instance()->getRxSamplingDevice(fileSourceDeviceIndex);
@@ -344,6 +377,7 @@ void MainCore::removeLastDevice()
     {
         DSPDeviceSourceEngine *lastDeviceEngine = m_deviceSets.back()->m_deviceSourceEngine;
         lastDeviceEngine->stopAcquistion();
+        lastDeviceEngine->removeSink(m_deviceSets.back()->m_spectrumEngine);
 
         // deletes old UI and input object
         m_deviceSets.back()->freeRxChannels();      // destroys the channel instances
@@ -567,6 +601,7 @@ void MainCore::loadPresetSettings(const Preset* preset, int tabIndex)
         if (deviceSet->m_deviceSourceEngine) // source device
         {
         	deviceSet->m_deviceSourceAPI->loadSourceSettings(preset);
+        	deviceSet->m_spectrumEngine->deserialize(preset->getSpectrumConfig());
         	deviceSet->loadRxChannelSettings(preset, m_pluginManager->getPluginAPI());
         }
         else if (deviceSet->m_deviceSinkEngine) // sink device
@@ -276,6 +276,8 @@ private:
     DSPEngine* m_dspEngine;
     int m_lastEngineState;
     qtwebapp::LoggerWithFile *m_logger;
+    int m_spectrumRate;   //!< spectrum stream frames per second. 0 if disabled
+    uint16_t m_apiPort;   //!< to make spectrum stream socket names unique per instance
 
     MessageQueue m_inputMessageQueue;
     QTimer m_masterTimer;
@@ -29,6 +29,7 @@
 #include "SWGLoggingInfo.h"
 #include "SWGAudioDevices.h"
 #include "SWGLocationInformation.h"
+#include "SWGThreadRoles.h"
 #include "SWGDVSeralDevices.h"
 #include "SWGPresetImport.h"
 #include "SWGPresetExport.h"
@@ -38,10 +39,12 @@
 #include "SWGChannelsDetail.h"
 #include "SWGChannelSettings.h"
 #include "SWGChannelReport.h"
+#include "SWGDSPSinkStats.h"
 #include "SWGSuccessResponse.h"
 #include "SWGErrorResponse.h"
 #include "SWGDeviceState.h"
 #include "SWGDeviceReport.h"
+#include "SWGSpectrumFrame.h"
 
 #include "maincore.h"
 #include "loggerwithfile.h"
@@ -51,11 +54,16 @@
 #include "device/deviceenumerator.h"
 #include "dsp/devicesamplesink.h"
 #include "dsp/devicesamplesource.h"
+#include "dsp/basebandsamplesink.h"
+#include "dsp/basebandsamplesource.h"
+#include "dsp/dspdevicesourceengine.h"
 #include "dsp/dspengine.h"
+#include "dsp/spectrumengine.h"
 #include "channel/channelsourceapi.h"
 #include "channel/channelsinkapi.h"
 #include "plugin/pluginapi.h"
 #include "plugin/pluginmanager.h"
+#include "util/threadroles.h"
 #include "webapiadaptersrv.h"
 
 WebAPIAdapterSrv::WebAPIAdapterSrv(MainCore& mainCore) :
@@ -507,6 +515,34 @@ int WebAPIAdapterSrv::instanceLocationPut(
     return 200;
 }
 
+int WebAPIAdapterSrv::instanceThreadRolesGet(
+        SWGSDRangel::SWGThreadRoles& response,
+        SWGSDRangel::SWGErrorResponse& error __attribute__((unused)))
+{
+    ThreadRoles::webapiFormat(response);
+    return 200;
+}
+
+int WebAPIAdapterSrv::instanceThreadRolesPatch(
+        const QList<QStringList>& rolesKeys,
+        SWGSDRangel::SWGThreadRoles& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    QString errorMessage;
+
+    if (!ThreadRoles::webapiUpdate(rolesKeys, response, errorMessage))
+    {
+        error.init();
+        *error.getMessage() = errorMessage;
+        return 400;
+    }
+
+    m_mainCore.m_settings.setThreadRoles(ThreadRoles::serialize());
+    ThreadRoles::webapiFormat(response);
+
+    return 200;
+}
+
 int WebAPIAdapterSrv::instanceDVSerialGet(
             SWGSDRangel::SWGDVSeralDevices& response,
             SWGSDRangel::SWGErrorResponse& error __attribute__((unused)))
@@ -1336,6 +1372,61 @@ int WebAPIAdapterSrv::devicesetDeviceReportGet(
     }
 }
 
+int WebAPIAdapterSrv::devicesetSpectrumGet(
+        int deviceSetIndex,
+        SWGSDRangel::SWGSpectrumFrame& response,
+        SWGSDRangel::SWGErrorResponse& error)
+{
+    error.init();
+
+    if ((deviceSetIndex >= 0) && (deviceSetIndex < (int) m_mainCore.m_deviceSets.size()))
+    {
+        DeviceSet *deviceSet = m_mainCore.m_deviceSets[deviceSetIndex];
+
+        if (deviceSet->m_spectrumEngine == 0)
+        {
+            *error.getMessage() = QString("Device set %1 has no spectrum").arg(deviceSetIndex);
+            return 400;
+        }
+
+        SpectrumEngine::Frame frame;
+
+        if (!deviceSet->m_spectrumEngine->getFrame(frame))
+        {
+            *error.getMessage() = QString("No spectrum available yet for device set %1").arg(deviceSetIndex);
+            return 404;
+        }
+
+        response.setFftSize(frame.m_fftSize);
+        response.setCenterFrequency(frame.m_centerFrequency);
+        response.setSampleRate(frame.m_sampleRate);
+        response.setSequence(frame.m_sequence);
+        response.setTimestamp(frame.m_timestamp);
+        response.setLinear(frame.m_linear ? 1 : 0);
+
+        QList<float> *power = response.getPower();
+        QList<float> *maxHold = response.getMaxHold();
+        QList<float> *minHold = response.getMinHold();
+        power->reserve(frame.m_fftSize);
+        maxHold->reserve(frame.m_fftSize);
+        minHold->reserve(frame.m_fftSize);
+
+        for (int i = 0; i < frame.m_fftSize; i++)
+        {
+            power->append(frame.m_power[i]);
+            maxHold->append(frame.m_maxHold[i]);
+            minHold->append(frame.m_minHold[i]);
+        }
+
+        return 200;
+    }
+    else
+    {
+        *error.getMessage() = QString("There is no device set with index %1").arg(deviceSetIndex);
+        return 404;
+    }
+}
+
 int WebAPIAdapterSrv::devicesetChannelsReportGet(
         int deviceSetIndex,
         SWGSDRangel::SWGChannelsDetail& response,
@@ -1558,7 +1649,14 @@ int WebAPIAdapterSrv::devicesetChannelSettingsGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setTx(1);
-                return channelAPI->webapiSettingsGet(response, *error.getMessage());
+                int status = channelAPI->webapiSettingsGet(response, *error.getMessage());
+                BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+                if (source && (status/100 == 2)) {
+                    response.setMixerGain(source->getMixerGain());
+                }
+
+                return status;
             }
         }
         else
@@ -1600,7 +1698,20 @@ int WebAPIAdapterSrv::devicesetChannelReportGet(
                 response.setChannelType(new QString());
                 channelAPI->getIdentifier(*response.getChannelType());
                 response.setTx(0);
-                return channelAPI->webapiReportGet(response, *error.getMessage());
+                int httpRC = channelAPI->webapiReportGet(response, *error.getMessage());
+
+                if (httpRC / 100 == 2)
+                {
+                    response.setDspStats(new SWGSDRangel::SWGDSPSinkStats());
+
+                    if (!deviceSet->m_deviceSourceEngine->webapiFormatChannelStats(*response.getDspStats(), dynamic_cast<BasebandSampleSink*>(channelAPI)))
+                    {
+                        delete response.getDspStats();
+                        response.setDspStats(0);
+                    }
+                }
+
+                return httpRC;
             }
         }
         else if (deviceSet->m_deviceSinkEngine) // Tx
@@ -1691,7 +1802,19 @@ int WebAPIAdapterSrv::devicesetChannelSettingsPutPatch(
 
                 if (channelType == *response.getChannelType())
                 {
-                    return channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+                    BasebandSampleSource *source = dynamic_cast<BasebandSampleSource*>(channelAPI);
+
+                    if (source && channelSettingsKeys.contains("mixerGain")) {
+                        source->setMixerGain(response.getMixerGain());
+                    }
+
+                    int status = channelAPI->webapiSettingsPutPatch(force, channelSettingsKeys, response, *error.getMessage());
+
+                    if (source && (status/100 == 2)) {
+                        response.setMixerGain(source->getMixerGain());
+                    }
+
+                    return status;
                 }
                 else
                 {
@@ -1800,6 +1923,8 @@ void WebAPIAdapterSrv::getDeviceSet(SWGSDRangel::SWGDeviceSet *swgDeviceSet, con
             channel->getIdentifier(*channels->back()->getId());
             channel->getTitle(*channels->back()->getTitle());
         }
+
+        deviceSet->m_deviceSourceEngine->webapiFormatStats(*swgDeviceSet);
     }
 }
 
@@ -97,6 +97,15 @@ public:
             SWGSDRangel::SWGLocationInformation& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int instanceThreadRolesGet(
+            SWGSDRangel::SWGThreadRoles& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
+    virtual int instanceThreadRolesPatch(
+            const QList<QStringList>& rolesKeys,
+            SWGSDRangel::SWGThreadRoles& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int instanceDVSerialGet(
             SWGSDRangel::SWGDVSeralDevices& response,
             SWGSDRangel::SWGErrorResponse& error);
@@ -200,6 +209,11 @@ public:
             SWGSDRangel::SWGDeviceReport& response,
             SWGSDRangel::SWGErrorResponse& error);
 
+    virtual int devicesetSpectrumGet(
+            int deviceSetIndex,
+            SWGSDRangel::SWGSpectrumFrame& response,
+            SWGSDRangel::SWGErrorResponse& error);
+
     virtual int devicesetChannelsReportGet(
             int deviceSetIndex,
             SWGSDRangel::SWGChannelsDetail& response,
@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGFileRecordReport.h"
 #include "SWGSampleRate.h"
 #include <QList>
 
@@ -46,6 +47,9 @@ public:
     QList<SWGSampleRate*>* getSampleRates();
     void setSampleRates(QList<SWGSampleRate*>* sample_rates);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -53,6 +57,9 @@ private:
     QList<SWGSampleRate*>* sample_rates;
     bool m_sample_rates_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
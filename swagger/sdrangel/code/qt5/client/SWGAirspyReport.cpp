@@ -30,6 +30,8 @@ SWGAirspyReport::SWGAirspyReport(QString* json) {
 SWGAirspyReport::SWGAirspyReport() {
     sample_rates = nullptr;
     m_sample_rates_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGAirspyReport::~SWGAirspyReport() {
@@ -40,6 +42,8 @@ void
 SWGAirspyReport::init() {
     sample_rates = new QList<SWGSampleRate*>();
     m_sample_rates_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -51,6 +55,9 @@ SWGAirspyReport::cleanup() {
         }
         delete sample_rates;
     }
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGAirspyReport*
@@ -66,6 +73,8 @@ void
 SWGAirspyReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&sample_rates, pJson["sampleRates"], "QList", "SWGSampleRate");
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -85,6 +94,9 @@ SWGAirspyReport::asJsonObject() {
     if(sample_rates->size() > 0){
         toJsonArray((QList<void*>*)sample_rates, obj, "sampleRates", "SWGSampleRate");
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -99,12 +111,23 @@ SWGAirspyReport::setSampleRates(QList<SWGSampleRate*>* sample_rates) {
     this->m_sample_rates_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGAirspyReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGAirspyReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGAirspyReport::isSet(){
     bool isObjectUpdated = false;
     do{
         if(sample_rates->size() > 0){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -38,6 +38,8 @@ SWGBladeRF2InputReport::SWGBladeRF2InputReport() {
     m_global_gain_range_isSet = false;
     gain_modes = nullptr;
     m_gain_modes_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGBladeRF2InputReport::~SWGBladeRF2InputReport() {
@@ -56,6 +58,8 @@ SWGBladeRF2InputReport::init() {
     m_global_gain_range_isSet = false;
     gain_modes = new QList<SWGNamedEnum*>();
     m_gain_modes_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -79,6 +83,9 @@ SWGBladeRF2InputReport::cleanup() {
         }
         delete gain_modes;
     }
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGBladeRF2InputReport*
@@ -102,6 +109,8 @@ SWGBladeRF2InputReport::fromJsonObject(QJsonObject &pJson) {
     
     
     ::SWGSDRangel::setValue(&gain_modes, pJson["gainModes"], "QList", "SWGNamedEnum");
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -133,6 +142,9 @@ SWGBladeRF2InputReport::asJsonObject() {
     if(gain_modes->size() > 0){
         toJsonArray((QList<void*>*)gain_modes, obj, "gainModes", "SWGNamedEnum");
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -187,6 +199,16 @@ SWGBladeRF2InputReport::setGainModes(QList<SWGNamedEnum*>* gain_modes) {
     this->m_gain_modes_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGBladeRF2InputReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGBladeRF2InputReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGBladeRF2InputReport::isSet(){
@@ -197,6 +219,7 @@ SWGBladeRF2InputReport::isSet(){
         if(bandwidth_range != nullptr && bandwidth_range->isSet()){ isObjectUpdated = true; break;}
         if(global_gain_range != nullptr && global_gain_range->isSet()){ isObjectUpdated = true; break;}
         if(gain_modes->size() > 0){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
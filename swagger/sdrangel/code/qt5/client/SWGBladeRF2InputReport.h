@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGFileRecordReport.h"
 #include "SWGFrequencyRange.h"
 #include "SWGNamedEnum.h"
 #include "SWGRange.h"
@@ -60,6 +61,9 @@ public:
     QList<SWGNamedEnum*>* getGainModes();
     void setGainModes(QList<SWGNamedEnum*>* gain_modes);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -79,6 +83,9 @@ private:
     QList<SWGNamedEnum*>* gain_modes;
     bool m_gain_modes_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
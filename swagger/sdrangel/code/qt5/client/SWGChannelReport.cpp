@@ -32,6 +32,8 @@ SWGChannelReport::SWGChannelReport() {
     m_channel_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    dsp_stats = nullptr;
+    m_dsp_stats_isSet = false;
     am_demod_report = nullptr;
     m_am_demod_report_isSet = false;
     am_mod_report = nullptr;
@@ -72,6 +74,8 @@ SWGChannelReport::init() {
     m_channel_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    dsp_stats = new SWGDSPSinkStats();
+    m_dsp_stats_isSet = false;
     am_demod_report = new SWGAMDemodReport();
     m_am_demod_report_isSet = false;
     am_mod_report = new SWGAMModReport();
@@ -108,6 +112,9 @@ SWGChannelReport::cleanup() {
         delete channel_type;
     }
 
+    if(dsp_stats != nullptr) { 
+        delete dsp_stats;
+    }
     if(am_demod_report != nullptr) { 
         delete am_demod_report;
     }
@@ -167,6 +174,8 @@ SWGChannelReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&tx, pJson["tx"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&dsp_stats, pJson["dspStats"], "SWGDSPSinkStats", "SWGDSPSinkStats");
+    
     ::SWGSDRangel::setValue(&am_demod_report, pJson["AMDemodReport"], "SWGAMDemodReport", "SWGAMDemodReport");
     
     ::SWGSDRangel::setValue(&am_mod_report, pJson["AMModReport"], "SWGAMModReport", "SWGAMModReport");
@@ -217,6 +226,9 @@ SWGChannelReport::asJsonObject() {
     if(m_tx_isSet){
         obj->insert("tx", QJsonValue(tx));
     }
+    if((dsp_stats != nullptr) && (dsp_stats->isSet())){
+        toJsonValue(QString("dspStats"), dsp_stats, obj, QString("SWGDSPSinkStats"));
+    }
     if((am_demod_report != nullptr) && (am_demod_report->isSet())){
         toJsonValue(QString("AMDemodReport"), am_demod_report, obj, QString("SWGAMDemodReport"));
     }
@@ -283,6 +295,16 @@ SWGChannelReport::setTx(qint32 tx) {
     this->m_tx_isSet = true;
 }
 
+SWGDSPSinkStats*
+SWGChannelReport::getDspStats() {
+    return dsp_stats;
+}
+void
+SWGChannelReport::setDspStats(SWGDSPSinkStats* dsp_stats) {
+    this->dsp_stats = dsp_stats;
+    this->m_dsp_stats_isSet = true;
+}
+
 SWGAMDemodReport*
 SWGChannelReport::getAmDemodReport() {
     return am_demod_report;
@@ -430,6 +452,7 @@ SWGChannelReport::isSet(){
     do{
         if(channel_type != nullptr && *channel_type != QString("")){ isObjectUpdated = true; break;}
         if(m_tx_isSet){ isObjectUpdated = true; break;}
+        if(dsp_stats != nullptr && dsp_stats->isSet()){ isObjectUpdated = true; break;}
         if(am_demod_report != nullptr && am_demod_report->isSet()){ isObjectUpdated = true; break;}
         if(am_mod_report != nullptr && am_mod_report->isSet()){ isObjectUpdated = true; break;}
         if(atv_mod_report != nullptr && atv_mod_report->isSet()){ isObjectUpdated = true; break;}
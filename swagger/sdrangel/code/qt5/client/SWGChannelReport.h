@@ -27,6 +27,7 @@
 #include "SWGATVModReport.h"
 #include "SWGBFMDemodReport.h"
 #include "SWGDSDDemodReport.h"
+#include "SWGDSPSinkStats.h"
 #include "SWGDaemonSourceReport.h"
 #include "SWGNFMDemodReport.h"
 #include "SWGNFMModReport.h"
@@ -62,6 +63,9 @@ public:
     qint32 getTx();
     void setTx(qint32 tx);
 
+    SWGDSPSinkStats* getDspStats();
+    void setDspStats(SWGDSPSinkStats* dsp_stats);
+
     SWGAMDemodReport* getAmDemodReport();
     void setAmDemodReport(SWGAMDemodReport* am_demod_report);
 
@@ -114,6 +118,9 @@ private:
     qint32 tx;
     bool m_tx_isSet;
 
+    SWGDSPSinkStats* dsp_stats;
+    bool m_dsp_stats_isSet;
+
     SWGAMDemodReport* am_demod_report;
     bool m_am_demod_report_isSet;
 
@@ -32,6 +32,8 @@ SWGChannelSettings::SWGChannelSettings() {
     m_channel_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    mixer_gain = 0.0f;
+    m_mixer_gain_isSet = false;
     am_demod_settings = nullptr;
     m_am_demod_settings_isSet = false;
     am_mod_settings = nullptr;
@@ -74,6 +76,8 @@ SWGChannelSettings::init() {
     m_channel_type_isSet = false;
     tx = 0;
     m_tx_isSet = false;
+    mixer_gain = 0.0f;
+    m_mixer_gain_isSet = false;
     am_demod_settings = new SWGAMDemodSettings();
     m_am_demod_settings_isSet = false;
     am_mod_settings = new SWGAMModSettings();
@@ -174,6 +178,8 @@ SWGChannelSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&tx, pJson["tx"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&mixer_gain, pJson["mixerGain"], "float", "");
+    
     ::SWGSDRangel::setValue(&am_demod_settings, pJson["AMDemodSettings"], "SWGAMDemodSettings", "SWGAMDemodSettings");
     
     ::SWGSDRangel::setValue(&am_mod_settings, pJson["AMModSettings"], "SWGAMModSettings", "SWGAMModSettings");
@@ -226,6 +232,9 @@ SWGChannelSettings::asJsonObject() {
     if(m_tx_isSet){
         obj->insert("tx", QJsonValue(tx));
     }
+    if(m_mixer_gain_isSet){
+        obj->insert("mixerGain", QJsonValue(mixer_gain));
+    }
     if((am_demod_settings != nullptr) && (am_demod_settings->isSet())){
         toJsonValue(QString("AMDemodSettings"), am_demod_settings, obj, QString("SWGAMDemodSettings"));
     }
@@ -295,6 +304,16 @@ SWGChannelSettings::setTx(qint32 tx) {
     this->m_tx_isSet = true;
 }
 
+float
+SWGChannelSettings::getMixerGain() {
+    return mixer_gain;
+}
+void
+SWGChannelSettings::setMixerGain(float mixer_gain) {
+    this->mixer_gain = mixer_gain;
+    this->m_mixer_gain_isSet = true;
+}
+
 SWGAMDemodSettings*
 SWGChannelSettings::getAmDemodSettings() {
     return am_demod_settings;
@@ -452,6 +471,7 @@ SWGChannelSettings::isSet(){
     do{
         if(channel_type != nullptr && *channel_type != QString("")){ isObjectUpdated = true; break;}
         if(m_tx_isSet){ isObjectUpdated = true; break;}
+        if(m_mixer_gain_isSet){ isObjectUpdated = true; break;}
         if(am_demod_settings != nullptr && am_demod_settings->isSet()){ isObjectUpdated = true; break;}
         if(am_mod_settings != nullptr && am_mod_settings->isSet()){ isObjectUpdated = true; break;}
         if(atv_mod_settings != nullptr && atv_mod_settings->isSet()){ isObjectUpdated = true; break;}
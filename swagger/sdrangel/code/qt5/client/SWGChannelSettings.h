@@ -63,6 +63,9 @@ public:
     qint32 getTx();
     void setTx(qint32 tx);
 
+    float getMixerGain();
+    void setMixerGain(float mixer_gain);
+
     SWGAMDemodSettings* getAmDemodSettings();
     void setAmDemodSettings(SWGAMDemodSettings* am_demod_settings);
 
@@ -118,6 +121,9 @@ private:
     qint32 tx;
     bool m_tx_isSet;
 
+    float mixer_gain;
+    bool m_mixer_gain_isSet;
+
     SWGAMDemodSettings* am_demod_settings;
     bool m_am_demod_settings_isSet;
 
@@ -0,0 +1,236 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGDSPSinkStats.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGDSPSinkStats::SWGDSPSinkStats(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGDSPSinkStats::SWGDSPSinkStats() {
+    name = nullptr;
+    m_name_isSet = false;
+    threaded = 0;
+    m_threaded_isSet = false;
+    nb_samples = 0L;
+    m_nb_samples_isSet = false;
+    processing_time_ns = 0L;
+    m_processing_time_ns_isSet = false;
+    max_latency_ns = 0L;
+    m_max_latency_ns_isSet = false;
+    thread_cpu_time_ns = 0L;
+    m_thread_cpu_time_ns_isSet = false;
+    fifo = nullptr;
+    m_fifo_isSet = false;
+}
+
+SWGDSPSinkStats::~SWGDSPSinkStats() {
+    this->cleanup();
+}
+
+void
+SWGDSPSinkStats::init() {
+    name = new QString("");
+    m_name_isSet = false;
+    threaded = 0;
+    m_threaded_isSet = false;
+    nb_samples = 0L;
+    m_nb_samples_isSet = false;
+    processing_time_ns = 0L;
+    m_processing_time_ns_isSet = false;
+    max_latency_ns = 0L;
+    m_max_latency_ns_isSet = false;
+    thread_cpu_time_ns = 0L;
+    m_thread_cpu_time_ns_isSet = false;
+    fifo = new SWGSampleFifoStats();
+    m_fifo_isSet = false;
+}
+
+void
+SWGDSPSinkStats::cleanup() {
+    if(name != nullptr) { 
+        delete name;
+    }
+
+
+
+
+
+    if(fifo != nullptr) { 
+        delete fifo;
+    }
+}
+
+SWGDSPSinkStats*
+SWGDSPSinkStats::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGDSPSinkStats::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&name, pJson["name"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&threaded, pJson["threaded"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_samples, pJson["nbSamples"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&processing_time_ns, pJson["processingTimeNs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&max_latency_ns, pJson["maxLatencyNs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&thread_cpu_time_ns, pJson["threadCpuTimeNs"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&fifo, pJson["fifo"], "SWGSampleFifoStats", "SWGSampleFifoStats");
+    
+}
+
+QString
+SWGDSPSinkStats::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGDSPSinkStats::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(name != nullptr && *name != QString("")){
+        toJsonValue(QString("name"), name, obj, QString("QString"));
+    }
+    if(m_threaded_isSet){
+        obj->insert("threaded", QJsonValue(threaded));
+    }
+    if(m_nb_samples_isSet){
+        obj->insert("nbSamples", QJsonValue(nb_samples));
+    }
+    if(m_processing_time_ns_isSet){
+        obj->insert("processingTimeNs", QJsonValue(processing_time_ns));
+    }
+    if(m_max_latency_ns_isSet){
+        obj->insert("maxLatencyNs", QJsonValue(max_latency_ns));
+    }
+    if(m_thread_cpu_time_ns_isSet){
+        obj->insert("threadCpuTimeNs", QJsonValue(thread_cpu_time_ns));
+    }
+    if((fifo != nullptr) && (fifo->isSet())){
+        toJsonValue(QString("fifo"), fifo, obj, QString("SWGSampleFifoStats"));
+    }
+
+    return obj;
+}
+
+QString*
+SWGDSPSinkStats::getName() {
+    return name;
+}
+void
+SWGDSPSinkStats::setName(QString* name) {
+    this->name = name;
+    this->m_name_isSet = true;
+}
+
+qint32
+SWGDSPSinkStats::getThreaded() {
+    return threaded;
+}
+void
+SWGDSPSinkStats::setThreaded(qint32 threaded) {
+    this->threaded = threaded;
+    this->m_threaded_isSet = true;
+}
+
+qint64
+SWGDSPSinkStats::getNbSamples() {
+    return nb_samples;
+}
+void
+SWGDSPSinkStats::setNbSamples(qint64 nb_samples) {
+    this->nb_samples = nb_samples;
+    this->m_nb_samples_isSet = true;
+}
+
+qint64
+SWGDSPSinkStats::getProcessingTimeNs() {
+    return processing_time_ns;
+}
+void
+SWGDSPSinkStats::setProcessingTimeNs(qint64 processing_time_ns) {
+    this->processing_time_ns = processing_time_ns;
+    this->m_processing_time_ns_isSet = true;
+}
+
+qint64
+SWGDSPSinkStats::getMaxLatencyNs() {
+    return max_latency_ns;
+}
+void
+SWGDSPSinkStats::setMaxLatencyNs(qint64 max_latency_ns) {
+    this->max_latency_ns = max_latency_ns;
+    this->m_max_latency_ns_isSet = true;
+}
+
+qint64
+SWGDSPSinkStats::getThreadCpuTimeNs() {
+    return thread_cpu_time_ns;
+}
+void
+SWGDSPSinkStats::setThreadCpuTimeNs(qint64 thread_cpu_time_ns) {
+    this->thread_cpu_time_ns = thread_cpu_time_ns;
+    this->m_thread_cpu_time_ns_isSet = true;
+}
+
+SWGSampleFifoStats*
+SWGDSPSinkStats::getFifo() {
+    return fifo;
+}
+void
+SWGDSPSinkStats::setFifo(SWGSampleFifoStats* fifo) {
+    this->fifo = fifo;
+    this->m_fifo_isSet = true;
+}
+
+
+bool
+SWGDSPSinkStats::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(name != nullptr && *name != QString("")){ isObjectUpdated = true; break;}
+        if(m_threaded_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_samples_isSet){ isObjectUpdated = true; break;}
+        if(m_processing_time_ns_isSet){ isObjectUpdated = true; break;}
+        if(m_max_latency_ns_isSet){ isObjectUpdated = true; break;}
+        if(m_thread_cpu_time_ns_isSet){ isObjectUpdated = true; break;}
+        if(fifo != nullptr && fifo->isSet()){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,96 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGDSPSinkStats.h
+ *
+ * Processing statistics of a baseband sample sink (channel, spectrum, recorder...)
+ */
+
+#ifndef SWGDSPSinkStats_H_
+#define SWGDSPSinkStats_H_
+
+#include <QJsonObject>
+
+
+#include "SWGSampleFifoStats.h"
+#include <QString>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGDSPSinkStats: public SWGObject {
+public:
+    SWGDSPSinkStats();
+    SWGDSPSinkStats(QString* json);
+    virtual ~SWGDSPSinkStats();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGDSPSinkStats* fromJson(QString &jsonString) override;
+
+    QString* getName();
+    void setName(QString* name);
+
+    qint32 getThreaded();
+    void setThreaded(qint32 threaded);
+
+    qint64 getNbSamples();
+    void setNbSamples(qint64 nb_samples);
+
+    qint64 getProcessingTimeNs();
+    void setProcessingTimeNs(qint64 processing_time_ns);
+
+    qint64 getMaxLatencyNs();
+    void setMaxLatencyNs(qint64 max_latency_ns);
+
+    qint64 getThreadCpuTimeNs();
+    void setThreadCpuTimeNs(qint64 thread_cpu_time_ns);
+
+    SWGSampleFifoStats* getFifo();
+    void setFifo(SWGSampleFifoStats* fifo);
+
+
+    virtual bool isSet() override;
+
+private:
+    QString* name;
+    bool m_name_isSet;
+
+    qint32 threaded;
+    bool m_threaded_isSet;
+
+    qint64 nb_samples;
+    bool m_nb_samples_isSet;
+
+    qint64 processing_time_ns;
+    bool m_processing_time_ns_isSet;
+
+    qint64 max_latency_ns;
+    bool m_max_latency_ns_isSet;
+
+    qint64 thread_cpu_time_ns;
+    bool m_thread_cpu_time_ns_isSet;
+
+    SWGSampleFifoStats* fifo;
+    bool m_fifo_isSet;
+
+};
+
+}
+
+#endif /* SWGDSPSinkStats_H_ */
@@ -36,6 +36,8 @@ SWGDaemonSinkSettings::SWGDaemonSinkSettings() {
     m_data_port_isSet = false;
     tx_delay = 0;
     m_tx_delay_isSet = false;
+    use_gso = 0;
+    m_use_gso_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = nullptr;
@@ -56,6 +58,8 @@ SWGDaemonSinkSettings::init() {
     m_data_port_isSet = false;
     tx_delay = 0;
     m_tx_delay_isSet = false;
+    use_gso = 0;
+    m_use_gso_isSet = false;
     rgb_color = 0;
     m_rgb_color_isSet = false;
     title = new QString("");
@@ -71,6 +75,7 @@ SWGDaemonSinkSettings::cleanup() {
 
 
 
+
     if(title != nullptr) { 
         delete title;
     }
@@ -95,6 +100,8 @@ SWGDaemonSinkSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&tx_delay, pJson["txDelay"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&use_gso, pJson["useGSO"], "qint32", "");
+    
     ::SWGSDRangel::setValue(&rgb_color, pJson["rgbColor"], "qint32", "");
     
     ::SWGSDRangel::setValue(&title, pJson["title"], "QString", "QString");
@@ -127,6 +134,9 @@ SWGDaemonSinkSettings::asJsonObject() {
     if(m_tx_delay_isSet){
         obj->insert("txDelay", QJsonValue(tx_delay));
     }
+    if(m_use_gso_isSet){
+        obj->insert("useGSO", QJsonValue(use_gso));
+    }
     if(m_rgb_color_isSet){
         obj->insert("rgbColor", QJsonValue(rgb_color));
     }
@@ -177,6 +187,16 @@ SWGDaemonSinkSettings::setTxDelay(qint32 tx_delay) {
     this->m_tx_delay_isSet = true;
 }
 
+qint32
+SWGDaemonSinkSettings::getUseGso() {
+    return use_gso;
+}
+void
+SWGDaemonSinkSettings::setUseGso(qint32 use_gso) {
+    this->use_gso = use_gso;
+    this->m_use_gso_isSet = true;
+}
+
 qint32
 SWGDaemonSinkSettings::getRgbColor() {
     return rgb_color;
@@ -206,6 +226,7 @@ SWGDaemonSinkSettings::isSet(){
         if(data_address != nullptr && *data_address != QString("")){ isObjectUpdated = true; break;}
         if(m_data_port_isSet){ isObjectUpdated = true; break;}
         if(m_tx_delay_isSet){ isObjectUpdated = true; break;}
+        if(m_use_gso_isSet){ isObjectUpdated = true; break;}
         if(m_rgb_color_isSet){ isObjectUpdated = true; break;}
         if(title != nullptr && *title != QString("")){ isObjectUpdated = true; break;}
     }while(false);
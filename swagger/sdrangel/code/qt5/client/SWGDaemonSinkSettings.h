@@ -54,6 +54,9 @@ public:
     qint32 getTxDelay();
     void setTxDelay(qint32 tx_delay);
 
+    qint32 getUseGso();
+    void setUseGso(qint32 use_gso);
+
     qint32 getRgbColor();
     void setRgbColor(qint32 rgb_color);
 
@@ -76,6 +79,9 @@ private:
     qint32 tx_delay;
     bool m_tx_delay_isSet;
 
+    qint32 use_gso;
+    bool m_use_gso_isSet;
+
     qint32 rgb_color;
     bool m_rgb_color_isSet;
 
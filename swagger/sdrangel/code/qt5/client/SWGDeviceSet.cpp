@@ -34,6 +34,10 @@ SWGDeviceSet::SWGDeviceSet() {
     m_channelcount_isSet = false;
     channels = nullptr;
     m_channels_isSet = false;
+    sample_fifo = nullptr;
+    m_sample_fifo_isSet = false;
+    dsp_sinks = nullptr;
+    m_dsp_sinks_isSet = false;
 }
 
 SWGDeviceSet::~SWGDeviceSet() {
@@ -48,6 +52,10 @@ SWGDeviceSet::init() {
     m_channelcount_isSet = false;
     channels = new QList<SWGChannel*>();
     m_channels_isSet = false;
+    sample_fifo = new SWGSampleFifoStats();
+    m_sample_fifo_isSet = false;
+    dsp_sinks = new QList<SWGDSPSinkStats*>();
+    m_dsp_sinks_isSet = false;
 }
 
 void
@@ -63,6 +71,16 @@ SWGDeviceSet::cleanup() {
         }
         delete channels;
     }
+    if(sample_fifo != nullptr) { 
+        delete sample_fifo;
+    }
+    if(dsp_sinks != nullptr) { 
+        auto arr = dsp_sinks;
+        for(auto o: *arr) { 
+            delete o;
+        }
+        delete dsp_sinks;
+    }
 }
 
 SWGDeviceSet*
@@ -82,6 +100,10 @@ SWGDeviceSet::fromJsonObject(QJsonObject &pJson) {
     
     
     ::SWGSDRangel::setValue(&channels, pJson["channels"], "QList", "SWGChannel");
+    ::SWGSDRangel::setValue(&sample_fifo, pJson["sampleFifo"], "SWGSampleFifoStats", "SWGSampleFifoStats");
+    
+    
+    ::SWGSDRangel::setValue(&dsp_sinks, pJson["dspSinks"], "QList", "SWGDSPSinkStats");
 }
 
 QString
@@ -107,6 +129,12 @@ SWGDeviceSet::asJsonObject() {
     if(channels->size() > 0){
         toJsonArray((QList<void*>*)channels, obj, "channels", "SWGChannel");
     }
+    if((sample_fifo != nullptr) && (sample_fifo->isSet())){
+        toJsonValue(QString("sampleFifo"), sample_fifo, obj, QString("SWGSampleFifoStats"));
+    }
+    if(dsp_sinks->size() > 0){
+        toJsonArray((QList<void*>*)dsp_sinks, obj, "dspSinks", "SWGDSPSinkStats");
+    }
 
     return obj;
 }
@@ -141,6 +169,26 @@ SWGDeviceSet::setChannels(QList<SWGChannel*>* channels) {
     this->m_channels_isSet = true;
 }
 
+SWGSampleFifoStats*
+SWGDeviceSet::getSampleFifo() {
+    return sample_fifo;
+}
+void
+SWGDeviceSet::setSampleFifo(SWGSampleFifoStats* sample_fifo) {
+    this->sample_fifo = sample_fifo;
+    this->m_sample_fifo_isSet = true;
+}
+
+QList<SWGDSPSinkStats*>*
+SWGDeviceSet::getDspSinks() {
+    return dsp_sinks;
+}
+void
+SWGDeviceSet::setDspSinks(QList<SWGDSPSinkStats*>* dsp_sinks) {
+    this->dsp_sinks = dsp_sinks;
+    this->m_dsp_sinks_isSet = true;
+}
+
 
 bool
 SWGDeviceSet::isSet(){
@@ -149,6 +197,8 @@ SWGDeviceSet::isSet(){
         if(sampling_device != nullptr && sampling_device->isSet()){ isObjectUpdated = true; break;}
         if(m_channelcount_isSet){ isObjectUpdated = true; break;}
         if(channels->size() > 0){ isObjectUpdated = true; break;}
+        if(sample_fifo != nullptr && sample_fifo->isSet()){ isObjectUpdated = true; break;}
+        if(dsp_sinks->size() > 0){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -23,6 +23,8 @@
 
 
 #include "SWGChannel.h"
+#include "SWGDSPSinkStats.h"
+#include "SWGSampleFifoStats.h"
 #include "SWGSamplingDevice.h"
 #include <QList>
 
@@ -53,6 +55,12 @@ public:
     QList<SWGChannel*>* getChannels();
     void setChannels(QList<SWGChannel*>* channels);
 
+    SWGSampleFifoStats* getSampleFifo();
+    void setSampleFifo(SWGSampleFifoStats* sample_fifo);
+
+    QList<SWGDSPSinkStats*>* getDspSinks();
+    void setDspSinks(QList<SWGDSPSinkStats*>* dsp_sinks);
+
 
     virtual bool isSet() override;
 
@@ -66,6 +74,12 @@ private:
     QList<SWGChannel*>* channels;
     bool m_channels_isSet;
 
+    SWGSampleFifoStats* sample_fifo;
+    bool m_sample_fifo_isSet;
+
+    QList<SWGDSPSinkStats*>* dsp_sinks;
+    bool m_dsp_sinks_isSet;
+
 };
 
 }
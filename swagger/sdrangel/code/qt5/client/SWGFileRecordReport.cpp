@@ -0,0 +1,253 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGFileRecordReport.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGFileRecordReport::SWGFileRecordReport(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGFileRecordReport::SWGFileRecordReport() {
+    recording = 0;
+    m_recording_isSet = false;
+    written_bytes = 0L;
+    m_written_bytes_isSet = false;
+    dropped_blocks = 0L;
+    m_dropped_blocks_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+    pending_blocks = 0;
+    m_pending_blocks_isSet = false;
+    last_write_latency_us = 0;
+    m_last_write_latency_us_isSet = false;
+    max_write_latency_us = 0;
+    m_max_write_latency_us_isSet = false;
+    avg_write_latency_us = 0;
+    m_avg_write_latency_us_isSet = false;
+}
+
+SWGFileRecordReport::~SWGFileRecordReport() {
+    this->cleanup();
+}
+
+void
+SWGFileRecordReport::init() {
+    recording = 0;
+    m_recording_isSet = false;
+    written_bytes = 0L;
+    m_written_bytes_isSet = false;
+    dropped_blocks = 0L;
+    m_dropped_blocks_isSet = false;
+    dropped_bytes = 0L;
+    m_dropped_bytes_isSet = false;
+    pending_blocks = 0;
+    m_pending_blocks_isSet = false;
+    last_write_latency_us = 0;
+    m_last_write_latency_us_isSet = false;
+    max_write_latency_us = 0;
+    m_max_write_latency_us_isSet = false;
+    avg_write_latency_us = 0;
+    m_avg_write_latency_us_isSet = false;
+}
+
+void
+SWGFileRecordReport::cleanup() {
+
+
+
+
+
+
+
+
+}
+
+SWGFileRecordReport*
+SWGFileRecordReport::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGFileRecordReport::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&recording, pJson["recording"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&written_bytes, pJson["writtenBytes"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped_blocks, pJson["droppedBlocks"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&dropped_bytes, pJson["droppedBytes"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&pending_blocks, pJson["pendingBlocks"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&last_write_latency_us, pJson["lastWriteLatencyUs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&max_write_latency_us, pJson["maxWriteLatencyUs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&avg_write_latency_us, pJson["avgWriteLatencyUs"], "qint32", "");
+    
+}
+
+QString
+SWGFileRecordReport::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGFileRecordReport::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_recording_isSet){
+        obj->insert("recording", QJsonValue(recording));
+    }
+    if(m_written_bytes_isSet){
+        obj->insert("writtenBytes", QJsonValue(written_bytes));
+    }
+    if(m_dropped_blocks_isSet){
+        obj->insert("droppedBlocks", QJsonValue(dropped_blocks));
+    }
+    if(m_dropped_bytes_isSet){
+        obj->insert("droppedBytes", QJsonValue(dropped_bytes));
+    }
+    if(m_pending_blocks_isSet){
+        obj->insert("pendingBlocks", QJsonValue(pending_blocks));
+    }
+    if(m_last_write_latency_us_isSet){
+        obj->insert("lastWriteLatencyUs", QJsonValue(last_write_latency_us));
+    }
+    if(m_max_write_latency_us_isSet){
+        obj->insert("maxWriteLatencyUs", QJsonValue(max_write_latency_us));
+    }
+    if(m_avg_write_latency_us_isSet){
+        obj->insert("avgWriteLatencyUs", QJsonValue(avg_write_latency_us));
+    }
+
+    return obj;
+}
+
+qint32
+SWGFileRecordReport::getRecording() {
+    return recording;
+}
+void
+SWGFileRecordReport::setRecording(qint32 recording) {
+    this->recording = recording;
+    this->m_recording_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getWrittenBytes() {
+    return written_bytes;
+}
+void
+SWGFileRecordReport::setWrittenBytes(qint64 written_bytes) {
+    this->written_bytes = written_bytes;
+    this->m_written_bytes_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getDroppedBlocks() {
+    return dropped_blocks;
+}
+void
+SWGFileRecordReport::setDroppedBlocks(qint64 dropped_blocks) {
+    this->dropped_blocks = dropped_blocks;
+    this->m_dropped_blocks_isSet = true;
+}
+
+qint64
+SWGFileRecordReport::getDroppedBytes() {
+    return dropped_bytes;
+}
+void
+SWGFileRecordReport::setDroppedBytes(qint64 dropped_bytes) {
+    this->dropped_bytes = dropped_bytes;
+    this->m_dropped_bytes_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getPendingBlocks() {
+    return pending_blocks;
+}
+void
+SWGFileRecordReport::setPendingBlocks(qint32 pending_blocks) {
+    this->pending_blocks = pending_blocks;
+    this->m_pending_blocks_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getLastWriteLatencyUs() {
+    return last_write_latency_us;
+}
+void
+SWGFileRecordReport::setLastWriteLatencyUs(qint32 last_write_latency_us) {
+    this->last_write_latency_us = last_write_latency_us;
+    this->m_last_write_latency_us_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getMaxWriteLatencyUs() {
+    return max_write_latency_us;
+}
+void
+SWGFileRecordReport::setMaxWriteLatencyUs(qint32 max_write_latency_us) {
+    this->max_write_latency_us = max_write_latency_us;
+    this->m_max_write_latency_us_isSet = true;
+}
+
+qint32
+SWGFileRecordReport::getAvgWriteLatencyUs() {
+    return avg_write_latency_us;
+}
+void
+SWGFileRecordReport::setAvgWriteLatencyUs(qint32 avg_write_latency_us) {
+    this->avg_write_latency_us = avg_write_latency_us;
+    this->m_avg_write_latency_us_isSet = true;
+}
+
+
+bool
+SWGFileRecordReport::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_recording_isSet){ isObjectUpdated = true; break;}
+        if(m_written_bytes_isSet){ isObjectUpdated = true; break;}
+        if(m_dropped_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_dropped_bytes_isSet){ isObjectUpdated = true; break;}
+        if(m_pending_blocks_isSet){ isObjectUpdated = true; break;}
+        if(m_last_write_latency_us_isSet){ isObjectUpdated = true; break;}
+        if(m_max_write_latency_us_isSet){ isObjectUpdated = true; break;}
+        if(m_avg_write_latency_us_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -34,6 +34,8 @@ SWGFileSourceSettings::SWGFileSourceSettings() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
 }
 
 SWGFileSourceSettings::~SWGFileSourceSettings() {
@@ -48,6 +50,8 @@ SWGFileSourceSettings::init() {
     m_acceleration_factor_isSet = false;
     loop = 0;
     m_loop_isSet = false;
+    as_fast_as_possible = 0;
+    m_as_fast_as_possible_isSet = false;
 }
 
 void
@@ -57,6 +61,7 @@ SWGFileSourceSettings::cleanup() {
     }
 
 
+
 }
 
 SWGFileSourceSettings*
@@ -76,6 +81,8 @@ SWGFileSourceSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&loop, pJson["loop"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&as_fast_as_possible, pJson["asFastAsPossible"], "qint32", "");
+    
 }
 
 QString
@@ -101,6 +108,9 @@ SWGFileSourceSettings::asJsonObject() {
     if(m_loop_isSet){
         obj->insert("loop", QJsonValue(loop));
     }
+    if(m_as_fast_as_possible_isSet){
+        obj->insert("asFastAsPossible", QJsonValue(as_fast_as_possible));
+    }
 
     return obj;
 }
@@ -135,6 +145,16 @@ SWGFileSourceSettings::setLoop(qint32 loop) {
     this->m_loop_isSet = true;
 }
 
+qint32
+SWGFileSourceSettings::getAsFastAsPossible() {
+    return as_fast_as_possible;
+}
+void
+SWGFileSourceSettings::setAsFastAsPossible(qint32 as_fast_as_possible) {
+    this->as_fast_as_possible = as_fast_as_possible;
+    this->m_as_fast_as_possible_isSet = true;
+}
+
 
 bool
 SWGFileSourceSettings::isSet(){
@@ -143,6 +163,7 @@ SWGFileSourceSettings::isSet(){
         if(file_name != nullptr && *file_name != QString("")){ isObjectUpdated = true; break;}
         if(m_acceleration_factor_isSet){ isObjectUpdated = true; break;}
         if(m_loop_isSet){ isObjectUpdated = true; break;}
+        if(m_as_fast_as_possible_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
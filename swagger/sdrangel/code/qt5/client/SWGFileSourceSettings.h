@@ -51,6 +51,9 @@ public:
     qint32 getLoop();
     void setLoop(qint32 loop);
 
+    qint32 getAsFastAsPossible();
+    void setAsFastAsPossible(qint32 as_fast_as_possible);
+
 
     virtual bool isSet() override;
 
@@ -64,6 +67,9 @@ private:
     qint32 loop;
     bool m_loop_isSet;
 
+    qint32 as_fast_as_possible;
+    bool m_as_fast_as_possible_isSet;
+
 };
 
 }
@@ -48,6 +48,8 @@ SWGLimeSdrInputReport::SWGLimeSdrInputReport() {
     m_hw_timestamp_isSet = false;
     temperature = 0.0f;
     m_temperature_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGLimeSdrInputReport::~SWGLimeSdrInputReport() {
@@ -76,6 +78,8 @@ SWGLimeSdrInputReport::init() {
     m_hw_timestamp_isSet = false;
     temperature = 0.0f;
     m_temperature_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -90,6 +94,9 @@ SWGLimeSdrInputReport::cleanup() {
 
 
 
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGLimeSdrInputReport*
@@ -123,6 +130,8 @@ SWGLimeSdrInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&temperature, pJson["temperature"], "float", "");
     
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -169,6 +178,9 @@ SWGLimeSdrInputReport::asJsonObject() {
     if(m_temperature_isSet){
         obj->insert("temperature", QJsonValue(temperature));
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -273,6 +285,16 @@ SWGLimeSdrInputReport::setTemperature(float temperature) {
     this->m_temperature_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGLimeSdrInputReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGLimeSdrInputReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGLimeSdrInputReport::isSet(){
@@ -288,6 +310,7 @@ SWGLimeSdrInputReport::isSet(){
         if(m_link_rate_isSet){ isObjectUpdated = true; break;}
         if(m_hw_timestamp_isSet){ isObjectUpdated = true; break;}
         if(m_temperature_isSet){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGFileRecordReport.h"
 
 #include "SWGObject.h"
 #include "export.h"
@@ -71,6 +72,9 @@ public:
     float getTemperature();
     void setTemperature(float temperature);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -105,6 +109,9 @@ private:
     float temperature;
     bool m_temperature_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
@@ -44,6 +44,7 @@
 #include "SWGChannelsDetail.h"
 #include "SWGDSDDemodReport.h"
 #include "SWGDSDDemodSettings.h"
+#include "SWGDSPSinkStats.h"
 #include "SWGDVSeralDevices.h"
 #include "SWGDVSerialDevice.h"
 #include "SWGDaemonSinkSettings.h"
@@ -58,6 +59,7 @@
 #include "SWGErrorResponse.h"
 #include "SWGFCDProPlusSettings.h"
 #include "SWGFCDProSettings.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFileSourceReport.h"
 #include "SWGFileSourceSettings.h"
 #include "SWGFrequency.h"
@@ -108,10 +110,14 @@
 #include "SWGSSBDemodSettings.h"
 #include "SWGSSBModReport.h"
 #include "SWGSSBModSettings.h"
+#include "SWGSampleFifoStats.h"
 #include "SWGSampleRate.h"
 #include "SWGSamplingDevice.h"
+#include "SWGSpectrumFrame.h"
 #include "SWGSuccessResponse.h"
 #include "SWGTestSourceSettings.h"
+#include "SWGThreadRole.h"
+#include "SWGThreadRoles.h"
 #include "SWGUDPSinkReport.h"
 #include "SWGUDPSinkSettings.h"
 #include "SWGUDPSourceReport.h"
@@ -214,6 +220,9 @@ namespace SWGSDRangel {
     if(QString("SWGDSDDemodSettings").compare(type) == 0) {
       return new SWGDSDDemodSettings();
     }
+    if(QString("SWGDSPSinkStats").compare(type) == 0) {
+      return new SWGDSPSinkStats();
+    }
     if(QString("SWGDVSeralDevices").compare(type) == 0) {
       return new SWGDVSeralDevices();
     }
@@ -256,6 +265,9 @@ namespace SWGSDRangel {
     if(QString("SWGFCDProSettings").compare(type) == 0) {
       return new SWGFCDProSettings();
     }
+    if(QString("SWGFileRecordReport").compare(type) == 0) {
+      return new SWGFileRecordReport();
+    }
     if(QString("SWGFileSourceReport").compare(type) == 0) {
       return new SWGFileSourceReport();
     }
@@ -406,18 +418,30 @@ namespace SWGSDRangel {
     if(QString("SWGSSBModSettings").compare(type) == 0) {
       return new SWGSSBModSettings();
     }
+    if(QString("SWGSampleFifoStats").compare(type) == 0) {
+      return new SWGSampleFifoStats();
+    }
     if(QString("SWGSampleRate").compare(type) == 0) {
       return new SWGSampleRate();
     }
     if(QString("SWGSamplingDevice").compare(type) == 0) {
       return new SWGSamplingDevice();
     }
+    if(QString("SWGSpectrumFrame").compare(type) == 0) {
+      return new SWGSpectrumFrame();
+    }
     if(QString("SWGSuccessResponse").compare(type) == 0) {
       return new SWGSuccessResponse();
     }
     if(QString("SWGTestSourceSettings").compare(type) == 0) {
       return new SWGTestSourceSettings();
     }
+    if(QString("SWGThreadRole").compare(type) == 0) {
+      return new SWGThreadRole();
+    }
+    if(QString("SWGThreadRoles").compare(type) == 0) {
+      return new SWGThreadRoles();
+    }
     if(QString("SWGUDPSinkReport").compare(type) == 0) {
       return new SWGUDPSinkReport();
     }
@@ -56,6 +56,8 @@ SWGNFMDemodSettings::SWGNFMDemodSettings() {
     m_title_isSet = false;
     audio_device_name = nullptr;
     m_audio_device_name_isSet = false;
+    pfb_channels = 0;
+    m_pfb_channels_isSet = false;
 }
 
 SWGNFMDemodSettings::~SWGNFMDemodSettings() {
@@ -92,6 +94,8 @@ SWGNFMDemodSettings::init() {
     m_title_isSet = false;
     audio_device_name = new QString("");
     m_audio_device_name_isSet = false;
+    pfb_channels = 0;
+    m_pfb_channels_isSet = false;
 }
 
 void
@@ -114,6 +118,7 @@ SWGNFMDemodSettings::cleanup() {
     if(audio_device_name != nullptr) { 
         delete audio_device_name;
     }
+
 }
 
 SWGNFMDemodSettings*
@@ -155,6 +160,8 @@ SWGNFMDemodSettings::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&audio_device_name, pJson["audioDeviceName"], "QString", "QString");
     
+    ::SWGSDRangel::setValue(&pfb_channels, pJson["pfbChannels"], "qint32", "");
+    
 }
 
 QString
@@ -213,6 +220,9 @@ SWGNFMDemodSettings::asJsonObject() {
     if(audio_device_name != nullptr && *audio_device_name != QString("")){
         toJsonValue(QString("audioDeviceName"), audio_device_name, obj, QString("QString"));
     }
+    if(m_pfb_channels_isSet){
+        obj->insert("pfbChannels", QJsonValue(pfb_channels));
+    }
 
     return obj;
 }
@@ -357,6 +367,16 @@ SWGNFMDemodSettings::setAudioDeviceName(QString* audio_device_name) {
     this->m_audio_device_name_isSet = true;
 }
 
+qint32
+SWGNFMDemodSettings::getPfbChannels() {
+    return pfb_channels;
+}
+void
+SWGNFMDemodSettings::setPfbChannels(qint32 pfb_channels) {
+    this->pfb_channels = pfb_channels;
+    this->m_pfb_channels_isSet = true;
+}
+
 
 bool
 SWGNFMDemodSettings::isSet(){
@@ -376,6 +396,7 @@ SWGNFMDemodSettings::isSet(){
         if(m_rgb_color_isSet){ isObjectUpdated = true; break;}
         if(title != nullptr && *title != QString("")){ isObjectUpdated = true; break;}
         if(audio_device_name != nullptr && *audio_device_name != QString("")){ isObjectUpdated = true; break;}
+        if(m_pfb_channels_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -84,6 +84,9 @@ public:
     QString* getAudioDeviceName();
     void setAudioDeviceName(QString* audio_device_name);
 
+    qint32 getPfbChannels();
+    void setPfbChannels(qint32 pfb_channels);
+
 
     virtual bool isSet() override;
 
@@ -130,6 +133,9 @@ private:
     QString* audio_device_name;
     bool m_audio_device_name_isSet;
 
+    qint32 pfb_channels;
+    bool m_pfb_channels_isSet;
+
 };
 
 }
@@ -30,6 +30,8 @@ SWGPerseusReport::SWGPerseusReport(QString* json) {
 SWGPerseusReport::SWGPerseusReport() {
     sample_rates = nullptr;
     m_sample_rates_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGPerseusReport::~SWGPerseusReport() {
@@ -40,6 +42,8 @@ void
 SWGPerseusReport::init() {
     sample_rates = new QList<SWGSampleRate*>();
     m_sample_rates_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -51,6 +55,9 @@ SWGPerseusReport::cleanup() {
         }
         delete sample_rates;
     }
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGPerseusReport*
@@ -66,6 +73,8 @@ void
 SWGPerseusReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&sample_rates, pJson["sampleRates"], "QList", "SWGSampleRate");
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -85,6 +94,9 @@ SWGPerseusReport::asJsonObject() {
     if(sample_rates->size() > 0){
         toJsonArray((QList<void*>*)sample_rates, obj, "sampleRates", "SWGSampleRate");
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -99,12 +111,23 @@ SWGPerseusReport::setSampleRates(QList<SWGSampleRate*>* sample_rates) {
     this->m_sample_rates_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGPerseusReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGPerseusReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGPerseusReport::isSet(){
     bool isObjectUpdated = false;
     do{
         if(sample_rates->size() > 0){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -36,6 +36,8 @@ SWGPlutoSdrInputReport::SWGPlutoSdrInputReport() {
     m_gain_db_isSet = false;
     temperature = 0.0f;
     m_temperature_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGPlutoSdrInputReport::~SWGPlutoSdrInputReport() {
@@ -52,6 +54,8 @@ SWGPlutoSdrInputReport::init() {
     m_gain_db_isSet = false;
     temperature = 0.0f;
     m_temperature_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -62,6 +66,9 @@ SWGPlutoSdrInputReport::cleanup() {
     }
 
 
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGPlutoSdrInputReport*
@@ -83,6 +90,8 @@ SWGPlutoSdrInputReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&temperature, pJson["temperature"], "float", "");
     
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -111,6 +120,9 @@ SWGPlutoSdrInputReport::asJsonObject() {
     if(m_temperature_isSet){
         obj->insert("temperature", QJsonValue(temperature));
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -155,6 +167,16 @@ SWGPlutoSdrInputReport::setTemperature(float temperature) {
     this->m_temperature_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGPlutoSdrInputReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGPlutoSdrInputReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGPlutoSdrInputReport::isSet(){
@@ -164,6 +186,7 @@ SWGPlutoSdrInputReport::isSet(){
         if(rssi != nullptr && *rssi != QString("")){ isObjectUpdated = true; break;}
         if(m_gain_db_isSet){ isObjectUpdated = true; break;}
         if(m_temperature_isSet){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
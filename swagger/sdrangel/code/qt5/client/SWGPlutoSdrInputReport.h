@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGFileRecordReport.h"
 #include <QString>
 
 #include "SWGObject.h"
@@ -54,6 +55,9 @@ public:
     float getTemperature();
     void setTemperature(float temperature);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -70,6 +74,9 @@ private:
     float temperature;
     bool m_temperature_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
@@ -30,6 +30,8 @@ SWGRtlSdrReport::SWGRtlSdrReport(QString* json) {
 SWGRtlSdrReport::SWGRtlSdrReport() {
     gains = nullptr;
     m_gains_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGRtlSdrReport::~SWGRtlSdrReport() {
@@ -40,6 +42,8 @@ void
 SWGRtlSdrReport::init() {
     gains = new QList<SWGGain*>();
     m_gains_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -51,6 +55,9 @@ SWGRtlSdrReport::cleanup() {
         }
         delete gains;
     }
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGRtlSdrReport*
@@ -66,6 +73,8 @@ void
 SWGRtlSdrReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&gains, pJson["gains"], "QList", "SWGGain");
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -85,6 +94,9 @@ SWGRtlSdrReport::asJsonObject() {
     if(gains->size() > 0){
         toJsonArray((QList<void*>*)gains, obj, "gains", "SWGGain");
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -99,12 +111,23 @@ SWGRtlSdrReport::setGains(QList<SWGGain*>* gains) {
     this->m_gains_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGRtlSdrReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGRtlSdrReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGRtlSdrReport::isSet(){
     bool isObjectUpdated = false;
     do{
         if(gains->size() > 0){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
@@ -22,6 +22,7 @@
 #include <QJsonObject>
 
 
+#include "SWGFileRecordReport.h"
 #include "SWGGain.h"
 #include <QList>
 
@@ -46,6 +47,9 @@ public:
     QList<SWGGain*>* getGains();
     void setGains(QList<SWGGain*>* gains);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -53,6 +57,9 @@ private:
     QList<SWGGain*>* gains;
     bool m_gains_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
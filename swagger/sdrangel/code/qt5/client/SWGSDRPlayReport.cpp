@@ -36,6 +36,8 @@ SWGSDRPlayReport::SWGSDRPlayReport() {
     m_intermediate_frequencies_isSet = false;
     frequency_bands = nullptr;
     m_frequency_bands_isSet = false;
+    file_record = nullptr;
+    m_file_record_isSet = false;
 }
 
 SWGSDRPlayReport::~SWGSDRPlayReport() {
@@ -52,6 +54,8 @@ SWGSDRPlayReport::init() {
     m_intermediate_frequencies_isSet = false;
     frequency_bands = new QList<SWGFrequencyBand*>();
     m_frequency_bands_isSet = false;
+    file_record = new SWGFileRecordReport();
+    m_file_record_isSet = false;
 }
 
 void
@@ -84,6 +88,9 @@ SWGSDRPlayReport::cleanup() {
         }
         delete frequency_bands;
     }
+    if(file_record != nullptr) { 
+        delete file_record;
+    }
 }
 
 SWGSDRPlayReport*
@@ -105,6 +112,8 @@ SWGSDRPlayReport::fromJsonObject(QJsonObject &pJson) {
     ::SWGSDRangel::setValue(&intermediate_frequencies, pJson["intermediateFrequencies"], "QList", "SWGFrequency");
     
     ::SWGSDRangel::setValue(&frequency_bands, pJson["frequencyBands"], "QList", "SWGFrequencyBand");
+    ::SWGSDRangel::setValue(&file_record, pJson["fileRecord"], "SWGFileRecordReport", "SWGFileRecordReport");
+    
 }
 
 QString
@@ -133,6 +142,9 @@ SWGSDRPlayReport::asJsonObject() {
     if(frequency_bands->size() > 0){
         toJsonArray((QList<void*>*)frequency_bands, obj, "frequencyBands", "SWGFrequencyBand");
     }
+    if((file_record != nullptr) && (file_record->isSet())){
+        toJsonValue(QString("fileRecord"), file_record, obj, QString("SWGFileRecordReport"));
+    }
 
     return obj;
 }
@@ -177,6 +189,16 @@ SWGSDRPlayReport::setFrequencyBands(QList<SWGFrequencyBand*>* frequency_bands) {
     this->m_frequency_bands_isSet = true;
 }
 
+SWGFileRecordReport*
+SWGSDRPlayReport::getFileRecord() {
+    return file_record;
+}
+void
+SWGSDRPlayReport::setFileRecord(SWGFileRecordReport* file_record) {
+    this->file_record = file_record;
+    this->m_file_record_isSet = true;
+}
+
 
 bool
 SWGSDRPlayReport::isSet(){
@@ -186,6 +208,7 @@ SWGSDRPlayReport::isSet(){
         if(bandwidths->size() > 0){ isObjectUpdated = true; break;}
         if(intermediate_frequencies->size() > 0){ isObjectUpdated = true; break;}
         if(frequency_bands->size() > 0){ isObjectUpdated = true; break;}
+        if(file_record != nullptr && file_record->isSet()){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
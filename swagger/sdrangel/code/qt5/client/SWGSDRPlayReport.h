@@ -23,6 +23,7 @@
 
 
 #include "SWGBandwidth.h"
+#include "SWGFileRecordReport.h"
 #include "SWGFrequency.h"
 #include "SWGFrequencyBand.h"
 #include "SWGSampleRate.h"
@@ -58,6 +59,9 @@ public:
     QList<SWGFrequencyBand*>* getFrequencyBands();
     void setFrequencyBands(QList<SWGFrequencyBand*>* frequency_bands);
 
+    SWGFileRecordReport* getFileRecord();
+    void setFileRecord(SWGFileRecordReport* file_record);
+
 
     virtual bool isSet() override;
 
@@ -74,6 +78,9 @@ private:
     QList<SWGFrequencyBand*>* frequency_bands;
     bool m_frequency_bands_isSet;
 
+    SWGFileRecordReport* file_record;
+    bool m_file_record_isSet;
+
 };
 
 }
@@ -40,6 +40,12 @@ SWGSDRdaemonSourceReport::SWGSDRdaemonSourceReport() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    jitter_us = 0.0f;
+    m_jitter_us_isSet = false;
+    max_gap_us = 0;
+    m_max_gap_us_isSet = false;
+    nb_kernel_drops = 0;
+    m_nb_kernel_drops_isSet = false;
 }
 
 SWGSDRdaemonSourceReport::~SWGSDRdaemonSourceReport() {
@@ -60,6 +66,12 @@ SWGSDRdaemonSourceReport::init() {
     m_min_nb_blocks_isSet = false;
     max_nb_recovery = 0;
     m_max_nb_recovery_isSet = false;
+    jitter_us = 0.0f;
+    m_jitter_us_isSet = false;
+    max_gap_us = 0;
+    m_max_gap_us_isSet = false;
+    nb_kernel_drops = 0;
+    m_nb_kernel_drops_isSet = false;
 }
 
 void
@@ -72,6 +84,9 @@ SWGSDRdaemonSourceReport::cleanup() {
     }
 
 
+
+
+
 }
 
 SWGSDRdaemonSourceReport*
@@ -97,6 +112,12 @@ SWGSDRdaemonSourceReport::fromJsonObject(QJsonObject &pJson) {
     
     ::SWGSDRangel::setValue(&max_nb_recovery, pJson["maxNbRecovery"], "qint32", "");
     
+    ::SWGSDRangel::setValue(&jitter_us, pJson["jitterUs"], "float", "");
+    
+    ::SWGSDRangel::setValue(&max_gap_us, pJson["maxGapUs"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nb_kernel_drops, pJson["nbKernelDrops"], "qint32", "");
+    
 }
 
 QString
@@ -131,6 +152,15 @@ SWGSDRdaemonSourceReport::asJsonObject() {
     if(m_max_nb_recovery_isSet){
         obj->insert("maxNbRecovery", QJsonValue(max_nb_recovery));
     }
+    if(m_jitter_us_isSet){
+        obj->insert("jitterUs", QJsonValue(jitter_us));
+    }
+    if(m_max_gap_us_isSet){
+        obj->insert("maxGapUs", QJsonValue(max_gap_us));
+    }
+    if(m_nb_kernel_drops_isSet){
+        obj->insert("nbKernelDrops", QJsonValue(nb_kernel_drops));
+    }
 
     return obj;
 }
@@ -195,6 +225,36 @@ SWGSDRdaemonSourceReport::setMaxNbRecovery(qint32 max_nb_recovery) {
     this->m_max_nb_recovery_isSet = true;
 }
 
+float
+SWGSDRdaemonSourceReport::getJitterUs() {
+    return jitter_us;
+}
+void
+SWGSDRdaemonSourceReport::setJitterUs(float jitter_us) {
+    this->jitter_us = jitter_us;
+    this->m_jitter_us_isSet = true;
+}
+
+qint32
+SWGSDRdaemonSourceReport::getMaxGapUs() {
+    return max_gap_us;
+}
+void
+SWGSDRdaemonSourceReport::setMaxGapUs(qint32 max_gap_us) {
+    this->max_gap_us = max_gap_us;
+    this->m_max_gap_us_isSet = true;
+}
+
+qint32
+SWGSDRdaemonSourceReport::getNbKernelDrops() {
+    return nb_kernel_drops;
+}
+void
+SWGSDRdaemonSourceReport::setNbKernelDrops(qint32 nb_kernel_drops) {
+    this->nb_kernel_drops = nb_kernel_drops;
+    this->m_nb_kernel_drops_isSet = true;
+}
+
 
 bool
 SWGSDRdaemonSourceReport::isSet(){
@@ -206,6 +266,9 @@ SWGSDRdaemonSourceReport::isSet(){
         if(daemon_timestamp != nullptr && *daemon_timestamp != QString("")){ isObjectUpdated = true; break;}
         if(m_min_nb_blocks_isSet){ isObjectUpdated = true; break;}
         if(m_max_nb_recovery_isSet){ isObjectUpdated = true; break;}
+        if(m_jitter_us_isSet){ isObjectUpdated = true; break;}
+        if(m_max_gap_us_isSet){ isObjectUpdated = true; break;}
+        if(m_nb_kernel_drops_isSet){ isObjectUpdated = true; break;}
     }while(false);
     return isObjectUpdated;
 }
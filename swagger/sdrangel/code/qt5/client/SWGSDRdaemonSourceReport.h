@@ -60,6 +60,15 @@ public:
     qint32 getMaxNbRecovery();
     void setMaxNbRecovery(qint32 max_nb_recovery);
 
+    float getJitterUs();
+    void setJitterUs(float jitter_us);
+
+    qint32 getMaxGapUs();
+    void setMaxGapUs(qint32 max_gap_us);
+
+    qint32 getNbKernelDrops();
+    void setNbKernelDrops(qint32 nb_kernel_drops);
+
 
     virtual bool isSet() override;
 
@@ -82,6 +91,15 @@ private:
     qint32 max_nb_recovery;
     bool m_max_nb_recovery_isSet;
 
+    float jitter_us;
+    bool m_jitter_us_isSet;
+
+    qint32 max_gap_us;
+    bool m_max_gap_us_isSet;
+
+    qint32 nb_kernel_drops;
+    bool m_nb_kernel_drops_isSet;
+
 };
 
 }
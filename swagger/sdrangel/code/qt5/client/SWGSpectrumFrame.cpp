@@ -0,0 +1,280 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGSpectrumFrame.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGSpectrumFrame::SWGSpectrumFrame(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGSpectrumFrame::SWGSpectrumFrame() {
+    fft_size = 0;
+    m_fft_size_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    sequence = 0L;
+    m_sequence_isSet = false;
+    timestamp = 0L;
+    m_timestamp_isSet = false;
+    linear = 0;
+    m_linear_isSet = false;
+    power = nullptr;
+    m_power_isSet = false;
+    max_hold = nullptr;
+    m_max_hold_isSet = false;
+    min_hold = nullptr;
+    m_min_hold_isSet = false;
+}
+
+SWGSpectrumFrame::~SWGSpectrumFrame() {
+    this->cleanup();
+}
+
+void
+SWGSpectrumFrame::init() {
+    fft_size = 0;
+    m_fft_size_isSet = false;
+    center_frequency = 0L;
+    m_center_frequency_isSet = false;
+    sample_rate = 0;
+    m_sample_rate_isSet = false;
+    sequence = 0L;
+    m_sequence_isSet = false;
+    timestamp = 0L;
+    m_timestamp_isSet = false;
+    linear = 0;
+    m_linear_isSet = false;
+    power = new QList<float>();
+    m_power_isSet = false;
+    max_hold = new QList<float>();
+    m_max_hold_isSet = false;
+    min_hold = new QList<float>();
+    m_min_hold_isSet = false;
+}
+
+void
+SWGSpectrumFrame::cleanup() {
+
+
+
+
+
+
+    if(power != nullptr) { 
+        delete power;
+    }
+    if(max_hold != nullptr) { 
+        delete max_hold;
+    }
+    if(min_hold != nullptr) { 
+        delete min_hold;
+    }
+}
+
+SWGSpectrumFrame*
+SWGSpectrumFrame::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGSpectrumFrame::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&fft_size, pJson["fftSize"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&center_frequency, pJson["centerFrequency"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&sample_rate, pJson["sampleRate"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&sequence, pJson["sequence"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&timestamp, pJson["timestamp"], "qint64", "");
+    
+    ::SWGSDRangel::setValue(&linear, pJson["linear"], "qint32", "");
+    
+    
+    ::SWGSDRangel::setValue(&power, pJson["power"], "QList", "float");
+    
+    ::SWGSDRangel::setValue(&max_hold, pJson["maxHold"], "QList", "float");
+    
+    ::SWGSDRangel::setValue(&min_hold, pJson["minHold"], "QList", "float");
+}
+
+QString
+SWGSpectrumFrame::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGSpectrumFrame::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(m_fft_size_isSet){
+        obj->insert("fftSize", QJsonValue(fft_size));
+    }
+    if(m_center_frequency_isSet){
+        obj->insert("centerFrequency", QJsonValue(center_frequency));
+    }
+    if(m_sample_rate_isSet){
+        obj->insert("sampleRate", QJsonValue(sample_rate));
+    }
+    if(m_sequence_isSet){
+        obj->insert("sequence", QJsonValue(sequence));
+    }
+    if(m_timestamp_isSet){
+        obj->insert("timestamp", QJsonValue(timestamp));
+    }
+    if(m_linear_isSet){
+        obj->insert("linear", QJsonValue(linear));
+    }
+    if(power->size() > 0){
+        toJsonArray((QList<void*>*)power, obj, "power", "float");
+    }
+    if(max_hold->size() > 0){
+        toJsonArray((QList<void*>*)max_hold, obj, "maxHold", "float");
+    }
+    if(min_hold->size() > 0){
+        toJsonArray((QList<void*>*)min_hold, obj, "minHold", "float");
+    }
+
+    return obj;
+}
+
+qint32
+SWGSpectrumFrame::getFftSize() {
+    return fft_size;
+}
+void
+SWGSpectrumFrame::setFftSize(qint32 fft_size) {
+    this->fft_size = fft_size;
+    this->m_fft_size_isSet = true;
+}
+
+qint64
+SWGSpectrumFrame::getCenterFrequency() {
+    return center_frequency;
+}
+void
+SWGSpectrumFrame::setCenterFrequency(qint64 center_frequency) {
+    this->center_frequency = center_frequency;
+    this->m_center_frequency_isSet = true;
+}
+
+qint32
+SWGSpectrumFrame::getSampleRate() {
+    return sample_rate;
+}
+void
+SWGSpectrumFrame::setSampleRate(qint32 sample_rate) {
+    this->sample_rate = sample_rate;
+    this->m_sample_rate_isSet = true;
+}
+
+qint64
+SWGSpectrumFrame::getSequence() {
+    return sequence;
+}
+void
+SWGSpectrumFrame::setSequence(qint64 sequence) {
+    this->sequence = sequence;
+    this->m_sequence_isSet = true;
+}
+
+qint64
+SWGSpectrumFrame::getTimestamp() {
+    return timestamp;
+}
+void
+SWGSpectrumFrame::setTimestamp(qint64 timestamp) {
+    this->timestamp = timestamp;
+    this->m_timestamp_isSet = true;
+}
+
+qint32
+SWGSpectrumFrame::getLinear() {
+    return linear;
+}
+void
+SWGSpectrumFrame::setLinear(qint32 linear) {
+    this->linear = linear;
+    this->m_linear_isSet = true;
+}
+
+QList<float>*
+SWGSpectrumFrame::getPower() {
+    return power;
+}
+void
+SWGSpectrumFrame::setPower(QList<float>* power) {
+    this->power = power;
+    this->m_power_isSet = true;
+}
+
+QList<float>*
+SWGSpectrumFrame::getMaxHold() {
+    return max_hold;
+}
+void
+SWGSpectrumFrame::setMaxHold(QList<float>* max_hold) {
+    this->max_hold = max_hold;
+    this->m_max_hold_isSet = true;
+}
+
+QList<float>*
+SWGSpectrumFrame::getMinHold() {
+    return min_hold;
+}
+void
+SWGSpectrumFrame::setMinHold(QList<float>* min_hold) {
+    this->min_hold = min_hold;
+    this->m_min_hold_isSet = true;
+}
+
+
+bool
+SWGSpectrumFrame::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(m_fft_size_isSet){ isObjectUpdated = true; break;}
+        if(m_center_frequency_isSet){ isObjectUpdated = true; break;}
+        if(m_sample_rate_isSet){ isObjectUpdated = true; break;}
+        if(m_sequence_isSet){ isObjectUpdated = true; break;}
+        if(m_timestamp_isSet){ isObjectUpdated = true; break;}
+        if(m_linear_isSet){ isObjectUpdated = true; break;}
+        if(power->size() > 0){ isObjectUpdated = true; break;}
+        if(max_hold->size() > 0){ isObjectUpdated = true; break;}
+        if(min_hold->size() > 0){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+
@@ -0,0 +1,107 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+/*
+ * SWGSpectrumFrame.h
+ *
+ * Latest spectrum frame of a device set
+ */
+
+#ifndef SWGSpectrumFrame_H_
+#define SWGSpectrumFrame_H_
+
+#include <QJsonObject>
+
+
+#include <QList>
+
+#include "SWGObject.h"
+#include "export.h"
+
+namespace SWGSDRangel {
+
+class SWG_API SWGSpectrumFrame: public SWGObject {
+public:
+    SWGSpectrumFrame();
+    SWGSpectrumFrame(QString* json);
+    virtual ~SWGSpectrumFrame();
+    void init();
+    void cleanup();
+
+    virtual QString asJson () override;
+    virtual QJsonObject* asJsonObject() override;
+    virtual void fromJsonObject(QJsonObject &json) override;
+    virtual SWGSpectrumFrame* fromJson(QString &jsonString) override;
+
+    qint32 getFftSize();
+    void setFftSize(qint32 fft_size);
+
+    qint64 getCenterFrequency();
+    void setCenterFrequency(qint64 center_frequency);
+
+    qint32 getSampleRate();
+    void setSampleRate(qint32 sample_rate);
+
+    qint64 getSequence();
+    void setSequence(qint64 sequence);
+
+    qint64 getTimestamp();
+    void setTimestamp(qint64 timestamp);
+
+    qint32 getLinear();
+    void setLinear(qint32 linear);
+
+    QList<float>* getPower();
+    void setPower(QList<float>* power);
+
+    QList<float>* getMaxHold();
+    void setMaxHold(QList<float>* max_hold);
+
+    QList<float>* getMinHold();
+    void setMinHold(QList<float>* min_hold);
+
+
+    virtual bool isSet() override;
+
+private:
+    qint32 fft_size;
+    bool m_fft_size_isSet;
+
+    qint64 center_frequency;
+    bool m_center_frequency_isSet;
+
+    qint32 sample_rate;
+    bool m_sample_rate_isSet;
+
+    qint64 sequence;
+    bool m_sequence_isSet;
+
+    qint64 timestamp;
+    bool m_timestamp_isSet;
+
+    qint32 linear;
+    bool m_linear_isSet;
+
+    QList<float>* power;
+    bool m_power_isSet;
+
+    QList<float>* max_hold;
+    bool m_max_hold_isSet;
+
+    QList<float>* min_hold;
+    bool m_min_hold_isSet;
+
+};
+
+}
+
+#endif /* SWGSpectrumFrame_H_ */
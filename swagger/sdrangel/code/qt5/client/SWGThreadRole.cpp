@@ -0,0 +1,196 @@
+/**
+ * SDRangel
+ * This is the web REST/JSON API of SDRangel SDR software. SDRangel is an Open Source Qt5/OpenGL 3.0+ (4.3+ in Windows) GUI and server Software Defined Radio and signal analyzer in software. It supports Airspy, BladeRF, HackRF, LimeSDR, PlutoSDR, RTL-SDR, SDRplay RSP1 and FunCube    ---   Limitations and specifcities:    * In SDRangel GUI the first Rx device set cannot be deleted. Conversely the server starts with no device sets and its number of device sets can be reduced to zero by as many calls as necessary to /sdrangel/deviceset with DELETE method.   * Preset import and export from/to file is a server only feature.   * Device set focus is a GUI only feature.   * The following channels are not implemented (status 501 is returned): ATV and DATV demodulators, Channel Analyzer NG, LoRa demodulator   * The device settings and report structures contains only the sub-structure corresponding to the device type. The DeviceSettings and DeviceReport structures documented here shows all of them but only one will be or should be present at a time   * The channel settings and report structures contains only the sub-structure corresponding to the channel type. The ChannelSettings and ChannelReport structures documented here shows all of them but only one will be or should be present at a time    --- 
+ *
+ * OpenAPI spec version: 4.2.0
+ * Contact: f4exb06@gmail.com
+ *
+ * NOTE: This class is auto generated by the swagger code generator program.
+ * https://github.com/swagger-api/swagger-codegen.git
+ * Do not edit the class manually.
+ */
+
+
+#include "SWGThreadRole.h"
+
+#include "SWGHelpers.h"
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QObject>
+#include <QDebug>
+
+namespace SWGSDRangel {
+
+SWGThreadRole::SWGThreadRole(QString* json) {
+    init();
+    this->fromJson(*json);
+}
+
+SWGThreadRole::SWGThreadRole() {
+    role = nullptr;
+    m_role_isSet = false;
+    cpus = nullptr;
+    m_cpus_isSet = false;
+    policy = nullptr;
+    m_policy_isSet = false;
+    priority = 0;
+    m_priority_isSet = false;
+    nice = 0;
+    m_nice_isSet = false;
+}
+
+SWGThreadRole::~SWGThreadRole() {
+    this->cleanup();
+}
+
+void
+SWGThreadRole::init() {
+    role = new QString("");
+    m_role_isSet = false;
+    cpus = new QString("");
+    m_cpus_isSet = false;
+    policy = new QString("");
+    m_policy_isSet = false;
+    priority = 0;
+    m_priority_isSet = false;
+    nice = 0;
+    m_nice_isSet = false;
+}
+
+void
+SWGThreadRole::cleanup() {
+    if(role != nullptr) { 
+        delete role;
+    }
+    if(cpus != nullptr) { 
+        delete cpus;
+    }
+    if(policy != nullptr) { 
+        delete policy;
+    }
+
+
+}
+
+SWGThreadRole*
+SWGThreadRole::fromJson(QString &json) {
+    QByteArray array (json.toStdString().c_str());
+    QJsonDocument doc = QJsonDocument::fromJson(array);
+    QJsonObject jsonObject = doc.object();
+    this->fromJsonObject(jsonObject);
+    return this;
+}
+
+void
+SWGThreadRole::fromJsonObject(QJsonObject &pJson) {
+    ::SWGSDRangel::setValue(&role, pJson["role"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&cpus, pJson["cpus"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&policy, pJson["policy"], "QString", "QString");
+    
+    ::SWGSDRangel::setValue(&priority, pJson["priority"], "qint32", "");
+    
+    ::SWGSDRangel::setValue(&nice, pJson["nice"], "qint32", "");
+    
+}
+
+QString
+SWGThreadRole::asJson ()
+{
+    QJsonObject* obj = this->asJsonObject();
+
+    QJsonDocument doc(*obj);
+    QByteArray bytes = doc.toJson();
+    delete obj;
+    return QString(bytes);
+}
+
+QJsonObject*
+SWGThreadRole::asJsonObject() {
+    QJsonObject* obj = new QJsonObject();
+    if(role != nullptr && *role != QString("")){
+        toJsonValue(QString("role"), role, obj, QString("QString"));
+    }
+    if(cpus != nullptr && *cpus != QString("")){
+        toJsonValue(QString("cpus"), cpus, obj, QString("QString"));
+    }
+    if(policy != nullptr && *policy != QString("")){
+        toJsonValue(QString("policy"), policy, obj, QString("QString"));
+    }
+    if(m_priority_isSet){
+        obj->insert("priority", QJsonValue(priority));
+    }
+    if(m_nice_isSet){
+        obj->insert("nice", QJsonValue(nice));
+    }
+
+    return obj;
+}
+
+QString*
+SWGThreadRole::getRole() {
+    return role;
+}
+void
+SWGThreadRole::setRole(QString* role) {
+    this->role = role;
+    this->m_role_isSet = true;
+}
+
+QString*
+SWGThreadRole::getCpus() {
+    return cpus;
+}
+void
+SWGThreadRole::setCpus(QString* cpus) {
+    this->cpus = cpus;
+    this->m_cpus_isSet = true;
+}
+
+QString*
+SWGThreadRole::getPolicy() {
+    return policy;
+}
+void
+SWGThreadRole::setPolicy(QString* policy) {
+    this->policy = policy;
+    this->m_policy_isSet = true;
+}
+
+qint32
+SWGThreadRole::getPriority() {
+    return priority;
+}
+void
+SWGThreadRole::setPriority(qint32 priority) {
+    this->priority = priority;
+    this->m_priority_isSet = true;
+}
+
+qint32
+SWGThreadRole::getNice() {
+    return nice;
+}
+void
+SWGThreadRole::setNice(qint32 nice) {
+    this->nice = nice;
+    this->m_nice_isSet = true;
+}
+
+
+bool
+SWGThreadRole::isSet(){
+    bool isObjectUpdated = false;
+    do{
+        if(role != nullptr && *role != QString("")){ isObjectUpdated = true; break;}
+        if(cpus != nullptr && *cpus != QString("")){ isObjectUpdated = true; break;}
+        if(policy != nullptr && *policy != QString("")){ isObjectUpdated = true; break;}
+        if(m_priority_isSet){ isObjectUpdated = true; break;}
+        if(m_nice_isSet){ isObjectUpdated = true; break;}
+    }while(false);
+    return isObjectUpdated;
+}
+}
+